@@ -64,6 +64,7 @@ if (OGRE_CONFIG_THREADS)
 
 	if (OGRE_CONFIG_THREAD_PROVIDER STREQUAL "std")
 		set(OGRE_THREAD_PROVIDER 4)
+		set(OGRE_THREAD_WORK_STEALING ${OGRE_CONFIG_THREAD_WORK_STEALING})
 	endif ()
 
 endif()
@@ -0,0 +1,159 @@
+/*
+ * -----------------------------------------------------------------------------
+ * This source file is part of OGRE
+ * (Object-oriented Graphics Rendering Engine)
+ * For the latest info, see http://www.ogre3d.org/
+ *
+ * Copyright (c) 2000-2014 Torus Knot Software Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef __LodBatchGenerator_H_
+#define __LodBatchGenerator_H_
+
+#include "OgreLodPrerequisites.h"
+#include "OgreLodConfig.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+/** \addtogroup Optional
+*  @{
+*/
+/** \addtogroup MeshLodGenerator
+*  @{
+*/
+
+/**
+ * @brief Generates the Lod levels of many meshes, using all the threads of the WorkQueue.
+ *
+ * The meshes are loaded, injected and saved on the calling thread in the order they were added,
+ * while the Lod levels of the following meshes are generated by tasks on the WorkQueue.
+ * Generation runs ahead by at most the memory budget, but always by at least one mesh.
+ * Without a running WorkQueue, the meshes are generated one by one on the calling thread.
+ *
+ * MeshLodGenerator must be created before calling generate().
+ */
+class _OgreLodExport LodBatchGenerator : public MeshLodAlloc
+{
+public:
+    /// Progress and throughput of generate()
+    struct Statistics {
+        size_t meshCount; /// Number of meshes to process
+        size_t generatedCount; /// Number of meshes whose Lod levels were generated so far
+        size_t skippedCount; /// Number of meshes skipped, because their saved Lod config is up to date
+        size_t failedCount; /// Number of meshes which could not be loaded, generated or saved
+        size_t triangleCount; /// Number of triangles in the generated meshes
+        size_t peakBytesInFlight; /// Most estimated memory used by the meshes in flight at any time
+        unsigned long generateTime; /// Time spent generating, summed over all threads, in microseconds
+        unsigned long elapsedTime; /// Time since generate() started, in microseconds
+    };
+
+    /**
+     * @brief Receives the progress of generate().
+     */
+    class _OgreLodExport Listener
+    {
+    public:
+        virtual ~Listener() {}
+        /// Called on the calling thread of generate() after each mesh.
+        virtual void meshProcessed(const String& name, const String& group, const Statistics& statistics) = 0;
+    };
+
+    LodBatchGenerator();
+
+    /**
+     * @brief Sets the Lod config used for every mesh.
+     *
+     * Its mesh is ignored. If it has no Lod levels, MeshLodGenerator::getAutoconfig is used for
+     * each mesh, keeping the advanced settings. (no Lod levels by default)
+     */
+    void setLodConfig(const LodConfig& lodConfig);
+    const LodConfig& getLodConfig() const { return mLodConfig; }
+
+    /**
+     * @brief Sets how much memory the meshes being generated may use.
+     *
+     * It is estimated from the vertex and index count of the meshes. (256MB by default)
+     */
+    void setMemoryBudget(size_t bytes) { mMemoryBudget = bytes; }
+    size_t getMemoryBudget() const { return mMemoryBudget; }
+
+    /**
+     * @brief Sets the directory the meshes are saved to, after their Lod levels are generated.
+     *
+     * Saved meshes are unloaded, unless they were loaded before generate().
+     * If empty, the meshes are only kept loaded. (empty by default)
+     */
+    void setOutputDirectory(const String& path) { mOutputDirectory = path; }
+    const String& getOutputDirectory() const { return mOutputDirectory; }
+
+    /**
+     * @brief Sets the directory where the Lod config of each mesh is saved as "<mesh name>.lodconfig".
+     *
+     * A mesh is skipped if its saved Lod config is not older than the mesh file and it equals
+     * the config the mesh would be generated with. If empty, no mesh is skipped. (empty by default)
+     */
+    void setConfigDirectory(const String& path) { mConfigDirectory = path; }
+    const String& getConfigDirectory() const { return mConfigDirectory; }
+
+    void setListener(Listener* listener) { mListener = listener; }
+    Listener* getListener() const { return mListener; }
+
+    /// Adds a mesh to generate the Lod levels of.
+    void addMesh(const String& name, const String& group);
+    /// Adds all the .mesh files of a resource group.
+    void addResourceGroup(const String& group);
+    /// Removes all the added meshes.
+    void clear() { mMeshes.clear(); }
+
+    /**
+     * @brief Generates the Lod levels of all the added meshes.
+     *
+     * Errors of a mesh are logged and counted in Statistics::failedCount, they don't stop the batch.
+     */
+    void generate();
+
+    /// Gets the statistics of the current, or last, generate()
+    const Statistics& getStatistics() const { return mStatistics; }
+
+protected:
+    struct MeshEntry {
+        String name;
+        String group;
+    };
+    typedef vector<MeshEntry>::type MeshEntryList;
+
+    MeshEntryList mMeshes;
+    LodConfig mLodConfig;
+    size_t mMemoryBudget;
+    String mOutputDirectory;
+    String mConfigDirectory;
+    Listener* mListener;
+    Statistics mStatistics;
+};
+/** @} */
+/** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -55,6 +55,15 @@ public:
     /// Returns the collapse cost of the given edge. 
     virtual Real computeEdgeCollapseCost(LodData* data, LodData::Vertex* src, LodData::Edge* dstEdge) = 0;
 protected:
+    /** Computes the initial collapse costs like initCollapseCosts, spreading the
+        vertices over the threads of the WorkQueue.
+    @remarks
+        Only usable when computeVertexCollapseCost may run concurrently for different
+        vertices, that is when it writes nothing but the edges of the given vertex.
+        Falls back to initCollapseCosts for small meshes or without task concurrency.
+    */
+    void initCollapseCostsParallel(LodData* data);
+
     // Helper functions:
     bool isBorderVertex(const LodData::Vertex* vertex) const;
 };
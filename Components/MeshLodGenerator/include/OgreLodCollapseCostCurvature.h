@@ -41,6 +41,8 @@ class _OgreLodExport LodCollapseCostCurvature :
     public LodCollapseCost
 {
 public:
+    /// Computes the initial costs on the WorkQueue threads, if there are any.
+    virtual void initCollapseCosts(LodData* data);
     virtual Real computeEdgeCollapseCost(LodData* data, LodData::Vertex* src, LodData::Edge* dstEdge);
 };
 
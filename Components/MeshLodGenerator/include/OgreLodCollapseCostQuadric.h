@@ -55,6 +55,9 @@ protected:
     vector<Matrix4>::type mVertexQuadricList;
     void computeTrianglePlaneQuadric(LodData* data, size_t triangleID);
     void computeVertexQuadric(LodData* data, size_t vertexID);
+
+    /// Computes the quadrics of a range of triangles or vertices, for WorkQueue::parallelFor
+    struct QuadricTask;
 };
 
 }
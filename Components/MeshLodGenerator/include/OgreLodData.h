@@ -64,7 +64,7 @@ struct _OgreLodExport LodData {
     typedef vector<Vertex>::type VertexList;
     typedef vector<Triangle>::type TriangleList;
     typedef OGRE_HashSet<Vertex*, VertexHash, VertexEqual> UniqueVertexSet;
-    typedef multimap<Real, Vertex*>::type CollapseCostHeap;
+    class CollapseCostHeap;
 
     typedef VectorSet<Edge, 8> VEdges;
     typedef VectorSet<Triangle*, 7> VTriangles;
@@ -96,6 +96,56 @@ struct _OgreLodExport LodData {
         bool operator< (const Edge& other) const;
     };
 
+    /** Binary min-heap of the vertex collapse costs.
+    @remarks
+        Every vertex in the heap knows its position in it (Vertex::costHeapPosition),
+        so its cost can be changed or it can be removed in O(log n).
+        Equal costs are ordered by the vertex address, so the order of the
+        collapses doesn't depend on the order the vertices were added in.
+    */
+    class _OgreLodExport CollapseCostHeap {
+    public:
+        struct Entry {
+            Real cost;
+            Vertex* vertex;
+        };
+        typedef vector<Entry>::type EntryList;
+        typedef EntryList::const_iterator const_iterator;
+
+        /// Vertex::costHeapPosition of vertices which are not in the heap.
+        static const size_t NOT_IN_HEAP = ~static_cast<size_t>(0);
+
+        size_t size() const { return mEntries.size(); }
+        bool empty() const { return mEntries.empty(); }
+        void reserve(size_t count) { mEntries.reserve(count); }
+        void clear();
+        const_iterator begin() const { return mEntries.begin(); }
+        const_iterator end() const { return mEntries.end(); }
+
+        /// Returns the entry with the lowest cost. The heap must not be empty.
+        const Entry& top() const { return mEntries.front(); }
+        /// Returns the cost of a vertex, which must be in the heap.
+        Real getCost(const Vertex* vertex) const;
+
+        /// Adds a vertex, which must not be in the heap.
+        void push(Vertex* vertex, Real cost);
+        /// Changes the cost of a vertex, which must be in the heap.
+        void update(Vertex* vertex, Real cost);
+        /// Removes a vertex, which must be in the heap.
+        void erase(Vertex* vertex);
+        /// Replaces the content of the heap with the given entries in O(n). entries is left empty.
+        void assign(EntryList& entries);
+    private:
+        EntryList mEntries;
+
+        static bool less(const Entry& a, const Entry& b) {
+            return a.cost < b.cost || (a.cost == b.cost && a.vertex < b.vertex);
+        }
+        void place(size_t pos, const Entry& entry);
+        void siftUp(size_t pos);
+        void siftDown(size_t pos);
+    };
+
     struct Vertex {
         Vector3 position;
         VEdges edges;
@@ -104,7 +154,7 @@ struct _OgreLodExport LodData {
         Vector3 normal;
         Vertex* collapseTo;
         bool seam;
-        CollapseCostHeap::iterator costHeapPosition; /// Iterator pointing to the position in the mCollapseCostSet, which allows fast remove.
+        size_t costHeapPosition; /// Position in mCollapseCostHeap, which allows fast update and remove.
 
         void addEdge(const Edge& edge);
         void removeEdge(const Edge& edge);
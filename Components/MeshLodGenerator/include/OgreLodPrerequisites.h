@@ -54,6 +54,7 @@ namespace Ogre
     struct LodConfig;
     struct LodLevel;
     class LodConfigSerializer;
+    class LodBatchGenerator;
     class MeshLodGenerator;
     class LodWorkQueueWorker;
     class LodWorkQueueInjector;
@@ -0,0 +1,394 @@
+/*
+ * -----------------------------------------------------------------------------
+ * This source file is part of OGRE
+ * (Object-oriented Graphics Rendering Engine)
+ * For the latest info, see http://www.ogre3d.org/
+ *
+ * Copyright (c) 2000-2014 Torus Knot Software Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * -----------------------------------------------------------------------------
+ */
+
+#include "OgreMeshLodPrecompiledHeaders.h"
+#include "OgreLodBatchGenerator.h"
+#include "OgreMeshSerializer.h"
+#include "OgreFileSystem.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
+#include "OgreTimer.h"
+
+namespace Ogre
+{
+
+namespace
+{
+    /// A mesh of LodBatchGenerator::generate, generated by a WorkQueue task
+    struct BatchJob : public MeshLodAlloc
+    {
+        enum { PENDING, GENERATING, DONE };
+
+        MeshPtr mesh;
+        bool wasLoaded;
+        bool skipped;
+        LodConfig config;
+        LodCollapseCostPtr cost;
+        LodDataPtr data;
+        LodInputProviderPtr input;
+        LodOutputProviderPtr output;
+        LodCollapserPtr collapser;
+        size_t bytes;
+        size_t triangles;
+
+        AtomicScalar<int> status;
+        /// Exception thrown while loading or generating, if any
+        std::exception_ptr error;
+        unsigned long generateTime;
+        OGRE_WQ_MUTEX(mutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(sync);
+
+        BatchJob()
+            : wasLoaded(false), skipped(false), bytes(0), triangles(0), status(PENDING), generateTime(0)
+        {
+        }
+
+        /// Generates the Lod levels, unless another thread already started it
+        bool generate()
+        {
+            int expected = PENDING;
+            if (!status.compare_exchange_strong(expected, GENERATING))
+                return false;
+
+            Timer timer;
+            try
+            {
+                MeshLodGenerator::getSingleton()._process(config, cost.get(), data.get(), input.get(),
+                                                          output.get(), collapser.get());
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            generateTime = timer.getMicroseconds();
+
+            // Only the output is needed for injecting, so release the rest of the memory early
+            cost.reset();
+            data.reset();
+            input.reset();
+            collapser.reset();
+
+            OGRE_WQ_LOCK_MUTEX(mutex);
+            status = DONE;
+            OGRE_THREAD_NOTIFY_ALL(sync);
+            return true;
+        }
+
+        /// Waits until the Lod levels are generated, generating them here if no task started it yet
+        void waitGenerated()
+        {
+            if (generate())
+                return;
+
+            OGRE_WQ_LOCK_MUTEX_NAMED(mutex, lock);
+            while (status != DONE)
+                OGRE_THREAD_WAIT(sync, mutex, lock);
+        }
+    };
+    typedef SharedPtr<BatchJob> BatchJobPtr;
+
+    /// Generates the Lod levels of one mesh of a batch
+    struct BatchJobTask
+    {
+        BatchJobPtr job;
+
+        void operator()() const { job->generate(); }
+    };
+
+    /// Estimates the memory used for generating the Lod levels of a mesh
+    size_t estimateLodMemory(const MeshPtr& mesh, size_t levelCount, size_t& outTriangleCount)
+    {
+        size_t vertexCount = mesh->sharedVertexData ? mesh->sharedVertexData->vertexCount : 0;
+        size_t indexCount = 0;
+        for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+        {
+            const SubMesh* submesh = mesh->getSubMesh(i);
+            if (!submesh->useSharedVertices && submesh->vertexData)
+                vertexCount += submesh->vertexData->vertexCount;
+            if (submesh->indexData)
+                indexCount += submesh->indexData->indexCount;
+        }
+        outTriangleCount = indexCount / 3;
+
+        // The LodData, the copy of the input buffers, and the output index buffers of each level
+        return vertexCount * (sizeof(LodData::Vertex) + 2 * sizeof(Vector3)) +
+               outTriangleCount * sizeof(LodData::Triangle) +
+               indexCount * sizeof(uint32) * (levelCount + 1);
+    }
+
+    bool equalLodConfig(const LodConfig& a, const LodConfig& b)
+    {
+        // The serializer stores floats, so compare at that precision
+        if (a.strategy != b.strategy || a.levels.size() != b.levels.size())
+            return false;
+        for (size_t i = 0; i < a.levels.size(); ++i)
+        {
+            const LodLevel& la = a.levels[i];
+            const LodLevel& lb = b.levels[i];
+            if ((float)la.distance != (float)lb.distance || la.manualMeshName != lb.manualMeshName)
+                return false;
+            if (la.manualMeshName.empty() &&
+                (la.reductionMethod != lb.reductionMethod || (float)la.reductionValue != (float)lb.reductionValue))
+                return false;
+        }
+        const LodConfig::Advanced& aa = a.advanced;
+        const LodConfig::Advanced& ab = b.advanced;
+        if (aa.useCompression != ab.useCompression || aa.useVertexNormals != ab.useVertexNormals ||
+            (float)aa.outsideWeight != (float)ab.outsideWeight ||
+            (float)aa.outsideWalkAngle != (float)ab.outsideWalkAngle ||
+            aa.profile.size() != ab.profile.size())
+            return false;
+        for (size_t i = 0; i < aa.profile.size(); ++i)
+        {
+            if (aa.profile[i].src != ab.profile[i].src || aa.profile[i].dst != ab.profile[i].dst ||
+                (float)aa.profile[i].cost != (float)ab.profile[i].cost)
+                return false;
+        }
+        return true;
+    }
+
+    void logBatchError(const String& name)
+    {
+        String description;
+        try
+        {
+            throw;
+        }
+        catch (Exception& e)
+        {
+            description = e.getFullDescription();
+        }
+        catch (std::exception& e)
+        {
+            description = e.what();
+        }
+        catch (...)
+        {
+            description = "unknown error";
+        }
+        LogManager::getSingleton().logMessage("Failed to generate the Lod levels of '" + name + "': " + description,
+                                              LML_CRITICAL);
+    }
+}
+
+LodBatchGenerator::LodBatchGenerator() :
+    mMemoryBudget(256 * 1024 * 1024),
+    mListener(0),
+    mStatistics()
+{
+    mLodConfig.strategy = 0;
+}
+
+void LodBatchGenerator::setLodConfig(const LodConfig& lodConfig)
+{
+    mLodConfig = lodConfig;
+    mLodConfig.mesh.reset();
+}
+
+void LodBatchGenerator::addMesh(const String& name, const String& group)
+{
+    MeshEntry entry = {name, group};
+    mMeshes.push_back(entry);
+}
+
+void LodBatchGenerator::addResourceGroup(const String& group)
+{
+    StringVectorPtr names = ResourceGroupManager::getSingleton().findResourceNames(group, "*.mesh");
+    for (StringVector::iterator it = names->begin(); it != names->end(); ++it)
+    {
+        addMesh(*it, group);
+    }
+}
+
+void LodBatchGenerator::generate()
+{
+    size_t meshCount = mMeshes.size();
+    LogManager::getSingleton().logMessage("Generating the Lod levels of " + StringConverter::toString(meshCount) +
+                                          " meshes");
+    Timer timer;
+    mStatistics = Statistics();
+    mStatistics.meshCount = meshCount;
+
+    // Not through the ArchiveManager, which would share the archive with a resource location in the same directory
+    FileSystemArchiveFactory archiveFactory;
+    Archive* configArchive = 0;
+    if (!mConfigDirectory.empty())
+    {
+        configArchive = archiveFactory.createInstance(mConfigDirectory, true);
+        configArchive->load();
+    }
+
+    WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+    bool parallel = queue && queue->getTaskConcurrency() > 0;
+    vector<BatchJobPtr>::type jobs(meshCount);
+    size_t submitted = 0;
+    size_t bytesInFlight = 0;
+    for (size_t i = 0; i < meshCount; ++i)
+    {
+        // Keep generating ahead of saving, as far as the budget allows
+        while (submitted < meshCount && (submitted == i || bytesInFlight < mMemoryBudget))
+        {
+            const MeshEntry& entry = mMeshes[submitted];
+            BatchJobPtr job(OGRE_NEW BatchJob());
+            jobs[submitted] = job;
+            ++submitted;
+            try
+            {
+                job->mesh = MeshManager::getSingleton().getByName(entry.name, entry.group);
+                job->wasLoaded = job->mesh && job->mesh->isLoaded();
+                job->mesh = MeshManager::getSingleton().load(entry.name, entry.group);
+
+                job->config = mLodConfig;
+                job->config.mesh = job->mesh;
+                if (job->config.levels.empty())
+                {
+                    MeshLodGenerator::getSingleton().getAutoconfig(job->mesh, job->config);
+                }
+                else if (!job->config.strategy)
+                {
+                    job->config.strategy = DistanceLodBoxStrategy::getSingletonPtr();
+                }
+
+                time_t meshTime = ResourceGroupManager::getSingleton().resourceModifiedTime(entry.group, entry.name);
+                String configName = entry.name + ".lodconfig";
+                if (configArchive && meshTime != 0 && configArchive->exists(configName) &&
+                    configArchive->getModifiedTime(configName) >= meshTime)
+                {
+                    LodConfig savedConfig;
+                    DataStreamPtr stream = configArchive->open(configName);
+                    LodConfigSerializer().importLodConfig(&savedConfig, stream);
+                    job->skipped = equalLodConfig(savedConfig, job->config);
+                }
+                if (job->skipped)
+                {
+                    job->status = BatchJob::DONE;
+                    continue;
+                }
+
+                // Only buffers are touched while generating, the mesh is injected on this thread
+                job->config.advanced.useBackgroundQueue = true;
+                MeshLodGenerator::getSingleton()._resolveComponents(job->config, job->cost, job->data, job->input,
+                                                                    job->output, job->collapser);
+                job->bytes = estimateLodMemory(job->mesh, job->config.levels.size(), job->triangles);
+            }
+            catch (...)
+            {
+                job->error = std::current_exception();
+                job->status = BatchJob::DONE;
+                continue;
+            }
+
+            bytesInFlight += job->bytes;
+            if (parallel)
+            {
+                BatchJobTask task = {job};
+                queue->addTask(task);
+            }
+        }
+        mStatistics.peakBytesInFlight = std::max(mStatistics.peakBytesInFlight, bytesInFlight);
+
+        BatchJobPtr job = jobs[i];
+        jobs[i].reset();
+        const MeshEntry& entry = mMeshes[i];
+        job->waitGenerated();
+        bytesInFlight -= job->bytes;
+        mStatistics.generateTime += job->generateTime;
+
+        if (job->skipped)
+        {
+            ++mStatistics.skippedCount;
+            LogManager::getSingleton().logMessage("Lod levels of '" + entry.name + "' are up to date");
+        }
+        else if (job->error)
+        {
+            ++mStatistics.failedCount;
+            try
+            {
+                std::rethrow_exception(job->error);
+            }
+            catch (...)
+            {
+                logBatchError(entry.name);
+            }
+        }
+        else
+        {
+            try
+            {
+                job->output->inject();
+                MeshLodGenerator::_configureMeshLodUsage(job->config);
+                job->output.reset();
+
+                if (!mOutputDirectory.empty())
+                {
+                    MeshSerializer().exportMesh(job->mesh.get(), mOutputDirectory + "/" + entry.name);
+                }
+                if (configArchive)
+                {
+                    job->config.advanced.useBackgroundQueue = mLodConfig.advanced.useBackgroundQueue;
+                    LodConfigSerializer().exportLodConfig(job->config, mConfigDirectory + "/" + entry.name +
+                                                                           ".lodconfig");
+                }
+                ++mStatistics.generatedCount;
+                mStatistics.triangleCount += job->triangles;
+            }
+            catch (...)
+            {
+                ++mStatistics.failedCount;
+                logBatchError(entry.name);
+            }
+        }
+
+        // Saved meshes can be reloaded, so free the memory of the ones nobody loaded
+        if (job->mesh && !job->wasLoaded && (job->skipped || !mOutputDirectory.empty()))
+        {
+            job->mesh->unload();
+        }
+
+        mStatistics.elapsedTime = timer.getMicroseconds();
+        if (mListener)
+        {
+            mListener->meshProcessed(entry.name, entry.group, mStatistics);
+        }
+    }
+    mStatistics.elapsedTime = timer.getMicroseconds();
+
+    if (configArchive)
+    {
+        configArchive->unload();
+        archiveFactory.destroyInstance(configArchive);
+    }
+
+    LogManager::getSingleton().logMessage(
+        "Generated the Lod levels of " + StringConverter::toString(mStatistics.generatedCount) + " meshes (" +
+        StringConverter::toString(mStatistics.skippedCount) + " skipped, " +
+        StringConverter::toString(mStatistics.failedCount) + " failed) in " +
+        StringConverter::toString(mStatistics.elapsedTime / 1000) + " ms");
+}
+
+}
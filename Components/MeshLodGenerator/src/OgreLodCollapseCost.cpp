@@ -30,25 +30,88 @@
 
 namespace Ogre
 {
+    namespace {
+        /// Meshes with less vertices have their initial costs computed serially
+        const size_t PARALLEL_COST_VERTICES = 4096;
+        /// Vertices per parallel chunk
+        const size_t PARALLEL_COST_GRAIN = 1024;
+
+        void logUnusedVertex(LodData* data, const LodData::Vertex& vertex)
+        {
+#if OGRE_DEBUG_MODE
+            LogManager::getSingleton().stream() << "In " << data->mMeshName << " never used vertex found with ID: " << data->mCollapseCostHeap.size() << ". "
+                << "Vertex position: ("
+                << vertex.position.x << ", "
+                << vertex.position.y << ", "
+                << vertex.position.z << ") "
+                << "It will be excluded from Lod level calculations.";
+#endif
+        }
+
+        /// Computes the initial collapse costs of a range of vertices, for WorkQueue::parallelFor
+        struct VertexCollapseCostTask {
+            LodCollapseCost* cost;
+            LodData* data;
+            Real* costs;
+
+            void operator()(size_t begin, size_t end) const
+            {
+                for (size_t i = begin; i < end; i++) {
+                    LodData::Vertex* vertex = &data->mVertexList[i];
+                    if (vertex->edges.empty()) {
+                        continue;
+                    }
+                    Real collapseCost = LodData::UNINITIALIZED_COLLAPSE_COST;
+                    LodData::Vertex* collapseTo = NULL;
+                    cost->computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
+                    vertex->collapseTo = collapseTo;
+                    costs[i] = collapseCost;
+                }
+            }
+        };
+    }
+
     void LodCollapseCost::initCollapseCosts( LodData* data )
     {
         data->mCollapseCostHeap.clear();
+        data->mCollapseCostHeap.reserve(data->mVertexList.size());
         LodData::VertexList::iterator it = data->mVertexList.begin();
         LodData::VertexList::iterator itEnd = data->mVertexList.end();
         for (; it != itEnd; it++) {
             if (!it->edges.empty()) {
                 initVertexCollapseCost(data, &*it);
             } else {
-#if OGRE_DEBUG_MODE
-                LogManager::getSingleton().stream() << "In " << data->mMeshName << " never used vertex found with ID: " << data->mCollapseCostHeap.size() << ". "
-                    << "Vertex position: ("
-                    << it->position.x << ", "
-                    << it->position.y << ", "
-                    << it->position.z << ") "
-                    << "It will be excluded from Lod level calculations.";
-#endif
+                logUnusedVertex(data, *it);
+            }
+        }
+    }
+
+    void LodCollapseCost::initCollapseCostsParallel( LodData* data )
+    {
+        WorkQueue* workQueue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+        size_t vertexCount = data->mVertexList.size();
+        if (!workQueue || !workQueue->getTaskConcurrency() || vertexCount < PARALLEL_COST_VERTICES) {
+            LodCollapseCost::initCollapseCosts(data);
+            return;
+        }
+
+        data->mCollapseCostHeap.clear();
+        vector<Real>::type costs(vertexCount);
+        VertexCollapseCostTask task = { this, data, &costs[0] };
+        workQueue->parallelFor(0, vertexCount, PARALLEL_COST_GRAIN, task);
+
+        LodData::CollapseCostHeap::EntryList entries;
+        entries.reserve(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++) {
+            LodData::Vertex* vertex = &data->mVertexList[i];
+            if (!vertex->edges.empty()) {
+                LodData::CollapseCostHeap::Entry entry = { costs[i], vertex };
+                entries.push_back(entry);
+            } else {
+                logUnusedVertex(data, *vertex);
             }
         }
+        data->mCollapseCostHeap.assign(entries);
     }
 
     void LodCollapseCost::computeVertexCollapseCost( LodData* data, LodData::Vertex* vertex, Real& collapseCost, LodData::Vertex*& collapseTo )
@@ -71,7 +134,7 @@ namespace Ogre
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
         vertex->collapseTo = collapseTo;
-        vertex->costHeapPosition = data->mCollapseCostHeap.insert(LodData::CollapseCostHeap::value_type(collapseCost, vertex));
+        data->mCollapseCostHeap.push(vertex, collapseCost);
     }
 
     void LodCollapseCost::updateVertexCollapseCost( LodData* data, LodData::Vertex* vertex )
@@ -80,16 +143,14 @@ namespace Ogre
         LodData::Vertex* collapseTo = NULL;
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
-        if (vertex->collapseTo != collapseTo || collapseCost != vertex->costHeapPosition->first) {
-            OgreAssert(vertex->costHeapPosition != data->mCollapseCostHeap.end(), "");
-            data->mCollapseCostHeap.erase(vertex->costHeapPosition);
+        if (vertex->collapseTo != collapseTo || collapseCost != data->mCollapseCostHeap.getCost(vertex)) {
             if (collapseCost != LodData::UNINITIALIZED_COLLAPSE_COST) {
                 vertex->collapseTo = collapseTo;
-                vertex->costHeapPosition = data->mCollapseCostHeap.insert(LodData::CollapseCostHeap::value_type(collapseCost, vertex));
+                data->mCollapseCostHeap.update(vertex, collapseCost);
             } else {
+                data->mCollapseCostHeap.erase(vertex);
 #if OGRE_DEBUG_MODE
                 vertex->collapseTo = NULL;
-                vertex->costHeapPosition = data->mCollapseCostHeap.end();
 #endif
             }
         }
@@ -36,6 +36,11 @@
 
 namespace Ogre
 {
+    void LodCollapseCostCurvature::initCollapseCosts( LodData* data )
+    {
+        initCollapseCostsParallel(data);
+    }
+
     Real LodCollapseCostCurvature::computeEdgeCollapseCost( LodData* data, LodData::Vertex* src, LodData::Edge* dstEdge )
     {
         LodData::Vertex* dst = dstEdge->dst;
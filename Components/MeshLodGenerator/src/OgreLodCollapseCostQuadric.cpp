@@ -34,21 +34,55 @@
 
 #include "OgreLodCollapseCostQuadric.h"
 #include "OgreVector3.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre
 {
+    namespace {
+        /// Quadrics per parallel chunk
+        const size_t PARALLEL_QUADRIC_GRAIN = 1024;
+    }
+
+    struct LodCollapseCostQuadric::QuadricTask {
+        LodCollapseCostQuadric* cost;
+        LodData* data;
+        bool vertices;
+
+        void operator()(size_t begin, size_t end) const
+        {
+            for (size_t i = begin; i < end; i++) {
+                if (vertices) {
+                    cost->computeVertexQuadric(data, i);
+                } else {
+                    cost->computeTrianglePlaneQuadric(data, i);
+                }
+            }
+        }
+    };
 
     void LodCollapseCostQuadric::initCollapseCosts( LodData* data )
     {
+        WorkQueue* workQueue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+        bool parallel = workQueue && workQueue->getTaskConcurrency();
+
         mTrianglePlaneQuadricList.resize(data->mTriangleList.size());
-        for(size_t i=0;i<mTrianglePlaneQuadricList.size();i++){
-            computeTrianglePlaneQuadric(data, i);
+        QuadricTask triangleTask = { this, data, false };
+        if (parallel) {
+            workQueue->parallelFor(0, mTrianglePlaneQuadricList.size(), PARALLEL_QUADRIC_GRAIN, triangleTask);
+        } else {
+            triangleTask(0, mTrianglePlaneQuadricList.size());
         }
+
         mVertexQuadricList.resize(data->mVertexList.size());
-        for (size_t i=0;i<mVertexQuadricList.size();i++) {
-            computeVertexQuadric(data, i);
+        QuadricTask vertexTask = { this, data, true };
+        if (parallel) {
+            workQueue->parallelFor(0, mVertexQuadricList.size(), PARALLEL_QUADRIC_GRAIN, vertexTask);
+        } else {
+            vertexTask(0, mVertexQuadricList.size());
         }
-        LodCollapseCost::initCollapseCosts(data);
+
+        initCollapseCostsParallel(data);
     }
 
     void LodCollapseCostQuadric::computeTrianglePlaneQuadric( LodData* data, size_t triangleID )
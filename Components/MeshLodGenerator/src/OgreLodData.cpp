@@ -32,6 +32,116 @@ namespace Ogre
 // Use float limits instead of Real limits, because LodConfigSerializer may convert them to float.
 const Real LodData::NEVER_COLLAPSE_COST = std::numeric_limits<float>::max();
 const Real LodData::UNINITIALIZED_COLLAPSE_COST = std::numeric_limits<float>::infinity();
+const size_t LodData::CollapseCostHeap::NOT_IN_HEAP;
+
+void LodData::CollapseCostHeap::clear()
+{
+    for (size_t i = 0; i < mEntries.size(); i++) {
+        mEntries[i].vertex->costHeapPosition = NOT_IN_HEAP;
+    }
+    mEntries.clear();
+}
+
+Real LodData::CollapseCostHeap::getCost( const Vertex* vertex ) const
+{
+    OgreAssertDbg(vertex->costHeapPosition < mEntries.size() && mEntries[vertex->costHeapPosition].vertex == vertex, "Vertex is not in the heap");
+    return mEntries[vertex->costHeapPosition].cost;
+}
+
+void LodData::CollapseCostHeap::push( Vertex* vertex, Real cost )
+{
+    OgreAssertDbg(vertex->costHeapPosition == NOT_IN_HEAP, "Vertex is already in the heap");
+    Entry entry = { cost, vertex };
+    mEntries.push_back(entry);
+    vertex->costHeapPosition = mEntries.size() - 1;
+    siftUp(mEntries.size() - 1);
+}
+
+void LodData::CollapseCostHeap::update( Vertex* vertex, Real cost )
+{
+    size_t pos = vertex->costHeapPosition;
+    OgreAssertDbg(pos < mEntries.size() && mEntries[pos].vertex == vertex, "Vertex is not in the heap");
+    Real oldCost = mEntries[pos].cost;
+    mEntries[pos].cost = cost;
+    if (cost < oldCost) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+void LodData::CollapseCostHeap::erase( Vertex* vertex )
+{
+    size_t pos = vertex->costHeapPosition;
+    OgreAssertDbg(pos < mEntries.size() && mEntries[pos].vertex == vertex, "Vertex is not in the heap");
+    vertex->costHeapPosition = NOT_IN_HEAP;
+
+    // Move the last entry into the hole, then restore the heap in the direction it has to go.
+    Entry last = mEntries.back();
+    mEntries.pop_back();
+    if (pos < mEntries.size()) {
+        place(pos, last);
+        if (pos > 0 && less(last, mEntries[(pos - 1) / 2])) {
+            siftUp(pos);
+        } else {
+            siftDown(pos);
+        }
+    }
+}
+
+void LodData::CollapseCostHeap::assign( EntryList& entries )
+{
+    clear();
+    mEntries.swap(entries);
+    for (size_t i = 0; i < mEntries.size(); i++) {
+        mEntries[i].vertex->costHeapPosition = i;
+    }
+    // Floyd's heap construction.
+    for (size_t i = mEntries.size() / 2; i > 0; i--) {
+        siftDown(i - 1);
+    }
+}
+
+void LodData::CollapseCostHeap::place( size_t pos, const Entry& entry )
+{
+    mEntries[pos] = entry;
+    entry.vertex->costHeapPosition = pos;
+}
+
+void LodData::CollapseCostHeap::siftUp( size_t pos )
+{
+    Entry entry = mEntries[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!less(entry, mEntries[parent])) {
+            break;
+        }
+        place(pos, mEntries[parent]);
+        pos = parent;
+    }
+    place(pos, entry);
+}
+
+void LodData::CollapseCostHeap::siftDown( size_t pos )
+{
+    Entry entry = mEntries[pos];
+    size_t count = mEntries.size();
+    for (;;) {
+        size_t child = pos * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && less(mEntries[child + 1], mEntries[child])) {
+            child++;
+        }
+        if (!less(mEntries[child], entry)) {
+            break;
+        }
+        place(pos, mEntries[child]);
+        pos = child;
+    }
+    place(pos, entry);
+}
 
 void LodData::Vertex::addEdge( const LodData::Edge& edge )
 {
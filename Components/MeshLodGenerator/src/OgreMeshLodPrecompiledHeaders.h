@@ -58,6 +58,7 @@ THE SOFTWARE.
 #include "OgreLodCollapseCostOutside.h"
 #include "OgreLodConfig.h"
 #include "OgreLodConfigSerializer.h"
+#include "OgreLodBatchGenerator.h"
 #include "OgreLodData.h"
 #include "OgreLodCollapser.h"
 #include "OgreLodStrategyManager.h"
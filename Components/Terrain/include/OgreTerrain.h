@@ -1248,8 +1248,11 @@ namespace Ogre
 
         /** Calculate (or recalculate) the delta values of heights between a vertex
             in its recorded position, and the place it will end up in the LOD
-            in which it is removed. 
-        @param rect Rectangle describing the area in which heights have altered 
+            in which it is removed.
+        @remarks
+            Rows of quads are spread across the threads of the WorkQueue,
+            as they are for calculateNormals and calculateLightmap.
+        @param rect Rectangle describing the area in which heights have altered
         @return A Rectangle describing the area which was updated (may be wider
             than the input rectangle)
         */
@@ -1691,6 +1694,30 @@ namespace Ogre
         @note This point is relative to Terrain::getPosition
         */
         void getPointAlign(long x, long y, float height, Alignment align, Vector3* outpos) const;
+        /** Calculate the height deltas of a range of quad rows at one target LOD.
+        @param lodRect The area being calculated, rounded to the step of this LOD
+        @param targetLevel The LOD the deltas are calculated for
+        @param beginRow, endRow The range of quad rows, counted from lodRect.top
+        @param levelDeltas Output deltas for every vertex of lodRect, row major
+        */
+        void calculateHeightDeltasRows(const Rect& lodRect, int targetLevel,
+            long beginRow, long endRow, Real* levelDeltas);
+        /** Calculate the encoded normals of rows [top, bottom) of rect.
+        @param rect The area being calculated, which pData covers
+        @param pData Output PF_BYTE_RGB data, inverted in Y
+        */
+        void calculateNormalsRows(const Rect& rect, long top, long bottom, uint8* pData) const;
+        /// Calculate the normal at a point the slow way, looking in neighbours if need be
+        Vector3 calculateNormalAt(long x, long y) const;
+        /** Calculate the lightmap of rows [top, bottom) of rect.
+        @param rect The area being calculated in lightmap space, which pData covers
+        @param pData Output PF_L8 data, inverted in Y
+        */
+        void calculateLightmapRows(const Rect& rect, long top, long bottom, uint8* pData);
+        /// WorkQueue::parallelFor bodies for the derived data calculations
+        struct HeightDeltasTask;
+        struct NormalsTask;
+        struct LightmapTask;
         void calculateCurrentLod(Viewport* vp);
         /// Test a single quad of the terrain for ray intersection.
         std::pair<bool, Vector3> checkQuadIntersection(int x, int y, const Ray& ray); //const;
@@ -164,6 +164,16 @@ namespace Ogre
         /** Notify the node (and children) of a height delta value. */
         void notifyDelta(uint16 x, uint16 y, uint16 lod, Real delta);
 
+        /** Notify the node (and children) of the height delta values of an area.
+        @remarks
+            Equivalent to calling notifyDelta for every vertex of rect, but
+            each node only looks at the part of rect it covers once.
+        @param rect The area the deltas cover
+        @param lod The LOD level the deltas apply to
+        @param deltas One delta per vertex of rect, row major
+        */
+        void notifyDeltas(const Rect& rect, uint16 lod, const Real* deltas);
+
         /** Notify the node (and children) that deltas have finished being calculated.
         */
         void postDeltaCalculation(const Rect& rect);
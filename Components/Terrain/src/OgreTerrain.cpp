@@ -41,6 +41,7 @@ THE SOFTWARE.
 #include "OgreHardwarePixelBuffer.h"
 #include "OgreTextureManager.h"
 #include "OgreRoot.h"
+#include "OgreWorkQueue.h"
 #include "OgreRenderSystem.h"
 #include "OgreRay.h"
 #include "OgrePlane.h"
@@ -2092,6 +2093,19 @@ namespace Ogre
         }
     }
     //---------------------------------------------------------------------
+    struct Terrain::HeightDeltasTask
+    {
+        Terrain* terrain;
+        const Rect* lodRect;
+        int targetLevel;
+        Real* levelDeltas;
+
+        void operator()(size_t begin, size_t end) const
+        {
+            terrain->calculateHeightDeltasRows(*lodRect, targetLevel, begin, end, levelDeltas);
+        }
+    };
+    //---------------------------------------------------------------------
     Rect Terrain::calculateHeightDeltas(const Rect& rect)
     {
         Rect clampedRect(rect);
@@ -2104,13 +2118,14 @@ namespace Ogre
 
         mQuadTree->preDeltaCalculation(clampedRect);
 
+        WorkQueue* queue = Root::getSingleton().getWorkQueue();
+        vector<Real>::type levelDeltas;
+
         /// Iterate over target levels, 
         for (int targetLevel = 1; targetLevel < mNumLodLevels; ++targetLevel)
         {
             int sourceLevel = targetLevel - 1;
             int step = 1 << targetLevel;
-            // The step of the next higher LOD
-//          int higherstep = step >> 1;
 
             // need to widen the dirty rectangle since change will affect surrounding
             // vertices at lower LOD
@@ -2134,120 +2149,124 @@ namespace Ogre
             if (lodRect.bottom % step)
                 lodRect.bottom += step - (lodRect.bottom % step);
 
-            for (long j = lodRect.top; j < lodRect.bottom - step; j += step )
+            long rowCount = lodRect.height() / step - 1;
+            if (rowCount <= 0)
+                continue;
+
+            // Rows of quads write disjoint rows of vertices, so they can be
+            // calculated in parallel. The quadtree is told about the deltas
+            // afterwards since its nodes span many rows.
+            levelDeltas.assign(lodRect.width() * lodRect.height(), 0);
+            HeightDeltasTask task = {this, &lodRect, targetLevel, &levelDeltas[0]};
+            queue->parallelFor(0, rowCount, 0, task);
+
+            // max(delta) is the worst case scenario at this LOD
+            // compared to the original heightmap
+            mQuadTree->notifyDeltas(lodRect, sourceLevel, &levelDeltas[0]);
+
+        } // targetLevel
+
+        mQuadTree->postDeltaCalculation(clampedRect);
+
+        return finalRect;
+
+    }
+    //---------------------------------------------------------------------
+    void Terrain::calculateHeightDeltasRows(const Rect& lodRect, int targetLevel,
+        long beginRow, long endRow, Real* levelDeltas)
+    {
+        int step = 1 << targetLevel;
+        int halfStep = step / 2;
+        for (long j = lodRect.top + beginRow * step; j < lodRect.top + endRow * step; j += step)
+        {
+            for (long i = lodRect.left; i < lodRect.right - step; i += step )
             {
-                for (long i = lodRect.left; i < lodRect.right - step; i += step )
+                // Form planes relating to the lower detail tris to be produced
+                // For even tri strip rows, they are this shape:
+                // 2---3
+                // | / |
+                // 0---1
+                // For odd tri strip rows, they are this shape:
+                // 2---3
+                // | \ |
+                // 0---1
+
+                Vector3 v0, v1, v2, v3;
+                getPointAlign(i, j, ALIGN_X_Y, &v0);
+                getPointAlign(i + step, j, ALIGN_X_Y, &v1);
+                getPointAlign(i, j + step, ALIGN_X_Y, &v2);
+                getPointAlign(i + step, j + step, ALIGN_X_Y, &v3);
+
+                Plane t1, t2;
+                bool backwardTri = false;
+                // Odd or even in terms of target level
+                if ((j / step) % 2 == 0)
                 {
-                    // Form planes relating to the lower detail tris to be produced
-                    // For even tri strip rows, they are this shape:
-                    // 2---3
-                    // | / |
-                    // 0---1
-                    // For odd tri strip rows, they are this shape:
-                    // 2---3
-                    // | \ |
-                    // 0---1
-
-                    Vector3 v0, v1, v2, v3;
-                    getPointAlign(i, j, ALIGN_X_Y, &v0);
-                    getPointAlign(i + step, j, ALIGN_X_Y, &v1);
-                    getPointAlign(i, j + step, ALIGN_X_Y, &v2);
-                    getPointAlign(i + step, j + step, ALIGN_X_Y, &v3);
-
-                    Plane t1, t2;
-                    bool backwardTri = false;
-                    // Odd or even in terms of target level
-                    if ((j / step) % 2 == 0)
-                    {
-                        t1.redefine(v0, v1, v3);
-                        t2.redefine(v0, v3, v2);
-                    }
-                    else
-                    {
-                        t1.redefine(v1, v3, v2);
-                        t2.redefine(v0, v1, v2);
-                        backwardTri = true;
-                    }
+                    t1.redefine(v0, v1, v3);
+                    t2.redefine(v0, v3, v2);
+                }
+                else
+                {
+                    t1.redefine(v1, v3, v2);
+                    t2.redefine(v0, v1, v2);
+                    backwardTri = true;
+                }
 
-                    // include the bottommost row of vertices if this is the last row
-                    int yubound = (j == (mSize - step)? step : step - 1);
-                    for ( int y = 0; y <= yubound; y++ )
+                // include the bottommost row of vertices if this is the last row
+                int yubound = (j == (mSize - step)? step : step - 1);
+                for ( int y = 0; y <= yubound; y++ )
+                {
+                    long fulldetaily = j + y;
+                    const float* pHeight = mHeightData + fulldetaily * mSize;
+                    Real* pDelta = levelDeltas + (fulldetaily - lodRect.top) * lodRect.width();
+                    // the ALIGN_X_Y position of the vertices in this row
+                    Real actualY = fulldetaily * mScale + mBase;
+                    Real ypct = (Real)y / (Real)step;
+
+                    // include the rightmost col of vertices if this is the last col
+                    int xubound = (i == (mSize - step)? step : step - 1);
+                    for ( int x = 0; x <= xubound; x++ )
                     {
-                        // include the rightmost col of vertices if this is the last col
-                        int xubound = (i == (mSize - step)? step : step - 1);
-                        for ( int x = 0; x <= xubound; x++ )
+                        long fulldetailx = i + x;
+                        if ( fulldetailx % step == 0 && 
+                            fulldetaily % step == 0 )
                         {
-                            int fulldetailx = static_cast<int>(i + x);
-                            int fulldetaily = static_cast<int>(j + y);
-                            if ( fulldetailx % step == 0 && 
-                                fulldetaily % step == 0 )
-                            {
-                                // Skip, this one is a vertex at this level
-                                continue;
-                            }
-
-                            Real ypct = (Real)y / (Real)step;
-                            Real xpct = (Real)x / (Real)step;
-
-                            //interpolated height
-                            Vector3 actualPos;
-                            getPointAlign(fulldetailx, fulldetaily, ALIGN_X_Y, &actualPos);
-                            Real interp_h;
-                            // Determine which tri we're on 
-                            if ((xpct > ypct && !backwardTri) ||
-                                (xpct > (1-ypct) && backwardTri))
-                            {
-                                // Solve for x/z
-                                interp_h = 
-                                    (-t1.normal.x * actualPos.x
-                                    - t1.normal.y * actualPos.y
-                                    - t1.d) / t1.normal.z;
-                            }
-                            else
-                            {
-                                // Second tri
-                                interp_h = 
-                                    (-t2.normal.x * actualPos.x
-                                    - t2.normal.y * actualPos.y
-                                    - t2.d) / t2.normal.z;
-                            }
-
-                            Real actual_h = actualPos.z;
-                            Real delta = interp_h - actual_h;
-
-                            // max(delta) is the worst case scenario at this LOD
-                            // compared to the original heightmap
-
-                            // tell the quadtree about this 
-                            mQuadTree->notifyDelta(fulldetailx, fulldetaily, sourceLevel, delta);
-
-
-                            // If this vertex is being removed at this LOD, 
-                            // then save the height difference since that's the move
-                            // it will need to make. Vertices to be removed at this LOD
-                            // are halfway between the steps, but exclude those that
-                            // would have been eliminated at earlier levels
-                            int halfStep = step / 2;
-                            if (
-                             ((fulldetailx % step) == halfStep && (fulldetaily % halfStep) == 0) ||
-                             ((fulldetaily % step) == halfStep && (fulldetailx % halfStep) == 0))
-                            {
-                                // Save height difference 
-                                mDeltaData[fulldetailx + (fulldetaily * mSize)] = delta;
-                            }
+                            // Skip, this one is a vertex at this level
+                            continue;
+                        }
 
+                        Real xpct = (Real)x / (Real)step;
+                        Real actualX = fulldetailx * mScale + mBase;
+
+                        // Determine which tri we're on, and solve for z
+                        const Plane& t = ((xpct > ypct && !backwardTri) ||
+                            (xpct > (1-ypct) && backwardTri)) ? t1 : t2;
+                        Real interp_h = 
+                            (-t.normal.x * actualX
+                            - t.normal.y * actualY
+                            - t.d) / t.normal.z;
+
+                        Real delta = interp_h - pHeight[fulldetailx];
+                        pDelta[fulldetailx - lodRect.left] = delta;
+
+                        // If this vertex is being removed at this LOD, 
+                        // then save the height difference since that's the move
+                        // it will need to make. Vertices to be removed at this LOD
+                        // are halfway between the steps, but exclude those that
+                        // would have been eliminated at earlier levels
+                        if (
+                         ((fulldetailx % step) == halfStep && (fulldetaily % halfStep) == 0) ||
+                         ((fulldetaily % step) == halfStep && (fulldetailx % halfStep) == 0))
+                        {
+                            // Save height difference 
+                            mDeltaData[fulldetailx + (fulldetaily * mSize)] = delta;
                         }
 
                     }
-                } // i
-            } // j
-
-        } // targetLevel
-
-        mQuadTree->postDeltaCalculation(clampedRect);
-
-        return finalRect;
 
+                }
+            } // i
+        } // j
     }
     //---------------------------------------------------------------------
     void Terrain::finaliseHeightDeltas(const Rect& rect, bool cpuData)
@@ -3336,6 +3355,46 @@ namespace Ogre
         return currentLod;
     }
     //---------------------------------------------------------------------
+    namespace
+    {
+        /// Encode a unit normal as RGB
+        inline void encodeNormal(Real x, Real y, Real z, uint8* pStore)
+        {
+            pStore[0] = static_cast<uint8>((x + 1.0f) * 0.5f * 255.0f);
+            pStore[1] = static_cast<uint8>((y + 1.0f) * 0.5f * 255.0f);
+            pStore[2] = static_cast<uint8>((z + 1.0f) * 0.5f * 255.0f);
+        }
+
+        /** Add the unit normal of the triangle between the centre point and two 
+            of its neighbours, given as grid offsets and heights relative to the
+            centre, in ALIGN_X_Y space.
+        */
+        inline void addTriangleNormal(Real dx1, Real dy1, Real z1, 
+            Real dx2, Real dy2, Real z2, Real scale, Real& nx, Real& ny, Real& nz)
+        {
+            // neighbours are anticlockwise so the z part is always scale squared
+            Real x = scale * (dy1 * z2 - dy2 * z1);
+            Real y = scale * (dx2 * z1 - dx1 * z2);
+            Real z = scale * scale;
+            Real invLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+            nx += x * invLength;
+            ny += y * invLength;
+            nz += z * invLength;
+        }
+    }
+    //---------------------------------------------------------------------
+    struct Terrain::NormalsTask
+    {
+        const Terrain* terrain;
+        const Rect* rect;
+        uint8* data;
+
+        void operator()(size_t begin, size_t end) const
+        {
+            terrain->calculateNormalsRows(*rect, rect->top + begin, rect->top + end, data);
+        }
+    };
+    //---------------------------------------------------------------------
     PixelBox* Terrain::calculateNormals(const Rect &rect, Rect& finalRect)
     {
         // Widen the rectangle by 1 element in all directions since height
@@ -3353,59 +3412,138 @@ namespace Ogre
         PixelBox* pixbox = OGRE_NEW PixelBox(static_cast<uint32>(widenedRect.width()),
                                              static_cast<uint32>(widenedRect.height()), 1, PF_BYTE_RGB, pData);
 
-        // Evaluate normal like this
-        //  3---2---1
-        //  | \ | / |
-        //  4---P---0
-        //  | / | \ |
-        //  5---6---7
+        // rows are independent
+        NormalsTask task = {this, &widenedRect, pData};
+        Root::getSingleton().getWorkQueue()->parallelFor(0, widenedRect.height(), 0, task);
 
-        Plane plane;
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
+        finalRect = widenedRect;
+
+        return pixbox;
+    }
+    //---------------------------------------------------------------------
+    void Terrain::calculateNormalsRows(const Rect& rect, long top, long bottom, uint8* pData) const
+    {
+        // Points whose neighbours all lie in this terrain are calculated
+        // straight from the height rows, in a loop without calls or branches
+        // which the compiler can vectorise. The rest take the slow path.
+        long innerLeft = std::max(rect.left, 1L);
+        long innerRight = std::max(innerLeft, std::min(rect.right, (long)mSize - 1L));
+        vector<Real>::type normals((innerRight - innerLeft) * 3);
+        Real* nx = normals.empty() ? 0 : &normals[0];
+        Real* ny = nx + (innerRight - innerLeft);
+        Real* nz = ny + (innerRight - innerLeft);
+
+        // The fast path works in ALIGN_X_Y space, which is rotated into place
+        // by picking the components
+        const Real* outX = nx;
+        const Real* outY = ny;
+        const Real* outZ = nz;
+        Real signZ = 1.0f;
+        switch (mAlign)
         {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
-            {
-                Vector3 cumulativeNormal = Vector3::ZERO;
-
-                // Build points to sample
-                Vector3 centrePoint;
-                Vector3 adjacentPoints[8];
-                getPointFromSelfOrNeighbour(x  , y,   &centrePoint);
-                getPointFromSelfOrNeighbour(x+1, y,   &adjacentPoints[0]);
-                getPointFromSelfOrNeighbour(x+1, y+1, &adjacentPoints[1]);
-                getPointFromSelfOrNeighbour(x,   y+1, &adjacentPoints[2]);
-                getPointFromSelfOrNeighbour(x-1, y+1, &adjacentPoints[3]);
-                getPointFromSelfOrNeighbour(x-1, y,   &adjacentPoints[4]);
-                getPointFromSelfOrNeighbour(x-1, y-1, &adjacentPoints[5]);
-                getPointFromSelfOrNeighbour(x,   y-1, &adjacentPoints[6]);
-                getPointFromSelfOrNeighbour(x+1, y-1, &adjacentPoints[7]);
-
-                for (int i = 0; i < 8; ++i)
-                {
-                    plane.redefine(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
-                    cumulativeNormal += plane.normal;
-                }
+        case ALIGN_X_Z:
+            outY = nz;
+            outZ = ny;
+            signZ = -1.0f;
+            break;
+        case ALIGN_Y_Z:
+            outX = nz;
+            outZ = nx;
+            signZ = -1.0f;
+            break;
+        case ALIGN_X_Y:
+            break;
+        }
 
-                // normalise & store normal
-                cumulativeNormal.normalise();
+        for (long y = top; y < bottom; ++y)
+        {
+            // invert the Y to deal with image space
+            uint8* pRow = pData + (rect.bottom - y - 1) * rect.width() * 3;
+            bool innerRow = y > 0 && y < mSize - 1;
+            long fastLeft = innerRow ? innerLeft : rect.right;
+            long fastRight = innerRow ? innerRight : rect.right;
 
-                // encode as RGB, object space
-                // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
+            for (long x = rect.left; x < fastLeft; ++x)
+            {
+                Vector3 n = calculateNormalAt(x, y);
+                encodeNormal(n.x, n.y, n.z, pRow + (x - rect.left) * 3);
+            }
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX) * 3;
-                *pStore++ = static_cast<uint8>((cumulativeNormal.x + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.y + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.z + 1.0f) * 0.5f * 255.0f);
+            if (fastLeft < fastRight)
+            {
+                const float* hS = mHeightData + (y - 1) * mSize;
+                const float* hC = hS + mSize;
+                const float* hN = hC + mSize;
+                long count = fastRight - fastLeft;
+                for (long i = 0; i < count; ++i)
+                {
+                    long x = fastLeft + i;
+                    Real c = hC[x];
+                    // Neighbour heights in the same order as calculateNormalAt
+                    Real z0 = hC[x+1] - c, z1 = hN[x+1] - c, z2 = hN[x] - c, z3 = hN[x-1] - c;
+                    Real z4 = hC[x-1] - c, z5 = hS[x-1] - c, z6 = hS[x] - c, z7 = hS[x+1] - c;
+                    Real sx = 0, sy = 0, sz = 0;
+                    addTriangleNormal( 1,  0, z0,  1,  1, z1, mScale, sx, sy, sz);
+                    addTriangleNormal( 1,  1, z1,  0,  1, z2, mScale, sx, sy, sz);
+                    addTriangleNormal( 0,  1, z2, -1,  1, z3, mScale, sx, sy, sz);
+                    addTriangleNormal(-1,  1, z3, -1,  0, z4, mScale, sx, sy, sz);
+                    addTriangleNormal(-1,  0, z4, -1, -1, z5, mScale, sx, sy, sz);
+                    addTriangleNormal(-1, -1, z5,  0, -1, z6, mScale, sx, sy, sz);
+                    addTriangleNormal( 0, -1, z6,  1, -1, z7, mScale, sx, sy, sz);
+                    addTriangleNormal( 1, -1, z7,  1,  0, z0, mScale, sx, sy, sz);
+                    Real invLength = 1.0f / std::sqrt(sx * sx + sy * sy + sz * sz);
+                    nx[i] = sx * invLength;
+                    ny[i] = sy * invLength;
+                    nz[i] = sz * invLength;
+                }
 
+                uint8* pStore = pRow + (fastLeft - rect.left) * 3;
+                for (long i = 0; i < count; ++i, pStore += 3)
+                    encodeNormal(outX[i], outY[i], outZ[i] * signZ, pStore);
+            }
 
+            for (long x = fastRight; x < rect.right; ++x)
+            {
+                Vector3 n = calculateNormalAt(x, y);
+                encodeNormal(n.x, n.y, n.z, pRow + (x - rect.left) * 3);
             }
         }
+    }
+    //---------------------------------------------------------------------
+    Vector3 Terrain::calculateNormalAt(long x, long y) const
+    {
+        // Evaluate normal like this
+        //  3---2---1
+        //  | \ | / |
+        //  4---P---0
+        //  | / | \ |
+        //  5---6---7
 
-        finalRect = widenedRect;
+        Vector3 cumulativeNormal = Vector3::ZERO;
+
+        // Build points to sample
+        Vector3 centrePoint;
+        Vector3 adjacentPoints[8];
+        getPointFromSelfOrNeighbour(x  , y,   &centrePoint);
+        getPointFromSelfOrNeighbour(x+1, y,   &adjacentPoints[0]);
+        getPointFromSelfOrNeighbour(x+1, y+1, &adjacentPoints[1]);
+        getPointFromSelfOrNeighbour(x,   y+1, &adjacentPoints[2]);
+        getPointFromSelfOrNeighbour(x-1, y+1, &adjacentPoints[3]);
+        getPointFromSelfOrNeighbour(x-1, y,   &adjacentPoints[4]);
+        getPointFromSelfOrNeighbour(x-1, y-1, &adjacentPoints[5]);
+        getPointFromSelfOrNeighbour(x,   y-1, &adjacentPoints[6]);
+        getPointFromSelfOrNeighbour(x+1, y-1, &adjacentPoints[7]);
 
-        return pixbox;
+        Plane plane;
+        for (int i = 0; i < 8; ++i)
+        {
+            plane.redefine(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
+            cumulativeNormal += plane.normal;
+        }
+
+        // normalise
+        cumulativeNormal.normalise();
+        return cumulativeNormal;
     }
     //---------------------------------------------------------------------
     void Terrain::finaliseNormals(const Ogre::Rect &rect, Ogre::PixelBox *normalsBox)
@@ -3499,6 +3637,18 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
+    struct Terrain::LightmapTask
+    {
+        Terrain* terrain;
+        const Rect* rect;
+        uint8* data;
+
+        void operator()(size_t begin, size_t end) const
+        {
+            terrain->calculateLightmapRows(*rect, rect->top + begin, rect->top + end, data);
+        }
+    };
+    //---------------------------------------------------------------------
     PixelBox* Terrain::calculateLightmap(const Rect& rect, const Rect& extraTargetRect, Rect& outFinalRect)
     {
         // as well as calculating the lighting changes for the area that is
@@ -3537,11 +3687,23 @@ namespace Ogre
         PixelBox* pixbox = OGRE_NEW PixelBox(static_cast<uint32>(widenedRect.width()),
                                              static_cast<uint32>(widenedRect.height()), 1, PF_L8, pData);
 
+        // rows are independent, ray casts only read the heights
+        LightmapTask task = {this, &widenedRect, pData};
+        Root::getSingleton().getWorkQueue()->parallelFor(0, widenedRect.height(), 0, task);
+
+        return pixbox;
+
+
+    }
+    //---------------------------------------------------------------------
+    void Terrain::calculateLightmapRows(const Rect& rect, long top, long bottom, uint8* pData)
+    {
+        const Vector3& lightVec = TerrainGlobalOptions::getSingleton().getLightMapDirection();
         Real heightPad = (getMaxHeight() - getMinHeight()) * 1.0e-3f;
 
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
+        for (long y = top; y < bottom; ++y)
         {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
+            for (long x = rect.left; x < rect.right; ++x)
             {
                 float litVal = 1.0f;
 
@@ -3566,18 +3728,14 @@ namespace Ogre
 
                 // encode as L8
                 // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
+                long storeX = x - rect.left;
+                long storeY = rect.bottom - y - 1;
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX);
+                uint8* pStore = pData + ((storeY * rect.width()) + storeX);
                 *pStore = (unsigned char)(litVal * 255.0);
 
             }
         }
-
-        return pixbox;
-
-
     }
     //---------------------------------------------------------------------
     void Terrain::finaliseLightmap(const Rect& rect, PixelBox* lightmapBox)
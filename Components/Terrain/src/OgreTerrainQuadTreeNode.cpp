@@ -385,6 +385,36 @@ namespace Ogre
         }
     }
     //---------------------------------------------------------------------
+    void TerrainQuadTreeNode::notifyDeltas(const Rect& rect, uint16 lod, const Real* deltas)
+    {
+        long left = std::max(rect.left, (long)mOffsetX);
+        long top = std::max(rect.top, (long)mOffsetY);
+        long right = std::min(rect.right, (long)mBoundaryX);
+        long bottom = std::min(rect.bottom, (long)mBoundaryY);
+        if (left >= right || top >= bottom)
+            return;
+
+        if (lod >= mBaseLod && lod < mBaseLod + mLodLevels.size())
+        {
+            LodLevel* ll = mLodLevels[lod - mBaseLod];
+            Real maxDelta = ll->calcMaxHeightDelta;
+            for (long y = top; y < bottom; ++y)
+            {
+                const Real* pRow = deltas + (y - rect.top) * rect.width();
+                for (long x = left; x < right; ++x)
+                    maxDelta = std::max(maxDelta, pRow[x - rect.left]);
+            }
+            ll->calcMaxHeightDelta = maxDelta;
+        }
+
+        // children only hold higher detail LODs than ours
+        if (!isLeaf() && lod < mBaseLod)
+        {
+            for (int i = 0; i < 4; ++i)
+                mChildren[i]->notifyDeltas(rect, lod, deltas);
+        }
+    }
+    //---------------------------------------------------------------------
     void TerrainQuadTreeNode::postDeltaCalculation(const Rect& rect)
     {
         if (rect.left <= mBoundaryX || rect.right > mOffsetX
@@ -71,6 +71,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
     };
 
     /** A plane.
@@ -102,6 +111,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
     };
 
     /** A not rotated cube.
@@ -166,6 +184,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
     };
 
     /** Abstract operation volume source holding two sources as operants.
@@ -244,6 +271,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
     };
 
     /** Builds the union between two sources.
@@ -271,6 +307,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
     };
 
     /** Builds the difference between two sources.
@@ -299,6 +344,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
     };
 
     /** Source which does a unary operation to another one.
@@ -359,6 +413,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
     };
 
     /** Scales the given volume source.
@@ -386,6 +449,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
     };
 
     class _OgreVolumeExport CSGNoiseSource: public CSGUnarySource
@@ -429,6 +501,20 @@ namespace Volume {
             return mSrc->getValue(position) + toAdd;
         }
 
+        /* Gets the density values of at most BATCH_SIZE positions.
+        @param x
+            The x components of the positions.
+        @param y
+            The y components of the positions.
+        @param z
+            The z components of the positions.
+        @param values
+            Receives the values.
+        @param count
+            The amount of positions.
+        */
+        void getInternalValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
     public:
         
         /** Constructor.
@@ -464,6 +550,15 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
         
         /** Gets the initial seed.
         @return
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __Ogre_Volume_CacheSource_H__
 
 #include "OgreVector4.h"
+#include "Threading/OgreThreadHeaders.h"
 
 #include "OgreVolumeSource.h"
 #include "OgreVolumePrerequisites.h"
@@ -52,47 +53,116 @@ namespace Volume {
     bool _OgreVolumeExport operator<(const Vector3& a, const Vector3& b);
 
     /** A caching Source.
+    @remarks
+        The density values and gradients of the wrapped source are kept in dense bricks
+        of BRICK_SIZE^3 samples, found through a hash of the brick coordinates. Only the
+        positions on a lattice of the given voxel width, starting at the origin, are cached,
+        others are passed to the wrapped source. A position is stored in the coarsest lattice
+        of width voxelWidth * 2^n it lies on, so the corners of big and small octree nodes
+        both fill their bricks densely. When the maximum amount of bricks is reached, the
+        least recently used one is evicted. The cache can be used from several threads at once.
     */
     class _OgreVolumeExport CacheSource : public Source
     {
+    public:
+        /// The amount of samples along each side of a brick.
+        static const size_t BRICK_SIZE = 8;
+
     protected:
-        
-        /// Map for the cache
-        typedef map<Vector3, Vector4>::type UMapPositionValue;
-        mutable UMapPositionValue mCache;
+
+        /// Bits of the sample index within a brick, per axis.
+        static const int BRICK_SHIFT = 3;
+
+        /// The amount of coarser lattices a position can be stored in.
+        static const int LATTICE_LEVELS = 16;
+
+        /// The amount of independently locked parts of the cache.
+        static const size_t SHARD_COUNT = 16;
+
+        /// Dense block of cached samples.
+        struct Brick
+        {
+            /// The density values (w-component) and gradients (x, y and z component).
+            Vector4 values[BRICK_SIZE * BRICK_SIZE * BRICK_SIZE];
+            /// Which of the values are set.
+            uint64 valid[BRICK_SIZE * BRICK_SIZE * BRICK_SIZE / 64];
+            /// The packed lattice level and brick coordinates.
+            uint64 key;
+        };
+        typedef list<Brick*>::type BrickList;
+        typedef OGRE_HashMap<uint64, BrickList::iterator> BrickMap;
+
+        /// Part of the cache with its own lock, the bricks are distributed by their key.
+        struct Shard
+        {
+            OGRE_WQ_MUTEX(mutex);
+            /// The bricks, most recently used first.
+            BrickList bricks;
+            BrickMap lookup;
+            size_t hits;
+            size_t misses;
+        };
+        mutable Shard mShards[SHARD_COUNT];
 
         /// The source to cache.
         const Source *mSrc;
-        
+
+        /// The distance between two cached positions in the finest lattice.
+        Real mVoxelWidth;
+
+        /// The inverse of mVoxelWidth.
+        Real mInvVoxelWidth;
+
+        /// The maximum amount of bricks in each shard.
+        size_t mMaxShardBricks;
+
+        /** Finds the brick and the slot in it of a position.
+        @param position
+            The position.
+        @param key
+            Will hold the key of the brick.
+        @param slot
+            Will hold the index of the position in the brick.
+        @return
+            Whether the position is on the lattice and can be cached.
+        */
+        bool getBrickSlot(const Vector3 &position, uint64 &key, size_t &slot) const;
+
         /** Gets a density value and gradient from the cache.
         @param position
             The position of the density value and gradient.
         @return
             The density value (w-component) and the gradient (x, y and z component).
         */
-        inline Vector4 getFromCache(const Vector3 &position) const
-        {
-            Vector4 result;
-            map<Vector3, Vector4>::iterator it = mCache.find(position);
-            if (it == mCache.end())
-            {
-                result = mSrc->getValueAndGradient(position);
-                mCache[position] = result;
-            }
-            else
-            {
-                result = it->second;
-            }
-            return result;
-        }
+        Vector4 getFromCache(const Vector3 &position) const;
+
+        /** Gets the brick of a key, creating or recycling one if it is not cached.
+            The lock of the shard must be held.
+        @param shard
+            The shard of the brick.
+        @param key
+            The key of the brick.
+        @return
+            The brick.
+        */
+        Brick* getOrCreateBrick(Shard &shard, uint64 key) const;
 
     public:
         
         /** Constructor.
         @param src
             The source to cache.
+        @param voxelWidth
+            The distance between two cached positions. Octree nodes smaller than twice
+            this, or not aligned to it, are passed to the source uncached.
+        @param maxBricks
+            The maximum amount of bricks to keep, each takes a bit over 8 KB with single precision.
         */
-        CacheSource(const Source *src);
+        CacheSource(const Source *src, Real voxelWidth = (Real)1.0 / (Real)64.0, size_t maxBricks = 4096);
+
+        /** Destructor.
+        */
+        virtual ~CacheSource(void);
         
         /** Overridden from Source.
         */
@@ -102,6 +172,29 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const;
 
+        /** Overridden from Source. Looks up each brick once for a run of positions
+        sharing it and evaluates all missing values in one call to the wrapped source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
+
+        /** Gets how often a value was found in the cache.
+        */
+        size_t getHitCount(void) const;
+
+        /** Gets how often a value was requested from the source, including
+        the positions which are not cached.
+        */
+        size_t getMissCount(void) const;
+
+        /** Gets the amount of bricks currently held.
+        */
+        size_t getBrickCount(void) const;
+
+        /** Removes all cached values and resets the counters.
+        */
+        void clear(void);
+
     };
     /** @} */
     /** @} */
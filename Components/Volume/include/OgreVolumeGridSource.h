@@ -142,6 +142,14 @@ namespace Volume {
                 getVolumeGridValue(x, y, z + 1) - getVolumeGridValue(x, y, z - 1));
         }
 
+        /** Gets the gradient at a position in grid coordinates, filtered like the settings say.
+        @param scaledPosition
+            The position, scaled to the grid.
+        @return
+            The negated gradient, as returned by getValueAndGradient.
+        */
+        Vector3 getScaledGradient(const Vector3 &scaledPosition) const;
+
     public:
 
         GridSource(bool trilinearValue, bool trilinearGradient, bool sobelGradient);
@@ -158,6 +166,15 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const;
 
+        /** Overridden from VolumeSource.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from VolumeSource.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
+
         /** Gets the width of the texture.
         @return
             The width of the texture.
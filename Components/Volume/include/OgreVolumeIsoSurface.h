@@ -60,6 +60,17 @@ namespace Volume {
         */
         explicit IsoSurface(const Source *src);
 
+        /** Gets the values and gradients of up to eight positions, like the corners of a cube,
+        with one batch call to the source.
+        @param positions
+            The positions.
+        @param count
+            The amount of positions, at most 8.
+        @param values
+            Receives the gradients in x, y, z and the densities in w.
+        */
+        void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
     public:
 
         /// To call Marching Squares with a cube on its front.
@@ -80,6 +80,19 @@ namespace Volume {
             The manual object to add the lines to if this is a leaf in the octree.
         */
         void buildOctreeGridLines(ManualObject *manual) const;
+
+        /** Splits this cell and its children recursively if the split policy says so.
+        The children left without a center value get theirs with one batch call to the source.
+        @param splitPolicy
+            Defines the policy deciding whether to split this node or not.
+        @param src
+            The volume source.
+        @param geometricError
+            The accepted geometric error.
+        @return
+            true if this cell was split.
+        */
+        bool splitChildren(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError);
     public:
 
         /// Even in an OCtree, the amount of children should not be hardcoded.
@@ -524,6 +537,15 @@ namespace Volume {
             return mCenterValue;
         }
 
+        /** Gets whether the center value was set already.
+        @return
+            true if the center value is not zero.
+        */
+        inline bool hasCenterValue(void) const
+        {
+            return mCenterValue.x != (Real)0.0 || mCenterValue.y != (Real)0.0 || mCenterValue.z != (Real)0.0 || mCenterValue.w != (Real)0.0;
+        }
+
         /** Gets whether the isosurface is somewhat near to this node.
         @return
             true if somewhat near.
@@ -113,6 +113,20 @@ namespace Volume {
             The noise value.
         */
         Real noise(Real xIn, Real yIn, Real zIn) const;
+
+        /** 3D noise function for many positions at once.
+        @param xIn
+            The first dimension parameters.
+        @param yIn
+            The second dimension parameters.
+        @param zIn
+            The third dimension parameters.
+        @param results
+            Receives the noise values.
+        @param count
+            The amount of positions.
+        */
+        void noise(const Real *xIn, const Real *yIn, const Real *zIn, Real *results, size_t count) const;
         
         /** Gets the current seed.
         @return
@@ -80,6 +80,9 @@ namespace Volume {
 
         /// The amount of items being written as one chunk during serialization.
         static const size_t SERIALIZATION_CHUNK_SIZE;
+
+        /// The amount of positions the composed sources evaluate at once in their batch functions.
+        static const size_t BATCH_SIZE = 64;
         
         /** Destructor.
         */
@@ -101,6 +104,44 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const = 0;
 
+        /** Gets the density values of many positions at once. The positions are given as
+        separate arrays per component, so implementations can evaluate several of them
+        in one go. The default implementation calls getValue for each position.
+        @param x
+            The x components of the positions.
+        @param y
+            The y components of the positions.
+        @param z
+            The z components of the positions.
+        @param values
+            Receives the densities, must not overlap with the positions.
+        @param count
+            The amount of positions.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Gets the density values and gradients of many positions at once, like getValues.
+        The default implementation calls getValueAndGradient for each position.
+        @param x
+            The x components of the positions.
+        @param y
+            The y components of the positions.
+        @param z
+            The z components of the positions.
+        @param gradientX
+            Receives the x components of the gradients.
+        @param gradientY
+            Receives the y components of the gradients.
+        @param gradientZ
+            Receives the z components of the gradients.
+        @param values
+            Receives the densities.
+        @param count
+            The amount of positions.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const;
+
         /** Serializes a volume source to a discrete grid file with deflated
         compression. To achieve better compression, all density values are clamped
         within a maximum absolute value of (to - from).length() / 16.0. The values
@@ -25,11 +25,80 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreVolumeCSGSource.h"
+#include "OgrePlatformInformation.h"
 #include <algorithm>
 
+#if __OGRE_HAVE_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace Ogre {
 namespace Volume {
 
+    namespace {
+        /// Gets the amount of positions of the batch block starting at i.
+        inline size_t getBlockSize(size_t i, size_t count)
+        {
+            return count - i < Source::BATCH_SIZE ? count - i : Source::BATCH_SIZE;
+        }
+
+        /// Combines the values of two operants, keeping the smaller or the bigger one.
+        void combineValues(const Source *a, const Source *b, const Real signB, const bool keepSmaller,
+            const Real *x, const Real *y, const Real *z, Real *values, size_t count)
+        {
+            Real valuesB[Source::BATCH_SIZE];
+            a->getValues(x, y, z, values, count);
+            for (size_t i = 0; i < count; i += Source::BATCH_SIZE)
+            {
+                const size_t n = getBlockSize(i, count);
+                b->getValues(x + i, y + i, z + i, valuesB, n);
+                for (size_t j = 0; j < n; ++j)
+                {
+                    const Real valueB = signB * valuesB[j];
+                    if (keepSmaller ? !(values[i + j] < valueB) : !(values[i + j] > valueB))
+                    {
+                        values[i + j] = valueB;
+                    }
+                }
+            }
+        }
+
+        /// Combines the values and gradients of two operants, keeping the ones with the smaller or the bigger value.
+        void combineValuesAndGradients(const Source *a, const Source *b, const Real signB, const bool keepSmaller,
+            const Real *x, const Real *y, const Real *z,
+            Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count)
+        {
+            Real gradientXB[Source::BATCH_SIZE];
+            Real gradientYB[Source::BATCH_SIZE];
+            Real gradientZB[Source::BATCH_SIZE];
+            Real valuesB[Source::BATCH_SIZE];
+            a->getValuesAndGradients(x, y, z, gradientX, gradientY, gradientZ, values, count);
+            for (size_t i = 0; i < count; i += Source::BATCH_SIZE)
+            {
+                const size_t n = getBlockSize(i, count);
+                b->getValuesAndGradients(x + i, y + i, z + i, gradientXB, gradientYB, gradientZB, valuesB, n);
+                for (size_t j = 0; j < n; ++j)
+                {
+                    const Real valueB = signB * valuesB[j];
+                    if (keepSmaller ? !(values[i + j] < valueB) : !(values[i + j] > valueB))
+                    {
+                        gradientX[i + j] = signB * gradientXB[j];
+                        gradientY[i + j] = signB * gradientYB[j];
+                        gradientZ[i + j] = signB * gradientZB[j];
+                        values[i + j] = valueB;
+                    }
+                }
+            }
+        }
+    }
+
+#if __OGRE_HAVE_SSE
+    /// Select a where mask is set, b otherwise
+    #define __SELECT_PS(mask, a, b) _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b))
+#endif
+
+    //-----------------------------------------------------------------------
+
     Vector3 CSGCubeSource::mBoxNormals[6] = {
         Vector3::UNIT_X,
         Vector3::UNIT_Y,
@@ -49,13 +118,13 @@ namespace Volume {
 
     Vector4 CSGSphereSource::getValueAndGradient(const Vector3 &position) const
     {
-        Vector3 pMinCenter = position- mCenter;
-        Vector3 gradient = pMinCenter;
+        Vector3 gradient = position - mCenter;
+        Real length = gradient.normalise();
         return Vector4(
             gradient.x,
             gradient.y,
             gradient.z,
-            mR - gradient.normalise()
+            mR - length
             );
     }
     
@@ -66,6 +135,76 @@ namespace Volume {
         Vector3 pMinCenter = position - mCenter;
         return mR - pMinCenter.length();
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGSphereSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_SSE))
+        {
+            const __m128 r = _mm_set_ps1(mR);
+            const __m128 centerX = _mm_set_ps1(mCenter.x);
+            const __m128 centerY = _mm_set_ps1(mCenter.y);
+            const __m128 centerZ = _mm_set_ps1(mCenter.z);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 dX = _mm_sub_ps(_mm_loadu_ps(x + i), centerX);
+                __m128 dY = _mm_sub_ps(_mm_loadu_ps(y + i), centerY);
+                __m128 dZ = _mm_sub_ps(_mm_loadu_ps(z + i), centerZ);
+                __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dX, dX), _mm_mul_ps(dY, dY)), _mm_mul_ps(dZ, dZ)));
+                _mm_storeu_ps(values + i, _mm_sub_ps(r, length));
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            values[i] = CSGSphereSource::getValue(Vector3(x[i], y[i], z[i]));
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGSphereSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_SSE))
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set_ps1(1.0f);
+            const __m128 r = _mm_set_ps1(mR);
+            const __m128 centerX = _mm_set_ps1(mCenter.x);
+            const __m128 centerY = _mm_set_ps1(mCenter.y);
+            const __m128 centerZ = _mm_set_ps1(mCenter.z);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 dX = _mm_sub_ps(_mm_loadu_ps(x + i), centerX);
+                __m128 dY = _mm_sub_ps(_mm_loadu_ps(y + i), centerY);
+                __m128 dZ = _mm_sub_ps(_mm_loadu_ps(z + i), centerZ);
+                __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dX, dX), _mm_mul_ps(dY, dY)), _mm_mul_ps(dZ, dZ)));
+
+                // Normalise where possible, like Vector3::normalise
+                __m128 nonZero = _mm_cmpgt_ps(length, zero);
+                __m128 inverseLength = _mm_div_ps(one, length);
+                _mm_storeu_ps(gradientX + i, __SELECT_PS(nonZero, _mm_mul_ps(dX, inverseLength), dX));
+                _mm_storeu_ps(gradientY + i, __SELECT_PS(nonZero, _mm_mul_ps(dY, inverseLength), dY));
+                _mm_storeu_ps(gradientZ + i, __SELECT_PS(nonZero, _mm_mul_ps(dZ, inverseLength), dZ));
+                _mm_storeu_ps(values + i, _mm_sub_ps(r, length));
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            Vector4 value = CSGSphereSource::getValueAndGradient(Vector3(x[i], y[i], z[i]));
+            gradientX[i] = value.x;
+            gradientY[i] = value.y;
+            gradientZ[i] = value.z;
+            values[i] = value.w;
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -93,6 +232,45 @@ namespace Volume {
         // Lineare Algebra: Ein geometrischer Zugang, S.180-181
         return mD - mNormal.dotProduct(position);
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGPlaneSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_SSE))
+        {
+            const __m128 d = _mm_set_ps1(mD);
+            const __m128 normalX = _mm_set_ps1(mNormal.x);
+            const __m128 normalY = _mm_set_ps1(mNormal.y);
+            const __m128 normalZ = _mm_set_ps1(mNormal.z);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 dot = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(normalX, _mm_loadu_ps(x + i)),
+                    _mm_mul_ps(normalY, _mm_loadu_ps(y + i))),
+                    _mm_mul_ps(normalZ, _mm_loadu_ps(z + i)));
+                _mm_storeu_ps(values + i, _mm_sub_ps(d, dot));
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            values[i] = CSGPlaneSource::getValue(Vector3(x[i], y[i], z[i]));
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGPlaneSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        std::fill(gradientX, gradientX + count, mNormal.x);
+        std::fill(gradientY, gradientY + count, mNormal.y);
+        std::fill(gradientZ, gradientZ + count, mNormal.z);
+        CSGPlaneSource::getValues(x, y, z, values, count);
+    }
     
     //-----------------------------------------------------------------------
 
@@ -124,6 +302,114 @@ namespace Volume {
     {
         return distanceTo(position);
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGCubeSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_SSE))
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 minX = _mm_set_ps1(mBox.getMinimum().x);
+            const __m128 minY = _mm_set_ps1(mBox.getMinimum().y);
+            const __m128 minZ = _mm_set_ps1(mBox.getMinimum().z);
+            const __m128 maxX = _mm_set_ps1(mBox.getMaximum().x);
+            const __m128 maxY = _mm_set_ps1(mBox.getMaximum().y);
+            const __m128 maxZ = _mm_set_ps1(mBox.getMaximum().z);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 pX = _mm_loadu_ps(x + i);
+                __m128 pY = _mm_loadu_ps(y + i);
+                __m128 pZ = _mm_loadu_ps(z + i);
+                __m128 dMinX = _mm_sub_ps(pX, minX);
+                __m128 dMinY = _mm_sub_ps(pY, minY);
+                __m128 dMinZ = _mm_sub_ps(pZ, minZ);
+                __m128 dMaxX = _mm_sub_ps(maxX, pX);
+                __m128 dMaxY = _mm_sub_ps(maxY, pY);
+                __m128 dMaxZ = _mm_sub_ps(maxZ, pZ);
+
+                // Inside: the distance to the nearest side
+                __m128 inside = _mm_and_ps(
+                    _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(dMinX, zero), _mm_cmpge_ps(dMinY, zero)), _mm_cmpge_ps(dMinZ, zero)),
+                    _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(dMaxX, zero), _mm_cmpge_ps(dMaxY, zero)), _mm_cmpge_ps(dMaxZ, zero)));
+                __m128 insideDistance = _mm_min_ps(
+                    _mm_min_ps(_mm_min_ps(dMinX, dMinY), dMinZ),
+                    _mm_min_ps(_mm_min_ps(dMaxX, dMaxY), dMaxZ));
+
+                // Outside: the negative distance to the box
+                __m128 outsideX = _mm_max_ps(_mm_max_ps(_mm_sub_ps(zero, dMinX), _mm_sub_ps(zero, dMaxX)), zero);
+                __m128 outsideY = _mm_max_ps(_mm_max_ps(_mm_sub_ps(zero, dMinY), _mm_sub_ps(zero, dMaxY)), zero);
+                __m128 outsideZ = _mm_max_ps(_mm_max_ps(_mm_sub_ps(zero, dMinZ), _mm_sub_ps(zero, dMaxZ)), zero);
+                __m128 outsideDistance = _mm_sub_ps(zero, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(outsideX, outsideX), _mm_mul_ps(outsideY, outsideY)), _mm_mul_ps(outsideZ, outsideZ))));
+
+                _mm_storeu_ps(values + i, __SELECT_PS(inside, insideDistance, outsideDistance));
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            values[i] = distanceTo(Vector3(x[i], y[i], z[i]));
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGCubeSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        // The same Prewitt as getValueAndGradient, each of the six samples evaluated as a batch.
+        Real offset[BATCH_SIZE];
+        Real plus[BATCH_SIZE];
+        Real minus[BATCH_SIZE];
+        CSGCubeSource::getValues(x, y, z, values, count);
+        for (size_t i = 0; i < count; i += BATCH_SIZE)
+        {
+            const size_t n = getBlockSize(i, count);
+            for (size_t j = 0; j < n; ++j)
+            {
+                offset[j] = x[i + j] + (Real)1.0;
+            }
+            CSGCubeSource::getValues(offset, y + i, z + i, plus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                offset[j] = x[i + j] - (Real)1.0;
+            }
+            CSGCubeSource::getValues(offset, y + i, z + i, minus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                gradientX[i + j] = plus[j] - minus[j];
+                offset[j] = y[i + j] + (Real)1.0;
+            }
+            CSGCubeSource::getValues(x + i, offset, z + i, plus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                offset[j] = y[i + j] - (Real)1.0;
+            }
+            CSGCubeSource::getValues(x + i, offset, z + i, minus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                gradientY[i + j] = plus[j] - minus[j];
+                offset[j] = z[i + j] + (Real)1.0;
+            }
+            CSGCubeSource::getValues(x + i, y + i, offset, plus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                offset[j] = z[i + j] - (Real)1.0;
+            }
+            CSGCubeSource::getValues(x + i, y + i, offset, minus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                Vector3 gradient(gradientX[i + j], gradientY[i + j], plus[j] - minus[j]);
+                gradient.normalise();
+                gradientX[i + j] = -gradient.x;
+                gradientY[i + j] = -gradient.y;
+                gradientZ[i + j] = -gradient.z;
+            }
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -202,6 +488,21 @@ namespace Volume {
         }
         return valueB;
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        combineValues(mA, mB, (Real)1.0, true, x, y, z, values, count);
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        combineValuesAndGradients(mA, mB, (Real)1.0, true, x, y, z, gradientX, gradientY, gradientZ, values, count);
+    }
     
     //-----------------------------------------------------------------------
 
@@ -240,6 +541,21 @@ namespace Volume {
         }
         return valueB;
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        combineValues(mA, mB, (Real)1.0, false, x, y, z, values, count);
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        combineValuesAndGradients(mA, mB, (Real)1.0, false, x, y, z, gradientX, gradientY, gradientZ, values, count);
+    }
     
     //-----------------------------------------------------------------------
 
@@ -278,6 +594,21 @@ namespace Volume {
         }
         return valueB;
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        combineValues(mA, mB, (Real)-1.0, true, x, y, z, values, count);
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        combineValuesAndGradients(mA, mB, (Real)-1.0, true, x, y, z, gradientX, gradientY, gradientZ, values, count);
+    }
     
     //-----------------------------------------------------------------------
 
@@ -330,6 +661,32 @@ namespace Volume {
     {
         return (Real)-1.0 * mSrc->getValue(position);
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        mSrc->getValues(x, y, z, values, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (Real)-1.0 * values[i];
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        mSrc->getValuesAndGradients(x, y, z, gradientX, gradientY, gradientZ, values, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            gradientX[i] = (Real)-1.0 * gradientX[i];
+            gradientY[i] = (Real)-1.0 * gradientY[i];
+            gradientZ[i] = (Real)-1.0 * gradientZ[i];
+            values[i] = (Real)-1.0 * values[i];
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -350,6 +707,61 @@ namespace Volume {
     {
         return mSrc->getValue(position / mScale) * mScale;
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        const Real inverseScale = 1.0f / mScale;
+        Real scaledX[BATCH_SIZE];
+        Real scaledY[BATCH_SIZE];
+        Real scaledZ[BATCH_SIZE];
+        for (size_t i = 0; i < count; i += BATCH_SIZE)
+        {
+            const size_t n = getBlockSize(i, count);
+            for (size_t j = 0; j < n; ++j)
+            {
+                scaledX[j] = x[i + j] * inverseScale;
+                scaledY[j] = y[i + j] * inverseScale;
+                scaledZ[j] = z[i + j] * inverseScale;
+            }
+            mSrc->getValues(scaledX, scaledY, scaledZ, values + i, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                values[i + j] *= mScale;
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        const Real inverseScale = 1.0f / mScale;
+        Real scaledX[BATCH_SIZE];
+        Real scaledY[BATCH_SIZE];
+        Real scaledZ[BATCH_SIZE];
+        for (size_t i = 0; i < count; i += BATCH_SIZE)
+        {
+            const size_t n = getBlockSize(i, count);
+            for (size_t j = 0; j < n; ++j)
+            {
+                scaledX[j] = x[i + j] * inverseScale;
+                scaledY[j] = y[i + j] * inverseScale;
+                scaledZ[j] = z[i + j] * inverseScale;
+            }
+            mSrc->getValuesAndGradients(scaledX, scaledY, scaledZ,
+                gradientX + i, gradientY + i, gradientZ + i, values + i, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                gradientX[i + j] *= mScale;
+                gradientY[i + j] *= mScale;
+                gradientZ[i + j] *= mScale;
+                values[i + j] *= mScale;
+            }
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -400,6 +812,98 @@ namespace Volume {
     {
         return getInternalValue(position);
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getInternalValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real toAdd[BATCH_SIZE];
+        Real noise[BATCH_SIZE];
+        Real scaledX[BATCH_SIZE];
+        Real scaledY[BATCH_SIZE];
+        Real scaledZ[BATCH_SIZE];
+        std::fill(toAdd, toAdd + count, (Real)0.0);
+        for (size_t i = 0; i < mNumOctaves; ++i)
+        {
+            for (size_t j = 0; j < count; ++j)
+            {
+                scaledX[j] = x[j] * mFrequencies[i];
+                scaledY[j] = y[j] * mFrequencies[i];
+                scaledZ[j] = z[j] * mFrequencies[i];
+            }
+            mNoise.noise(scaledX, scaledY, scaledZ, noise, count);
+            for (size_t j = 0; j < count; ++j)
+            {
+                toAdd[j] += noise[j] * mAmplitudes[i];
+            }
+        }
+        mSrc->getValues(x, y, z, values, count);
+        for (size_t j = 0; j < count; ++j)
+        {
+            values[j] += toAdd[j];
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        for (size_t i = 0; i < count; i += BATCH_SIZE)
+        {
+            getInternalValues(x + i, y + i, z + i, values + i, getBlockSize(i, count));
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        Real offset[BATCH_SIZE];
+        Real plus[BATCH_SIZE];
+        Real minus[BATCH_SIZE];
+        for (size_t i = 0; i < count; i += BATCH_SIZE)
+        {
+            const size_t n = getBlockSize(i, count);
+            getInternalValues(x + i, y + i, z + i, values + i, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                offset[j] = x[i + j] + mGradientOff;
+            }
+            getInternalValues(offset, y + i, z + i, plus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                offset[j] = x[i + j] - mGradientOff;
+            }
+            getInternalValues(offset, y + i, z + i, minus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                gradientX[i + j] = -(plus[j] - minus[j]);
+                offset[j] = y[i + j] + mGradientOff;
+            }
+            getInternalValues(x + i, offset, z + i, plus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                offset[j] = y[i + j] - mGradientOff;
+            }
+            getInternalValues(x + i, offset, z + i, minus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                gradientY[i + j] = -(plus[j] - minus[j]);
+                offset[j] = z[i + j] + mGradientOff;
+            }
+            getInternalValues(x + i, y + i, offset, plus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                offset[j] = z[i + j] - mGradientOff;
+            }
+            getInternalValues(x + i, y + i, offset, minus, n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                gradientZ[i + j] = -(plus[j] - minus[j]);
+            }
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -407,5 +911,9 @@ namespace Volume {
     {
         return mSeed;
     }
+
+#if __OGRE_HAVE_SSE
+    #undef __SELECT_PS
+#endif
 }
 }
\ No newline at end of file
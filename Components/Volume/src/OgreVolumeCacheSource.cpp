@@ -38,10 +38,162 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
 
-    CacheSource::CacheSource(const Source *src) : mSrc(src)
+    namespace
     {
+        /// Bits of each packed brick coordinate in a brick key.
+        const int KEY_COORDINATE_BITS = 20;
+
+        /// Points further from the origin than this, in voxels, are not cached.
+        const int64 MAX_LATTICE_INDEX = int64(1) << (KEY_COORDINATE_BITS - 1 + 3);
+
+        /// How far from the lattice a position may be and still be cached, in voxels.
+        const Real LATTICE_EPSILON = (Real)0.001;
+
+        /// Gets the lattice index of a coordinate, or false if it is not on the lattice.
+        inline bool getLatticeIndex(Real coordinate, Real invVoxelWidth, int64 &index)
+        {
+            Real scaled = coordinate * invVoxelWidth;
+            if (!(Math::Abs(scaled) < (Real)MAX_LATTICE_INDEX))
+            {
+                return false;
+            }
+            index = (int64)Math::Floor(scaled + (Real)0.5);
+            return Math::Abs(scaled - (Real)index) <= LATTICE_EPSILON;
+        }
+
+        /// Gets the shard of a brick.
+        inline size_t getShardIndex(uint64 key, size_t shardCount)
+        {
+            return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 56) % shardCount;
+        }
     }
-    
+
+    //-----------------------------------------------------------------------
+
+    CacheSource::CacheSource(const Source *src, Real voxelWidth, size_t maxBricks) :
+        mSrc(src), mVoxelWidth(voxelWidth), mInvVoxelWidth((Real)1.0 / voxelWidth),
+        mMaxShardBricks(std::max<size_t>(1, maxBricks / SHARD_COUNT))
+    {
+        for (size_t i = 0; i < SHARD_COUNT; ++i)
+        {
+            mShards[i].hits = 0;
+            mShards[i].misses = 0;
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    CacheSource::~CacheSource(void)
+    {
+        clear();
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool CacheSource::getBrickSlot(const Vector3 &position, uint64 &key, size_t &slot) const
+    {
+        int64 index[3];
+        if (!getLatticeIndex(position.x, mInvVoxelWidth, index[0]) ||
+            !getLatticeIndex(position.y, mInvVoxelWidth, index[1]) ||
+            !getLatticeIndex(position.z, mInvVoxelWidth, index[2]))
+        {
+            return false;
+        }
+
+        // Store the position in the coarsest lattice it lies on
+        int level = 0;
+        int64 combined = index[0] | index[1] | index[2];
+        while (level < LATTICE_LEVELS - 1 && !(combined & (int64(1) << level)))
+        {
+            ++level;
+        }
+
+        const int64 mask = (int64(1) << KEY_COORDINATE_BITS) - 1;
+        key = (uint64)level << (3 * KEY_COORDINATE_BITS);
+        slot = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            // Arithmetic shifts, so negative indices round towards minus infinity
+            int64 cell = index[i] >> level;
+            key |= (uint64)((cell >> BRICK_SHIFT) & mask) << ((2 - i) * KEY_COORDINATE_BITS);
+            slot = (slot << BRICK_SHIFT) | (size_t)(cell & (BRICK_SIZE - 1));
+        }
+        return true;
+    }
+
+    //-----------------------------------------------------------------------
+
+    Vector4 CacheSource::getFromCache(const Vector3 &position) const
+    {
+        uint64 key;
+        size_t slot;
+        if (!getBrickSlot(position, key, slot))
+        {
+            {
+                OGRE_WQ_LOCK_MUTEX(mShards[0].mutex);
+                ++mShards[0].misses;
+            }
+            return mSrc->getValueAndGradient(position);
+        }
+
+        Shard &shard = mShards[getShardIndex(key, SHARD_COUNT)];
+        const uint64 validBit = uint64(1) << (slot % 64);
+        {
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            BrickMap::iterator it = shard.lookup.find(key);
+            if (it != shard.lookup.end())
+            {
+                Brick *brick = *it->second;
+                // Mark as most recently used
+                shard.bricks.splice(shard.bricks.begin(), shard.bricks, it->second);
+                if (brick->valid[slot / 64] & validBit)
+                {
+                    ++shard.hits;
+                    return brick->values[slot];
+                }
+            }
+            ++shard.misses;
+        }
+
+        // Evaluate without holding the lock, so other threads can use the cache meanwhile
+        Vector4 result = mSrc->getValueAndGradient(position);
+
+        OGRE_WQ_LOCK_MUTEX(shard.mutex);
+        Brick *brick = getOrCreateBrick(shard, key);
+        brick->values[slot] = result;
+        brick->valid[slot / 64] |= validBit;
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    CacheSource::Brick* CacheSource::getOrCreateBrick(Shard &shard, uint64 key) const
+    {
+        BrickMap::iterator it = shard.lookup.find(key);
+        if (it != shard.lookup.end())
+        {
+            return *it->second;
+        }
+
+        Brick *brick;
+        if (shard.lookup.size() >= mMaxShardBricks)
+        {
+            // Reuse the least recently used brick
+            brick = shard.bricks.back();
+            shard.bricks.pop_back();
+            shard.lookup.erase(brick->key);
+        }
+        else
+        {
+            brick = OGRE_NEW_T(Brick, MEMCATEGORY_GENERAL);
+        }
+        memset(brick->valid, 0, sizeof(brick->valid));
+        brick->key = key;
+        shard.bricks.push_front(brick);
+        shard.lookup[key] = shard.bricks.begin();
+        return brick;
+    }
+
     //-----------------------------------------------------------------------
 
     Vector4 CacheSource::getValueAndGradient(const Vector3 &position) const
@@ -56,5 +208,179 @@ namespace Volume {
         return getFromCache(position).w;
     }
 
+    //-----------------------------------------------------------------------
+
+    void CacheSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        const size_t chunkSize = 64;
+        uint64 keys[chunkSize];
+        size_t slots[chunkSize];
+        bool cached[chunkSize];
+        size_t missing[chunkSize];
+        Real missX[chunkSize], missY[chunkSize], missZ[chunkSize];
+        Real missGradientX[chunkSize], missGradientY[chunkSize], missGradientZ[chunkSize], missValues[chunkSize];
+
+        for (size_t begin = 0; begin < count; begin += chunkSize)
+        {
+            const size_t n = std::min(chunkSize, count - begin);
+            size_t missCount = 0;
+            size_t uncachedCount = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                cached[i] = getBrickSlot(Vector3(x[begin + i], y[begin + i], z[begin + i]), keys[i], slots[i]);
+                if (!cached[i])
+                {
+                    missing[missCount++] = i;
+                    ++uncachedCount;
+                }
+            }
+            if (uncachedCount)
+            {
+                OGRE_WQ_LOCK_MUTEX(mShards[0].mutex);
+                mShards[0].misses += uncachedCount;
+            }
+
+            // Resolve the brick once for each run of positions sharing it
+            for (size_t i = 0; i < n; )
+            {
+                if (!cached[i])
+                {
+                    ++i;
+                    continue;
+                }
+                const uint64 key = keys[i];
+                Shard &shard = mShards[getShardIndex(key, SHARD_COUNT)];
+                OGRE_WQ_LOCK_MUTEX(shard.mutex);
+                Brick *brick = 0;
+                BrickMap::iterator it = shard.lookup.find(key);
+                if (it != shard.lookup.end())
+                {
+                    brick = *it->second;
+                    // Mark as most recently used
+                    shard.bricks.splice(shard.bricks.begin(), shard.bricks, it->second);
+                }
+                for (; i < n && cached[i] && keys[i] == key; ++i)
+                {
+                    const size_t slot = slots[i];
+                    if (brick && (brick->valid[slot / 64] & (uint64(1) << (slot % 64))))
+                    {
+                        const Vector4 &value = brick->values[slot];
+                        gradientX[begin + i] = value.x;
+                        gradientY[begin + i] = value.y;
+                        gradientZ[begin + i] = value.z;
+                        values[begin + i] = value.w;
+                        ++shard.hits;
+                    }
+                    else
+                    {
+                        missing[missCount++] = i;
+                        ++shard.misses;
+                    }
+                }
+            }
+            if (!missCount)
+            {
+                continue;
+            }
+
+            // Evaluate the missing ones in one go without holding a lock
+            for (size_t j = 0; j < missCount; ++j)
+            {
+                missX[j] = x[begin + missing[j]];
+                missY[j] = y[begin + missing[j]];
+                missZ[j] = z[begin + missing[j]];
+            }
+            mSrc->getValuesAndGradients(missX, missY, missZ, missGradientX, missGradientY, missGradientZ, missValues, missCount);
+
+            for (size_t j = 0; j < missCount; ++j)
+            {
+                const size_t i = missing[j];
+                gradientX[begin + i] = missGradientX[j];
+                gradientY[begin + i] = missGradientY[j];
+                gradientZ[begin + i] = missGradientZ[j];
+                values[begin + i] = missValues[j];
+            }
+
+            // Store them, again resolving the brick once for each run
+            for (size_t j = 0; j < missCount; )
+            {
+                if (!cached[missing[j]])
+                {
+                    ++j;
+                    continue;
+                }
+                const uint64 key = keys[missing[j]];
+                Shard &shard = mShards[getShardIndex(key, SHARD_COUNT)];
+                OGRE_WQ_LOCK_MUTEX(shard.mutex);
+                Brick *brick = getOrCreateBrick(shard, key);
+                for (; j < missCount && cached[missing[j]] && keys[missing[j]] == key; ++j)
+                {
+                    const size_t slot = slots[missing[j]];
+                    brick->values[slot] = Vector4(missGradientX[j], missGradientY[j], missGradientZ[j], missValues[j]);
+                    brick->valid[slot / 64] |= uint64(1) << (slot % 64);
+                }
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t CacheSource::getHitCount(void) const
+    {
+        size_t hits = 0;
+        for (size_t i = 0; i < SHARD_COUNT; ++i)
+        {
+            OGRE_WQ_LOCK_MUTEX(mShards[i].mutex);
+            hits += mShards[i].hits;
+        }
+        return hits;
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t CacheSource::getMissCount(void) const
+    {
+        size_t misses = 0;
+        for (size_t i = 0; i < SHARD_COUNT; ++i)
+        {
+            OGRE_WQ_LOCK_MUTEX(mShards[i].mutex);
+            misses += mShards[i].misses;
+        }
+        return misses;
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t CacheSource::getBrickCount(void) const
+    {
+        size_t bricks = 0;
+        for (size_t i = 0; i < SHARD_COUNT; ++i)
+        {
+            OGRE_WQ_LOCK_MUTEX(mShards[i].mutex);
+            bricks += mShards[i].bricks.size();
+        }
+        return bricks;
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CacheSource::clear(void)
+    {
+        for (size_t i = 0; i < SHARD_COUNT; ++i)
+        {
+            Shard &shard = mShards[i];
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            for (BrickList::iterator it = shard.bricks.begin(); it != shard.bricks.end(); ++it)
+            {
+                OGRE_DELETE_T(*it, Brick, MEMCATEGORY_GENERAL);
+            }
+            shard.bricks.clear();
+            shard.lookup.clear();
+            shard.hits = 0;
+            shard.misses = 0;
+        }
+    }
+
 }
 }
\ No newline at end of file
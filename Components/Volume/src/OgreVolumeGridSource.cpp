@@ -29,6 +29,11 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreRay.h"
 #include "OgreVolumeCSGSource.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE
+#include <xmmintrin.h>
+#endif
 
 namespace Ogre {
 namespace Volume {
@@ -90,9 +95,8 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
     
-    Vector4 GridSource::getValueAndGradient(const Vector3 &position) const
+    Vector3 GridSource::getScaledGradient(const Vector3 &scaledPosition) const
     {
-        Vector3 scaledPosition(position.x * mPosXScale, position.y * mPosYScale, position.z * mPosZScale);
         Vector3 gradient;
         if (mTrilinearGradient)
         {
@@ -138,6 +142,15 @@ namespace Volume {
             gradient = getGradient((size_t)(scaledPosition.x + (Real)0.5), (size_t)(scaledPosition.y + (Real)0.5), (size_t)(scaledPosition.z + (Real)0.5));
             gradient *= (Real)-1.0;
         }
+        return gradient;
+    }
+
+    //-----------------------------------------------------------------------
+    
+    Vector4 GridSource::getValueAndGradient(const Vector3 &position) const
+    {
+        Vector3 scaledPosition(position.x * mPosXScale, position.y * mPosYScale, position.z * mPosZScale);
+        Vector3 gradient = getScaledGradient(scaledPosition);
         return Vector4(gradient.x, gradient.y, gradient.z, getValue(position));
     }
     
@@ -198,6 +211,93 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
     
+    void GridSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE
+        if (mTrilinearValue && PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_SSE))
+        {
+            const __m128 one = _mm_set_ps1(1.0f);
+            for (; i + 4 <= count; i += 4)
+            {
+                // Fetch the eight surrounding grid values of four positions
+                float f[8][4];
+                float d[3][4];
+                for (size_t l = 0; l < 4; ++l)
+                {
+                    Vector3 scaledPosition(x[i + l] * mPosXScale, y[i + l] * mPosYScale, z[i + l] * mPosZScale);
+                    size_t x0 = (size_t)scaledPosition.x;
+                    size_t x1 = (size_t)ceil(scaledPosition.x);
+                    size_t y0 = (size_t)scaledPosition.y;
+                    size_t y1 = (size_t)ceil(scaledPosition.y);
+                    size_t z0 = (size_t)scaledPosition.z;
+                    size_t z1 = (size_t)ceil(scaledPosition.z);
+
+                    d[0][l] = scaledPosition.x - (Real)x0;
+                    d[1][l] = scaledPosition.y - (Real)y0;
+                    d[2][l] = scaledPosition.z - (Real)z0;
+
+                    f[0][l] = getVolumeGridValue(x0, y0, z0);
+                    f[1][l] = getVolumeGridValue(x1, y0, z0);
+                    f[2][l] = getVolumeGridValue(x0, y1, z0);
+                    f[3][l] = getVolumeGridValue(x0, y0, z1);
+                    f[4][l] = getVolumeGridValue(x1, y0, z1);
+                    f[5][l] = getVolumeGridValue(x0, y1, z1);
+                    f[6][l] = getVolumeGridValue(x1, y1, z0);
+                    f[7][l] = getVolumeGridValue(x1, y1, z1);
+                }
+
+                // And interpolate them like getValue
+                __m128 dX = _mm_loadu_ps(d[0]);
+                __m128 dY = _mm_loadu_ps(d[1]);
+                __m128 dZ = _mm_loadu_ps(d[2]);
+                __m128 oneMinX = _mm_sub_ps(one, dX);
+                __m128 oneMinY = _mm_sub_ps(one, dY);
+                __m128 oneMinZ = _mm_sub_ps(one, dZ);
+                __m128 oneMinXoneMinY = _mm_mul_ps(oneMinX, oneMinY);
+                __m128 dXOneMinY = _mm_mul_ps(dX, oneMinY);
+
+                __m128 back = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_loadu_ps(f[0]), oneMinXoneMinY),
+                    _mm_mul_ps(_mm_loadu_ps(f[1]), dXOneMinY)),
+                    _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(f[2]), oneMinX), dY));
+                __m128 front = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_loadu_ps(f[3]), oneMinXoneMinY),
+                    _mm_mul_ps(_mm_loadu_ps(f[4]), dXOneMinY)),
+                    _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(f[5]), oneMinX), dY));
+                __m128 top = _mm_add_ps(
+                    _mm_mul_ps(_mm_loadu_ps(f[6]), oneMinZ),
+                    _mm_mul_ps(_mm_loadu_ps(f[7]), dZ));
+                _mm_storeu_ps(values + i, _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(oneMinZ, back),
+                    _mm_mul_ps(dZ, front)),
+                    _mm_mul_ps(_mm_mul_ps(dX, dY), top)));
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            values[i] = GridSource::getValue(Vector3(x[i], y[i], z[i]));
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+    
+    void GridSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        GridSource::getValues(x, y, z, values, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vector3 gradient = getScaledGradient(Vector3(x[i] * mPosXScale, y[i] * mPosYScale, z[i] * mPosZScale));
+            gradientX[i] = gradient.x;
+            gradientY[i] = gradient.y;
+            gradientZ[i] = gradient.z;
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+    
     size_t GridSource::getWidth(void) const
     {
         return mWidth;
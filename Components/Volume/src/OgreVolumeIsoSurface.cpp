@@ -25,6 +25,8 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreVolumeIsoSurface.h"
+#include "OgreVolumeSource.h"
+#include "OgreVector4.h"
 
 namespace Ogre {
 namespace Volume {
@@ -49,5 +51,25 @@ namespace Volume {
     IsoSurface::~IsoSurface(void)
     {
     }
+
+    //-----------------------------------------------------------------------
+
+    void IsoSurface::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        assert(count <= 8);
+        Real x[8], y[8], z[8];
+        Real gradientX[8], gradientY[8], gradientZ[8], densities[8];
+        for (size_t i = 0; i < count; ++i)
+        {
+            x[i] = positions[i].x;
+            y[i] = positions[i].y;
+            z[i] = positions[i].z;
+        }
+        mSrc->getValuesAndGradients(x, y, z, gradientX, gradientY, gradientZ, densities, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = Vector4(gradientX[i], gradientY[i], gradientZ[i], densities[i]);
+        }
+    }
 }
 }
\ No newline at end of file
@@ -46,17 +46,21 @@ namespace Volume {
         unsigned char cubeIndex = 0;
         Vector4 values[8];
 
-        // Find out the case.
-        for (size_t i = 0; i < 8; ++i)
+        if (volumeValues)
         {
-            if (volumeValues)
+            for (size_t i = 0; i < 8; ++i)
             {
                 values[i] = volumeValues[i];
             }
-            else
-            {
-                values[i] = mSrc->getValueAndGradient(corners[i]);
-            }
+        }
+        else
+        {
+            getValuesAndGradients(corners, 8, values);
+        }
+
+        // Find out the case.
+        for (size_t i = 0; i < 8; ++i)
+        {
             if (values[i].w >= ISO_LEVEL)
             {
                 cubeIndex |= 1 << i;
@@ -138,6 +142,14 @@ namespace Volume {
     {
         unsigned char squareIndex = 0;
         Vector4 values[4];
+        Vector3 squareCorners[4] = {corners[indices[0]], corners[indices[1]], corners[indices[2]], corners[indices[3]]};
+        Vector4 innerValues[4];
+
+        // Without cached values, the corners are needed with gradients for the normals anyway.
+        if (!volumeValues)
+        {
+            getValuesAndGradients(squareCorners, 4, innerValues);
+        }
 
         // Find out the case.
         for (size_t i = 0; i < 4; ++i)
@@ -148,7 +160,7 @@ namespace Volume {
             }
             else
             {
-                values[i] = mSrc->getValueAndGradient(corners[indices[i]]);
+                values[i] = innerValues[i];
             }
             if (values[i].w >= ISO_LEVEL)
             {
@@ -162,6 +174,11 @@ namespace Volume {
             return;
         }
 
+        if (volumeValues)
+        {
+            getValuesAndGradients(squareCorners, 4, innerValues);
+        }
+
         int edge = msEdges[squareIndex];
 
         // Find the intersection vertices.
@@ -172,30 +189,15 @@ namespace Volume {
         intersectionPoints[4] = corners[indices[2]];
         intersectionPoints[6] = corners[indices[3]];
 
-        Vector4 innerVal = mSrc->getValueAndGradient(intersectionPoints[0]);
-        intersectionNormals[0].x = innerVal.x;
-        intersectionNormals[0].y = innerVal.y;
-        intersectionNormals[0].z = innerVal.z;
-        intersectionNormals[0].normalise();
-        intersectionNormals[0] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[2]);
-        intersectionNormals[2].x = innerVal.x;
-        intersectionNormals[2].y = innerVal.y;
-        intersectionNormals[2].z = innerVal.z;
-        intersectionNormals[2].normalise();
-        intersectionNormals[2] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[4]);
-        intersectionNormals[4].x = innerVal.x;
-        intersectionNormals[4].y = innerVal.y;
-        intersectionNormals[4].z = innerVal.z;
-        intersectionNormals[4].normalise();
-        intersectionNormals[4] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[6]);
-        intersectionNormals[6].x = innerVal.x;
-        intersectionNormals[6].y = innerVal.y;
-        intersectionNormals[6].z = innerVal.z;
-        intersectionNormals[6].normalise();
-        intersectionNormals[6] *= innerVal.w + (Real)1.0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            Vector3 &normal = intersectionNormals[i * 2];
+            normal.x = innerValues[i].x;
+            normal.y = innerValues[i].y;
+            normal.z = innerValues[i].z;
+            normal.normalise();
+            normal *= innerValues[i].w + (Real)1.0;
+        }
 
         if (edge & 1)
         {
@@ -105,43 +105,68 @@ namespace Volume {
 
     void OctreeNode::split(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError)
     {
-        if (splitPolicy->doSplit(this, geometricError))
+        if (!splitChildren(splitPolicy, src, geometricError) && !hasCenterValue())
         {
-            Vector3 newCenter, xWidth, yWidth, zWidth;
-            OctreeNode::getChildrenDimensions(mFrom, mTo, newCenter, xWidth, yWidth, zWidth);
-            /*
-               4 5
-              7 6
-               0 1
-              3 2
-              0 == from
-              6 == to
-            */
-            mChildren = new OctreeNode*[OCTREE_CHILDREN_COUNT];
-            mChildren[0] = createInstance(mFrom, newCenter);
-            mChildren[0]->split(splitPolicy, src, geometricError);
-            mChildren[1] = createInstance(mFrom + xWidth, newCenter + xWidth);
-            mChildren[1]->split(splitPolicy, src, geometricError);
-            mChildren[2] = createInstance(mFrom + xWidth + zWidth, newCenter + xWidth + zWidth);
-            mChildren[2]->split(splitPolicy, src, geometricError);
-            mChildren[3] = createInstance(mFrom + zWidth, newCenter + zWidth);
-            mChildren[3]->split(splitPolicy, src, geometricError);
-            mChildren[4] = createInstance(mFrom + yWidth, newCenter + yWidth);
-            mChildren[4]->split(splitPolicy, src, geometricError);
-            mChildren[5] = createInstance(mFrom + yWidth + xWidth, newCenter + yWidth + xWidth);
-            mChildren[5]->split(splitPolicy, src, geometricError);
-            mChildren[6] = createInstance(mFrom + yWidth + xWidth + zWidth, newCenter + yWidth + xWidth + zWidth);
-            mChildren[6]->split(splitPolicy, src, geometricError);
-            mChildren[7] = createInstance(mFrom + yWidth + zWidth, newCenter + yWidth + zWidth);
-            mChildren[7]->split(splitPolicy, src, geometricError);
+            setCenterValue(src->getValueAndGradient(getCenter()));
         }
-        else
+    }
+    
+    //-----------------------------------------------------------------------
+
+    bool OctreeNode::splitChildren(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError)
+    {
+        if (!splitPolicy->doSplit(this, geometricError))
+        {
+            return false;
+        }
+
+        Vector3 newCenter, xWidth, yWidth, zWidth;
+        OctreeNode::getChildrenDimensions(mFrom, mTo, newCenter, xWidth, yWidth, zWidth);
+        /*
+           4 5
+          7 6
+           0 1
+          3 2
+          0 == from
+          6 == to
+        */
+        mChildren = new OctreeNode*[OCTREE_CHILDREN_COUNT];
+        mChildren[0] = createInstance(mFrom, newCenter);
+        mChildren[1] = createInstance(mFrom + xWidth, newCenter + xWidth);
+        mChildren[2] = createInstance(mFrom + xWidth + zWidth, newCenter + xWidth + zWidth);
+        mChildren[3] = createInstance(mFrom + zWidth, newCenter + zWidth);
+        mChildren[4] = createInstance(mFrom + yWidth, newCenter + yWidth);
+        mChildren[5] = createInstance(mFrom + yWidth + xWidth, newCenter + yWidth + xWidth);
+        mChildren[6] = createInstance(mFrom + yWidth + xWidth + zWidth, newCenter + yWidth + xWidth + zWidth);
+        mChildren[7] = createInstance(mFrom + yWidth + zWidth, newCenter + yWidth + zWidth);
+
+        // The leaves the split policy left without a center value get it in one batch.
+        OctreeNode *leaves[OCTREE_CHILDREN_COUNT];
+        Real x[OCTREE_CHILDREN_COUNT], y[OCTREE_CHILDREN_COUNT], z[OCTREE_CHILDREN_COUNT];
+        size_t leafCount = 0;
+        for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+        {
+            if (!mChildren[i]->splitChildren(splitPolicy, src, geometricError) && !mChildren[i]->hasCenterValue())
+            {
+                Vector3 center = mChildren[i]->getCenter();
+                leaves[leafCount] = mChildren[i];
+                x[leafCount] = center.x;
+                y[leafCount] = center.y;
+                z[leafCount] = center.z;
+                ++leafCount;
+            }
+        }
+        if (leafCount > 0)
         {
-            if (mCenterValue.x == (Real)0.0 && mCenterValue.y == (Real)0.0 && mCenterValue.z == (Real)0.0 && mCenterValue.w == (Real)0.0)
+            Real gradientX[OCTREE_CHILDREN_COUNT], gradientY[OCTREE_CHILDREN_COUNT], gradientZ[OCTREE_CHILDREN_COUNT];
+            Real values[OCTREE_CHILDREN_COUNT];
+            src->getValuesAndGradients(x, y, z, gradientX, gradientY, gradientZ, values, leafCount);
+            for (size_t i = 0; i < leafCount; ++i)
             {
-                setCenterValue(src->getValueAndGradient(getCenter()));
+                leaves[i]->setCenterValue(Vector4(gradientX[i], gradientY[i], gradientZ[i], values[i]));
             }
         }
+        return true;
     }
     
     //-----------------------------------------------------------------------
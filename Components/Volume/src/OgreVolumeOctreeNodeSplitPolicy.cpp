@@ -60,14 +60,21 @@ namespace Volume {
         }
 
         // Error metric of http://www.andrew.cmu.edu/user/jessicaz/publication/meshing/
-        Real f000 = mSrc->getValue(from);
-        Real f001 = mSrc->getValue(node->getCorner3());
-        Real f010 = mSrc->getValue(node->getCorner4());
-        Real f011 = mSrc->getValue(node->getCorner7());
-        Real f100 = mSrc->getValue(node->getCorner1());
-        Real f101 = mSrc->getValue(node->getCorner2());
-        Real f110 = mSrc->getValue(node->getCorner5());
-        Real f111 = mSrc->getValue(to);
+        const Vector3 corners[8] = {
+            from, node->getCorner3(), node->getCorner4(), node->getCorner7(),
+            node->getCorner1(), node->getCorner2(), node->getCorner5(), to
+        };
+        Real x[19], y[19], z[19];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            x[i] = corners[i].x;
+            y[i] = corners[i].y;
+            z[i] = corners[i].z;
+        }
+        Real f[8];
+        mSrc->getValues(x, y, z, f, 8);
+        const Real f000 = f[0], f001 = f[1], f010 = f[2], f011 = f[3];
+        const Real f100 = f[4], f101 = f[5], f110 = f[6], f111 = f[7];
 
         Vector3 positions[19][2] = {
             {node->getCenterBackBottom(), Vector3((Real)0.5, (Real)0.0, (Real)0.0)},
@@ -94,25 +101,39 @@ namespace Volume {
         };
 
     
+        for (size_t i = 0; i < 19; ++i)
+        {
+            x[i] = positions[i][0].x;
+            y[i] = positions[i][0].y;
+            z[i] = positions[i][0].z;
+        }
+        Real gradientX[19], gradientY[19], gradientZ[19], values[19];
+
+        // Evaluate in small batches so the early exit still saves most of the samples.
+        const size_t batchSize = 4;
         Real error = (Real)0.0;
-        Vector4 value;
         Vector3 gradient;
-        for (size_t i = 0; i < 19; ++i)
+        for (size_t batch = 0; batch < 19; batch += batchSize)
         {
-            value = mSrc->getValueAndGradient(positions[i][0]);
-            gradient.x = value.x;
-            gradient.y = value.y;
-            gradient.z = value.z;
-            Real interpolated = interpolate(f000, f001, f010, f011, f100, f101, f110, f111, positions[i][1]);
-            Real gradientMagnitude = gradient.length();
-            if (gradientMagnitude < FLT_EPSILON)
-            {
-                gradientMagnitude = (Real)1.0;
-            }
-            error += Math::Abs(value.w - interpolated) / gradientMagnitude;
-            if (error >= geometricError)
+            const size_t count = std::min(batchSize, (size_t)19 - batch);
+            mSrc->getValuesAndGradients(x + batch, y + batch, z + batch,
+                gradientX + batch, gradientY + batch, gradientZ + batch, values + batch, count);
+            for (size_t i = batch; i < batch + count; ++i)
             {
-                return true;
+                gradient.x = gradientX[i];
+                gradient.y = gradientY[i];
+                gradient.z = gradientZ[i];
+                Real interpolated = interpolate(f000, f001, f010, f011, f100, f101, f110, f111, positions[i][1]);
+                Real gradientMagnitude = gradient.length();
+                if (gradientMagnitude < FLT_EPSILON)
+                {
+                    gradientMagnitude = (Real)1.0;
+                }
+                error += Math::Abs(values[i] - interpolated) / gradientMagnitude;
+                if (error >= geometricError)
+                {
+                    return true;
+                }
             }
         }
         node->setCenterValue(centerValue);
@@ -25,11 +25,20 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreVolumeSimplexNoise.h"
+#include "OgrePlatformInformation.h"
 
 #include <time.h>
 
 #include <cmath>
 
+// The batch noise needs the SSE2 integer conversions.
+#if __OGRE_HAVE_SSE && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define __OGRE_VOLUME_HAVE_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define __OGRE_VOLUME_HAVE_SSE2 0
+#endif
+
 namespace Ogre {
 namespace Volume {
 
@@ -42,6 +51,117 @@ namespace Volume {
         Vector3(0,1,1), Vector3(0,-1,1), Vector3(0,1,-1), Vector3(0,-1,-1)
     };
 
+#if __OGRE_VOLUME_HAVE_SSE2
+    //-----------------------------------------------------------------------
+    /// Load the gradient components of four corners into three registers
+    #define __GATHER_GRADIENT_PS(gi, gx, gy, gz)                                        \
+        gx = _mm_setr_ps(grad3[gi[0]].x, grad3[gi[1]].x, grad3[gi[2]].x, grad3[gi[3]].x); \
+        gy = _mm_setr_ps(grad3[gi[0]].y, grad3[gi[1]].y, grad3[gi[2]].y, grad3[gi[3]].y); \
+        gz = _mm_setr_ps(grad3[gi[0]].z, grad3[gi[1]].z, grad3[gi[2]].z, grad3[gi[3]].z)
+    //-----------------------------------------------------------------------
+    /// The contribution of a simplex corner, zero where it is out of reach
+    static inline __m128 cornerContributionSSE(__m128 x, __m128 y, __m128 z, const int *gi)
+    {
+        __m128 gx, gy, gz;
+        __GATHER_GRADIENT_PS(gi, gx, gy, gz);
+        __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set_ps1(0.6f), _mm_mul_ps(x, x)), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        t = _mm_max_ps(t, _mm_setzero_ps());
+        t = _mm_mul_ps(t, t);
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, x), _mm_mul_ps(gy, y)), _mm_mul_ps(gz, z));
+        return _mm_mul_ps(_mm_mul_ps(t, t), dot);
+    }
+    //-----------------------------------------------------------------------
+    /// Four noise values at once, the same steps as SimplexNoise::noise for each of them
+    static size_t noiseSSE2(const short *perm, const short *permMod12, Real F3, Real G3,
+        const Real *xIn, const Real *yIn, const Real *zIn, Real *results, size_t count)
+    {
+        const __m128 one = _mm_set_ps1(1.0f);
+        const __m128 allBits = _mm_cmpeq_ps(one, one);
+        const __m128 f3 = _mm_set_ps1(F3);
+        const __m128 g3 = _mm_set_ps1(G3);
+        const __m128 g3Times2 = _mm_set_ps1((Real)2.0 * G3);
+        const __m128 g3Times3 = _mm_set_ps1((Real)3.0 * G3);
+
+        size_t n = 0;
+        for (; n + 4 <= count; n += 4)
+        {
+            __m128 x = _mm_loadu_ps(xIn + n);
+            __m128 y = _mm_loadu_ps(yIn + n);
+            __m128 z = _mm_loadu_ps(zIn + n);
+
+            // Skew the input space to determine which simplex cell we're in
+            __m128 s = _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), z), f3);
+            __m128 i = _mm_add_ps(x, s);
+            __m128 j = _mm_add_ps(y, s);
+            __m128 k = _mm_add_ps(z, s);
+            __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(i));
+            i = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, i), one));
+            truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(j));
+            j = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, j), one));
+            truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(k));
+            k = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, k), one));
+
+            // Unskew the cell origin back to (x,y,z) space and get the distances from it
+            __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(i, j), k), g3);
+            __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(i, t));
+            __m128 y0 = _mm_sub_ps(y, _mm_sub_ps(j, t));
+            __m128 z0 = _mm_sub_ps(z, _mm_sub_ps(k, t));
+
+            // Determine which simplex we are in, the masks select the same offsets as the branches of noise()
+            __m128 xy = _mm_cmpge_ps(x0, y0);
+            __m128 yz = _mm_cmpge_ps(y0, z0);
+            __m128 xz = _mm_cmpge_ps(x0, z0);
+            __m128 i1 = _mm_and_ps(xy, xz);
+            __m128 j1 = _mm_andnot_ps(xy, yz);
+            __m128 k1 = _mm_andnot_ps(_mm_or_ps(i1, j1), allBits);
+            __m128 i2 = _mm_or_ps(xy, xz);
+            __m128 j2 = _mm_or_ps(_mm_andnot_ps(xy, allBits), yz);
+            __m128 k2 = _mm_andnot_ps(_mm_and_ps(yz, xz), allBits);
+
+            __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(i1, one)), g3);
+            __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_and_ps(j1, one)), g3);
+            __m128 z1 = _mm_add_ps(_mm_sub_ps(z0, _mm_and_ps(k1, one)), g3);
+            __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(i2, one)), g3Times2);
+            __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_and_ps(j2, one)), g3Times2);
+            __m128 z2 = _mm_add_ps(_mm_sub_ps(z0, _mm_and_ps(k2, one)), g3Times2);
+            __m128 x3 = _mm_add_ps(_mm_sub_ps(x0, one), g3Times3);
+            __m128 y3 = _mm_add_ps(_mm_sub_ps(y0, one), g3Times3);
+            __m128 z3 = _mm_add_ps(_mm_sub_ps(z0, one), g3Times3);
+
+            // Work out the hashed gradient indices of the four simplex corners, lane by lane
+            int ii[4], jj[4], kk[4];
+            _mm_storeu_si128((__m128i*)ii, _mm_cvttps_epi32(i));
+            _mm_storeu_si128((__m128i*)jj, _mm_cvttps_epi32(j));
+            _mm_storeu_si128((__m128i*)kk, _mm_cvttps_epi32(k));
+            const int i1Bits = _mm_movemask_ps(i1), j1Bits = _mm_movemask_ps(j1), k1Bits = _mm_movemask_ps(k1);
+            const int i2Bits = _mm_movemask_ps(i2), j2Bits = _mm_movemask_ps(j2), k2Bits = _mm_movemask_ps(k2);
+            int gi0[4], gi1[4], gi2[4], gi3[4];
+            for (int l = 0; l < 4; ++l)
+            {
+                const int a = ii[l] & 255;
+                const int b = jj[l] & 255;
+                const int c = kk[l] & 255;
+                const int i1l = (i1Bits >> l) & 1, j1l = (j1Bits >> l) & 1, k1l = (k1Bits >> l) & 1;
+                const int i2l = (i2Bits >> l) & 1, j2l = (j2Bits >> l) & 1, k2l = (k2Bits >> l) & 1;
+                gi0[l] = permMod12[a + perm[b + perm[c]]];
+                gi1[l] = permMod12[a + i1l + perm[b + j1l + perm[c + k1l]]];
+                gi2[l] = permMod12[a + i2l + perm[b + j2l + perm[c + k2l]]];
+                gi3[l] = permMod12[a + 1 + perm[b + 1 + perm[c + 1]]];
+            }
+
+            // Add contributions from each corner, scaled to stay just inside [-1,1]
+            __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                cornerContributionSSE(x0, y0, z0, gi0),
+                cornerContributionSSE(x1, y1, z1, gi1)),
+                cornerContributionSSE(x2, y2, z2, gi2)),
+                cornerContributionSSE(x3, y3, z3, gi3));
+            _mm_storeu_ps(results + n, _mm_mul_ps(_mm_set_ps1(32.0f), sum));
+        }
+        return n;
+    }
+    #undef __GATHER_GRADIENT_PS
+#endif
+
     //-----------------------------------------------------------------------
     
     unsigned long SimplexNoise::random(void)
@@ -234,6 +354,23 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
     
+    void SimplexNoise::noise(const Real *xIn, const Real *yIn, const Real *zIn, Real *results, size_t count) const
+    {
+        size_t i = 0;
+#if __OGRE_VOLUME_HAVE_SSE2
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_SSE2))
+        {
+            i = noiseSSE2(perm, permMod12, F3, G3, xIn, yIn, zIn, results, count);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            results[i] = noise(xIn[i], yIn[i], zIn[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+    
     long SimplexNoise::getSeed(void) const
     {
         return mSeed;
@@ -61,6 +61,31 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
 
+    void Source::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = getValue(Vector3(x[i], y[i], z[i]));
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Source::getValuesAndGradients(const Real *x, const Real *y, const Real *z,
+        Real *gradientX, Real *gradientY, Real *gradientZ, Real *values, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vector4 value = getValueAndGradient(Vector3(x[i], y[i], z[i]));
+            gradientX[i] = value.x;
+            gradientY[i] = value.y;
+            gradientZ[i] = value.z;
+            values[i] = value.w;
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
     void Source::serialize(const Vector3 &from, const Vector3 &to, float voxelWidth, const String &file)
     {
         Real maxClampedAbsoluteDensity = (from - to).length() / (Real)16.0;
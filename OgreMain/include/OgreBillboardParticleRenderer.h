@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreParticleSystemRenderer.h"
 #include "OgreBillboardSet.h"
+#include "OgreBillboard.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -54,6 +55,10 @@ namespace Ogre {
     protected:
         /// The billboard set that's doing the rendering
         BillboardSet* mBillboardSet;
+        /// The billboards of the particles, kept between frames to avoid reallocation
+        vector<Billboard>::type mBillboards;
+        /// Pointers to mBillboards, passed to BillboardSet::injectBillboards
+        vector<const Billboard*>::type mBillboardPointers;
     public:
         BillboardParticleRenderer();
         ~BillboardParticleRenderer();
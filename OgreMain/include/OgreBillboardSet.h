@@ -238,6 +238,11 @@ namespace Ogre {
         */
         void genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* pBill = 0);
 
+        /** Version of genBillboardAxes working with the given camera direction instead
+            of mCamDir, which may be updated for accurate facing.
+        */
+        void genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* pBill, Vector3& camDir) const;
+
         /** Internal method, generates parametric offsets based on origin.
         */
         void getParametricOffsets(Real& left, Real& right, Real& top, Real& bottom);
@@ -248,6 +253,15 @@ namespace Ogre {
         */
         void genVertices(const Vector3* const offsets, const Billboard& pBillboard);
 
+        /** Version of genVertices writing to pDest instead of the locked buffer.
+        @param offsets Array of 4 Vector3 offsets
+        @param pBillboard Reference to billboard
+        @param colour The colour of the billboard, in the vertex colour format
+        @param pDest Pointer to the vertices, moved past the ones written
+        */
+        void genVertices(const Vector3* const offsets, const Billboard& pBillboard,
+            RGBA colour, float*& pDest) const;
+
         /** Internal method generates vertex offsets.
         @remarks
             Takes in parametric offsets as generated from getParametericOffsets, width and height values
@@ -257,7 +271,7 @@ namespace Ogre {
         */
         void genVertOffsets(Real inleft, Real inright, Real intop, Real inbottom,
             Real width, Real height,
-            const Vector3& x, const Vector3& y, Vector3* pDestVec);
+            const Vector3& x, const Vector3& y, Vector3* pDestVec) const;
 
 
         /** Sort by direction functor */
@@ -280,7 +294,13 @@ namespace Ogre {
             float operator()(Billboard* bill) const;
         };
 
-        static RadixSort<ActiveBillboardList, Billboard*, float> mRadixSorter;
+        /// Sorter of the billboards, one per set so that sets may be sorted at the same time
+        RadixSort<ActiveBillboardList, Billboard*, float> mRadixSorter;
+
+        /// The active billboards, passed to injectBillboards
+        vector<const Billboard*>::type mBatchBillboards;
+        /// Billboards passed to injectBillboards which survived culling
+        vector<const Billboard*>::type mInjectedBillboards;
 
         /// Use point rendering?
         bool mPointRendering;
@@ -548,8 +568,28 @@ namespace Ogre {
         void beginBillboards(size_t numBillboards = 0);
         /** Define a billboard. */
         void injectBillboard(const Billboard& bb);
+        /** Define several billboards at once.
+        @remarks
+            This gives the same result as calling injectBillboard for each of them,
+            but billboards sharing the same corner offsets are generated in batches
+            using SIMD, and large numbers of billboards are split across the threads
+            of the WorkQueue, each writing its own range of the vertex buffer.
+        @param billboards Array of pointers to the billboards.
+        @param count Number of billboards.
+        */
+        void injectBillboards(const Billboard* const* billboards, size_t count);
         /** Finish defining billboards. */
         void endBillboards(void);
+        /** Internal method generating the vertices of several billboards, as injectBillboards
+            does but without culling them.
+        @remarks
+            May be called for different ranges of billboards at the same time, from any
+            thread, between beginBillboards and endBillboards.
+        @param billboards Array of pointers to the billboards.
+        @param count Number of billboards.
+        @param pDest Pointer to the vertices of the first billboard.
+        */
+        void _genVertices(const Billboard* const* billboards, size_t count, float* pDest) const;
         /** Set the bounds of the BillboardSet.
         @remarks
             You may need to call this if you're injecting billboards manually, 
@@ -473,6 +473,29 @@ namespace Ogre {
         void setFreeOnClose(bool free) { mFreeOnClose = free; }
     };
 
+    /** Read-only MemoryDataStream over a file mapped into the address space.
+    @remarks
+        The operating system pages the file in on demand, and getPtr gives
+        direct access to its bytes, so loaders which parse from memory do not
+        need to copy the whole file into the heap first. The file must not be
+        truncated while the stream is open.
+    */
+    class _OgreExport MappedFileDataStream : public MemoryDataStream
+    {
+    public:
+        /** Map a file into memory.
+        @param name The name to give the stream
+        @param path The full path of the file to map
+        */
+        MappedFileDataStream(const String& name, const String& path);
+
+        ~MappedFileDataStream();
+
+        /** @copydoc DataStream::close
+        */
+        void close(void);
+    };
+
     /** Common subclass of DataStream for handling data from 
         std::basic_istream.
     */
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __EdgeListBuilder_H__
 
 #include "OgrePrerequisites.h"
+#include "OgreCommon.h"
 #include "OgreRenderOperation.h"
 #include "OgreVector3.h"
 #include "OgreVector4.h"
@@ -192,9 +193,20 @@ namespace Ogre {
         void addIndexData(const IndexData* indexData, size_t vertexSet = 0, 
             RenderOperation::OperationType opType = RenderOperation::OT_TRIANGLE_LIST);
 
+        /** Sets the distance under which vertex positions are welded into a common vertex.
+        @remarks
+            By default (0) only vertices at exactly the same position are welded. Otherwise
+            each vertex is welded to the first common vertex not further away than this,
+            or else becomes a new common vertex itself.
+        */
+        void setWeldTolerance(Real tolerance) { mWeldTolerance = tolerance; }
+        /// Gets the distance under which vertex positions are welded
+        Real getWeldTolerance(void) const { return mWeldTolerance; }
+
         /** Builds the edge information based on the information built up so far.
         @remarks
             The caller takes responsibility for deleting the returned structure.
+            The edges are connected in parallel on the WorkQueue, when there is one.
         */
         EdgeData* build(void);
 
@@ -230,15 +242,14 @@ namespace Ogre {
                 return a.indexSet < b.indexSet;
             }
         };
-        /** Comparator for unique vertex list */
-        struct vectorLess {
-            bool operator()(const Vector3& a, const Vector3& b) const
+        /** Hash for unique vertex list */
+        struct vectorHash {
+            size_t operator()(const Vector3& v) const
             {
-                if (a.x < b.x) return true;
-                if (a.x > b.x) return false;
-                if (a.y < b.y) return true;
-                if (a.y > b.y) return false;
-                return a.z < b.z;
+                // adding zero folds -0 into 0, which compares equal to it
+                uint32 hash = HashCombine(0, v.x + Real(0));
+                hash = HashCombine(hash, v.y + Real(0));
+                return HashCombine(hash, v.z + Real(0));
             }
         };
 
@@ -250,23 +261,27 @@ namespace Ogre {
         VertexDataList mVertexDataList;
         CommonVertexList mVertices;
         EdgeData* mEdgeData;
-        /// Map for identifying common vertices
-        typedef map<Vector3, size_t, vectorLess>::type CommonVertexMap;
-        CommonVertexMap mCommonVertexMap;
-        /** Edge map, used to connect edges. Note we allow many triangles on an edge,
-        after connected an existing edge, we will remove it and never used again.
+        /** Map for identifying common vertices, by position or else by the cell of a
+            grid as large as the weld tolerance
         */
-        typedef multimap< std::pair<size_t, size_t>, std::pair<size_t, size_t> >::type EdgeMap;
-        EdgeMap mEdgeMap;
+        typedef OGRE_HashMultiMap<Vector3, size_t, vectorHash> CommonVertexMap;
+        CommonVertexMap mCommonVertexMap;
+        Real mWeldTolerance;
+
+        void buildTriangles(const Geometry &geometry);
 
-        void buildTrianglesEdges(const Geometry &geometry);
+        /** Connects the edges of all the triangles built so far.
+        @remarks
+            Each triangle side connects to the oldest unconnected side going the other
+            way between the same common vertices, or else starts a new edge. Note we
+            allow many triangles on an edge, after connecting an existing edge it is
+            never used again.
+        */
+        void buildEdges(void);
 
         /// Finds an existing common vertex, or inserts a new one
         size_t findOrCreateCommonVertex(const Vector3& vec, size_t vertexSet, 
             size_t indexSet, size_t originalIndex);
-        /// Connect existing edge or create a new edge - utility method during building
-        void connectOrCreateEdge(size_t vertexSet, size_t triangleIndex, size_t vertIndex0, size_t vertIndex1, 
-            size_t sharedVertIndex0, size_t sharedVertIndex1);
     };
     /** @} */
     /** @} */
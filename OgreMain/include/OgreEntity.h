@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgreCommon.h"
 
 #include "OgreMovableObject.h"
+#include "OgreMesh.h"
 #include "OgreQuaternion.h"
 #include "OgreVector3.h"
 #include "OgreHardwareBufferManager.h"
@@ -180,8 +181,12 @@ namespace Ogre {
         /// Records the last frame in which animation was updated.
         unsigned long mFrameAnimationLastUpdated;
 
-        /// Perform all the updates required for an animated entity.
-        void updateAnimation(void);
+        /** Perform all the updates required for an animated entity.
+        @param blendBatch
+            If not null, software skinning is added to this batch instead of being
+            performed right away.
+        */
+        void updateAnimation(Mesh::SoftwareVertexBlendBatch* blendBatch = 0);
 
         /// Records the last frame in which the bones was updated.
         /// It's a pointer because it can be shared between different entities with
@@ -742,6 +747,16 @@ namespace Ogre {
         */
         void _updateAnimation(void);
 
+        /** Advanced method to update the animation of many entities at once.
+        @remarks
+            Does the same as calling _updateAnimation on each of the entities,
+            except that the software skinning of all of them is performed together
+            at the end, spread over the tasks of the WorkQueue of Root. Everything
+            else, like updating the skeletons and binding the temporary buffers,
+            still happens one entity after another on the calling thread.
+        */
+        static void _updateAnimations(const vector<Entity*>::type& entities);
+
         /** Tests if any animation applied to this entity.
         @remarks
             An entity is animated if any animation state is enabled, or any manual bone
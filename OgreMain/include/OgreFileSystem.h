@@ -69,6 +69,27 @@ namespace Ogre {
         static bool getIgnoreHidden();
     };
 
+    /** Specialisation of the ArchiveFactory for filesystem folders whose files
+        are mapped into memory when opened read-only.
+    @remarks
+        Files are returned as MappedFileDataStream, so loaders that parse from
+        memory, like Mesh and the image codecs, read straight from the mapping
+        instead of a heap copy of the file. Use the "MappedFileSystem" type
+        for resource locations holding large read-only assets.
+    */
+    class _OgreExport MappedFileSystemArchiveFactory : public ArchiveFactory
+    {
+    public:
+        /// @copydoc FactoryObj::getType
+        const String& getType(void) const;
+
+        using ArchiveFactory::createInstance;
+
+        Archive *createInstance( const String& name, bool readOnly );
+        /// @copydoc FactoryObj::destroyInstance
+        void destroyInstance(Archive* ptr) { OGRE_DELETE ptr; }
+    };
+
     class APKFileSystemArchiveFactory : public ArchiveFactory
     {
     public:
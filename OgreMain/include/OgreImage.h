@@ -406,9 +406,12 @@ namespace Ogre {
             FILTER_NEAREST,
             FILTER_LINEAR,
             FILTER_BILINEAR,
+            /// Averages all source pixels covered by each destination pixel
             FILTER_BOX,
             FILTER_TRIANGLE,
-            FILTER_BICUBIC
+            FILTER_BICUBIC,
+            /// Kaiser windowed sinc, sharper than FILTER_BOX when downsampling
+            FILTER_KAISER
         };
         /** Scale a 1D, 2D or 3D image volume. 
             @param  src         PixelBox containing the source pointer, dimensions and format
@@ -421,6 +424,21 @@ namespace Ogre {
         
         /** Resize a 2D image, applying the appropriate filter. */
         void resize(ushort width, ushort height, Filter filter = FILTER_BILINEAR);
+
+        /** Generates the full mipmap chain of the image on the CPU.
+        @remarks
+            Any mipmaps the image already has are replaced. Every level is
+            filtered from the level above it, kept in float precision, so the
+            whole chain costs about 4/3 of filtering the top level. Faces and
+            the lines of each level are processed in parallel on the WorkQueue
+            of Root, if there is one.
+        @param gammaCorrected Whether the colour channels are sRGB encoded, in
+            which case they are filtered in linear space. Alpha is always
+            filtered as is.
+        @param filter Either FILTER_BOX or FILTER_KAISER.
+        @note Compressed formats are not supported.
+        */
+        Image & generateMipmaps(bool gammaCorrected = false, Filter filter = FILTER_BOX);
         
         /// Static function to calculate size in bytes from the number of mipmaps, faces and the dimensions
         static size_t calculateSize(size_t mipmaps, size_t faces, uint32 width, uint32 height, uint32 depth, PixelFormat format);
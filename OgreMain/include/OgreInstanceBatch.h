@@ -142,6 +142,13 @@ namespace Ogre
         /// When true remove the memory of the IndexData we've created because no one else will
         bool mRemoveOwnIndexData;
 
+        /// Indices in mInstancedEntities of the instances found visible by cullInstances
+        vector<uint32>::type mVisibleInstances;
+        /// Centre and radius of each instance tested by cullInstances
+        vector<float>::type mCullSpheres;
+        /// Scratch list of the spheres that passed in cullInstances
+        vector<uint32>::type mCullResults;
+
         virtual void setupVertices( const SubMesh* baseSubMesh ) = 0;
         virtual void setupIndices( const SubMesh* baseSubMesh ) = 0;
         virtual void createAllInstancedEntities(void);
@@ -161,6 +168,21 @@ namespace Ogre
 
         void updateVisibility(void);
 
+        /** Finds the instances the camera can see, filling mVisibleInstances.
+        @remarks
+            Does the same as calling InstancedEntity::findVisible on every instance,
+            but gathers their bounding spheres first and tests them against the
+            frustum planes several at a time with OptimisedUtil::cullSpheres.
+        @par
+            This is the only place where the batches decide which instances are
+            visible. Subclasses needing a test of their own, per instance or for
+            the whole batch, override this method and fill mVisibleInstances with
+            the indices of the visible instances.
+        @param camera The camera to cull against, or null to just keep the
+            instances which are in the scene and visible.
+        */
+        virtual void cullInstances( Camera *camera );
+
         /** @see _defragmentBatch */
         void defragmentBatchNoCull( InstancedEntityVec &usedEntities, CustomParamsVec &usedParams );
 
@@ -96,9 +96,9 @@ namespace Ogre
         };
 
         typedef vector<InstanceBatch*>::type        InstanceBatchVec;   //vec[batchN] = Batch
-        typedef map<String, InstanceBatchVec>::type InstanceBatchMap;   //map[materialName] = Vec
+        typedef OGRE_HashMap<String, InstanceBatchVec> InstanceBatchMap; //map[materialName] = Vec
 
-        typedef map<String, BatchSettings>::type    BatchSettingsMap;
+        typedef OGRE_HashMap<String, BatchSettings> BatchSettingsMap;
 
         const String            mName;                  //Not the name of the mesh
         MeshPtr                 mMeshReference;
@@ -133,7 +133,11 @@ namespace Ogre
         /// Returns number of 32-bit values written
         size_t getTransforms3x4( float *xform ) const;
 
-        /// Returns true if this InstancedObject is visible to the current camera
+        /** Returns true if this InstancedObject is visible to the current camera
+        @remarks
+            The batches don't call this for each instance, InstanceBatch::cullInstances
+            does the same test for all of them at once and is the method to override.
+        */
         bool findVisible( Camera *camera ) const;
 
         /// Creates/destroys our own skeleton, also tells slaves to unlink if we're destroying
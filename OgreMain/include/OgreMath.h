@@ -463,6 +463,16 @@ namespace Ogre
         }
 
         static void SetRandomValueProvider(RandomValueProvider* provider);
+
+        /** Sets a random value provider for the calling thread only.
+        @remarks
+            While set, it takes precedence over the one passed to SetRandomValueProvider
+            for the random functions called from this thread. This allows tasks running
+            in parallel to use random streams of their own.
+        @param provider The provider to use, or 0 to go back to the shared one.
+        @return The provider previously set for this thread.
+        */
+        static RandomValueProvider* SetThreadRandomValueProvider(RandomValueProvider* provider);
        
         /** Tangent function.
             @param fValue
@@ -820,6 +820,78 @@ namespace Ogre {
             const Affine3* const* blendMatrices, size_t numMatrices,
             bool blendNormals);
 
+        /** Collects software vertex blends, so that many of them can be performed
+            together and in parallel.
+        @remarks
+            Each blend added does the same as softwareVertexBlend, except that the
+            blending itself is deferred to execute, which may spread it over the
+            threads of a WorkQueue. All buffers are locked in add and unlocked in
+            execute, so on the calling thread only, and a buffer used by several
+            blends, like the source data of a mesh shared by many entities, is
+            only locked once.
+        @par
+            The blend matrices passed to add must stay valid until execute returns.
+        */
+        class _OgreExport SoftwareVertexBlendBatch : public AnimationAlloc
+        {
+        public:
+            /// A part of a blend, with the pointers into the locked buffers
+            struct Blend
+            {
+                const float* srcPos;
+                float* destPos;
+                const float* srcNorm;
+                float* destNorm;
+                const float* blendWeight;
+                const unsigned char* blendIndex;
+                size_t srcPosStride, destPosStride;
+                size_t srcNormStride, destNormStride;
+                size_t blendWeightStride, blendIndexStride;
+                size_t numWeightsPerVertex;
+                size_t numVertices;
+                /// Index of the first blend matrix in the batch
+                size_t firstMatrix;
+            };
+
+            SoftwareVertexBlendBatch();
+            /// Unlocks the buffers of blends not executed
+            ~SoftwareVertexBlendBatch();
+
+            /** Adds a blend, the parameters are the same as for softwareVertexBlend.
+            */
+            void add(const VertexData* sourceVertexData,
+                const VertexData* targetVertexData,
+                const Affine3* const* blendMatrices, size_t numMatrices,
+                bool blendNormals);
+
+            /** Performs all blends added since the last call and unlocks their buffers.
+            @param queue
+                If not null, the blends are spread over the tasks of this queue.
+            */
+            void execute(WorkQueue* queue = 0);
+
+            /// Gets whether no blends were added since the last execute
+            bool empty(void) const { return mBlends.empty(); }
+
+            /// Performs the given range of the pending blends, used by execute
+            void _performBlends(size_t begin, size_t end) const;
+
+        private:
+            SoftwareVertexBlendBatch(const SoftwareVertexBlendBatch&); /* do not use */
+            SoftwareVertexBlendBatch& operator=(const SoftwareVertexBlendBatch&); /* do not use */
+
+            /// Locks the buffer, unless this batch locked it already
+            void* lockBuffer(const HardwareVertexBufferSharedPtr& buffer, HardwareBuffer::LockOptions options);
+            void unlockBuffers(void);
+
+            typedef vector<Blend>::type BlendList;
+            BlendList mBlends;
+            typedef vector<const Affine3*>::type BlendMatrixList;
+            BlendMatrixList mBlendMatrices;
+            typedef map<HardwareVertexBuffer*, std::pair<HardwareVertexBufferSharedPtr, void*> >::type LockedBufferMap;
+            LockedBufferMap mLockedBuffers;
+        };
+
         /** Performs a software vertex morph, of the kind used for
             morph animation although it can be used for other purposes. 
         @remarks
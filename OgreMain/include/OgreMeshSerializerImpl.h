@@ -186,7 +186,39 @@ namespace Ogre {
         /// This function can be overloaded to disable validation in debug builds.
         virtual void enableValidation();
 
+        /** Defers reading the payload of a buffer when the stream is held in memory.
+        @remarks
+            If the stream is a MemoryDataStream (including mapped files) and no endian
+            flipping is needed, the buffer is locked and the stream skips the payload,
+            which is copied straight from the stream memory by finishBufferReads.
+        @return Whether the read was deferred, otherwise nothing was done.
+        */
+        bool deferBufferRead(DataStreamPtr& stream, const SharedPtr<HardwareBuffer>& buffer,
+            size_t size);
+        /** Copies the deferred payloads and unlocks their buffers.
+        @remarks
+            Large meshes are copied in parallel on the WorkQueue, so the buffers of
+            the submeshes are filled at the same time.
+        */
+        void finishBufferReads(void);
+        /// Unlocks the buffers of the deferred payloads without copying them
+        void discardBufferReads(void);
+
         ushort exportedLodCount; // Needed to limit exported Edge data, when exporting
+
+        /// A buffer payload waiting to be copied from the stream memory
+        struct PendingBufferRead
+        {
+            SharedPtr<HardwareBuffer> buffer;
+            const uchar* src;
+            void* dest;
+            size_t size;
+        };
+        typedef vector<PendingBufferRead>::type PendingBufferReadList;
+        struct PendingBufferReadTask;
+        PendingBufferReadList mPendingBufferReads;
+        /// Vertex data whose colours are converted once their buffers are filled
+        vector<VertexData*>::type mPendingColourConversions;
     };
 
 
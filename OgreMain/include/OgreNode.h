@@ -225,6 +225,20 @@ namespace Ogre {
         /// User objects binding.
         UserObjectBindings mUserObjectBindings;
 
+        /// Transform store mirroring this node, if any
+        NodeTransformStore* mTransformStore;
+        /// Index of this node in mTransformStore
+        uint32 mTransformStoreIndex;
+
+        /** Class-specific notification that a NodeTransformStore wrote the derived transform.
+        @remarks
+            Counterpart of updateFromParentImpl for nodes which are updated in a batch;
+            the derived members are already up to date when this is called.
+        */
+        virtual void updateFromTransformStoreImpl(void) const {}
+
+        friend class NodeTransformStore;
+
     public:
         /** Constructor, should only be called by parent, not directly.
         @remarks
@@ -572,6 +586,21 @@ namespace Ogre {
         */
         virtual void _update(bool updateChildren, bool parentHasChanged);
 
+        /** Internal method to gather the children an update of this node has to cascade to.
+        @remarks
+            Lets a SceneManager update the children itself, e.g. spread over several
+            threads. Call _update(false, parentHasChanged) first, then this method, and
+            finally _update(true, returned value) on each gathered child. The pending
+            child updates are cleared, as _update(true, parentHasChanged) would do.
+        @param parentHasChanged
+            As passed to _update.
+        @param children
+            Receives the children which need an update.
+        @return
+            The parentHasChanged value to pass on to the gathered children.
+        */
+        bool _collectChildrenToUpdate(bool parentHasChanged, ChildNodeMap& children);
+
         /** Sets a listener for this Node.
         @remarks
             Note for size and performance reasons only one listener per node is
@@ -0,0 +1,162 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef _NodeTransformStore_H__
+#define _NodeTransformStore_H__
+
+#include "OgrePrerequisites.h"
+
+#include "OgreMatrix4.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Scene
+    *  @{
+    */
+    /** Structure-of-arrays storage for the transforms of a Node hierarchy.
+    @remarks
+        The store mirrors the local position, orientation and scale of every
+        Node below a given root in contiguous arrays, ordered breadth-first so
+        that all nodes of one hierarchy level are adjacent and every parent
+        precedes its children. Derived transforms are then computed level by
+        level with a SIMD kernel, instead of recursing through Node::_update.
+    @par
+        Nodes keep their usual interface: any change that calls Node::needUpdate
+        is written through to the store, and after update() the derived values
+        are copied back into the nodes whose transform actually changed, raising
+        the same notifications as Node::_updateFromParent.
+    @par
+        The layout is rebuilt lazily whenever children are added to or removed
+        from a node in the store.
+    @note
+        Not available when OGRE_NODE_INHERIT_TRANSFORM is enabled, since the
+        kernel only composes position, orientation and scale.
+    */
+    class _OgreExport NodeTransformStore : public NodeAlloc
+    {
+    public:
+        typedef vector<Node*>::type NodeList;
+
+        /** Creates a store mirroring the hierarchy below root. */
+        NodeTransformStore(Node* root);
+        ~NodeTransformStore();
+
+        /** Gets the root of the mirrored hierarchy. */
+        Node* getRoot(void) const { return mRoot; }
+
+        /** Recomputes the derived transforms of all changed nodes and
+            propagates the results back into the nodes.
+        */
+        void update(void);
+
+        /** Gets the mirrored nodes in breadth-first order, as of the last update.
+        @remarks
+            Entries may be NULL if the node was destroyed since.
+        */
+        const NodeList& getNodes(void) const { return mNodes; }
+
+        /** Gets the number of hierarchy levels, as of the last update. */
+        size_t getNumLevels(void) const { return mLevelStart.empty() ? 0 : mLevelStart.size() - 1; }
+
+        /** Returns whether the transform of the node at the given index changed
+            during the last update.
+        */
+        bool isTransformChanged(size_t index) const { return (mFlags[index] & FLAG_CHANGED) != 0; }
+
+        /** Returns whether the node at the given index or any of its descendants
+            changed during the last update.
+        @remarks
+            Useful to restrict bottom-up passes such as bounds updates, iterating
+            getNodes() in reverse.
+        */
+        bool isBranchChanged(size_t index) const { return (mFlags[index] & FLAG_BRANCH_CHANGED) != 0; }
+
+        /** Gets the derived transform of the node at the given index. */
+        const Affine3& getDerivedTransform(size_t index) const { return mDerivedTransforms[index]; }
+
+        /// Internal method, called by Node when its local transform changed
+        void _notifyLocalTransformChanged(Node* node);
+        /// Internal method, called by Node when its children changed
+        void _notifyHierarchyChanged(void) { mLayoutDirty = true; }
+        /// Internal method, called by Node on destruction
+        void _notifyNodeDestroyed(Node* node);
+    protected:
+        enum Flags
+        {
+            FLAG_INHERIT_ORIENTATION = 1 << 0,
+            FLAG_INHERIT_SCALE = 1 << 1,
+            FLAG_DIRTY = 1 << 2,
+            FLAG_CHANGED = 1 << 3,
+            FLAG_BRANCH_CHANGED = 1 << 4
+        };
+
+        /// Component arrays of a position, orientation and scale each
+        struct Transforms
+        {
+            vector<Real>::type posX, posY, posZ;
+            vector<Real>::type rotW, rotX, rotY, rotZ;
+            vector<Real>::type sclX, sclY, sclZ;
+
+            void resize(size_t n);
+            void set(size_t i, const Vector3& pos, const Quaternion& orient, const Vector3& scale);
+        };
+
+        Node* mRoot;
+        bool mLayoutDirty;
+
+        /// Nodes in breadth-first order
+        NodeList mNodes;
+        /// Index of the parent of each node, the root refers to itself
+        vector<uint32>::type mParents;
+        /// Combination of Flags for each node
+        vector<uint8>::type mFlags;
+        /// First node of each level, plus one past the last node
+        vector<size_t>::type mLevelStart;
+
+        Transforms mLocal;
+        Transforms mDerived;
+        vector<Affine3>::type mDerivedTransforms;
+
+        /// Rebuilds the breadth-first layout from the current hierarchy
+        void rebuildLayout(void);
+        /// Reads the local transform of a node into the given slot
+        void loadLocal(size_t index, const Node* node);
+        /// Computes derived transforms for [begin, end), all parents must be up to date
+        void updateRange(size_t begin, size_t end);
+    };
+    /** @} */
+    /** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif // _NodeTransformStore_H__
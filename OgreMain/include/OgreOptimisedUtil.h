@@ -203,6 +203,122 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Converts normalised 8 bit components to floats, with exactly the
+            same results as Bitwise::fixedToFloat.
+        @param src Pointer to the source components.
+        @param dst Pointer to the destination floats.
+        @param count Number of components to convert.
+        */
+        virtual void convertUByteToFloat(
+            const uint8* src,
+            float* dst,
+            size_t count) = 0;
+
+        /** Converts floats to normalised 8 bit components, with exactly the
+            same results as Bitwise::floatToFixed.
+        @param src Pointer to the source floats.
+        @param dst Pointer to the destination components.
+        @param count Number of components to convert.
+        */
+        virtual void convertFloatToUByte(
+            const float* src,
+            uint8* dst,
+            size_t count) = 0;
+
+        /** Converts half floats to floats, with exactly the same results as
+            Bitwise::halfToFloat.
+        @param src Pointer to the source half floats.
+        @param dst Pointer to the destination floats.
+        @param count Number of components to convert.
+        */
+        virtual void convertHalfToFloat(
+            const uint16* src,
+            float* dst,
+            size_t count) = 0;
+
+        /** Converts floats to half floats, with exactly the same results as
+            Bitwise::floatToHalf.
+        @param src Pointer to the source floats.
+        @param dst Pointer to the destination half floats.
+        @param count Number of components to convert.
+        */
+        virtual void convertFloatToHalf(
+            const float* src,
+            uint16* dst,
+            size_t count) = 0;
+
+        /** Bilinearly filters one row of 4 channel 8 bit pixels, using the
+            same 12 bit fixed point weights as the byte linear resampler.
+        @param srcRow1 The source row above the destination row.
+        @param srcRow2 The source row below the destination row.
+        @param syf Weight of srcRow2, in 1/4096ths.
+        @param sx1 Per destination pixel, the left source column.
+        @param sx2 Per destination pixel, the right source column.
+        @param sxf Per destination pixel, the weight of the right source
+            column in 1/4096ths.
+        @param dst Pointer to the destination pixels.
+        @param count Number of destination pixels.
+        */
+        virtual void linearResampleRowUByte4(
+            const uint8* srcRow1,
+            const uint8* srcRow2,
+            uint32 syf,
+            const uint32* sx1,
+            const uint32* sx2,
+            const uint32* sxf,
+            uint8* dst,
+            size_t count) = 0;
+
+        /** Adds 8 bit components onto 32 bit accumulators, as used by the
+            box filter.
+        @param src Pointer to the source components.
+        @param accum Pointer to the accumulators.
+        @param count Number of components to accumulate.
+        */
+        virtual void accumulateUBytes(
+            const uint8* src,
+            uint32* accum,
+            size_t count) = 0;
+
+        /** Generates the quads of billboards sharing the same corner offsets,
+            in the vertex layout of BillboardSet.
+        @param centres Pointer to x, y, z and the packed vertex colour (as raw
+            bits) of each billboard.
+        @param texcoords Pointer to the left, top, right and bottom texture
+            coordinates of each billboard.
+        @param offsets Pointer to x, y, z of the left-top, right-top, left-bottom
+            and right-bottom corners relative to the centre, 12 floats.
+        @param dest Pointer receiving four vertices per billboard, each made of
+            the position, the colour and the texture coordinates.
+        @param count Number of billboards.
+        */
+        virtual void generateBillboardQuads(
+            const float* centres,
+            const float* texcoords,
+            const float* offsets,
+            float* dest,
+            size_t count) = 0;
+
+        /** Tests bounding spheres against a set of planes, and writes the
+            indices of the spheres that pass.
+        @remarks
+            A sphere passes unless it lies entirely on the negative side of one
+            of the planes, the same test as Frustum::isVisible(const Sphere&).
+        @param planes Pointer to the normal x, y, z and d of each plane.
+        @param numPlanes Number of planes.
+        @param spheres Pointer to the centre x, y, z and the radius of each sphere.
+        @param visible Pointer receiving the indices of the spheres that pass,
+            in increasing order, must have room for count indices.
+        @param count Number of spheres.
+        @return The number of spheres that pass.
+        */
+        virtual size_t cullSpheres(
+            const float* planes,
+            size_t numPlanes,
+            const float* spheres,
+            uint32* visible,
+            size_t count) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
@@ -146,6 +146,55 @@ namespace Ogre {
         /// Utility method to reset this particle
         void resetDimensions(void);
     };
+
+    /** Structure of arrays view of a run of particles.
+    @remarks
+        ParticleSystem instances which keep their particles in structure of
+        arrays storage (see ParticleSystem::setSoAStorageEnabled) hand their
+        active particles to affectors in this form, with one array per
+        attribute. Entry i of each array belongs to the same particle, so
+        loops over a single attribute walk contiguous memory and can be
+        vectorised by the compiler.
+    @par
+        particles[i] is the Particle instance the entry is mirrored to for
+        the renderer. Its members are not kept up to date while the system
+        is being updated, so affectors working on a batch should only use
+        the arrays.
+    */
+    struct ParticleBatch
+    {
+        /// Number of particles in each array
+        size_t count;
+        /// The Particle instances the arrays are mirrored to
+        Particle* const* particles;
+        /// World (or local, depending on the system) positions
+        Real* positionX;
+        Real* positionY;
+        Real* positionZ;
+        /// Directions (and speed)
+        Real* directionX;
+        Real* directionY;
+        Real* directionZ;
+        /// Current colours
+        float* colourR;
+        float* colourG;
+        float* colourB;
+        float* colourA;
+        /// Seconds left of the particles' natural life
+        Real* timeToLive;
+        /// Seconds of the particles' natural life
+        Real* totalTimeToLive;
+        /// Current rotations in radians
+        Real* rotation;
+        /// Speeds of rotation in radians/sec
+        Real* rotationSpeed;
+        /// Personal widths if ownDimensions is set
+        Real* width;
+        /// Personal heights if ownDimensions is set
+        Real* height;
+        /// Non zero for particles with their own dimensions
+        uint8* ownDimensions;
+    };
     /** @} */
     /** @} */
 }
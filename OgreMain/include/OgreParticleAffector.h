@@ -110,6 +110,24 @@ namespace Ogre {
         */
         virtual void _affectParticles(ParticleSystem* pSystem, Real timeElapsed) = 0;
 
+        /** Method called to allow the affector to 'do it's stuff' on the particles of a system
+            which keeps them in structure of arrays storage.
+        @remarks
+            The default implementation copies the arrays back to the Particle instances, calls
+            the per particle _affectParticles and reads the result back into the arrays. This
+            works for any affector, but is slower than the regular path; affectors which can
+            operate on the arrays directly should override this method.
+        @param
+            pSystem Pointer to the ParticleSystem the batch belongs to.
+        @param
+            batch The particles to affect.
+        @param
+            timeElapsed The number of seconds which have elapsed since the last call.
+        @see
+            ParticleSystem::setSoAStorageEnabled
+        */
+        virtual void _affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed);
+
         /** Returns the name of the type of affector. 
         @remarks
             This property is useful for determining the type of affector procedurally so another
@@ -143,6 +143,13 @@ namespace Ogre {
             String doGet(const void* target) const;
             void doSet(void* target, const String& val);
         };
+        /** Command object for structure of arrays storage (see ParamCommand).*/
+        class CmdSoAStorage : public ParamCommand
+        {
+        public:
+            String doGet(const void* target) const;
+            void doSet(void* target, const String& val);
+        };
 
         /// Default constructor required for STL creation in manager
         ParticleSystem();
@@ -567,6 +574,76 @@ namespace Ogre {
         /// Gets whether particles are sorted relative to the camera.
         bool getSortingEnabled(void) const { return mSorted; }
 
+        /** Sets whether the attributes of the active particles are kept in structure of arrays storage.
+        @remarks
+            By default every particle is updated through its own Particle instance, one
+            at a time. When this is enabled, position, direction, colour, time to live,
+            rotation and dimensions of all active particles are held in one array per
+            attribute instead. Expiry, motion and affectors then work on these arrays
+            (see ParticleAffector::_affectParticleBatch), which is a lot faster for
+            systems with many particles. The arrays are compacted when particles expire.
+        @par
+            The Particle instances are only brought up to date when they are needed,
+            that is when the system is sorted or rendered, or getParticle or _getIterator
+            are called; systems which aren't visible skip this step entirely. Because of
+            this ParticleSystemRenderer::_notifyParticleMoved is deferred until then as
+            well. Changes made to particles obtained through getParticle or _getIterator
+            are picked up by the next update.
+        */
+        void setSoAStorageEnabled(bool enabled);
+        /// Gets whether the particles are kept in structure of arrays storage.
+        bool getSoAStorageEnabled(void) const { return mSoAStorage; }
+
+        /** Internal method writing the structure of arrays storage to the Particle
+            instances and the list of active particles.
+        @remarks
+            Does nothing unless setSoAStorageEnabled(true) was called. This is done
+            automatically before the particles are sorted or rendered.
+        */
+        void _syncParticleInstances(void);
+
+        /** Internal method reading back the Particle instances which may have been
+            changed since the structure of arrays storage was last written.
+        @remarks
+            Does nothing unless setSoAStorageEnabled(true) was called. This is done
+            automatically at the start of every update.
+        */
+        void _syncParticleArrays(void);
+
+        /** Sets the seed of the random stream used while the system is updated in parallel.
+        @remarks
+            When ParticleSystemManager::setParallelUpdatesEnabled is on, the emitters and
+            affectors of this system draw their random numbers (Math::UnitRandom and friends)
+            from a stream of the system's own rather than the shared generator, so the result
+            does not depend on how the systems are spread over the threads. The stream is
+            seeded from the name of the system by default. Setting the seed restarts it.
+        */
+        void setRandomSeed(uint32 seed);
+        /// Gets the seed of the random stream used while the system is updated in parallel.
+        uint32 getRandomSeed(void) const { return mRandomSeed; }
+
+        /** Internal method preparing an update which may run alongside those of other systems.
+        @remarks
+            Used by ParticleSystemManager when parallel updates are enabled. This does the
+            part of _update which has to happen on the calling thread. If it returns true,
+            _updateParallel and then _finishParallelUpdate must follow; if an update is
+            already pending, timeElapsed is added to it and false is returned.
+        @param timeElapsed The amount of time, in seconds, since the last frame.
+        */
+        bool _prepareParallelUpdate(Real timeElapsed);
+
+        /** Internal method moving the particles on after _prepareParallelUpdate.
+        @remarks
+            May be called for several systems at the same time, from any thread.
+            Random numbers are drawn from the stream of the system, see setRandomSeed.
+        */
+        void _updateParallel(void);
+
+        /** Internal method completing an update after _updateParallel, on the thread
+            which called _prepareParallelUpdate.
+        */
+        void _finishParallelUpdate(void);
+
         /** Set the (initial) bounds of the particle system manually. 
         @remarks
             If you can, set the bounds of a particle system up-front and 
@@ -661,6 +738,7 @@ namespace Ogre {
         static CmdLocalSpace msLocalSpaceCmd;
         static CmdIterationInterval msIterationIntervalCmd;
         static CmdNonvisibleTimeout msNonvisibleTimeoutCmd;
+        static CmdSoAStorage msSoAStorageCmd;
 
 
         AxisAlignedBox mAABB;
@@ -703,6 +781,8 @@ namespace Ogre {
         bool mEmittedEmitterPoolInitialised;
         /// Used to control if the particle system should emit particles or not.
         bool mIsEmitting;
+        /// Particles kept in structure of arrays storage?
+        bool mSoAStorage;
 
         typedef list<Particle*>::type ActiveParticleList;
         typedef list<Particle*>::type FreeParticleList;
@@ -728,7 +808,8 @@ namespace Ogre {
             float operator()(Particle* p) const;
         };
 
-        static RadixSort<ActiveParticleList, Particle*, float> mRadixSorter;
+        /// Sorter of the particles, one per system so that systems may be sorted at the same time
+        RadixSort<ActiveParticleList, Particle*, float> mRadixSorter;
 
         /** Active particle list.
             @remarks
@@ -758,6 +839,64 @@ namespace Ogre {
         */
         ParticlePool mParticlePool;
 
+        /** Structure of arrays storage of the active particles.
+        @remarks
+            Only used if setSoAStorageEnabled(true) was called. Entry i of each
+            array belongs to the particle particles[i]. The arrays are kept
+            compact, particles which expire are dropped by moving the following
+            ones down, so they stay in the order they were emitted in.
+        */
+        struct ParticleArrays
+        {
+            vector<Particle*>::type particles;
+            vector<Real>::type positionX, positionY, positionZ;
+            vector<Real>::type directionX, directionY, directionZ;
+            vector<float>::type colourR, colourG, colourB, colourA;
+            vector<Real>::type timeToLive, totalTimeToLive;
+            vector<Real>::type rotation, rotationSpeed;
+            vector<Real>::type width, height;
+            vector<uint8>::type ownDimensions;
+            /// Number of entries in use
+            size_t count;
+
+            ParticleArrays() : count(0) {}
+            /// Adds an entry for p, its attributes are not read yet
+            void append(Particle* p);
+            /// Reads the attributes of entry i from its Particle instance
+            void read(size_t i);
+            /// Writes the attributes of entry i to its Particle instance
+            void write(size_t i) const;
+            /// Moves entry src to dst
+            void move(size_t dst, size_t src);
+            /// Gets a batch for the entries [begin, end)
+            ParticleBatch getBatch(size_t begin, size_t end);
+        };
+
+        /// Structure of arrays storage, see setSoAStorageEnabled
+        ParticleArrays mParticleArrays;
+        /// First entry of mParticleArrays which may be older than its Particle instance
+        size_t mParticleArraysDirtyFrom;
+        /// Have mParticleArrays changed since they were last written to the Particle instances?
+        bool mParticleInstancesOutdated;
+        /// Have particles expired since mActiveParticles was last rewritten from mParticleArrays?
+        bool mActiveParticlesOutdated;
+
+        /// Seed of the random stream, see setRandomSeed
+        uint32 mRandomSeed;
+        /// Current state of the random stream
+        uint32 mRandomState;
+        /// Has _prepareParallelUpdate been called without _finishParallelUpdate?
+        bool mParallelUpdatePending;
+        /// Time elapsed for the pending parallel update, scaled by the speed factor
+        Real mParallelUpdateTime;
+        /// Have the bounds been recalculated by the pending parallel update?
+        bool mParallelBoundsChanged;
+
+        /// Emission requests of the regular emitters, reused by _triggerEmitters
+        vector<unsigned>::type mEmissionRequests;
+        /// Emission requests of the active emitted emitters, reused by _triggerEmitters
+        vector<unsigned>::type mEmittedEmissionRequests;
+
         typedef list<ParticleEmitter*>::type FreeEmittedEmitterList;
         typedef list<ParticleEmitter*>::type ActiveEmittedEmitterList;
         typedef vector<ParticleEmitter*>::type EmittedEmitterList;
@@ -818,6 +957,24 @@ namespace Ogre {
         /// Default nonvisible update timeout
         static Real msDefaultNonvisibleTimeout;
 
+        /** Part of _update checking whether the system needs updating and setting up
+            the renderer, the pools and the transforms of the parent node.
+        @param timeElapsed In: seconds since the last update, out: the time to pass
+            to updateParticles, scaled by the speed factor.
+        @return false if the system is not to be updated.
+        */
+        bool prepareUpdate(Real& timeElapsed);
+
+        /** Part of _update moving the particles on. Once prepareUpdate returned true
+            for each of them, this may run for several systems at the same time.
+        */
+        void updateParticles(Real timeElapsed);
+
+        /** Version of _updateBounds which leaves notifying the parent node to the caller.
+        @return Whether the bounds have been recalculated.
+        */
+        bool calculateBounds(void);
+
         /** Internal method used to expire dead particles. */
         void _expire(Real timeElapsed);
 
@@ -834,6 +991,12 @@ namespace Ogre {
         /** Applies the effects of affectors. */
         void _triggerAffectors(Real timeElapsed);
 
+        /** Version of _expire working on the structure of arrays storage. */
+        void _expireArrays(Real timeElapsed);
+
+        /** Version of _applyMotion working on the structure of arrays storage. */
+        void _applyMotionArrays(Real timeElapsed);
+
         /** Sort the particles in the system **/
         void _sortParticles(Camera* cam);
 
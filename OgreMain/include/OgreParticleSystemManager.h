@@ -99,6 +99,15 @@ namespace Ogre {
         // Factory instance
         ParticleSystemFactory* mFactory;
 
+        /// Update systems in parallel?
+        bool mParallelUpdates;
+
+        typedef vector<std::pair<ParticleSystem*, Real> >::type QueuedUpdateList;
+        /// Updates waiting for _updateQueuedSystems
+        QueuedUpdateList mQueuedUpdates;
+        /// Systems being updated by _updateQueuedSystems
+        vector<ParticleSystem*>::type mDueSystems;
+
         /** Internal script parsing method. */
         void parseNewEmitter(const String& type, DataStreamPtr& chunk, ParticleSystem* sys);
         /** Internal script parsing method. */
@@ -315,6 +324,36 @@ namespace Ogre {
         */
         void _initialise(void);
 
+        /** Sets whether the particle systems are updated in parallel.
+        @remarks
+            By default each particle system is updated by its own controller as soon as
+            the ControllerManager gets to it. When this is enabled, the controllers only
+            queue the updates, and once all controllers are done the due systems are
+            updated at the same time on the WorkQueue, each expiring, emitting, affecting
+            and computing bounds on its own thread.
+        @par
+            While updated this way, every system draws its random numbers from a stream
+            of its own, see ParticleSystem::setRandomSeed, so the outcome is the same
+            whatever the number of threads. Emitters and affectors must not use any other
+            state shared between systems.
+        */
+        void setParallelUpdatesEnabled(bool enabled);
+        /// Gets whether the particle systems are updated in parallel.
+        bool getParallelUpdatesEnabled(void) const { return mParallelUpdates; }
+
+        /** Internal method queuing the update of a system, see setParallelUpdatesEnabled. */
+        void _queueUpdate(ParticleSystem* sys, Real timeElapsed);
+
+        /** Internal method dropping the queued updates of a system which is destroyed. */
+        void _cancelQueuedUpdates(ParticleSystem* sys);
+
+        /** Internal method updating all systems with queued updates in parallel.
+        @remarks
+            Called by ControllerManager::updateAllControllers once all controllers have
+            been updated.
+        */
+        void _updateQueuedSystems(void);
+
         /// @copydoc ScriptLoader::getScriptPatterns
         const StringVector& getScriptPatterns(void) const;
         /// @copydoc ScriptLoader::parseScript
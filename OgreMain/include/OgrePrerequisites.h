@@ -161,12 +161,14 @@ namespace Ogre {
     class MovablePlane;
     class Node;
     class NodeAnimationTrack;
+    class NodeTransformStore;
     class NodeKeyFrame;
     class NumericAnimationTrack;
     class NumericKeyFrame;
     class Particle;
     class ParticleAffector;
     class ParticleAffectorFactory;
+    struct ParticleBatch;
     class ParticleEmitter;
     class ParticleEmitterFactory;
     class ParticleSystem;
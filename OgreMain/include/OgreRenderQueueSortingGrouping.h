@@ -107,6 +107,11 @@ namespace Ogre {
         over a RenderablePass list or a 2-level grouped list which 
         causes a visit call at the Pass level, and a call for each
         Renderable underneath.
+    @par
+        Items are stored in flat lists and ordered by a 64 bit key with a
+        RadixSort in sort(), pass hash and distance for grouping, distance
+        and pass hash for depth sorting. Once the lists have grown to their
+        usual size, queueing a frame costs no allocations.
     */
     class _OgreExport QueuedRenderableCollection : public RenderQueueAlloc
     {
@@ -132,25 +137,6 @@ namespace Ogre {
         };
 
     protected:
-        /// Comparator to order pass groups
-        struct PassGroupLess
-        {
-            bool operator()(const Pass* a, const Pass* b) const
-            {
-                // Sort by passHash, which is pass, then texture unit changes
-                uint32 hasha = a->getHash();
-                uint32 hashb = b->getHash();
-                if (hasha == hashb)
-                {
-                    // Must differentTransparentQueueItemLessiate by pointer incase 2 passes end up with the same hash
-                    return a < b;
-                }
-                else
-                {
-                    return hasha < hashb;
-                }
-            }
-        };
         /// Comparator to order objects by descending camera distance
         struct DepthSortDescendingLess
         {
@@ -192,48 +178,61 @@ namespace Ogre {
          vectors only ever increase in size, so even if we do clear() the memory stays
          allocated, ie fast */
         typedef vector<RenderablePass>::type RenderablePassList;
-        typedef vector<Renderable*>::type RenderableList;
-        /** Map of pass to renderable lists, this is a grouping by pass. */
-        typedef map<Pass*, RenderableList, PassGroupLess>::type PassGroupRenderableMap;
 
-        /// Functor for accessing sort value 1 for radix sort (Pass)
-        struct RadixSortFunctorPass
+        /// Gets the bits of a non-negative depth, which order the same as the depth itself
+        static uint32 getDepthBits(Real depth)
         {
-            uint32 operator()(const RenderablePass& p) const
+            float d = static_cast<float>(depth);
+            uint32 bits;
+            memcpy(&bits, &d, sizeof(bits));
+            return bits;
+        }
+
+        /// Functor for the sort key of grouped items: pass hash, then ascending distance
+        struct RadixSortFunctorPassDistance
+        {
+            const Camera* camera;
+
+            RadixSortFunctorPassDistance(const Camera* cam)
+                : camera(cam)
             {
-                return p.pass->getHash();
             }
-        };
 
-        /// Radix sorter for accessing sort value 1 (Pass)
-        static RadixSort<RenderablePassList, RenderablePass, uint32> msRadixSorter1;
+            uint64 operator()(const RenderablePass& p) const
+            {
+                // near objects first within a pass, so that depth testing rejects more
+                return (static_cast<uint64>(p.pass->getHash()) << 32) |
+                    getDepthBits(p.renderable->getSquaredViewDepth(camera));
+            }
+        };
 
-        /// Functor for descending sort value 2 for radix sort (distance)
-        struct RadixSortFunctorDistance
+        /// Functor for the sort key of sorted items: descending distance, then pass hash
+        struct RadixSortFunctorDistancePass
         {
             const Camera* camera;
 
-            RadixSortFunctorDistance(const Camera* cam)
+            RadixSortFunctorDistancePass(const Camera* cam)
                 : camera(cam)
             {
             }
 
-            float operator()(const RenderablePass& p) const
+            uint64 operator()(const RenderablePass& p) const
             {
-                // Sort DESCENDING by depth (ie far objects first), use negative distance
-                // here because radix sorter always dealing with accessing sort
-                return static_cast<float>(- p.renderable->getSquaredViewDepth(camera));
+                // Sort DESCENDING by depth (ie far objects first), inverting the
+                // depth bits since the radix sorter always sorts ascending
+                return (static_cast<uint64>(~getDepthBits(p.renderable->getSquaredViewDepth(camera))) << 32) |
+                    p.pass->getHash();
             }
         };
 
-        /// Radix sorter for sort value 2 (distance)
-        static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
+        /// Radix sorter for the 64 bit sort keys
+        static RadixSort<RenderablePassList, RenderablePass, uint64> msRadixSorter;
 
         /// Bitmask of the organisation modes requested
         uint8 mOrganisationMode;
 
-        /// Grouped 
-        PassGroupRenderableMap mGrouped;
+        /// Grouped by pass once sorted, by the pass hash of the sort key and then by pass
+        RenderablePassList mGrouped;
         /// Sorted descending (can iterate backwards to get ascending)
         RenderablePassList mSortedDescending;
 
@@ -250,10 +249,10 @@ namespace Ogre {
         /// Empty the collection
         void clear(void);
 
-        /** Remove the group entry (if any) for a given Pass.
+        /** Remove the entries (if any) for a given Pass.
         @remarks
-            To be used when a pass is destroyed, such that any
-            grouping level for it becomes useless.
+            To be used when a pass is destroyed before the collection is
+            cleared. Nothing is kept per pass across clear() calls.
         */  
         void removePassGroup(Pass* p);
         
@@ -281,6 +280,9 @@ namespace Ogre {
         void addRenderable(Pass* pass, Renderable* rend);
         
         /** Perform any sorting that is required on this collection.
+        @remarks
+            Must be called after the last item was added, before
+            acceptVisitor, for any organisation mode.
         @param cam The camera
         */
         void sort(const Camera* cam);
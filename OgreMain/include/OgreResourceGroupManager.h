@@ -294,6 +294,26 @@ namespace Ogre {
         };
         /// List of possible file locations
         typedef vector<ResourceLocation>::type LocationList;
+        /// Progress and throughput of loadResourceGroupPipelined
+        struct PipelineStatistics
+        {
+            /// Number of resources to load
+            size_t resourceCount;
+            /// Number of resources whose source file was read ahead so far
+            size_t readCount;
+            /// Number of resources loaded so far
+            size_t loadedCount;
+            /// Size of the source files of the resources loaded so far, in bytes
+            size_t loadedBytes;
+            /// Most bytes being read, or read but not loaded, at any time
+            size_t peakBytesInFlight;
+            /// Time spent reading ahead, summed over all threads, in microseconds
+            unsigned long readTime;
+            /// Time spent loading on the calling thread, in microseconds
+            unsigned long loadTime;
+            /// Time since the load started, in microseconds
+            unsigned long elapsedTime;
+        };
 
     protected:
         /// Map of resource types (strings) to ResourceManagers, used to notify them to load / unload group contents
@@ -308,6 +328,16 @@ namespace Ogre {
 
         ResourceLoadingListener *mLoadingListener;
 
+        /// Parse the scripts of a group in parallel?
+        bool mParallelScriptParsing;
+
+        /// Statistics of the last loadResourceGroupPipelined
+        PipelineStatistics mPipelineStatistics;
+        /// State shared by loadResourceGroupPipelined and the tasks reading ahead
+        struct PipelineState;
+        /// The state of the running loadResourceGroupPipelined, if any
+        PipelineState* mPipelineState;
+
         /// Resource index entry, resourcename->location 
         typedef map<String, Archive*>::type ResourceLocationIndex;
 
@@ -563,6 +593,35 @@ namespace Ogre {
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
             bool loadWorldGeom = true);
 
+        /** Loads the resources of a group, reading their files in parallel.
+        @remarks
+            Does the same as loadResourceGroup for the main resources of the group,
+            but the source file of each resource is read into memory ahead by tasks
+            on the WorkQueue, while the calling thread prepares and loads the
+            resources in the order loadResourceGroup would use. When a resource
+            opens its own file through openResource, it gets the copy read ahead.
+            Reading runs ahead of loading by at most inFlightBytes, as measured by
+            the size of the source files, but always by at least one resource.
+        @par
+            Only the archives are used from the worker threads: the resource managers
+            are not thread safe in every threading configuration, so Resource::prepare,
+            Resource::load and the listeners all run on the calling thread. While the
+            tasks run, openResource reads any other file into memory as a whole too,
+            one file at a time, since archives are not thread safe. The group is
+            not locked while its resources are loaded, so it must not be changed
+            by other threads meanwhile. If a resource fails to load, the exception
+            is rethrown once no task reads from the archives anymore.
+            The ResourceGroupListener events are fired on the calling thread as with
+            loadResourceGroup, and getPipelineStatistics can be used from them to
+            report the progress. World geometry is not loaded.
+        @param name The name of the resource group to load
+        @param inFlightBytes How many bytes preparing may run ahead of loading
+        */
+        void loadResourceGroupPipelined(const String& name, size_t inFlightBytes = 64 * 1024 * 1024);
+
+        /// Gets the statistics of the current, or last, loadResourceGroupPipelined
+        const PipelineStatistics& getPipelineStatistics(void) const { return mPipelineStatistics; }
+
         /** Unloads a resource group.
         @remarks
             This method unloads all the resources that have been declared as
@@ -1012,6 +1071,13 @@ namespace Ogre {
         */
         ScriptLoader *_findScriptLoader(const String &pattern) const;
 
+        /** Internal method for finding the archive a resource was located in.
+        @param resourceName Fully qualified name of the file
+        @param groupName The name of the resource group to look in
+        @return The archive containing the resource, or 0 if it could not be found
+        */
+        Archive* _getArchiveToResource(const String& resourceName, const String& groupName) const;
+
         /** Internal method for getting a registered ResourceManager.
         @param resourceType String identifying the resource type.
         */
@@ -1074,6 +1140,20 @@ namespace Ogre {
         */      
         const LocationList& getResourceLocationList(const String& groupName) const;
 
+        /** Sets whether the scripts of a group are parsed in parallel.
+        @remarks
+            By default the scripts of a group are read and parsed one after the other
+            when the group is initialised. When this is enabled, all the scripts are
+            read into memory first and each ScriptLoader does the part of the parsing
+            that does not depend on other scripts (see ScriptLoader::_prepareScript)
+            for all of them at the same time on the WorkQueue. Imports, inheritance
+            and the creation of the resources still happen one script at a time, in
+            the usual order and on the calling thread.
+        */
+        void setParallelScriptParsingEnabled(bool enabled) { mParallelScriptParsing = enabled; }
+        /// Gets whether the scripts of a group are parsed in parallel.
+        bool getParallelScriptParsingEnabled(void) const { return mParallelScriptParsing; }
+
         /// Sets a new loading listener
         void setLoadingListener(ResourceLoadingListener *listener);
         /// Returns the current loading listener
@@ -47,6 +47,7 @@ Torus Knot Software Ltd.
 #include "OgreInstanceManager.h"
 #include "OgreRenderSystem.h"
 #include "OgreLodListener.h"
+#include "OgreMesh.h"
 #include "OgreHeaderPrefix.h"
 #include "OgreNameGenerator.h"
 
@@ -428,6 +429,17 @@ namespace Ogre {
         /// Root scene node
         SceneNode* mSceneRoot;
 
+        /// Structure-of-arrays transform store for the scene graph, if enabled
+        NodeTransformStore* mTransformStore;
+
+        /// Whether scene graph update and culling are spread over the WorkQueue
+        bool mParallelSceneGraph;
+        /// Parallel version of the scene graph update, see setParallelSceneGraphEnabled
+        void updateSceneGraphParallel(void);
+        /// Parallel version of the visibility traversal, see setParallelSceneGraphEnabled
+        void findVisibleObjectsParallel(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds,
+            bool onlyShadowCasters);
+
         /// Autotracking scene nodes
         typedef set<SceneNode*>::type AutoTrackingSceneNodes;
         AutoTrackingSceneNodes mAutoTrackingSceneNodes;
@@ -871,6 +883,8 @@ namespace Ogre {
         /// Visibility mask used to show / hide objects
         uint32 mVisibilityMask;
         bool mFindVisibleObjects;
+        /// Collects the software skinning of the entities queued while finding visible objects
+        Mesh::SoftwareVertexBlendBatch* mSoftwareVertexBlendBatch;
 
         /// Suppress render state changes?
         bool mSuppressRenderStateChanges;
@@ -2188,6 +2202,44 @@ namespace Ogre {
         /** Returns true if all scene nodes axis are to be displayed */
         bool getDisplaySceneNodes(void) const {return mDisplayNodes;}
 
+        /** Sets whether the scene graph is updated through a NodeTransformStore.
+        @remarks
+            When enabled, _updateSceneGraph mirrors the transforms of all SceneNodes
+            below the root in contiguous arrays and updates them level by level with
+            SIMD, instead of recursing through SceneNode::_update. This pays off for
+            scenes with many nodes; the SceneNode interface is unchanged either way.
+        @note
+            Not available when OGRE_NODE_INHERIT_TRANSFORM is enabled, nor in
+            scene managers whose SceneNode subclasses extend SceneNode::_update.
+        */
+        virtual void setTransformStoreEnabled(bool enabled);
+        /** Returns whether the scene graph is updated through a NodeTransformStore. */
+        bool isTransformStoreEnabled(void) const { return mTransformStore != 0; }
+
+        /** Sets whether the scene graph is updated and culled on several threads.
+        @remarks
+            When enabled, the scene graph is split into subtrees, going down a few
+            levels from the root SceneNode until there are several per thread. The
+            subtrees are updated and tested against the camera frustum in batches,
+            which the threads of the Root's WorkQueue process alongside the calling
+            thread, while the levels above them are handled on the calling thread.
+            Each batch gathers its visible objects in a list of its own, and the lists
+            are merged into the RenderQueue in order once all batches are done, so the
+            result is the same as the serial traversal.
+        @par
+            Only the generic traversal is affected: the transform store and
+            scene managers overriding _findVisibleObjects keep their own paths. Without
+            thread support, or while the WorkQueue has no running workers, everything
+            runs on the calling thread.
+        @note
+            Node listeners and MovableObject::_notifyMoved may then be called from worker
+            threads. Not available in scene managers whose SceneNode subclasses update
+            shared structures in SceneNode::_update or _updateBounds.
+        */
+        virtual void setParallelSceneGraphEnabled(bool enabled);
+        /** Returns whether the scene graph is updated and culled on several threads. */
+        bool isParallelSceneGraphEnabled(void) const { return mParallelSceneGraph; }
+
         /** Creates an animation which can be used to animate scene nodes.
         @remarks
             An animation is a collection of 'tracks' which over time change the position / orientation
@@ -3218,6 +3270,15 @@ namespace Ogre {
         */
         bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+        /** Gets the batch software skinning is added to, or null if it should
+            be performed right away.
+        @remarks
+            While visible objects are being found, the entities put their software
+            skinning into this batch. It's performed afterwards, spread over the
+            tasks of the WorkQueue of Root.
+        */
+        Mesh::SoftwareVertexBlendBatch* _getSoftwareVertexBlendBatch(void) const { return mSoftwareVertexBlendBatch; }
+
         /** Set whether to automatically normalise normals on objects whenever they
             are scaled.
         @remarks
@@ -77,6 +77,7 @@ namespace Ogre {
         AxisAlignedBox mWorldAABB;
 
         void updateFromParentImpl(void) const;
+        void updateFromTransformStoreImpl(void) const;
 
         /** See Node. */
         Node* createChildImpl(void);
@@ -210,6 +211,32 @@ namespace Ogre {
             VisibleObjectsBoundsInfo* visibleBounds, 
             bool includeChildren = true, bool displayNodes = false, bool onlyShadowCasters = false);
 
+        /** Internal method which gathers the objects _findVisibleObjects would add to the queue.
+            @remarks
+                This only reads the scene graph, so independent subtrees may be processed on
+                several threads, provided the frustum planes of the camera are up to date.
+                The gathered objects must then be passed to RenderQueue::processVisibleObject and
+                the gathered nodes to _addDebugRenderablesToQueue, on the thread owning the queue.
+                To queue everything in the same order as _findVisibleObjects, go through the
+                objects and take the next node whenever a null entry comes.
+            @param
+                cam The active camera
+            @param
+                objects Receives the objects attached to visible nodes, this node and its children
+                included, and a null entry where the debug renderables of each node go
+            @param
+                nodes Receives the visible nodes, each after its children
+        */
+        void _collectVisibleObjects(const Camera* cam, ObjectMap& objects,
+            vector<SceneNode*>::type& nodes);
+
+        /** Internal method which adds the debug display of this node to the queue.
+            @remarks
+                Adds the node axes if displayNodes is set, and the bounding box if it is
+                shown for this node or by the SceneManager. Called by _findVisibleObjects.
+        */
+        void _addDebugRenderablesToQueue(RenderQueue* queue, bool displayNodes);
+
         /** Gets the axis-aligned bounding box of this node (and hence all subnodes).
         @remarks
             Recommended only if you are extending a SceneManager, because the bounding box returned
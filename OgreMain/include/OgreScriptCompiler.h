@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "OgreScriptLoader.h"
 #include "OgreGpuProgram.h"
 #include "OgreAny.h"
+#include "OgreSerializer.h"
 #include "Threading/OgreThreadHeaders.h"
 #include "OgreHeaderPrefix.h"
 
@@ -393,6 +394,36 @@ namespace Ogre
         virtual bool handleEvent(ScriptCompiler *compiler, ScriptCompilerEvent *evt, void *retval);
     };
 
+    /** Serialises concrete syntax trees to and from a compact binary cache.
+    @remarks
+        The cache holds the output of ScriptLexer and ScriptParser together with a
+        hash of the source it was built from, so later runs can skip lexing and
+        parsing as long as the source is unchanged. Caches are written in native
+        endian, they are not meant to be shared between platforms.
+    */
+    class _OgreExport ConcreteNodeListSerializer : public Serializer
+    {
+    public:
+        ConcreteNodeListSerializer();
+
+        /** Writes the given tree to the stream
+        @param nodes The tree to write
+        @param str The script code the tree was parsed from
+        @param stream The stream to write to
+        */
+        void exportConcreteNodeList(const ConcreteNodeListPtr& nodes, const String& str, const DataStreamPtr& stream);
+        /** Reads a tree back from the stream
+        @param stream The stream to read from
+        @param str The current script code, the cache is only used if it was built from it
+        @param source The source the nodes are attributed to (e.g. a script file)
+        @return The cached tree, or a null pointer if the cache is stale or of a different version
+        */
+        ConcreteNodeListPtr importConcreteNodeList(DataStreamPtr& stream, const String& str, const String& source);
+    private:
+        void writeNodes(const ConcreteNodeList& nodes);
+        bool readNodes(DataStreamPtr& stream, ConcreteNodeList& nodes, ConcreteNode* parent, const String& source);
+    };
+
     class ScriptTranslator;
     class ScriptTranslatorManager;
 
@@ -418,6 +449,12 @@ namespace Ogre
 
         // A pointer to the specific compiler instance used
         OGRE_THREAD_POINTER(ScriptCompiler, mScriptCompiler);
+
+        // Whether parsed scripts are cached next to their source
+        bool mScriptCacheEnabled;
+
+        /// Parses the script, going through the binary cache of the resource location
+        ConcreteNodeListPtr parseCached(const String& str, const String& source, const String& group);
     public:
         ScriptCompilerManager();
         virtual ~ScriptCompilerManager();
@@ -449,12 +486,33 @@ namespace Ogre
 		*/
 		uint32 registerCustomWordId(const String &word);
 
+        /** Sets whether parsed scripts are cached in a binary form
+        @remarks
+            When enabled, the parsed form of each script is stored as
+            "<script>.cache" next to the script in its resource location, provided
+            the location is writable. Later runs load the cache instead of lexing
+            and parsing the script again, as long as the script is unchanged.
+            Disabled by default.
+        */
+        void setScriptCacheEnabled(bool enabled);
+        /// Returns whether parsed scripts are cached in a binary form
+        bool getScriptCacheEnabled() const;
+
         /// Adds a script extension that can be handled (e.g. *.material, *.pu, etc.)
         void addScriptPattern(const String &pattern);
         /// @copydoc ScriptLoader::getScriptPatterns
         const StringVector& getScriptPatterns(void) const;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, const String& groupName);
+        /** @copydoc ScriptLoader::_prepareScript
+        @remarks
+            Lexes and parses the script, the order dependent steps are left to
+            _parsePreparedScript. Scripts going through the binary cache are not
+            prepared, as the cache lives in their resource location.
+        */
+        Any _prepareScript(const DataStreamPtr& stream, const String& groupName);
+        /// @copydoc ScriptLoader::_parsePreparedScript
+        void _parsePreparedScript(DataStreamPtr& stream, const String& groupName, const Any& prepared);
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const;
 
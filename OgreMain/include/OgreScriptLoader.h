@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreDataStream.h"
 #include "OgreStringVector.h"
+#include "OgreAny.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -77,6 +78,28 @@ namespace Ogre {
         */
         virtual void parseScript(DataStreamPtr& stream, const String& groupName) = 0;
 
+        /** Does the part of parsing a script that is independent of all other scripts.
+        @remarks
+            Called from worker threads for every script of a group before any of them
+            is passed to _parsePreparedScript, if ResourceGroupManager parses scripts
+            in parallel. Only the stream may be touched, and it must be left at its
+            start. The default does nothing.
+        @param stream In-memory copy of the script
+        @param groupName The name of the resource group the script belongs to
+        @return Whatever _parsePreparedScript needs to finish the script
+        */
+        virtual Any _prepareScript(const DataStreamPtr& stream, const String& groupName) { return Any(); }
+
+        /** Parse a script file with the result of _prepareScript.
+        @remarks
+            Called in the usual script order on the thread initialising the group.
+            The default ignores the prepared data and calls parseScript.
+        */
+        virtual void _parsePreparedScript(DataStreamPtr& stream, const String& groupName, const Any& prepared)
+        {
+            parseScript(stream, groupName);
+        }
+
         /** Gets the relative loading order of scripts of this type.
         @remarks
             There are dependencies between some kinds of scripts, and to enforce
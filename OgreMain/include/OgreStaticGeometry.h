@@ -151,9 +151,11 @@ namespace Ogre {
         {
             VertexData* vertexData;
             IndexData* indexData;
+            /// Packed string identifying the vertex / index format, see MaterialBucket
+            String formatString;
         };
         typedef vector<SubMeshLodGeometryLink>::type SubMeshLodGeometryLinkList;
-        typedef map<SubMesh*, SubMeshLodGeometryLinkList*>::type SubMeshGeometryLookup;
+        typedef OGRE_HashMap<SubMesh*, SubMeshLodGeometryLinkList*> SubMeshGeometryLookup;
         /// Structure recording a queued submesh for the build
         struct QueuedSubMesh : public BatchedGeometryAlloc
         {
@@ -177,6 +179,8 @@ namespace Ogre {
             Vector3 scale;
         };
         typedef vector<QueuedGeometry*>::type QueuedGeometryList;
+        /// Source buffers locked for a build, with the pointer to their data
+        typedef OGRE_HashMap<HardwareBuffer*, uchar*> SourceBufferLockMap;
         
         // forward declarations
         class LODBucket;
@@ -206,6 +210,10 @@ namespace Ogre {
             HardwareIndexBuffer::IndexType mIndexType;
             /// Maximum vertex indexable
             size_t mMaxVertexIndex;
+            /// Destination index data, while locked for the build
+            void* mIndexLock;
+            /// Destination vertex data of each buffer, while locked for the build
+            vector<uchar*>::type mVertexLocks;
 
             template<typename T>
             void copyIndexes(const T* src, T* dst, size_t count, size_t indexOffset)
@@ -246,6 +254,22 @@ namespace Ogre {
             bool assign(QueuedGeometry* qsm);
             /// Build
             void build(bool stencilShadows);
+            /** Creates and locks the buffers of this bucket, the first step of build. */
+            void _lockBuffers(bool stencilShadows);
+            /** Locks the buffers the queued geometry is copied from.
+            @remarks
+                Buffers already in sourceLocks are not locked again, so the source
+                buffers of several buckets can be locked at once.
+            */
+            void _lockSourceBuffers(SourceBufferLockMap& sourceLocks);
+            /** Copies the queued geometry into the locked buffers.
+            @remarks
+                Writes to the buffers of this bucket only, so several buckets can
+                be filled at the same time on different threads.
+            */
+            void _copyGeometry(const SourceBufferLockMap& sourceLocks);
+            /** Unlocks the buffers of this bucket, the last step of build. */
+            void _unlockBuffers(bool stencilShadows);
             /// Dump contents for diagnostics
             void dump(std::ofstream& of) const;
         };
@@ -269,7 +293,7 @@ namespace Ogre {
             /// list of Geometry Buckets in this region
             GeometryBucketList mGeometryBucketList;
             // index to current Geometry Buckets for a given geometry format
-            typedef map<String, GeometryBucket*>::type CurrentGeometryMap;
+            typedef OGRE_HashMap<String, GeometryBucket*> CurrentGeometryMap;
             CurrentGeometryMap mCurrentGeometryMap;
             /// Get a packed string identifying the geometry format
             String getGeometryFormatString(SubMeshLodGeometryLink* geom);
@@ -520,6 +544,9 @@ namespace Ogre {
         /// Map of regions
         RegionMap mRegionMap;
 
+        /// Buckets waiting to be filled at the end of build, 0 outside of build
+        MaterialBucket::GeometryBucketList* mDeferredBuckets;
+
         /** Virtual method for getting a region most suitable for the
             passed in bounds. Can be overridden by subclasses.
         */
@@ -79,6 +79,20 @@ namespace Ogre
         /// Numeric identifier for a request
         typedef unsigned long long int RequestID;
 
+        /// A unit of work for addTask, it must not throw
+        typedef std::function<void()> Task;
+        /// A body for parallelFor, processing the indices [begin, end)
+        typedef std::function<void(size_t, size_t)> RangeTask;
+
+        /// Scheduling priority of a Task
+        enum TaskPriority
+        {
+            TASK_PRIORITY_HIGH = 0,
+            TASK_PRIORITY_NORMAL = 1,
+            TASK_PRIORITY_LOW = 2,
+            TASK_PRIORITY_COUNT = 3
+        };
+
         /** General purpose request structure. 
         */
         class _OgreExport Request : public UtilityAlloc
@@ -363,6 +377,43 @@ namespace Ogre
         */
         virtual uint16 getChannel(const String& channelName);
 
+        /** Add a lightweight task to be run by the worker threads.
+        @remarks
+            Unlike requests, tasks bypass handlers and responses entirely, which
+            makes them cheap enough for fine-grained parallel work. Tasks of a
+            higher priority are started before any task of a lower one; there
+            is no ordering between tasks of the same priority. Any result must
+            be passed back by the task itself.
+        @par
+            The default implementation runs the task immediately on the calling
+            thread, as does any queue which is not running. Tasks still pending
+            when the queue shuts down are discarded, like requests.
+        */
+        virtual void addTask(const Task& task, TaskPriority priority = TASK_PRIORITY_NORMAL) { task(); }
+
+        /** Gets the number of threads tasks are run on concurrently to the
+            calling thread, 0 if addTask is synchronous.
+        */
+        virtual size_t getTaskConcurrency(void) const { return 0; }
+
+        /** Runs body over the range [begin, end) in parallel and waits for it.
+        @remarks
+            The range is split into chunks of grainSize indices, which are handed
+            out to the calling thread and up to getTaskConcurrency() tasks, so
+            the call may be nested within another task. Chunks are processed in
+            no particular order.
+        @param begin, end The range of indices to process.
+        @param grainSize Number of indices per chunk, 0 to choose one from the
+            available concurrency.
+        @param body Called with the bounds of each chunk.
+        @param priority The priority of the helper tasks.
+        @note
+            The first exception thrown by body is rethrown on the calling thread,
+            once all chunks being processed have finished; chunks not yet started
+            are skipped.
+        */
+        void parallelFor(size_t begin, size_t end, size_t grainSize, const RangeTask& body,
+                         TaskPriority priority = TASK_PRIORITY_NORMAL);
     };
 
     /** Base for a general purpose request / response style background work queue.
@@ -431,6 +482,9 @@ namespace Ogre
         /** Returns whether the queue is trying to shut down. */
         virtual bool isShuttingDown() const { return mShuttingDown; }
 
+        /** Returns whether the queue has been started up and not shut down since. */
+        bool isRunning() const { return mIsRunning; }
+
         /// @copydoc WorkQueue::addRequestHandler
         virtual void addRequestHandler(uint16 channel, RequestHandler* rh);
         /// @copydoc WorkQueue::removeRequestHandler
@@ -35,7 +35,8 @@ THE SOFTWARE
 #elif OGRE_THREAD_PROVIDER == 3
     #include "OgreDefaultWorkQueueTBB.h"
 #elif OGRE_THREAD_PROVIDER == 4
-	#include "OgreDefaultWorkQueueStandard.h"
+    #include "OgreDefaultWorkQueueStandard.h"
+    #include "OgreDefaultWorkQueueStealing.h"
 #endif
 
 #endif
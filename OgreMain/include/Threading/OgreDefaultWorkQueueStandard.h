@@ -51,7 +51,18 @@ namespace Ogre
         /// @copydoc WorkQueue::startup
         virtual void startup(bool forceRestart = true);
 
+        /// @copydoc WorkQueue::addTask
+        virtual void addTask(const Task& task, TaskPriority priority = TASK_PRIORITY_NORMAL);
+
+        /// @copydoc WorkQueue::getTaskConcurrency
+        virtual size_t getTaskConcurrency(void) const;
+
     protected:
+        /** Runs the pending task of the highest priority, if there is any.
+        @return Whether a task was run.
+        */
+        bool processNextTask(void);
+
         /** To be called by a separate thread; will return immediately if there
             are items in the queue, or suspend the thread until new items are added
             otherwise.
@@ -70,6 +81,8 @@ namespace Ogre
         OGRE_WQ_THREAD_SYNCHRONISER(mInitSync);
 
         OGRE_WQ_THREAD_SYNCHRONISER(mRequestCondition);
+        /// Pending tasks of each priority, guarded by mRequestMutex
+        deque<Task>::type mTasks[TASK_PRIORITY_COUNT];
 #if OGRE_THREAD_SUPPORT
         typedef vector<OGRE_THREAD_TYPE*>::type WorkerThreadList;
         WorkerThreadList mWorkers;
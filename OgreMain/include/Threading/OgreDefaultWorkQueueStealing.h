@@ -0,0 +1,127 @@
+/*-------------------------------------------------------------------------
+This source file is a part of OGRE
+(Object-oriented Graphics Rendering Engine)
+
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+-------------------------------------------------------------------------*/
+#ifndef __OgreDefaultWorkQueueStealing_H__
+#define __OgreDefaultWorkQueueStealing_H__
+
+#include "../OgreWorkQueue.h"
+
+namespace Ogre
+{
+    /** Implementation of a general purpose request / response style background work queue,
+        which schedules tasks by work stealing.
+    @remarks
+        Every worker thread owns one deque of tasks per priority. Tasks added by a worker
+        go to the back of its own deques and are taken back from there, so nested work
+        stays on the thread which created it, while idle workers steal from the front of
+        the other workers' deques. Tasks added by other threads are spread over the workers
+        in turn. Each deque is only contended by its owner and the occasional thief,
+        instead of every thread meeting on a single queue.
+    @par
+        Requests are still served through the shared queue of DefaultWorkQueueBase,
+        whenever a worker finds no task to run.
+    @par
+        Only available with OGRE_THREAD_PROVIDER = 4. Root uses it instead of
+        DefaultWorkQueue when OGRE_THREAD_WORK_STEALING is set.
+    */
+    class _OgreExport StealingWorkQueue : public DefaultWorkQueueBase
+    {
+    public:
+
+        StealingWorkQueue(const String& name = BLANKSTRING);
+        virtual ~StealingWorkQueue(); 
+
+        /// Main function for each thread spawned.
+        virtual void _threadMain();
+
+        /// @copydoc WorkQueue::shutdown
+        virtual void shutdown();
+
+        /// @copydoc WorkQueue::startup
+        virtual void startup(bool forceRestart = true);
+
+        /// @copydoc WorkQueue::addTask
+        virtual void addTask(const Task& task, TaskPriority priority = TASK_PRIORITY_NORMAL);
+
+        /// @copydoc WorkQueue::getTaskConcurrency
+        virtual size_t getTaskConcurrency(void) const;
+
+    protected:
+        /// The tasks owned by one worker thread
+        struct TaskDeque : public UtilityAlloc
+        {
+            OGRE_WQ_MUTEX(mutex);
+            deque<Task>::type tasks[TASK_PRIORITY_COUNT];
+        };
+        typedef vector<TaskDeque*>::type TaskDequeList;
+
+        /// Takes a task from the deques of the given worker, or steals one from the others
+        bool popTask(size_t worker, Task& task);
+
+        /// Returns whether there are requests a worker could process
+        bool hasPendingRequests(void);
+
+        /** To be called by a worker thread; suspends the thread until new work is added,
+            unless some was added since wakeCount was read from mWakeCount.
+        */
+        void waitForWork(size_t wakeCount);
+
+        /// Wakes up one or all sleeping workers
+        void wakeWorkers(bool all);
+
+        /// Notify that a thread has registered itself with the render system
+        virtual void notifyThreadRegistered();
+
+        virtual void notifyWorkers();
+
+        TaskDequeList mTaskDeques;
+        /// Worker whose deques receive the next task added by another thread
+        AtomicScalar<size_t> mNextDeque;
+        /// Index for the next worker thread to start
+        AtomicScalar<size_t> mNextWorker;
+        /// Number of queued tasks of each priority, so empty priorities are skipped
+        AtomicScalar<size_t> mPendingTasks[TASK_PRIORITY_COUNT];
+        /// Incremented whenever work is added, so that sleeping workers never miss any
+        AtomicScalar<size_t> mWakeCount;
+        /// Workers in or about to enter waitForWork
+        AtomicScalar<size_t> mSleepingWorkers;
+        OGRE_WQ_MUTEX(mWakeMutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(mWakeSync);
+
+        size_t mNumThreadsRegisteredWithRS;
+        /// Init notification mutex (must lock before waiting on initCondition)
+        OGRE_WQ_MUTEX(mInitMutex);
+        /// Synchroniser token to wait / notify on thread init 
+        OGRE_WQ_THREAD_SYNCHRONISER(mInitSync);
+
+#if OGRE_THREAD_SUPPORT
+        typedef vector<OGRE_THREAD_TYPE*>::type WorkerThreadList;
+        WorkerThreadList mWorkers;
+#endif
+    };
+
+}
+
+#endif
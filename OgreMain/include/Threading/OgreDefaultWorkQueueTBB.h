@@ -64,6 +64,14 @@ namespace Ogre
         /// Register the current thread with the rendersystem
         void _registerThreadWithRenderSystem();
 
+        /** @copydoc WorkQueue::addTask
+        @note tbb::task_group has no priorities, so priority is ignored.
+        */
+        virtual void addTask(const Task& task, TaskPriority priority = TASK_PRIORITY_NORMAL);
+
+        /// @copydoc WorkQueue::getTaskConcurrency
+        virtual size_t getTaskConcurrency(void) const;
+
     protected:
         virtual void notifyWorkers();
 
@@ -133,7 +133,9 @@ namespace Ogre {
         Vector3 bboxMax = Math::NEG_INFINITY * Vector3::UNIT_SCALE;
         Real radius = 0.0f;
         mBillboardSet->beginBillboards(currentParticles.size());
-        Billboard bb;
+        mBillboards.resize(currentParticles.size());
+        mBillboardPointers.resize(currentParticles.size());
+        size_t index = 0;
         Affine3 invWorld;
 
         if (mBillboardSet->getBillboardsInWorldSpace() && mBillboardSet->getParentSceneNode())
@@ -143,6 +145,7 @@ namespace Ogre {
             i != currentParticles.end(); ++i)
         {
             Particle* p = *i;
+            Billboard& bb = mBillboards[index];
             bb.mPosition = p->mPosition;
             Vector3 pos = p->mPosition;
 
@@ -168,10 +171,12 @@ namespace Ogre {
                 bb.mWidth = p->mWidth;
                 bb.mHeight = p->mHeight;
             }
-            mBillboardSet->injectBillboard(bb);
-
+            mBillboardPointers[index++] = &bb;
         }
 
+        if (!mBillboardPointers.empty())
+            mBillboardSet->injectBillboards(&mBillboardPointers[0], mBillboardPointers.size());
+
         // Only set bounds if there are any active particles
         if(currentParticles.size())
             mBillboardSet->setBounds( AxisAlignedBox( bboxMin, bboxMax ), radius );
@@ -29,13 +29,31 @@ THE SOFTWARE.
 
 #include "OgreBillboardSet.h"
 #include "OgreBillboard.h"
+#include "OgreOptimisedUtil.h"
 
 #include <algorithm>
 
 namespace Ogre {
-    // Init statics
-    RadixSort<BillboardSet::ActiveBillboardList, Billboard*, float> BillboardSet::mRadixSorter;
+    namespace
+    {
+        /// Number of billboards per chunk when injectBillboards runs on several threads
+        const size_t BILLBOARD_GRAIN_SIZE = 1024;
+
+        /// Generates the vertices of a range of billboards, for WorkQueue::parallelFor
+        struct BillboardVertexTask
+        {
+            const BillboardSet* set;
+            const Billboard* const* billboards;
+            float* dest;
+            size_t floatsPerBillboard;
 
+            void operator()(size_t begin, size_t end) const
+            {
+                set->_genVertices(billboards + begin, end - begin,
+                    dest + begin * floatsPerBillboard);
+            }
+        };
+    }
     //-----------------------------------------------------------------------
     BillboardSet::BillboardSet() :
         mBoundingRadius(0.0f), 
@@ -523,6 +541,153 @@ namespace Ogre {
         mNumVisibleBillboards++;
     }
     //-----------------------------------------------------------------------
+    void BillboardSet::injectBillboards(const Billboard* const* billboards, size_t count)
+    {
+        // Culling and the pool limit are dealt with first, on this thread
+        size_t freeBillboards = mPoolSize - mNumVisibleBillboards;
+        if (mCullIndividual)
+        {
+            mInjectedBillboards.clear();
+            for (size_t i = 0; i < count && mInjectedBillboards.size() < freeBillboards; ++i)
+            {
+                if (billboardVisible(mCurrentCamera, *billboards[i]))
+                    mInjectedBillboards.push_back(billboards[i]);
+            }
+            count = mInjectedBillboards.size();
+            billboards = count ? &mInjectedBillboards[0] : 0;
+        }
+        else
+        {
+            count = std::min(count, freeBillboards);
+        }
+        if (!count)
+            return;
+
+        size_t floatsPerBillboard = mMainBuf->getVertexSize() / sizeof(float);
+        if (!mPointRendering)
+            floatsPerBillboard *= 4;
+
+        // Each chunk writes its own range of the locked buffer
+        WorkQueue* queue = Root::getSingleton().getWorkQueue();
+        if (count > BILLBOARD_GRAIN_SIZE && queue->getTaskConcurrency())
+        {
+            BillboardVertexTask task = {this, billboards, mLockPtr, floatsPerBillboard};
+            queue->parallelFor(0, count, BILLBOARD_GRAIN_SIZE, task);
+        }
+        else
+        {
+            _genVertices(billboards, count, mLockPtr);
+        }
+
+        mLockPtr += count * floatsPerBillboard;
+        mNumVisibleBillboards += static_cast<unsigned short>(count);
+    }
+    //-----------------------------------------------------------------------
+    void BillboardSet::_genVertices(const Billboard* const* billboards, size_t count, float* pDest) const
+    {
+        // Billboards using the precalculated offsets without rotation are gathered
+        // into runs for OptimisedUtil, the others are generated one by one
+        const size_t maxRunSize = 64;
+        float centres[maxRunSize * 4];
+        float texcoords[maxRunSize * 4];
+        size_t runSize = 0;
+        float* runDest = pDest;
+
+        // Same conversion as Root::convertColourValue, done once for the whole range
+        RenderSystem* rs = Root::getSingleton().getRenderSystem();
+        const VertexElementType colourType = rs ?
+            rs->getColourVertexElementType() : VertexElement::getBestColourVertexElementType();
+        const bool perBillboardAxes = !mPointRendering &&
+            (mBillboardType == BBT_ORIENTED_SELF ||
+            mBillboardType == BBT_PERPENDICULAR_SELF ||
+            (mAccurateFacing && mBillboardType != BBT_PERPENDICULAR_COMMON));
+        Vector3 camDir = mCamDir;
+        float offsets[12];
+        for (size_t corner = 0; corner < 4; ++corner)
+        {
+            offsets[corner * 3 + 0] = mVOffset[corner].x;
+            offsets[corner * 3 + 1] = mVOffset[corner].y;
+            offsets[corner * 3 + 2] = mVOffset[corner].z;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Billboard& bb = *billboards[i];
+            RGBA colour = VertexElement::convertColourValue(bb.mColour, colourType);
+
+            if (!mPointRendering && !perBillboardAxes &&
+                (mAllDefaultSize || !bb.mOwnDimensions) &&
+                (mAllDefaultRotation || bb.mRotation == Radian(0)))
+            {
+                assert( bb.mUseTexcoordRect || bb.mTexcoordIndex < mTextureCoords.size() );
+                const FloatRect& r =
+                    bb.mUseTexcoordRect ? bb.mTexcoordRect : mTextureCoords[bb.mTexcoordIndex];
+
+                float* centre = centres + runSize * 4;
+                centre[0] = bb.mPosition.x;
+                centre[1] = bb.mPosition.y;
+                centre[2] = bb.mPosition.z;
+                memcpy(centre + 3, &colour, sizeof(RGBA));
+                float* rect = texcoords + runSize * 4;
+                rect[0] = r.left;
+                rect[1] = r.top;
+                rect[2] = r.right;
+                rect[3] = r.bottom;
+
+                if (++runSize == maxRunSize)
+                {
+                    OptimisedUtil::getImplementation()->generateBillboardQuads(
+                        centres, texcoords, offsets, runDest, runSize);
+                    runDest += runSize * 24;
+                    runSize = 0;
+                }
+                continue;
+            }
+
+            // Flush the run before this billboard
+            if (runSize)
+            {
+                OptimisedUtil::getImplementation()->generateBillboardQuads(
+                    centres, texcoords, offsets, runDest, runSize);
+                runDest += runSize * 24;
+                runSize = 0;
+            }
+
+            if (perBillboardAxes)
+            {
+                // Have to generate axes & offsets per billboard
+                Vector3 camX, camY;
+                Vector3 vOwnOffset[4];
+                genBillboardAxes(&camX, &camY, &bb, camDir);
+                if (mAllDefaultSize)
+                    genVertOffsets(mLeftOff, mRightOff, mTopOff, mBottomOff,
+                        mDefaultWidth, mDefaultHeight, camX, camY, vOwnOffset);
+                else
+                    genVertOffsets(mLeftOff, mRightOff, mTopOff, mBottomOff,
+                        bb.mWidth, bb.mHeight, camX, camY, vOwnOffset);
+                genVertices(vOwnOffset, bb, colour, runDest);
+            }
+            else if (!mPointRendering && !mAllDefaultSize && bb.mOwnDimensions)
+            {
+                // Generate using own dimensions
+                Vector3 vOwnOffset[4];
+                genVertOffsets(mLeftOff, mRightOff, mTopOff, mBottomOff,
+                    bb.mWidth, bb.mHeight, mCamX, mCamY, vOwnOffset);
+                genVertices(vOwnOffset, bb, colour, runDest);
+            }
+            else
+            {
+                genVertices(mVOffset, bb, colour, runDest);
+            }
+        }
+
+        if (runSize)
+        {
+            OptimisedUtil::getImplementation()->generateBillboardQuads(
+                centres, texcoords, offsets, runDest, runSize);
+        }
+    }
+    //-----------------------------------------------------------------------
     void BillboardSet::endBillboards(void)
     {
         mMainBuf->unlock();
@@ -598,14 +763,11 @@ namespace Ogre {
                 _sortBillboards(mCurrentCamera);
             }
 
+            mBatchBillboards.assign(mActiveBillboards.begin(), mActiveBillboards.end());
+
             beginBillboards(mActiveBillboards.size());
-            ActiveBillboardList::iterator it;
-            for(it = mActiveBillboards.begin();
-                it != mActiveBillboards.end();
-                ++it )
-            {
-                injectBillboard(*(*it));
-            }
+            if (!mBatchBillboards.empty())
+                injectBillboards(&mBatchBillboards[0], mBatchBillboards.size());
             endBillboards();
             mBillboardDataChanged = false;
         }
@@ -1005,6 +1167,12 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     void BillboardSet::genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* bb)
+    {
+        genBillboardAxes(pX, pY, bb, mCamDir);
+    }
+    //-----------------------------------------------------------------------
+    void BillboardSet::genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* bb,
+        Vector3& camDir) const
     {
         // If we're using accurate facing, recalculate camera direction per BB
         if (mAccurateFacing && 
@@ -1013,8 +1181,8 @@ namespace Ogre {
             mBillboardType == BBT_ORIENTED_SELF))
         {
             // cam -> bb direction
-            mCamDir = bb->mPosition - mCamPos;
-            mCamDir.normalise();
+            camDir = bb->mPosition - mCamPos;
+            camDir.normalise();
         }
 
 
@@ -1026,9 +1194,9 @@ namespace Ogre {
                 // Point billboards will have 'up' based on but not equal to cameras
                 // Use pY temporarily to avoid allocation
                 *pY = mCamQ * Vector3::UNIT_Y;
-                *pX = mCamDir.crossProduct(*pY);
+                *pX = camDir.crossProduct(*pY);
                 pX->normalise();
-                *pY = pX->crossProduct(mCamDir); // both normalised already
+                *pY = pX->crossProduct(camDir); // both normalised already
             }
             else
             {
@@ -1042,7 +1210,7 @@ namespace Ogre {
             // Y-axis is common direction
             // X-axis is cross with camera direction
             *pY = mCommonDirection;
-            *pX = mCamDir.crossProduct(*pY);
+            *pX = camDir.crossProduct(*pY);
             pX->normalise();
             break;
 
@@ -1051,7 +1219,7 @@ namespace Ogre {
             // X-axis is cross with camera direction
             // Scale direction first
             *pY = bb->mDirection;
-            *pX = mCamDir.crossProduct(*pY);
+            *pX = camDir.crossProduct(*pY);
             pX->normalise();
             break;
 
@@ -1113,6 +1281,12 @@ namespace Ogre {
     {
         RGBA colour;
         Root::getSingleton().convertColourValue(bb.mColour, &colour);
+        genVertices(offsets, bb, colour, mLockPtr);
+    }
+    //-----------------------------------------------------------------------
+    void BillboardSet::genVertices(
+        const Vector3* const offsets, const Billboard& bb, RGBA colour, float*& pDest) const
+    {
         RGBA* pCol;
 
         // Texcoords
@@ -1124,78 +1298,78 @@ namespace Ogre {
         {
             // Single vertex per billboard, ignore offsets
             // position
-            *mLockPtr++ = bb.mPosition.x;
-            *mLockPtr++ = bb.mPosition.y;
-            *mLockPtr++ = bb.mPosition.z;
+            *pDest++ = bb.mPosition.x;
+            *pDest++ = bb.mPosition.y;
+            *pDest++ = bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // No texture coords in point rendering
         }
         else if (mAllDefaultRotation || bb.mRotation == Radian(0))
         {
             // Left-top
             // Positions
-            *mLockPtr++ = offsets[0].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[0].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[0].z + bb.mPosition.z;
+            *pDest++ = offsets[0].x + bb.mPosition.x;
+            *pDest++ = offsets[0].y + bb.mPosition.y;
+            *pDest++ = offsets[0].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.left;
+            *pDest++ = r.top;
 
             // Right-top
             // Positions
-            *mLockPtr++ = offsets[1].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[1].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[1].z + bb.mPosition.z;
+            *pDest++ = offsets[1].x + bb.mPosition.x;
+            *pDest++ = offsets[1].y + bb.mPosition.y;
+            *pDest++ = offsets[1].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.right;
+            *pDest++ = r.top;
 
             // Left-bottom
             // Positions
-            *mLockPtr++ = offsets[2].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[2].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[2].z + bb.mPosition.z;
+            *pDest++ = offsets[2].x + bb.mPosition.x;
+            *pDest++ = offsets[2].y + bb.mPosition.y;
+            *pDest++ = offsets[2].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.left;
+            *pDest++ = r.bottom;
 
             // Right-bottom
             // Positions
-            *mLockPtr++ = offsets[3].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[3].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[3].z + bb.mPosition.z;
+            *pDest++ = offsets[3].x + bb.mPosition.x;
+            *pDest++ = offsets[3].y + bb.mPosition.y;
+            *pDest++ = offsets[3].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.right;
+            *pDest++ = r.bottom;
         }
         else if (mRotationType == BBR_VERTEX)
         {
@@ -1210,66 +1384,66 @@ namespace Ogre {
             // Left-top
             // Positions
             pt = rotation * offsets[0];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.left;
+            *pDest++ = r.top;
 
             // Right-top
             // Positions
             pt = rotation * offsets[1];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.right;
+            *pDest++ = r.top;
 
             // Left-bottom
             // Positions
             pt = rotation * offsets[2];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.left;
+            *pDest++ = r.bottom;
 
             // Right-bottom
             // Positions
             pt = rotation * offsets[3];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.right;
+            *pDest++ = r.bottom;
         }
         else
         {
@@ -1288,69 +1462,69 @@ namespace Ogre {
 
             // Left-top
             // Positions
-            *mLockPtr++ = offsets[0].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[0].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[0].z + bb.mPosition.z;
+            *pDest++ = offsets[0].x + bb.mPosition.x;
+            *pDest++ = offsets[0].y + bb.mPosition.y;
+            *pDest++ = offsets[0].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = mid_u - cos_rot_w + sin_rot_h;
-            *mLockPtr++ = mid_v - sin_rot_w - cos_rot_h;
+            *pDest++ = mid_u - cos_rot_w + sin_rot_h;
+            *pDest++ = mid_v - sin_rot_w - cos_rot_h;
 
             // Right-top
             // Positions
-            *mLockPtr++ = offsets[1].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[1].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[1].z + bb.mPosition.z;
+            *pDest++ = offsets[1].x + bb.mPosition.x;
+            *pDest++ = offsets[1].y + bb.mPosition.y;
+            *pDest++ = offsets[1].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = mid_u + cos_rot_w + sin_rot_h;
-            *mLockPtr++ = mid_v + sin_rot_w - cos_rot_h;
+            *pDest++ = mid_u + cos_rot_w + sin_rot_h;
+            *pDest++ = mid_v + sin_rot_w - cos_rot_h;
 
             // Left-bottom
             // Positions
-            *mLockPtr++ = offsets[2].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[2].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[2].z + bb.mPosition.z;
+            *pDest++ = offsets[2].x + bb.mPosition.x;
+            *pDest++ = offsets[2].y + bb.mPosition.y;
+            *pDest++ = offsets[2].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = mid_u - cos_rot_w - sin_rot_h;
-            *mLockPtr++ = mid_v - sin_rot_w + cos_rot_h;
+            *pDest++ = mid_u - cos_rot_w - sin_rot_h;
+            *pDest++ = mid_v - sin_rot_w + cos_rot_h;
 
             // Right-bottom
             // Positions
-            *mLockPtr++ = offsets[3].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[3].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[3].z + bb.mPosition.z;
+            *pDest++ = offsets[3].x + bb.mPosition.x;
+            *pDest++ = offsets[3].y + bb.mPosition.y;
+            *pDest++ = offsets[3].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = mid_u + cos_rot_w - sin_rot_h;
-            *mLockPtr++ = mid_v + sin_rot_w + cos_rot_h;
+            *pDest++ = mid_u + cos_rot_w - sin_rot_h;
+            *pDest++ = mid_v + sin_rot_w + cos_rot_h;
         }
 
     }
     //-----------------------------------------------------------------------
     void BillboardSet::genVertOffsets(Real inleft, Real inright, Real intop, Real inbottom,
-        Real width, Real height, const Vector3& x, const Vector3& y, Vector3* pDestVec)
+        Real width, Real height, const Vector3& x, const Vector3& y, Vector3* pDestVec) const
     {
         Vector3 vLeftOff, vRightOff, vTopOff, vBottomOff;
         /* Calculate default offsets. Scale the axes by
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "OgreControllerManager.h"
 
 #include "OgrePredefinedControllers.h"
+#include "OgreParticleSystemManager.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -82,6 +83,12 @@ namespace Ogre {
             {
                 (*ci)->update();
             }
+
+            // Particle systems updated in parallel have only queued their updates
+            ParticleSystemManager* particleMgr = ParticleSystemManager::getSingletonPtr();
+            if (particleMgr)
+                particleMgr->_updateQueuedSystems();
+
             mLastFrameNumber = thisFrameNumber;
         }
     }
@@ -27,6 +27,19 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  if !defined(NOMINMAX) && defined(_MSC_VER)
+#   define NOMINMAX // required to stop windows.h messing up std::min
+#  endif
+#  include <windows.h>
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -467,6 +480,85 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
+    MappedFileDataStream::MappedFileDataStream(const String& name, const String& path)
+        : MemoryDataStream(name, 0, 0, false, true)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, 
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + path, "MappedFileDataStream::MappedFileDataStream");
+        }
+
+        LARGE_INTEGER fileSize;
+        fileSize.QuadPart = 0;
+        GetFileSizeEx(file, &fileSize);
+        mSize = static_cast<size_t>(fileSize.QuadPart);
+        if (mSize)
+        {
+            // the view keeps the mapping alive once the handles are closed
+            HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+            if (mapping)
+            {
+                mData = static_cast<uchar*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+#elif OGRE_PLATFORM == OGRE_PLATFORM_WINRT
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+            "File mapping is not supported on this platform", 
+            "MappedFileDataStream::MappedFileDataStream");
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + path, "MappedFileDataStream::MappedFileDataStream");
+        }
+
+        struct stat tagStat;
+        if (fstat(fd, &tagStat) == 0)
+            mSize = static_cast<size_t>(tagStat.st_size);
+        if (mSize)
+        {
+            // the mapping stays valid once the descriptor is closed
+            void* pMem = mmap(0, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (pMem != MAP_FAILED)
+                mData = static_cast<uchar*>(pMem);
+        }
+        ::close(fd);
+#endif
+
+        if (mSize && !mData)
+        {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot map file: " + path, "MappedFileDataStream::MappedFileDataStream");
+        }
+        mPos = mData;
+        mEnd = mData + mSize;
+    }
+    //-----------------------------------------------------------------------
+    MappedFileDataStream::~MappedFileDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    void MappedFileDataStream::close(void)
+    {
+        if (mData)
+        {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+            UnmapViewOfFile(mData);
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+            munmap(mData, mSize);
+#endif
+            mData = mPos = mEnd = 0;
+        }
+    }
+    //-----------------------------------------------------------------------
     FileStreamDataStream::FileStreamDataStream(std::ifstream* s, bool freeOnClose)
         : DataStream(), mInStream(s), mFStreamRO(s), mFStream(0), mFreeOnClose(freeOnClose)
     {
@@ -29,9 +29,79 @@ THE SOFTWARE.
 #include "OgreEdgeListBuilder.h"
 #include "OgreVertexIndexData.h"
 #include "OgreOptimisedUtil.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
+    namespace
+    {
+        /// Minimum number of triangle sides before connecting the edges in parallel
+        const size_t PARALLEL_EDGE_SIDES = 16384;
+        const uint32 NO_SIDE = ~uint32(0);
+
+        /// Key of the side going between two common vertices, in that direction
+        inline uint64 sideKey(uint32 from, uint32 to)
+        {
+            return (uint64(from) << 32) | to;
+        }
+
+        /** Matches the sides of a range of buckets, for WorkQueue::parallelFor.
+        @remarks
+            Both directions of an edge always fall in the same bucket, so buckets are
+            independent. Within a bucket the sides are visited in triangle order, so
+            the result is the same as connecting all the sides one by one.
+        */
+        struct EdgeConnectTask
+        {
+            const EdgeData::Triangle* triangles;
+            const uint32* bucketSides;   /// Sides grouped by bucket, in order within each
+            const size_t* bucketStarts;  /// Start of each bucket in bucketSides, plus the end
+            uint32* owners;              /// Out: the side which started the edge of each side
+            uint32* nextOpen;            /// Scratch: next unconnected side in the same direction
+
+            void operator()(size_t begin, size_t end) const
+            {
+                // Oldest and newest unconnected sides going in each direction
+                typedef OGRE_HashMap<uint64, std::pair<uint32, uint32> > OpenSideMap;
+                OpenSideMap open;
+                for (size_t b = begin; b < end; ++b)
+                {
+                    open.clear();
+                    open.reserve(bucketStarts[b + 1] - bucketStarts[b]);
+                    for (size_t i = bucketStarts[b]; i < bucketStarts[b + 1]; ++i)
+                    {
+                        uint32 side = bucketSides[i];
+                        const EdgeData::Triangle& tri = triangles[side / 3];
+                        uint32 v0 = static_cast<uint32>(tri.sharedVertIndex[side % 3]);
+                        uint32 v1 = static_cast<uint32>(tri.sharedVertIndex[(side + 1) % 3]);
+
+                        // Connect to the existing edge (should be reversed order)
+                        OpenSideMap::iterator it = open.find(sideKey(v1, v0));
+                        if (it != open.end())
+                        {
+                            owners[side] = it->second.first;
+                            it->second.first = nextOpen[it->second.first];
+                            if (it->second.first == NO_SIDE)
+                                open.erase(it);
+                            continue;
+                        }
+
+                        // Not found, this side starts a new edge
+                        owners[side] = side;
+                        nextOpen[side] = NO_SIDE;
+                        std::pair<OpenSideMap::iterator, bool> inserted = open.insert(
+                            OpenSideMap::value_type(sideKey(v0, v1), std::make_pair(side, side)));
+                        if (!inserted.second)
+                        {
+                            nextOpen[inserted.first->second.second] = side;
+                            inserted.first->second.second = side;
+                        }
+                    }
+                }
+            }
+        };
+    }
+
     EdgeData::EdgeData() : isClosed(false){}
     
     void EdgeData::log(Log* l)
@@ -75,7 +145,7 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     EdgeListBuilder::EdgeListBuilder()
-        : mEdgeData(0)
+        : mEdgeData(0), mWeldTolerance(0)
     {
     }
     //---------------------------------------------------------------------
@@ -181,24 +251,22 @@ namespace Ogre {
             mEdgeData->edgeGroups[vSet].triCount = 0;
         }
 
-        // Build triangles and edge list
+        // Build triangles, then the edge list between all of them
         GeometryList::const_iterator i, iend;
         iend = mGeometryList.end();
         for (i = mGeometryList.begin(); i != iend; ++i)
         {
-            buildTrianglesEdges(*i);
+            buildTriangles(*i);
         }
+        buildEdges();
 
         // Allocate memory for light facing calculate
         mEdgeData->triangleLightFacings.resize(mEdgeData->triangles.size());
 
-        // Record closed, ie the mesh is manifold
-        mEdgeData->isClosed = mEdgeMap.empty();
-
         return mEdgeData;
     }
     //---------------------------------------------------------------------
-    void EdgeListBuilder::buildTrianglesEdges(const Geometry &geometry)
+    void EdgeListBuilder::buildTriangles(const Geometry &geometry)
     {
         size_t indexSet = geometry.indexSet;
         size_t vertexSet = geometry.vertexSet;
@@ -334,18 +402,8 @@ namespace Ogre {
                 // skeletally animated meshes)
                 mEdgeData->triangleFaceNormals.push_back(
                     Math::calculateFaceNormalWithoutNormalize(v[0], v[1], v[2]));
-                // Add triangle to list
+                // Add triangle to list, its edges are connected once all are known
                 mEdgeData->triangles.push_back(tri);
-                // Connect or create edges from common list
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[0], tri.vertIndex[1], 
-                    tri.sharedVertIndex[0], tri.sharedVertIndex[1]);
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[1], tri.vertIndex[2], 
-                    tri.sharedVertIndex[1], tri.sharedVertIndex[2]);
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[2], tri.vertIndex[0], 
-                    tri.sharedVertIndex[2], tri.sharedVertIndex[0]);
                 ++triangleIndex;
             }
         }
@@ -358,57 +416,140 @@ namespace Ogre {
         vbuf->unlock();
     }
     //---------------------------------------------------------------------
-    void EdgeListBuilder::connectOrCreateEdge(size_t vertexSet, size_t triangleIndex, 
-        size_t vertIndex0, size_t vertIndex1, size_t sharedVertIndex0, 
-        size_t sharedVertIndex1)
+    void EdgeListBuilder::buildEdges(void)
     {
-        // Find the existing edge (should be reversed order) on shared vertices
-        EdgeMap::iterator emi = mEdgeMap.find(std::pair<size_t, size_t>(sharedVertIndex1, sharedVertIndex0));
-        if (emi != mEdgeMap.end())
+        const EdgeData::TriangleList& triangles = mEdgeData->triangles;
+        const size_t numSides = triangles.size() * 3;
+
+        // Spread the sides over buckets by the common vertices they go between,
+        // whatever the direction, keeping them in order within each bucket
+        WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+        size_t numBuckets = 1;
+        if (numSides >= PARALLEL_EDGE_SIDES && queue && queue->getTaskConcurrency())
+            numBuckets = (queue->getTaskConcurrency() + 1) * 4;
+
+        vector<uint32>::type sideBuckets(numSides);
+        vector<size_t>::type bucketStarts(numBuckets + 1, 0);
+        for (size_t side = 0; side < numSides; ++side)
         {
-            // The edge already exist, connect it
-            EdgeData::Edge& e = mEdgeData->edgeGroups[emi->second.first].edges[emi->second.second];
-            // update with second side
-            e.triIndex[1] = triangleIndex;
-            e.degenerate = false;
-
-            // Remove from the edge map, so we never supplied to connect edge again
-            mEdgeMap.erase(emi);
+            const EdgeData::Triangle& tri = triangles[side / 3];
+            size_t v0 = tri.sharedVertIndex[side % 3];
+            size_t v1 = tri.sharedVertIndex[(side + 1) % 3];
+            uint32 bucket = numBuckets > 1 ?
+                HashCombine(HashCombine(0, std::min(v0, v1)), std::max(v0, v1)) % numBuckets : 0;
+            sideBuckets[side] = bucket;
+            ++bucketStarts[bucket + 1];
         }
+        for (size_t b = 0; b < numBuckets; ++b)
+            bucketStarts[b + 1] += bucketStarts[b];
+
+        vector<uint32>::type bucketSides(numSides);
+        vector<size_t>::type bucketFill(bucketStarts.begin(), bucketStarts.end() - 1);
+        for (size_t side = 0; side < numSides; ++side)
+            bucketSides[bucketFill[sideBuckets[side]]++] = static_cast<uint32>(side);
+
+        // Match the sides of every bucket on its own
+        vector<uint32>::type owners(numSides);
+        vector<uint32>::type nextOpen(numSides);
+        EdgeConnectTask task = {triangles.empty() ? 0 : &triangles[0],
+            bucketSides.empty() ? 0 : &bucketSides[0], &bucketStarts[0],
+            owners.empty() ? 0 : &owners[0], nextOpen.empty() ? 0 : &nextOpen[0]};
+        if (numBuckets > 1)
+            queue->parallelFor(0, numBuckets, 1, task);
         else
+            task(0, numBuckets);
+
+        // Create the edges in triangle order, so they don't depend on the bucketing.
+        // All edges 'belong' to the vertex set of the triangle which started them.
+        vector<uint32>::type& edgeIndices = nextOpen;
+        size_t openEdges = 0;
+        for (size_t side = 0; side < numSides; ++side)
         {
-            // Not found, create new edge
-            mEdgeMap.insert(EdgeMap::value_type(
-                std::pair<size_t, size_t>(sharedVertIndex0, sharedVertIndex1),
-                std::pair<size_t, size_t>(vertexSet, mEdgeData->edgeGroups[vertexSet].edges.size())));
-            EdgeData::Edge e;
-            e.degenerate = true; // initialise as degenerate
-
-            // Set only first tri, the other will be completed in connect existing edge
-            e.triIndex[0] = triangleIndex;
-            e.triIndex[1] = static_cast<size_t>(~0);
-            e.sharedVertIndex[0] = sharedVertIndex0;
-            e.sharedVertIndex[1] = sharedVertIndex1;
-            e.vertIndex[0] = vertIndex0;
-            e.vertIndex[1] = vertIndex1;
-            mEdgeData->edgeGroups[vertexSet].edges.push_back(e);
+            size_t triangleIndex = side / 3;
+            const EdgeData::Triangle& tri = triangles[triangleIndex];
+            if (owners[side] == side)
+            {
+                EdgeData::EdgeList& edges = mEdgeData->edgeGroups[tri.vertexSet].edges;
+                edgeIndices[side] = static_cast<uint32>(edges.size());
+
+                EdgeData::Edge e;
+                e.degenerate = true; // initialise as degenerate
+
+                // Set only first tri, the other will be completed in connect existing edge
+                e.triIndex[0] = triangleIndex;
+                e.triIndex[1] = static_cast<size_t>(~0);
+                e.sharedVertIndex[0] = tri.sharedVertIndex[side % 3];
+                e.sharedVertIndex[1] = tri.sharedVertIndex[(side + 1) % 3];
+                e.vertIndex[0] = tri.vertIndex[side % 3];
+                e.vertIndex[1] = tri.vertIndex[(side + 1) % 3];
+                edges.push_back(e);
+                ++openEdges;
+            }
+            else
+            {
+                // The edge already exist, connect it
+                uint32 owner = owners[side];
+                EdgeData::Edge& e = mEdgeData->edgeGroups[triangles[owner / 3].vertexSet].edges[edgeIndices[owner]];
+                // update with second side
+                e.triIndex[1] = triangleIndex;
+                e.degenerate = false;
+                --openEdges;
+            }
         }
+
+        // Record closed, ie the mesh is manifold
+        mEdgeData->isClosed = openEdges == 0;
     }
     //---------------------------------------------------------------------
     size_t EdgeListBuilder::findOrCreateCommonVertex(const Vector3& vec, 
         size_t vertexSet, size_t indexSet, size_t originalIndex)
     {
         // Because the algorithm doesn't care about manifold or not, we just identifying
-        // the common vertex by EXACT same position.
-        // Hint: We can use quantize method for welding almost same position vertex fastest.
-        std::pair<CommonVertexMap::iterator, bool> inserted =
-            mCommonVertexMap.insert(CommonVertexMap::value_type(vec, mVertices.size()));
-        if (!inserted.second)
+        // the common vertex by EXACT same position, or else by the weld tolerance.
+        Vector3 key = vec;
+        if (mWeldTolerance > 0)
         {
-            // Already existing, return old one
-            return inserted.first->second;
+            // Common vertices within the tolerance are in the same cell of the grid
+            // or a neighbouring one, weld to the first of them
+            key.x = Math::Floor(vec.x / mWeldTolerance);
+            key.y = Math::Floor(vec.y / mWeldTolerance);
+            key.z = Math::Floor(vec.z / mWeldTolerance);
+            Real toleranceSquared = mWeldTolerance * mWeldTolerance;
+            size_t found = mVertices.size();
+            for (int z = -1; z <= 1; ++z)
+            {
+                for (int y = -1; y <= 1; ++y)
+                {
+                    for (int x = -1; x <= 1; ++x)
+                    {
+                        std::pair<CommonVertexMap::iterator, CommonVertexMap::iterator> range =
+                            mCommonVertexMap.equal_range(key + Vector3(Real(x), Real(y), Real(z)));
+                        for (CommonVertexMap::iterator i = range.first; i != range.second; ++i)
+                        {
+                            if (i->second < found &&
+                                mVertices[i->second].position.squaredDistance(vec) <= toleranceSquared)
+                            {
+                                found = i->second;
+                            }
+                        }
+                    }
+                }
+            }
+            if (found != mVertices.size())
+                return found;
         }
+        else
+        {
+            CommonVertexMap::iterator i = mCommonVertexMap.find(key);
+            if (i != mCommonVertexMap.end())
+            {
+                // Already existing, return old one
+                return i->second;
+            }
+        }
+
         // Not found, insert
+        mCommonVertexMap.insert(CommonVertexMap::value_type(key, mVertices.size()));
         CommonVertex newCommon;
         newCommon.index = mVertices.size();
         newCommon.position = vec;
@@ -734,7 +734,7 @@ namespace Ogre {
         // update the animation
         if (displayEntity->hasSkeleton() || displayEntity->hasVertexAnimation())
         {
-            displayEntity->updateAnimation();
+            displayEntity->updateAnimation(mManager ? mManager->_getSoftwareVertexBlendBatch() : 0);
 
             //--- pass this point,  we are sure that the transformation matrix of each bone and tagPoint have been updated
             ChildObjectList::iterator child_itr = mChildObjectList.begin();
@@ -858,7 +858,7 @@ namespace Ogre {
         return true;
     }
     //-----------------------------------------------------------------------
-    void Entity::updateAnimation(void)
+    void Entity::updateAnimation(Mesh::SoftwareVertexBlendBatch* blendBatch)
     {
         // Do nothing if not initialised yet
         if (!mInitialised)
@@ -935,6 +935,8 @@ namespace Ogre {
                 if (softwareAnimation)
                 {
                     const Affine3* blendMatrices[256];
+                    Mesh::SoftwareVertexBlendBatch localBatch;
+                    Mesh::SoftwareVertexBlendBatch& batch = blendBatch ? *blendBatch : localBatch;
 
                     // Ok, we need to do a software blend
                     // Firstly, check out working vertex buffers
@@ -951,7 +953,7 @@ namespace Ogre {
                         Mesh::prepareMatricesForVertexBlend(blendMatrices,
                                                             mBoneMatrices, mMesh->sharedBlendIndexToBoneIndexMap);
                         // Blend, taking source from either mesh data or morph data
-                        Mesh::softwareVertexBlend(
+                        batch.add(
                             (mMesh->getSharedVertexDataAnimationType() != VAT_NONE) ?
                             mSoftwareVertexAnimVertexData : mMesh->sharedVertexData,
                             mSkelAnimVertexData,
@@ -973,7 +975,7 @@ namespace Ogre {
                             Mesh::prepareMatricesForVertexBlend(blendMatrices,
                                                                 mBoneMatrices, se->mSubMesh->blendIndexToBoneIndexMap);
                             // Blend, taking source from either mesh data or morph data
-                            Mesh::softwareVertexBlend(
+                            batch.add(
                                 (se->getSubMesh()->getVertexAnimationType() != VAT_NONE)?
                                 se->mSoftwareVertexAnimVertexData : se->mSubMesh->vertexData,
                                 se->mSkelAnimVertexData,
@@ -982,7 +984,7 @@ namespace Ogre {
                         }
 
                     }
-
+                    localBatch.execute();
                 }
             }
 
@@ -1400,6 +1402,20 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void Entity::_updateAnimations(const vector<Entity*>::type& entities)
+    {
+        Mesh::SoftwareVertexBlendBatch batch;
+        for (vector<Entity*>::type::const_iterator i = entities.begin(); i != entities.end(); ++i)
+        {
+            Entity* entity = *i;
+            if (entity->hasSkeleton() || entity->hasVertexAnimation())
+            {
+                entity->updateAnimation(&batch);
+            }
+        }
+        batch.execute(Root::getSingleton().getWorkQueue());
+    }
+    //-----------------------------------------------------------------------
     bool Entity::_isAnimated(void) const
     {
         return (mAnimationState && mAnimationState->hasEnabledAnimationState()) ||
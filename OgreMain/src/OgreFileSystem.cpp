@@ -73,8 +73,12 @@ namespace {
             StringVector* simpleList, FileInfoList* detailList) const;
 
         OGRE_AUTO_MUTEX;
+
+        /// Whether files opened read-only are mapped into memory
+        bool mMapFiles;
     public:
-        FileSystemArchive(const String& name, const String& archType, bool readOnly );
+        FileSystemArchive(const String& name, const String& archType, bool readOnly,
+            bool mapFiles = false);
         ~FileSystemArchive();
 
         /// @copydoc Archive::isCaseSensitive
@@ -119,8 +123,9 @@ namespace {
 }
 
     //-----------------------------------------------------------------------
-    FileSystemArchive::FileSystemArchive(const String& name, const String& archType, bool readOnly )
-        : Archive(name, archType)
+    FileSystemArchive::FileSystemArchive(const String& name, const String& archType, bool readOnly,
+        bool mapFiles)
+        : Archive(name, archType), mMapFiles(mapFiles)
     {
         // Even failed attempt to write to read only location violates Apple AppStore validation process.
         // And successful writing to some probe file does not prove that whole location with subfolders 
@@ -356,6 +361,11 @@ namespace {
                         "FileSystemArchive::open");
         }
 
+        if (readOnly && mMapFiles)
+        {
+            return DataStreamPtr(OGRE_NEW MappedFileDataStream(filename, full_path));
+        }
+
         if (!readOnly)
         {
             mode |= std::ios::out;
@@ -577,4 +587,15 @@ namespace {
     {
         return gIgnoreHidden;
     }
+    //-----------------------------------------------------------------------
+    const String& MappedFileSystemArchiveFactory::getType(void) const
+    {
+        static String name = "MappedFileSystem";
+        return name;
+    }
+
+    Archive *MappedFileSystemArchiveFactory::createInstance( const String& name, bool readOnly )
+    {
+        return OGRE_NEW FileSystemArchive(name, getType(), readOnly, true);
+    }
 }
@@ -390,11 +390,13 @@ namespace Ogre {
     //---------------------------------------------------------------------
     Codec::DecodeResult FreeImageCodec::decode(const DataStreamPtr& input) const
     {
-        // Buffer stream into memory (TODO: override IO functions instead?)
-        MemoryDataStream memStream(input, true);
+        // Buffer stream into memory, unless it already is (TODO: override IO functions instead?)
+        MemoryDataStreamPtr memStream = dynamic_pointer_cast<MemoryDataStream>(input);
+        if (!memStream)
+            memStream.reset(OGRE_NEW MemoryDataStream(input, true));
 
-        FIMEMORY* fiMem = 
-            FreeImage_OpenMemory(memStream.getPtr(), static_cast<DWORD>(memStream.size()));
+        FIMEMORY* fiMem = FreeImage_OpenMemory(memStream->getCurrentPtr(),
+            static_cast<DWORD>(memStream->size() - memStream->tell()));
 
         FIBITMAP* fiBitmap = FreeImage_LoadFromMemory(
             (FREE_IMAGE_FORMAT)mFreeImageType, fiMem);
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "OgreImage.h"
 #include "OgreImageCodec.h"
 #include "OgreImageResampler.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
     ImageCodec::~ImageCodec() {
@@ -670,8 +672,216 @@ namespace Ogre {
                 LinearResampler::scale(src, scaled);
             }
             break;
+
+        case FILTER_BOX:
+            switch (src.format) 
+            {
+            case PF_L8: case PF_A8: case PF_BYTE_LA:
+            case PF_R8G8B8: case PF_B8G8R8:
+            case PF_R8G8B8A8: case PF_B8G8R8A8:
+            case PF_A8B8G8R8: case PF_A8R8G8B8:
+            case PF_X8B8G8R8: case PF_X8R8G8B8:
+                if(src.format == scaled.format) 
+                {
+                    // No intermediate buffer needed
+                    temp = scaled;
+                }
+                else
+                {
+                    // Allocate temp buffer of destination size in source format 
+                    temp = PixelBox(scaled.getWidth(), scaled.getHeight(), scaled.getDepth(), src.format);
+                    buf.reset(OGRE_NEW MemoryDataStream(temp.getConsecutiveSize()));
+                    temp.data = buf->getPtr();
+                }
+                // byte-oriented integer sums, no conversion
+                switch (PixelUtil::getNumElemBytes(src.format)) 
+                {
+                case 1: BoxResampler_Byte<1>::scale(src, temp); break;
+                case 2: BoxResampler_Byte<2>::scale(src, temp); break;
+                case 3: BoxResampler_Byte<3>::scale(src, temp); break;
+                case 4: BoxResampler_Byte<4>::scale(src, temp); break;
+                default:
+                    // never reached
+                    assert(false);
+                }
+                if(temp.data != scaled.data)
+                {
+                    // Blit temp buffer
+                    PixelUtil::bulkPixelConversion(temp, scaled);
+                }
+                break;
+            default:
+                // floating-point math, performs conversion but always works
+                BoxResampler::scale(src, scaled);
+            }
+            break;
+
+        case FILTER_KAISER:
+            {
+                // separable floating-point filter, converts through float RGBA
+                PixelBox fsrc = src;
+                MemoryDataStreamPtr srcbuf;
+                if(src.format != PF_FLOAT32_RGBA || !src.isConsecutive())
+                {
+                    fsrc = PixelBox(src.getWidth(), src.getHeight(), src.getDepth(), PF_FLOAT32_RGBA);
+                    srcbuf.reset(OGRE_NEW MemoryDataStream(fsrc.getConsecutiveSize()));
+                    fsrc.data = srcbuf->getPtr();
+                    PixelUtil::bulkPixelConversion(src, fsrc);
+                }
+                if(scaled.format == PF_FLOAT32_RGBA && scaled.isConsecutive())
+                {
+                    temp = scaled;
+                }
+                else
+                {
+                    temp = PixelBox(scaled.getWidth(), scaled.getHeight(), scaled.getDepth(), PF_FLOAT32_RGBA);
+                    buf.reset(OGRE_NEW MemoryDataStream(temp.getConsecutiveSize()));
+                    temp.data = buf->getPtr();
+                }
+                SeparableResampler::scale(fsrc, temp, filter);
+                if(temp.data != scaled.data)
+                {
+                    PixelUtil::bulkPixelConversion(temp, scaled);
+                }
+            }
+            break;
         }
     }
+    //-----------------------------------------------------------------------------
+    namespace
+    {
+        float srgbToLinear(float c)
+        {
+            return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+
+        float linearToSrgb(float c)
+        {
+            if (c <= 0.0031308f)
+                return std::max(c, 0.0f) * 12.92f;
+            return 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        }
+
+        /// Applies f to the colour channels of float RGBA pixels
+        void convertColourChannels(float* data, size_t numPixels, float (*f)(float))
+        {
+            for (size_t i = 0; i < numPixels; ++i, data += 4)
+            {
+                data[0] = f(data[0]);
+                data[1] = f(data[1]);
+                data[2] = f(data[2]);
+            }
+        }
+
+        /// WorkQueue::parallelFor body filtering the mipmap chains of a range of faces
+        struct MipmapTask
+        {
+            Image* image;
+            /// The top levels of all faces, float RGBA in linear space
+            float* topLevels;
+            Image::Filter filter;
+            bool gammaCorrected;
+            WorkQueue* queue;
+
+            void operator()(size_t begin, size_t end) const
+            {
+                size_t numMipmaps = image->getNumMipmaps();
+                size_t topSize = image->getWidth() * image->getHeight() * image->getDepth() * 4;
+                vector<float>::type previous, data, encoded;
+                for (size_t face = begin; face < end; ++face)
+                {
+                    // Each level is filtered from the one above it, in linear space
+                    PixelBox src(image->getWidth(), image->getHeight(), image->getDepth(), PF_FLOAT32_RGBA,
+                        topLevels + face * topSize);
+                    for (size_t mipmap = 1; mipmap <= numMipmaps; ++mipmap)
+                    {
+                        PixelBox dst = image->getPixelBox(face, mipmap);
+                        data.resize(dst.getWidth() * dst.getHeight() * dst.getDepth() * 4);
+                        PixelBox filtered(dst.getWidth(), dst.getHeight(), dst.getDepth(), PF_FLOAT32_RGBA, &data[0]);
+                        SeparableResampler::scale(src, filtered, filter, queue);
+                        if (gammaCorrected)
+                        {
+                            encoded = data;
+                            convertColourChannels(&encoded[0], encoded.size() / 4, linearToSrgb);
+                            PixelUtil::bulkPixelConversion(
+                                PixelBox(filtered.getWidth(), filtered.getHeight(), filtered.getDepth(), PF_FLOAT32_RGBA, &encoded[0]), dst);
+                        }
+                        else
+                        {
+                            PixelUtil::bulkPixelConversion(filtered, dst);
+                        }
+                        previous.swap(data);
+                        src = PixelBox(filtered.getWidth(), filtered.getHeight(), filtered.getDepth(), PF_FLOAT32_RGBA, &previous[0]);
+                    }
+                }
+            }
+        };
+    }
+    //-----------------------------------------------------------------------------
+    Image & Image::generateMipmaps(bool gammaCorrected, Filter filter)
+    {
+        // generating mipmaps of dynamic images is not supported
+        assert(mAutoDelete);
+
+        if (PixelUtil::isCompressed(mFormat))
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Mipmaps can not be generated for compressed formats",
+                "Image::generateMipmaps");
+        }
+        if (filter != FILTER_BOX && filter != FILTER_KAISER)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Only the box and kaiser filters are supported",
+                "Image::generateMipmaps");
+        }
+
+        // Halve until every dimension is 1
+        uint32 numMipmaps = 0;
+        for (uint32 w = mWidth, h = mHeight, d = mDepth; w > 1 || h > 1 || d > 1; ++numMipmaps)
+        {
+            w = std::max<uint32>(w / 2, 1);
+            h = std::max<uint32>(h / 2, 1);
+            d = std::max<uint32>(d / 2, 1);
+        }
+
+        // Keep the top levels as float RGBA, linearised if needed
+        size_t numFaces = getNumFaces();
+        size_t topPixels = (size_t)mWidth * mHeight * mDepth;
+        vector<float>::type topLevels(numFaces * topPixels * 4);
+        for (size_t face = 0; face < numFaces; ++face)
+        {
+            PixelBox top(mWidth, mHeight, mDepth, PF_FLOAT32_RGBA, &topLevels[face * topPixels * 4]);
+            PixelUtil::bulkPixelConversion(getPixelBox(face, 0), top);
+            if (gammaCorrected)
+                convertColourChannels(&topLevels[face * topPixels * 4], topPixels, srgbToLinear);
+        }
+
+        // Move the top levels into a buffer with room for the whole chain
+        Image old;
+        old.loadDynamicImage(mBuffer, mWidth, mHeight, mDepth, mFormat, true, numFaces, mNumMipmaps);
+        // do not delete[] mBuffer!  old will destroy it
+        mNumMipmaps = numMipmaps;
+        mBufSize = calculateSize(mNumMipmaps, numFaces, mWidth, mHeight, mDepth, mFormat);
+        mBuffer = OGRE_ALLOC_T(uchar, mBufSize, MEMCATEGORY_GENERAL);
+        for (size_t face = 0; face < numFaces; ++face)
+        {
+            PixelBox src = old.getPixelBox(face, 0);
+            memcpy(getPixelBox(face, 0).data, src.data, src.getConsecutiveSize());
+        }
+
+        if (numMipmaps == 0)
+            return *this;
+
+        Root* root = Root::getSingletonPtr();
+        MipmapTask task = {this, &topLevels[0], filter, gammaCorrected, root ? root->getWorkQueue() : 0};
+        if (task.queue)
+            task.queue->parallelFor(0, numFaces, 1, task);
+        else
+            task(0, numFaces);
+
+        return *this;
+    }
 
     //-----------------------------------------------------------------------------    
 
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #define OGREIMAGERESAMPLER_H
 
 #include <algorithm>
+#include "OgreOptimisedUtil.h"
+#include "OgreWorkQueue.h"
 
 // this file is inlined into OgreImage.cpp!
 // do not include anywhere else.
@@ -298,13 +300,29 @@ template<unsigned int channels> struct LinearResampler_Byte {
         // using 16/48-bit fixed precision, incremented by steps
         uint64 stepx = ((uint64)src.getWidth() << 48) / dst.getWidth();
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
-        
-        uint64 sy_48 = (stepy >> 1) - 1;
-        for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+
+        // the horizontal samples are the same for every row
+        size_t dstWidth = dst.getWidth();
+        vector<uint32>::type columns(dstWidth * 3);
+        uint32* sx1 = &columns[0];
+        uint32* sx2 = sx1 + dstWidth;
+        uint32* sxf = sx2 + dstWidth;
+        uint64 sx_48 = (stepx >> 1) - 1;
+        for (size_t x = 0; x < dstWidth; x++, sx_48+=stepx) {
             // bottom 28 bits of temp are 16/12 bit fixed precision, used to
             // adjust a source coordinate backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
             // fractional bits are the blend weight of the second sample
+            unsigned int temp = static_cast<unsigned int>(sx_48 >> 36);
+            temp = (temp > 0x800)? temp - 0x800 : 0;
+            sxf[x] = temp & 0xFFF;
+            sx1[x] = temp >> 12;
+            sx2[x] = std::min(sx1[x]+1, src.right-src.left-1);
+        }
+
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+        uint64 sy_48 = (stepy >> 1) - 1;
+        for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
             unsigned int temp = static_cast<unsigned int>(sy_48 >> 36);
             temp = (temp > 0x800)? temp - 0x800: 0;
             unsigned int syf = temp & 0xFFF;
@@ -313,30 +331,314 @@ template<unsigned int channels> struct LinearResampler_Byte {
             size_t syoff1 = sy1 * src.rowPitch;
             size_t syoff2 = sy2 * src.rowPitch;
 
-            uint64 sx_48 = (stepx >> 1) - 1;
-            for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
-                temp = static_cast<unsigned int>(sx_48 >> 36);
-                temp = (temp > 0x800)? temp - 0x800 : 0;
-                unsigned int sxf = temp & 0xFFF;
-                uint32 sx1 = temp >> 12;
-                uint32 sx2 = std::min(sx1+1, src.right-src.left-1);
+            if (channels == 4) {
+                // vectorised where available, same results as below
+                util->linearResampleRowUByte4(srcdata + syoff1*channels, srcdata + syoff2*channels,
+                    syf, sx1, sx2, sxf, pdst, dstWidth);
+                pdst += channels*dstWidth;
+            } else {
+                for (size_t x = 0; x < dstWidth; x++) {
+                    unsigned int sxfsyf = sxf[x]*syf;
+                    for (unsigned int k = 0; k < channels; k++) {
+                        unsigned int accum =
+                            srcdata[(sx1[x] + syoff1)*channels+k]*(0x1000000-(sxf[x]<<12)-(syf<<12)+sxfsyf) +
+                            srcdata[(sx2[x] + syoff1)*channels+k]*((sxf[x]<<12)-sxfsyf) +
+                            srcdata[(sx1[x] + syoff2)*channels+k]*((syf<<12)-sxfsyf) +
+                            srcdata[(sx2[x] + syoff2)*channels+k]*sxfsyf;
+                        // accum is computed using 8/24-bit fixed-point math
+                        // (maximum is 0xFF000000; rounding will not cause overflow)
+                        *pdst++ = static_cast<uchar>((accum + 0x800000) >> 24);
+                    }
+                }
+            }
+            pdst += channels*dst.getRowSkip();
+        }
+    }
+};
+
+
+// box filter footprint, the source pixels [s1, s2) touched by
+// destination pixel d when scaling srcSize pixels to dstSize pixels
+inline void getBoxFootprint(size_t d, size_t srcSize, size_t dstSize, size_t& s1, size_t& s2)
+{
+    s1 = (d * srcSize) / dstSize;
+    s2 = ((d + 1) * srcSize + dstSize - 1) / dstSize;
+}
+
+
+// default floating-point box resampler, does format conversion.
+// averages every source pixel overlapping each destination pixel,
+// which is the appropriate filter for downsampling
+struct BoxResampler {
+    static void scale(const PixelBox& src, const PixelBox& dst) {
+        size_t srcelemsize = PixelUtil::getNumElemBytes(src.format);
+        size_t dstelemsize = PixelUtil::getNumElemBytes(dst.format);
 
-                unsigned int sxfsyf = sxf*syf;
+        // srcdata stays at beginning, pdst is a moving pointer
+        uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
+        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+
+        for (size_t z = 0; z < dst.getDepth(); z++) {
+            size_t sz1, sz2;
+            getBoxFootprint(z, src.getDepth(), dst.getDepth(), sz1, sz2);
+            for (size_t y = 0; y < dst.getHeight(); y++) {
+                size_t sy1, sy2;
+                getBoxFootprint(y, src.getHeight(), dst.getHeight(), sy1, sy2);
+                for (size_t x = 0; x < dst.getWidth(); x++) {
+                    size_t sx1, sx2;
+                    getBoxFootprint(x, src.getWidth(), dst.getWidth(), sx1, sx2);
+
+                    ColourValue accum(0, 0, 0, 0), sample;
+                    for (size_t sz = sz1; sz < sz2; sz++) {
+                        for (size_t sy = sy1; sy < sy2; sy++) {
+                            uchar* psrc = srcdata + srcelemsize*(sz*src.slicePitch + sy*src.rowPitch);
+                            for (size_t sx = sx1; sx < sx2; sx++) {
+                                PixelUtil::unpackColour(&sample, src.format, psrc + srcelemsize*sx);
+                                accum += sample;
+                            }
+                        }
+                    }
+                    accum /= (float)((sz2 - sz1) * (sy2 - sy1) * (sx2 - sx1));
+                    PixelUtil::packColour(accum, dst.format, pdst);
+
+                    pdst += dstelemsize;
+                }
+                pdst += dstelemsize*dst.getRowSkip();
+            }
+            pdst += dstelemsize*dst.getSliceSkip();
+        }
+    }
+};
+
+
+// byte box resampler, does not do any format conversions.
+// only handles pixel formats that use 1 byte per color channel.
+// 2D only; punts 3D pixelboxes to default BoxResampler (slow).
+// source rows are summed with integer math, then averaged with rounding
+template<unsigned int channels> struct BoxResampler_Byte {
+    static void scale(const PixelBox& src, const PixelBox& dst) {
+        // assert(src.format == dst.format);
+
+        // only optimized for 2D
+        if (src.getDepth() > 1 || dst.getDepth() > 1) {
+            BoxResampler::scale(src, dst);
+            return;
+        }
+
+        // srcdata stays at beginning of slice, pdst is a moving pointer
+        uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
+        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+
+        size_t srcWidth = src.getWidth();
+        vector<uint32>::type accum(srcWidth * channels);
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+
+        for (size_t y = 0; y < dst.getHeight(); y++) {
+            size_t sy1, sy2;
+            getBoxFootprint(y, src.getHeight(), dst.getHeight(), sy1, sy2);
+
+            // sum the source rows of this destination row
+            std::fill(accum.begin(), accum.end(), 0);
+            for (size_t sy = sy1; sy < sy2; sy++) {
+                util->accumulateUBytes(srcdata + sy*src.rowPitch*channels, &accum[0], srcWidth*channels);
+            }
+
+            for (size_t x = 0; x < dst.getWidth(); x++) {
+                size_t sx1, sx2;
+                getBoxFootprint(x, srcWidth, dst.getWidth(), sx1, sx2);
+                uint32 area = static_cast<uint32>((sx2 - sx1) * (sy2 - sy1));
                 for (unsigned int k = 0; k < channels; k++) {
-                    unsigned int accum =
-                        srcdata[(sx1 + syoff1)*channels+k]*(0x1000000-(sxf<<12)-(syf<<12)+sxfsyf) +
-                        srcdata[(sx2 + syoff1)*channels+k]*((sxf<<12)-sxfsyf) +
-                        srcdata[(sx1 + syoff2)*channels+k]*((syf<<12)-sxfsyf) +
-                        srcdata[(sx2 + syoff2)*channels+k]*sxfsyf;
-                    // accum is computed using 8/24-bit fixed-point math
-                    // (maximum is 0xFF000000; rounding will not cause overflow)
-                    *pdst++ = static_cast<uchar>((accum + 0x800000) >> 24);
+                    uint32 sum = 0;
+                    for (size_t sx = sx1; sx < sx2; sx++)
+                        sum += accum[sx*channels + k];
+                    *pdst++ = static_cast<uchar>((sum + area/2) / area);
                 }
             }
             pdst += channels*dst.getRowSkip();
         }
     }
 };
+
+// modified bessel function of the first kind and order 0, for the kaiser window
+inline double besselI0(double x)
+{
+    double sum = 1.0, term = 1.0, q = x * x / 4.0;
+    for (int k = 1; term > sum * 1e-12; k++) {
+        term *= q / (k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+
+// source pixels and their weights for every destination pixel along one
+// axis, as used by the separable resampler. the kernel is stretched by the
+// scale factor when minifying, and edge pixels are repeated
+struct ResampleWeights {
+    // destination pixel d uses entries [offsets[d], offsets[d+1])
+    vector<size_t>::type offsets;
+    vector<size_t>::type indices;
+    vector<float>::type weights;
+
+    ResampleWeights(Image::Filter filter, size_t srcSize, size_t dstSize) {
+        // kaiser windowed sinc with the same width and alpha as nvtt
+        const double kaiserWidth = 3.0, kaiserAlpha = 4.0;
+        const double scale = (double)srcSize / dstSize;
+        const double stretch = std::max(scale, 1.0);
+        const double support = filter == Image::FILTER_KAISER ? kaiserWidth * stretch : 0.5 * scale;
+
+        offsets.reserve(dstSize + 1);
+        for (size_t d = 0; d < dstSize; d++) {
+            offsets.push_back(indices.size());
+            double centre = (d + 0.5) * scale;
+            double lo = centre - support, hi = centre + support;
+            double total = 0;
+            for (long s = (long)std::floor(lo); s < (long)std::ceil(hi); s++) {
+                double w;
+                if (filter == Image::FILTER_KAISER) {
+                    double x = (s + 0.5 - centre) / stretch;
+                    double t = x / kaiserWidth;
+                    if (t <= -1.0 || t >= 1.0)
+                        continue;
+                    double sinc = x == 0 ? 1.0 : std::sin(Math::PI * x) / (Math::PI * x);
+                    w = sinc * besselI0(kaiserAlpha * std::sqrt(1.0 - t * t)) / besselI0(kaiserAlpha);
+                } else {
+                    // coverage of source pixel s by the destination pixel
+                    w = (std::min<double>(s + 1, hi) - std::max<double>(s, lo)) / scale;
+                    if (w <= 0)
+                        continue;
+                }
+
+                size_t index = static_cast<size_t>(Math::Clamp<long>(s, 0, (long)srcSize - 1));
+                if (indices.size() > offsets.back() && indices.back() == index) {
+                    weights.back() += (float)w;
+                } else {
+                    indices.push_back(index);
+                    weights.push_back((float)w);
+                }
+                total += w;
+            }
+            for (size_t i = offsets.back(); i < indices.size(); i++)
+                weights[i] = (float)(weights[i] / total);
+        }
+        offsets.push_back(indices.size());
+    }
+
+    // filters one line of float RGBA pixels, strides are given in floats
+    void filterLine(const float* src, size_t srcStride, float* dst, size_t dstStride) const {
+        for (size_t d = 0; d + 1 < offsets.size(); d++, dst += dstStride) {
+            float r = 0, g = 0, b = 0, a = 0;
+            for (size_t i = offsets[d]; i < offsets[d + 1]; i++) {
+                const float* psrc = src + indices[i] * srcStride;
+                float w = weights[i];
+                r += psrc[0] * w;
+                g += psrc[1] * w;
+                b += psrc[2] * w;
+                a += psrc[3] * w;
+            }
+            dst[0] = r; dst[1] = g; dst[2] = b; dst[3] = a;
+        }
+    }
+};
+
+
+// WorkQueue::parallelFor body filtering a range of lines along one axis
+struct ResampleAxisTask {
+    const ResampleWeights* weights;
+    const float* src;
+    float* dst;
+    // lines are numbered by an outer and an inner index, the latter
+    // counting pixels, all strides are given in floats
+    size_t inner;
+    size_t srcOuterStride;
+    size_t dstOuterStride;
+    size_t srcStride;
+    size_t dstStride;
+
+    void operator()(size_t begin, size_t end) const {
+        for (size_t l = begin; l < end; l++) {
+            size_t outer = l / inner, offset = (l % inner) * 4;
+            weights->filterLine(src + outer * srcOuterStride + offset, srcStride,
+                dst + outer * dstOuterStride + offset, dstStride);
+        }
+    }
+};
+
+
+// separable float resampler for the box and kaiser filters. only handles
+// consecutive PF_FLOAT32_RGBA boxes; filters x, y and z in turn and skips
+// axes which are not scaled. lines are spread over queue if given
+struct SeparableResampler {
+    static void scale(const PixelBox& src, const PixelBox& dst, Image::Filter filter, WorkQueue* queue = 0) {
+        assert(src.format == PF_FLOAT32_RGBA && src.isConsecutive());
+        assert(dst.format == PF_FLOAT32_RGBA && dst.isConsecutive());
+
+        size_t srcSize[3] = { src.getWidth(), src.getHeight(), src.getDepth() };
+        size_t dstSize[3] = { dst.getWidth(), dst.getHeight(), dst.getDepth() };
+
+        // size of the intermediate image after each axis
+        size_t size[3] = { srcSize[0], srcSize[1], srcSize[2] };
+        vector<float>::type temp[2];
+        const float* psrc = reinterpret_cast<const float*>(src.data);
+        float* pdst = reinterpret_cast<float*>(dst.data);
+        size_t lastAxis = 3;
+        for (size_t axis = 0; axis < 3; axis++) {
+            if (srcSize[axis] != dstSize[axis])
+                lastAxis = axis;
+        }
+        if (lastAxis == 3) {
+            if (psrc != pdst)
+                memcpy(pdst, psrc, dst.getConsecutiveSize());
+            return;
+        }
+
+        for (size_t axis = 0; axis <= lastAxis; axis++) {
+            if (srcSize[axis] == dstSize[axis])
+                continue;
+
+            size_t newSize[3] = { size[0], size[1], size[2] };
+            newSize[axis] = dstSize[axis];
+            float* out = pdst;
+            if (axis != lastAxis) {
+                temp[axis & 1].resize(newSize[0] * newSize[1] * newSize[2] * 4);
+                out = &temp[axis & 1][0];
+            }
+
+            ResampleWeights weights(filter, srcSize[axis], dstSize[axis]);
+            ResampleAxisTask task;
+            task.weights = &weights;
+            task.src = psrc;
+            task.dst = out;
+            size_t lines;
+            if (axis == 0) {
+                lines = size[1] * size[2];
+                task.inner = 1;
+                task.srcOuterStride = size[0] * 4;
+                task.dstOuterStride = newSize[0] * 4;
+                task.srcStride = task.dstStride = 4;
+            } else if (axis == 1) {
+                lines = size[0] * size[2];
+                task.inner = size[0];
+                task.srcOuterStride = size[0] * size[1] * 4;
+                task.dstOuterStride = newSize[0] * newSize[1] * 4;
+                task.srcStride = task.dstStride = size[0] * 4;
+            } else {
+                lines = size[0] * size[1];
+                task.inner = lines;
+                task.srcOuterStride = task.dstOuterStride = 0;
+                task.srcStride = task.dstStride = lines * 4;
+            }
+
+            if (queue)
+                queue->parallelFor(0, lines, 0, task);
+            else
+                task(0, lines);
+
+            psrc = out;
+            std::copy(newSize, newSize + 3, size);
+        }
+    }
+};
 /** @} */
 /** @} */
 
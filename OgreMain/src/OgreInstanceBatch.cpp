@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgreInstancedEntity.h"
 #include "OgreRenderQueue.h"
 #include "OgreLodListener.h"
+#include "OgreOptimisedUtil.h"
 
 namespace Ogre
 {
@@ -165,20 +166,64 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void InstanceBatch::updateVisibility(void)
     {
-        mVisible = false;
+        //Trick to force Ogre not to render us if none of our instances is visible
+        //Because we do Camera::isVisible(), it is better if the SceneNode from the
+        //InstancedEntity is not part of the scene graph (i.e. ultimate parent is root node)
+        //to avoid unnecessary wasteful calculations
+        cullInstances( mCurrentCamera );
+        mVisible = !mVisibleInstances.empty();
+    }
+    //-----------------------------------------------------------------------
+    void InstanceBatch::cullInstances( Camera *camera )
+    {
+        //Gather the instances in the scene, the ones to test against the camera
+        mVisibleInstances.clear();
+        mCullSpheres.clear();
+        for( size_t i=0; i<mInstancedEntities.size(); ++i )
+        {
+            const InstancedEntity *entity = mInstancedEntities[i];
+            if( entity->isInScene() && entity->isVisible() )
+            {
+                mVisibleInstances.push_back( static_cast<uint32>(i) );
+                if( camera )
+                {
+                    const Vector3 &centre = entity->_getDerivedPosition();
+                    mCullSpheres.push_back( static_cast<float>(centre.x) );
+                    mCullSpheres.push_back( static_cast<float>(centre.y) );
+                    mCullSpheres.push_back( static_cast<float>(centre.z) );
+                    mCullSpheres.push_back( static_cast<float>(entity->getBoundingRadius()) );
+                }
+            }
+        }
 
-        InstancedEntityVec::const_iterator itor = mInstancedEntities.begin();
-        InstancedEntityVec::const_iterator end  = mInstancedEntities.end();
+        if( !camera || mVisibleInstances.empty() )
+            return;
 
-        while( itor != end && !mVisible )
+        //Same planes as Camera::isVisible, skipping the far one when it's infinite
+        const Frustum *frustum = camera->getCullingFrustum() ?
+                                    camera->getCullingFrustum() : camera;
+        const Plane *frustumPlanes = frustum->getFrustumPlanes();
+        float planes[6 * 4];
+        size_t numPlanes = 0;
+        for( int p=0; p<6; ++p )
         {
-            //Trick to force Ogre not to render us if none of our instances is visible
-            //Because we do Camera::isVisible(), it is better if the SceneNode from the
-            //InstancedEntity is not part of the scene graph (i.e. ultimate parent is root node)
-            //to avoid unnecessary wasteful calculations
-            mVisible |= (*itor)->findVisible( mCurrentCamera );
-            ++itor;
+            if( p == FRUSTUM_PLANE_FAR && frustum->getFarClipDistance() == 0 )
+                continue;
+            planes[numPlanes * 4 + 0] = static_cast<float>( frustumPlanes[p].normal.x );
+            planes[numPlanes * 4 + 1] = static_cast<float>( frustumPlanes[p].normal.y );
+            planes[numPlanes * 4 + 2] = static_cast<float>( frustumPlanes[p].normal.z );
+            planes[numPlanes * 4 + 3] = static_cast<float>( frustumPlanes[p].d );
+            ++numPlanes;
         }
+
+        mCullResults.resize( mVisibleInstances.size() );
+        const size_t numVisible = OptimisedUtil::getImplementation()->cullSpheres(
+                    planes, numPlanes, &mCullSpheres[0], &mCullResults[0], mVisibleInstances.size() );
+
+        //The results are increasing, so the candidates can be compacted in place
+        for( size_t i=0; i<numVisible; ++i )
+            mVisibleInstances[i] = mVisibleInstances[mCullResults[i]];
+        mVisibleInstances.resize( numVisible );
     }
     //-----------------------------------------------------------------------
     void InstanceBatch::createAllInstancedEntities()
@@ -184,39 +184,33 @@ namespace Ogre
         float *pDest = static_cast<float*>(mRenderOperation.vertexData->vertexBufferBinding->
                                             getBuffer(bufferIdx)->lock( HardwareBuffer::HBL_DISCARD ));
 
-        InstancedEntityVec::const_iterator itor = mInstancedEntities.begin();
-        InstancedEntityVec::const_iterator end  = mInstancedEntities.end();
-
         unsigned char numCustomParams           = mCreator->getNumCustomParams();
-        size_t customParamIdx                   = 0;
 
-        while( itor != end )
-        {
-            //Cull on an individual basis, the less entities are visible, the less instances we draw.
-            //No need to use null matrices at all!
-            if( (*itor)->findVisible( currentCamera ) )
-            {
-                const size_t floatsWritten = (*itor)->getTransforms3x4( pDest );
+        //Cull on an individual basis, the less entities are visible, the less instances we draw.
+        //No need to use null matrices at all! Only the visible ones are written, packed together
+        cullInstances( currentCamera );
 
-                if( mManager->getCameraRelativeRendering() )
-                    makeMatrixCameraRelative3x4( pDest, floatsWritten );
+        for( size_t n=0; n<mVisibleInstances.size(); ++n )
+        {
+            const size_t instanceIdx = mVisibleInstances[n];
+            const size_t floatsWritten = mInstancedEntities[instanceIdx]->getTransforms3x4( pDest );
 
-                pDest += floatsWritten;
+            if( mManager->getCameraRelativeRendering() )
+                makeMatrixCameraRelative3x4( pDest, floatsWritten );
 
-                //Write custom parameters, if any
-                for( unsigned char i=0; i<numCustomParams; ++i )
-                {
-                    *pDest++ = mCustomParams[customParamIdx+i].x;
-                    *pDest++ = mCustomParams[customParamIdx+i].y;
-                    *pDest++ = mCustomParams[customParamIdx+i].z;
-                    *pDest++ = mCustomParams[customParamIdx+i].w;
-                }
+            pDest += floatsWritten;
 
-                ++retVal;
+            //Write custom parameters, if any
+            const size_t customParamIdx = instanceIdx * numCustomParams;
+            for( unsigned char i=0; i<numCustomParams; ++i )
+            {
+                *pDest++ = mCustomParams[customParamIdx+i].x;
+                *pDest++ = mCustomParams[customParamIdx+i].y;
+                *pDest++ = mCustomParams[customParamIdx+i].z;
+                *pDest++ = mCustomParams[customParamIdx+i].w;
             }
-            ++itor;
 
-            customParamIdx += numCustomParams;
+            ++retVal;
         }
 
         mRenderOperation.vertexData->vertexBufferBinding->getBuffer(bufferIdx)->unlock();
@@ -281,48 +281,45 @@ namespace Ogre
             const size_t maxPixelsPerLine = std::min( static_cast<size_t>(mMatrixTexture->getWidth()), mMaxFloatsPerLine >> 2 );
 
             //Calculate UV offsets, which change per instance
-            for( size_t i=0; i<mInstancesPerBatch; ++i )
+            //When using a lookup bone matrix method only the instances in the visible range of
+            //the camera are updated, as culled by updateVertexTexture. Otherwise this is only
+            //called once, for every instance
+            const size_t numInstances = useMatrixLookup ? mVisibleInstances.size() : mInstancesPerBatch;
+            for( size_t n=0; n<numInstances; ++n )
             {
+                const size_t i = useMatrixLookup ? mVisibleInstances[n] : n;
                 InstancedEntity* entity = useMatrixLookup ? mInstancedEntities[i] : NULL;
-                if  //Update if we are not using a lookup bone matrix method. In this case the function will 
-                    //be called only once
-                    (!useMatrixLookup || 
-                    //Update if we are in the visible range of the camera (for look up bone matrix method
-                    //and static mode).
-                    (entity->findVisible(currentCamera)))
-                {
-                    size_t matrixIndex = useMatrixLookup ? entity->mTransformLookupNumber : i;
-                    size_t instanceIdx = matrixIndex * mMatricesPerInstance * mRowLength;
-                    *thisVec = ((instanceIdx % maxPixelsPerLine) / texWidth) - (float)(texelOffsets.x);
-                    *(thisVec + 1) = ((instanceIdx / maxPixelsPerLine) / texHeight) - (float)(texelOffsets.y);
-                    thisVec += 2;
+                size_t matrixIndex = useMatrixLookup ? entity->mTransformLookupNumber : i;
+                size_t instanceIdx = matrixIndex * mMatricesPerInstance * mRowLength;
+                *thisVec = ((instanceIdx % maxPixelsPerLine) / texWidth) - (float)(texelOffsets.x);
+                *(thisVec + 1) = ((instanceIdx / maxPixelsPerLine) / texHeight) - (float)(texelOffsets.y);
+                thisVec += 2;
 
-                    if (useMatrixLookup)
+                if (useMatrixLookup)
+                {
+                    const Affine3& mat =  entity->_getParentNodeFullTransform();
+                    *(thisVec)     = static_cast<float>( mat[0][0] );
+                    *(thisVec + 1) = static_cast<float>( mat[0][1] );
+                    *(thisVec + 2) = static_cast<float>( mat[0][2] );
+                    *(thisVec + 3) = static_cast<float>( mat[0][3] );
+                    *(thisVec + 4) = static_cast<float>( mat[1][0] );
+                    *(thisVec + 5) = static_cast<float>( mat[1][1] );
+                    *(thisVec + 6) = static_cast<float>( mat[1][2] );
+                    *(thisVec + 7) = static_cast<float>( mat[1][3] );
+                    *(thisVec + 8) = static_cast<float>( mat[2][0] );
+                    *(thisVec + 9) = static_cast<float>( mat[2][1] );
+                    *(thisVec + 10)= static_cast<float>( mat[2][2] );
+                    *(thisVec + 11)= static_cast<float>( mat[2][3] );
+                    if(currentCamera && mManager->getCameraRelativeRendering()) // && useMatrixLookup
                     {
-                        const Affine3& mat =  entity->_getParentNodeFullTransform();
-                        *(thisVec)     = static_cast<float>( mat[0][0] );
-                        *(thisVec + 1) = static_cast<float>( mat[0][1] );
-                        *(thisVec + 2) = static_cast<float>( mat[0][2] );
-                        *(thisVec + 3) = static_cast<float>( mat[0][3] );
-                        *(thisVec + 4) = static_cast<float>( mat[1][0] );
-                        *(thisVec + 5) = static_cast<float>( mat[1][1] );
-                        *(thisVec + 6) = static_cast<float>( mat[1][2] );
-                        *(thisVec + 7) = static_cast<float>( mat[1][3] );
-                        *(thisVec + 8) = static_cast<float>( mat[2][0] );
-                        *(thisVec + 9) = static_cast<float>( mat[2][1] );
-                        *(thisVec + 10)= static_cast<float>( mat[2][2] );
-                        *(thisVec + 11)= static_cast<float>( mat[2][3] );
-                        if(currentCamera && mManager->getCameraRelativeRendering()) // && useMatrixLookup
-                        {
-                            const Vector3 &cameraRelativePosition = currentCamera->getDerivedPosition();
-                            *(thisVec + 3) -= static_cast<float>( cameraRelativePosition.x );
-                            *(thisVec + 7) -= static_cast<float>( cameraRelativePosition.y );
-                            *(thisVec + 11) -=  static_cast<float>( cameraRelativePosition.z );
-                        }
-                        thisVec += 12;
+                        const Vector3 &cameraRelativePosition = currentCamera->getDerivedPosition();
+                        *(thisVec + 3) -= static_cast<float>( cameraRelativePosition.x );
+                        *(thisVec + 7) -= static_cast<float>( cameraRelativePosition.y );
+                        *(thisVec + 11) -=  static_cast<float>( cameraRelativePosition.z );
                     }
-                    ++visibleEntityCount;
+                    thisVec += 12;
                 }
+                ++visibleEntityCount;
             }
 
             mInstanceVertexBuffer->unlock();
@@ -401,6 +398,11 @@ namespace Ogre
     {
         size_t renderedInstances = 0;
         bool useMatrixLookup = useBoneMatrixLookup();
+
+        //Cull on an individual basis, the less entities are visible, the less instances we draw.
+        //No need to use null matrices at all!
+        cullInstances( currentCamera );
+
         if (useMatrixLookup)
         {
             //if we are using bone matrix look up we have to update the instance buffer for the 
@@ -420,14 +422,11 @@ namespace Ogre
 
         float *pSource = reinterpret_cast<float*>(pixelBox.data);
         
-        InstancedEntityVec::const_iterator itor = mInstancedEntities.begin();
-        
         vector<bool>::type writtenPositions(getMaxLookupTableInstances(), false);
 
         size_t floatPerEntity = mMatricesPerInstance * mRowLength * 4;
         size_t entitiesPerPadding = (size_t)(mMaxFloatsPerLine / floatPerEntity);
         
-        size_t instanceCount = mInstancedEntities.size();
         size_t updatedInstances = 0;
 
         float* transforms = NULL;
@@ -437,9 +436,9 @@ namespace Ogre
             transforms = mTempTransformsArray3x4;
         }
         
-        for(size_t i = 0 ; i < instanceCount ; ++i)
+        for(size_t i = 0 ; i < mVisibleInstances.size() ; ++i)
         {
-            InstancedEntity* entity = mInstancedEntities[i];
+            InstancedEntity* entity = mInstancedEntities[mVisibleInstances[i]];
             size_t textureLookupPosition = updatedInstances;
             if (useMatrixLookup)
             {
@@ -447,10 +446,7 @@ namespace Ogre
             }
             //Check that we are not using a lookup matrix or that we have not already written
             //The bone data
-            if (((!useMatrixLookup) || !writtenPositions[entity->mTransformLookupNumber]) &&
-                //Cull on an individual basis, the less entities are visible, the less instances we draw.
-                //No need to use null matrices at all!
-                (entity->findVisible( currentCamera )))
+            if ((!useMatrixLookup) || !writtenPositions[entity->mTransformLookupNumber])
             {
                 float* pDest = pSource + floatPerEntity * textureLookupPosition + 
                     (size_t)(textureLookupPosition / entitiesPerPadding) * mWidthFloatsPadding;
@@ -482,8 +478,6 @@ namespace Ogre
                     ++updatedInstances;
                 }
             }
-
-            ++itor;
         }
 
         if (!useMatrixLookup)
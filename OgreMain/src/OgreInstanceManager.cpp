@@ -167,8 +167,7 @@ namespace Ogre
     {
         InstanceBatch *instanceBatch;
 
-        if( mInstanceBatches.empty() ||
-            (mInstanceBatches[materialName].size () == 0))
+        if( mInstanceBatches[materialName].empty() )
             instanceBatch = buildNewBatch( materialName, true );
         else
             instanceBatch = getFreeBatch( materialName );
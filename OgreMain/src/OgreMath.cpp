@@ -48,6 +48,9 @@ namespace Ogre
 
     Math::RandomValueProvider* Math::mRandProvider = NULL;
 
+    /// Provider of the calling thread, see SetThreadRandomValueProvider
+    static thread_local Math::RandomValueProvider* msThreadRandProvider = NULL;
+
     //-----------------------------------------------------------------------
     Math::Math( unsigned int trigTableSize )
     {
@@ -151,7 +154,9 @@ namespace Ogre
     //-----------------------------------------------------------------------
     Real Math::UnitRandom ()
     {
-        if (mRandProvider)
+        if (msThreadRandProvider)
+            return msThreadRandProvider->getRandomUnit();
+        else if (mRandProvider)
             return mRandProvider->getRandomUnit();
         else return Real(rand()) / RAND_MAX;
     }
@@ -161,6 +166,13 @@ namespace Ogre
     {
         mRandProvider = provider;
     }
+    //-----------------------------------------------------------------------
+    Math::RandomValueProvider* Math::SetThreadRandomValueProvider(RandomValueProvider* provider)
+    {
+        RandomValueProvider* previous = msThreadRandProvider;
+        msThreadRandProvider = provider;
+        return previous;
+    }
 
    //-----------------------------------------------------------------------
     void Math::setAngleUnit(Math::AngleUnit unit)
@@ -37,6 +37,7 @@ THE SOFTWARE.
 #include "OgreTangentSpaceCalc.h"
 #include "OgreLodStrategyManager.h"
 #include "OgrePixelCountLodStrategy.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -209,8 +210,10 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless the archive already gave us
+        // memory (e.g. a mapped file) which can be parsed in place
+        if (!dynamic_pointer_cast<MemoryDataStream>(mFreshFromDisk))
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -1929,20 +1932,63 @@ namespace Ogre {
         const Affine3* const* blendMatrices, size_t numMatrices,
         bool blendNormals)
     {
-        float *pSrcPos = 0;
-        float *pSrcNorm = 0;
-        float *pDestPos = 0;
-        float *pDestNorm = 0;
-        float *pBlendWeight = 0;
-        unsigned char* pBlendIdx = 0;
-        size_t srcPosStride = 0;
-        size_t srcNormStride = 0;
-        size_t destPosStride = 0;
-        size_t destNormStride = 0;
-        size_t blendWeightStride = 0;
-        size_t blendIdxStride = 0;
+        SoftwareVertexBlendBatch batch;
+        batch.add(sourceVertexData, targetVertexData, blendMatrices, numMatrices, blendNormals);
+        batch.execute();
+    }
+    //---------------------------------------------------------------------
+    namespace {
+    /// Maximum number of vertices blended by a single task
+    const size_t SOFTWARE_BLEND_VERTICES_PER_TASK = 4096;
+
+    struct SoftwareVertexBlendTask
+    {
+        const Mesh::SoftwareVertexBlendBatch* batch;
 
+        void operator()(size_t begin, size_t end) const
+        {
+            batch->_performBlends(begin, end);
+        }
+    };
+    }
+    //---------------------------------------------------------------------
+    Mesh::SoftwareVertexBlendBatch::SoftwareVertexBlendBatch()
+    {
+    }
+    //---------------------------------------------------------------------
+    Mesh::SoftwareVertexBlendBatch::~SoftwareVertexBlendBatch()
+    {
+        unlockBuffers();
+    }
+    //---------------------------------------------------------------------
+    void* Mesh::SoftwareVertexBlendBatch::lockBuffer(const HardwareVertexBufferSharedPtr& buffer,
+        HardwareBuffer::LockOptions options)
+    {
+        LockedBufferMap::iterator i = mLockedBuffers.find(buffer.get());
+        if (i != mLockedBuffers.end())
+            return i->second.second;
 
+        void* pBuffer = buffer->lock(options);
+        mLockedBuffers[buffer.get()] = std::make_pair(buffer, pBuffer);
+        return pBuffer;
+    }
+    //---------------------------------------------------------------------
+    void Mesh::SoftwareVertexBlendBatch::unlockBuffers(void)
+    {
+        for (LockedBufferMap::iterator i = mLockedBuffers.begin(); i != mLockedBuffers.end(); ++i)
+        {
+            i->second.first->unlock();
+        }
+        mLockedBuffers.clear();
+        mBlends.clear();
+        mBlendMatrices.clear();
+    }
+    //---------------------------------------------------------------------
+    void Mesh::SoftwareVertexBlendBatch::add(const VertexData* sourceVertexData,
+        const VertexData* targetVertexData,
+        const Affine3* const* blendMatrices, size_t numMatrices,
+        bool blendNormals)
+    {
         // Get elements for source
         const VertexElement* srcElemPos =
             sourceVertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
@@ -1963,6 +2009,11 @@ namespace Ogre {
         // Do we have normals and want to blend them?
         bool includeNormals = blendNormals && (srcElemNorm != NULL) && (destElemNorm != NULL);
 
+        Blend blend;
+        blend.srcNorm = 0;
+        blend.destNorm = 0;
+        blend.srcNormStride = 0;
+        blend.destNormStride = 0;
 
         // Get buffers for source
         HardwareVertexBufferSharedPtr srcPosBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemPos->getSource());
@@ -1970,102 +2021,109 @@ namespace Ogre {
         HardwareVertexBufferSharedPtr srcWeightBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemBlendWeights->getSource());
         HardwareVertexBufferSharedPtr srcNormBuf;
 
-        srcPosStride = srcPosBuf->getVertexSize();
-        
-        blendIdxStride = srcIdxBuf->getVertexSize();
-        
-        blendWeightStride = srcWeightBuf->getVertexSize();
+        blend.srcPosStride = srcPosBuf->getVertexSize();
+        blend.blendIndexStride = srcIdxBuf->getVertexSize();
+        blend.blendWeightStride = srcWeightBuf->getVertexSize();
         if (includeNormals)
         {
             srcNormBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemNorm->getSource());
-            srcNormStride = srcNormBuf->getVertexSize();
+            blend.srcNormStride = srcNormBuf->getVertexSize();
         }
         // Get buffers for target
         HardwareVertexBufferSharedPtr destPosBuf = targetVertexData->vertexBufferBinding->getBuffer(destElemPos->getSource());
         HardwareVertexBufferSharedPtr destNormBuf;
-        destPosStride = destPosBuf->getVertexSize();
+        blend.destPosStride = destPosBuf->getVertexSize();
         if (includeNormals)
         {
             destNormBuf = targetVertexData->vertexBufferBinding->getBuffer(destElemNorm->getSource());
-            destNormStride = destNormBuf->getVertexSize();
+            blend.destNormStride = destNormBuf->getVertexSize();
         }
 
-        void* pBuffer;
-
         // Lock source buffers for reading
-        pBuffer = srcPosBuf->lock(HardwareBuffer::HBL_READ_ONLY);
-        srcElemPos->baseVertexPointerToElement(pBuffer, &pSrcPos);
+        float* pFloat;
+        unsigned char* pUChar;
+        srcElemPos->baseVertexPointerToElement(lockBuffer(srcPosBuf, HardwareBuffer::HBL_READ_ONLY), &pFloat);
+        blend.srcPos = pFloat;
         if (includeNormals)
         {
-            if (srcNormBuf != srcPosBuf)
-            {
-                // Different buffer
-                pBuffer = srcNormBuf->lock(HardwareBuffer::HBL_READ_ONLY);
-            }
-            srcElemNorm->baseVertexPointerToElement(pBuffer, &pSrcNorm);
+            srcElemNorm->baseVertexPointerToElement(lockBuffer(srcNormBuf, HardwareBuffer::HBL_READ_ONLY), &pFloat);
+            blend.srcNorm = pFloat;
         }
 
         // Indices must be 4 bytes
         assert(srcElemBlendIndices->getType() == VET_UBYTE4 &&
                "Blend indices must be VET_UBYTE4");
-        pBuffer = srcIdxBuf->lock(HardwareBuffer::HBL_READ_ONLY);
-        srcElemBlendIndices->baseVertexPointerToElement(pBuffer, &pBlendIdx);
-        if (srcWeightBuf != srcIdxBuf)
-        {
-            // Lock buffer
-            pBuffer = srcWeightBuf->lock(HardwareBuffer::HBL_READ_ONLY);
-        }
-        srcElemBlendWeights->baseVertexPointerToElement(pBuffer, &pBlendWeight);
-        unsigned short numWeightsPerVertex =
-            VertexElement::getTypeCount(srcElemBlendWeights->getType());
-
+        srcElemBlendIndices->baseVertexPointerToElement(lockBuffer(srcIdxBuf, HardwareBuffer::HBL_READ_ONLY), &pUChar);
+        blend.blendIndex = pUChar;
+        srcElemBlendWeights->baseVertexPointerToElement(lockBuffer(srcWeightBuf, HardwareBuffer::HBL_READ_ONLY), &pFloat);
+        blend.blendWeight = pFloat;
+        blend.numWeightsPerVertex = VertexElement::getTypeCount(srcElemBlendWeights->getType());
 
         // Lock destination buffers for writing
-        pBuffer = destPosBuf->lock(
+        destElemPos->baseVertexPointerToElement(lockBuffer(destPosBuf,
             (destNormBuf != destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize()) ||
             (destNormBuf == destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize() + destElemNorm->getSize()) ?
-            HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
-        destElemPos->baseVertexPointerToElement(pBuffer, &pDestPos);
+            HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL), &blend.destPos);
         if (includeNormals)
         {
-            if (destNormBuf != destPosBuf)
-            {
-                pBuffer = destNormBuf->lock(
-                    destNormBuf->getVertexSize() == destElemNorm->getSize() ?
-                    HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
-            }
-            destElemNorm->baseVertexPointerToElement(pBuffer, &pDestNorm);
+            destElemNorm->baseVertexPointerToElement(lockBuffer(destNormBuf,
+                destNormBuf->getVertexSize() == destElemNorm->getSize() ?
+                HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL), &blend.destNorm);
         }
 
-        OptimisedUtil::getImplementation()->softwareVertexSkinning(
-            pSrcPos, pDestPos,
-            pSrcNorm, pDestNorm,
-            pBlendWeight, pBlendIdx,
-            blendMatrices,
-            srcPosStride, destPosStride,
-            srcNormStride, destNormStride,
-            blendWeightStride, blendIdxStride,
-            numWeightsPerVertex,
-            targetVertexData->vertexCount);
+        blend.firstMatrix = mBlendMatrices.size();
+        mBlendMatrices.insert(mBlendMatrices.end(), blendMatrices, blendMatrices + numMatrices);
 
-        // Unlock source buffers
-        srcPosBuf->unlock();
-        srcIdxBuf->unlock();
-        if (srcWeightBuf != srcIdxBuf)
+        // Split large blends, so that a single huge mesh is spread over the tasks as well
+        size_t numVertices = targetVertexData->vertexCount;
+        for (size_t first = 0; first < numVertices; first += SOFTWARE_BLEND_VERTICES_PER_TASK)
         {
-            srcWeightBuf->unlock();
+            Blend part = blend;
+            part.numVertices = std::min(numVertices - first, SOFTWARE_BLEND_VERTICES_PER_TASK);
+            part.srcPos = rawOffsetPointer(blend.srcPos, first * blend.srcPosStride);
+            part.destPos = rawOffsetPointer(blend.destPos, first * blend.destPosStride);
+            if (includeNormals)
+            {
+                part.srcNorm = rawOffsetPointer(blend.srcNorm, first * blend.srcNormStride);
+                part.destNorm = rawOffsetPointer(blend.destNorm, first * blend.destNormStride);
+            }
+            part.blendWeight = rawOffsetPointer(blend.blendWeight, first * blend.blendWeightStride);
+            part.blendIndex = rawOffsetPointer(blend.blendIndex, first * blend.blendIndexStride);
+            mBlends.push_back(part);
+        }
+    }
+    //---------------------------------------------------------------------
+    void Mesh::SoftwareVertexBlendBatch::_performBlends(size_t begin, size_t end) const
+    {
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Blend& blend = mBlends[i];
+            util->softwareVertexSkinning(
+                blend.srcPos, blend.destPos,
+                blend.srcNorm, blend.destNorm,
+                blend.blendWeight, blend.blendIndex,
+                mBlendMatrices.empty() ? 0 : &mBlendMatrices[0] + blend.firstMatrix,
+                blend.srcPosStride, blend.destPosStride,
+                blend.srcNormStride, blend.destNormStride,
+                blend.blendWeightStride, blend.blendIndexStride,
+                blend.numWeightsPerVertex,
+                blend.numVertices);
         }
-        if (includeNormals && srcNormBuf != srcPosBuf)
+    }
+    //---------------------------------------------------------------------
+    void Mesh::SoftwareVertexBlendBatch::execute(WorkQueue* queue)
+    {
+        if (queue && mBlends.size() > 1)
         {
-            srcNormBuf->unlock();
+            SoftwareVertexBlendTask task = {this};
+            queue->parallelFor(0, mBlends.size(), 0, task);
         }
-        // Unlock destination buffers
-        destPosBuf->unlock();
-        if (includeNormals && destNormBuf != destPosBuf)
+        else
         {
-            destNormBuf->unlock();
+            _performBlends(0, mBlends.size());
         }
-
+        unlockBuffers();
     }
     //---------------------------------------------------------------------
     void Mesh::softwareVertexMorph(Real t,
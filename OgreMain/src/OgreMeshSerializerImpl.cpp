@@ -44,6 +44,30 @@ namespace Ogre {
 
     /// stream overhead = ID + size
     const long MSTREAM_OVERHEAD_SIZE = sizeof(uint16) + sizeof(uint32);
+    /// Bytes per chunk when the deferred buffer payloads are copied in parallel
+    const size_t BUFFER_READ_GRAIN_SIZE = 256 * 1024;
+
+    /// Copies a range of chunks of the deferred payloads, for WorkQueue::parallelFor
+    struct MeshSerializerImpl::PendingBufferReadTask
+    {
+        const PendingBufferRead* reads;
+        /// Offset of each payload within all payloads, plus the total size
+        const size_t* offsets;
+        size_t numReads;
+
+        void operator()(size_t begin, size_t end) const
+        {
+            size_t first = begin * BUFFER_READ_GRAIN_SIZE;
+            size_t last = std::min(end * BUFFER_READ_GRAIN_SIZE, offsets[numReads]);
+            size_t i = std::upper_bound(offsets, offsets + numReads, first) - offsets - 1;
+            for (; i < numReads && offsets[i] < last; ++i)
+            {
+                size_t from = std::max(first, offsets[i]) - offsets[i];
+                size_t to = std::min(last, offsets[i + 1]) - offsets[i];
+                memcpy(static_cast<uchar*>(reads[i].dest) + from, reads[i].src + from, to - from);
+            }
+        }
+    };
     //---------------------------------------------------------------------
     MeshSerializerImpl::MeshSerializerImpl()
     {
@@ -104,18 +128,85 @@ namespace Ogre {
         pushInnerChunk(stream);
         unsigned short streamID = readChunk(stream);
 
-        while(!stream->eof())
+        try
         {
-            switch (streamID)
+            while(!stream->eof())
             {
-            case M_MESH:
-                readMesh(stream, pMesh, listener);
-                break;
-            }
+                switch (streamID)
+                {
+                case M_MESH:
+                    readMesh(stream, pMesh, listener);
+                    break;
+                }
 
-            streamID = readChunk(stream);
+                streamID = readChunk(stream);
+            }
+        }
+        catch (...)
+        {
+            discardBufferReads();
+            throw;
         }
         popInnerChunk(stream);
+
+        finishBufferReads();
+    }
+    //---------------------------------------------------------------------
+    bool MeshSerializerImpl::deferBufferRead(DataStreamPtr& stream,
+        const SharedPtr<HardwareBuffer>& buffer, size_t size)
+    {
+        MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(stream.get());
+        if (mFlipEndian || !memStream || memStream->size() - memStream->tell() < size)
+            return false;
+
+        PendingBufferRead read;
+        read.buffer = buffer;
+        read.src = memStream->getCurrentPtr();
+        read.dest = buffer->lock(0, size, HardwareBuffer::HBL_DISCARD);
+        read.size = size;
+        mPendingBufferReads.push_back(read);
+        memStream->skip(size);
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::finishBufferReads(void)
+    {
+        if (!mPendingBufferReads.empty())
+        {
+            size_t numReads = mPendingBufferReads.size();
+            vector<size_t>::type offsets(numReads + 1, 0);
+            for (size_t i = 0; i < numReads; ++i)
+                offsets[i + 1] = offsets[i] + mPendingBufferReads[i].size;
+
+            PendingBufferReadTask task = {&mPendingBufferReads[0], &offsets[0], numReads};
+            size_t numChunks = (offsets[numReads] + BUFFER_READ_GRAIN_SIZE - 1) / BUFFER_READ_GRAIN_SIZE;
+            WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+            if (numChunks > 1 && queue && queue->getTaskConcurrency())
+                queue->parallelFor(0, numChunks, 1, task);
+            else
+                task(0, numChunks);
+
+            discardBufferReads();
+        }
+
+        // Perform any necessary colour conversion for an active rendersystem
+        for (size_t i = 0; i < mPendingColourConversions.size(); ++i)
+        {
+            // We don't know the source type if it's VET_COLOUR, but assume ARGB
+            // since that's the most common. Won't get used unless the mesh is
+            // ambiguous anyway, which will have been warned about in the log
+            mPendingColourConversions[i]->convertPackedColour(VET_COLOUR_ARGB,
+                VertexElement::getBestColourVertexElementType());
+        }
+        mPendingColourConversions.clear();
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::discardBufferReads(void)
+    {
+        for (size_t i = 0; i < mPendingBufferReads.size(); ++i)
+            mPendingBufferReads[i].buffer->unlock();
+        mPendingBufferReads.clear();
+        mPendingColourConversions.clear();
     }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::writeMesh(const Mesh* pMesh)
@@ -707,14 +798,11 @@ namespace Ogre {
             popInnerChunk(stream);
         }
 
-        // Perform any necessary colour conversion for an active rendersystem
+        // Perform any necessary colour conversion for an active rendersystem,
+        // once the buffers have been filled
         if (Root::getSingletonPtr() && Root::getSingleton().getRenderSystem())
         {
-            // We don't know the source type if it's VET_COLOUR, but assume ARGB
-            // since that's the most common. Won't get used unless the mesh is
-            // ambiguous anyway, which will have been warned about in the log
-            dest->convertPackedColour(VET_COLOUR_ARGB,
-                VertexElement::getBestColourVertexElementType());
+            mPendingColourConversions.push_back(dest);
         }
     }
     //---------------------------------------------------------------------
@@ -814,16 +902,19 @@ namespace Ogre {
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
             pMesh->mVertexBufferShadowBuffer);
-        void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
-        stream->read(pBuf, dest->vertexCount * vertexSize);
-
-        // endian conversion for OSX
-        flipFromLittleEndian(
-            pBuf,
-            dest->vertexCount,
-            vertexSize,
-            dest->vertexDeclaration->findElementsBySource(bindIndex));
-        vbuf->unlock();
+        if (!deferBufferRead(stream, vbuf, dest->vertexCount * vertexSize))
+        {
+            void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
+            stream->read(pBuf, dest->vertexCount * vertexSize);
+
+            // endian conversion for OSX
+            flipFromLittleEndian(
+                pBuf,
+                dest->vertexCount,
+                vertexSize,
+                dest->vertexDeclaration->findElementsBySource(bindIndex));
+            vbuf->unlock();
+        }
 
         // Set binding
         dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
@@ -1010,12 +1101,15 @@ namespace Ogre {
                         sm->indexData->indexCount,
                         pMesh->mIndexBufferUsage,
                         pMesh->mIndexBufferShadowBuffer);
-                // unsigned int* faceVertexIndices
-                unsigned int* pIdx = static_cast<unsigned int*>(
-                    ibuf->lock(HardwareBuffer::HBL_DISCARD)
-                    );
-                readInts(stream, pIdx, sm->indexData->indexCount);
-                ibuf->unlock();
+                if (!deferBufferRead(stream, ibuf, ibuf->getSizeInBytes()))
+                {
+                    // unsigned int* faceVertexIndices
+                    unsigned int* pIdx = static_cast<unsigned int*>(
+                        ibuf->lock(HardwareBuffer::HBL_DISCARD)
+                        );
+                    readInts(stream, pIdx, sm->indexData->indexCount);
+                    ibuf->unlock();
+                }
 
             }
             else // 16-bit
@@ -1025,12 +1119,15 @@ namespace Ogre {
                         sm->indexData->indexCount,
                         pMesh->mIndexBufferUsage,
                         pMesh->mIndexBufferShadowBuffer);
-                // unsigned short* faceVertexIndices
-                unsigned short* pIdx = static_cast<unsigned short*>(
-                    ibuf->lock(HardwareBuffer::HBL_DISCARD)
-                    );
-                readShorts(stream, pIdx, sm->indexData->indexCount);
-                ibuf->unlock();
+                if (!deferBufferRead(stream, ibuf, ibuf->getSizeInBytes()))
+                {
+                    // unsigned short* faceVertexIndices
+                    unsigned short* pIdx = static_cast<unsigned short*>(
+                        ibuf->lock(HardwareBuffer::HBL_DISCARD)
+                        );
+                    readShorts(stream, pIdx, sm->indexData->indexCount);
+                    ibuf->unlock();
+                }
             }
         }
         sm->indexData->indexBuffer = ibuf;
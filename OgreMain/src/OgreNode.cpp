@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreManualObject.h"
+#include "OgreNodeTransformStore.h"
 
 namespace Ogre {
 
@@ -51,7 +52,9 @@ namespace Ogre {
         mInitialScale(Vector3::UNIT_SCALE),
         mCachedTransformOutOfDate(true),
         mListener(0), 
-        mDebug(0)
+        mDebug(0),
+        mTransformStore(0),
+        mTransformStoreIndex(0)
     {
         needUpdate();
 
@@ -78,7 +81,9 @@ namespace Ogre {
         mInitialScale(Vector3::UNIT_SCALE),
         mCachedTransformOutOfDate(true),
         mListener(0), 
-        mDebug(0)
+        mDebug(0),
+        mTransformStore(0),
+        mTransformStoreIndex(0)
 
     {
 
@@ -102,6 +107,9 @@ namespace Ogre {
         if(mParent)
             mParent->removeChild(this);
 
+        if (mTransformStore)
+            mTransformStore->_notifyNodeDestroyed(this);
+
         if (mQueuedForUpdate)
         {
             // Erase from queued updates
@@ -123,6 +131,12 @@ namespace Ogre {
     {
         bool different = (parent != mParent);
 
+        // Layout of the transform store(s) involved is now out of date
+        if (different && mTransformStore)
+            mTransformStore->_notifyHierarchyChanged();
+        if (different && parent && parent->mTransformStore)
+            parent->mTransformStore->_notifyHierarchyChanged();
+
         mParent = parent;
         // Request update from parent
         mParentNotified = false ;
@@ -226,6 +240,23 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    bool Node::_collectChildrenToUpdate(bool parentHasChanged, ChildNodeMap& children)
+    {
+        bool childParentChanged = mNeedChildUpdate || parentHasChanged;
+        if (childParentChanged)
+        {
+            children.insert(children.end(), mChildren.begin(), mChildren.end());
+        }
+        else
+        {
+            children.insert(children.end(), mChildrenToUpdate.begin(), mChildrenToUpdate.end());
+        }
+
+        mChildrenToUpdate.clear();
+        mNeedChildUpdate = false;
+        return childParentChanged;
+    }
+    //-----------------------------------------------------------------------
     void Node::_updateFromParent(void) const
     {
         updateFromParentImpl();
@@ -782,6 +813,9 @@ namespace Ogre {
         mNeedChildUpdate = true;
         mCachedTransformOutOfDate = true;
 
+        if (mTransformStore)
+            mTransformStore->_notifyLocalTransformChanged(this);
+
         // Make sure we're not root and parent hasn't been notified before
         if (mParent && (!mParentNotified || forceParentUpdate))
         {
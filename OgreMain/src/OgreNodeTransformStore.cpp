@@ -0,0 +1,397 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreNodeTransformStore.h"
+#include "OgreNode.h"
+
+#if __OGRE_HAVE_SSE
+#include "OgreSIMDHelper.h"
+#endif
+
+namespace Ogre {
+
+    namespace {
+        /// Raw component pointers of NodeTransformStore::Transforms, for the kernels
+        struct TransformArrays
+        {
+            Real *posX, *posY, *posZ;
+            Real *rotW, *rotX, *rotY, *rotZ;
+            Real *sclX, *sclY, *sclZ;
+        };
+        //---------------------------------------------------------------------
+        void updateTransformsGeneral(const TransformArrays& local, const TransformArrays& derived,
+            const uint32* parents, const uint8* flags, uint8 inheritOrientation, uint8 inheritScale,
+            size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const uint32 p = parents[i];
+                Quaternion parentOrient(derived.rotW[p], derived.rotX[p], derived.rotY[p], derived.rotZ[p]);
+                Vector3 parentScale(derived.sclX[p], derived.sclY[p], derived.sclZ[p]);
+                Quaternion orient(local.rotW[i], local.rotX[i], local.rotY[i], local.rotZ[i]);
+                Vector3 scale(local.sclX[i], local.sclY[i], local.sclZ[i]);
+
+                if (flags[i] & inheritOrientation)
+                    orient = parentOrient * orient;
+                if (flags[i] & inheritScale)
+                    scale = parentScale * scale;
+
+                Vector3 pos = parentOrient * (parentScale * Vector3(local.posX[i], local.posY[i], local.posZ[i]));
+
+                derived.posX[i] = pos.x + derived.posX[p];
+                derived.posY[i] = pos.y + derived.posY[p];
+                derived.posZ[i] = pos.z + derived.posZ[p];
+                derived.rotW[i] = orient.w;
+                derived.rotX[i] = orient.x;
+                derived.rotY[i] = orient.y;
+                derived.rotZ[i] = orient.z;
+                derived.sclX[i] = scale.x;
+                derived.sclY[i] = scale.y;
+                derived.sclZ[i] = scale.z;
+            }
+        }
+#if __OGRE_HAVE_SSE
+        //---------------------------------------------------------------------
+        /// Load the parent components of four nodes into one register
+        #define __GATHER_PS(arr, p) _mm_setr_ps(arr[p[0]], arr[p[1]], arr[p[2]], arr[p[3]])
+        /// Select a where mask is set, b otherwise
+        #define __SELECT_PS(mask, a, b) _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b))
+        //---------------------------------------------------------------------
+        size_t __OGRE_SIMD_ALIGN_ATTRIBUTE updateTransformsSSE(const TransformArrays& local,
+            const TransformArrays& derived, const uint32* parents, const uint8* flags,
+            uint8 inheritOrientation, uint8 inheritScale, size_t begin, size_t end)
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 two = _mm_set_ps1(2.0f);
+
+            size_t i = begin;
+            for (; i + 4 <= end; i += 4)
+            {
+                const uint32* p = parents + i;
+                const uint8* f = flags + i;
+
+                __m128 pw = __GATHER_PS(derived.rotW, p);
+                __m128 px = __GATHER_PS(derived.rotX, p);
+                __m128 py = __GATHER_PS(derived.rotY, p);
+                __m128 pz = __GATHER_PS(derived.rotZ, p);
+
+                __m128 lw = _mm_loadu_ps(local.rotW + i);
+                __m128 lx = _mm_loadu_ps(local.rotX + i);
+                __m128 ly = _mm_loadu_ps(local.rotY + i);
+                __m128 lz = _mm_loadu_ps(local.rotZ + i);
+
+                // Orientation: parent * local, where inherited
+                __m128 inheritO = _mm_cmpneq_ps(_mm_setr_ps(
+                    (f[0] & inheritOrientation) ? 1.0f : 0.0f, (f[1] & inheritOrientation) ? 1.0f : 0.0f,
+                    (f[2] & inheritOrientation) ? 1.0f : 0.0f, (f[3] & inheritOrientation) ? 1.0f : 0.0f), zero);
+
+                __m128 qw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(pw, lw), _mm_mul_ps(px, lx)),
+                                       _mm_add_ps(_mm_mul_ps(py, ly), _mm_mul_ps(pz, lz)));
+                __m128 qx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pw, lx), _mm_mul_ps(px, lw)),
+                                                  _mm_mul_ps(py, lz)), _mm_mul_ps(pz, ly));
+                __m128 qy = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pw, ly), _mm_mul_ps(py, lw)),
+                                                  _mm_mul_ps(pz, lx)), _mm_mul_ps(px, lz));
+                __m128 qz = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pw, lz), _mm_mul_ps(pz, lw)),
+                                                  _mm_mul_ps(px, ly)), _mm_mul_ps(py, lx));
+
+                _mm_storeu_ps(derived.rotW + i, __SELECT_PS(inheritO, qw, lw));
+                _mm_storeu_ps(derived.rotX + i, __SELECT_PS(inheritO, qx, lx));
+                _mm_storeu_ps(derived.rotY + i, __SELECT_PS(inheritO, qy, ly));
+                _mm_storeu_ps(derived.rotZ + i, __SELECT_PS(inheritO, qz, lz));
+
+                // Scale: parent * local, where inherited
+                __m128 psx = __GATHER_PS(derived.sclX, p);
+                __m128 psy = __GATHER_PS(derived.sclY, p);
+                __m128 psz = __GATHER_PS(derived.sclZ, p);
+
+                __m128 lsx = _mm_loadu_ps(local.sclX + i);
+                __m128 lsy = _mm_loadu_ps(local.sclY + i);
+                __m128 lsz = _mm_loadu_ps(local.sclZ + i);
+
+                __m128 inheritS = _mm_cmpneq_ps(_mm_setr_ps(
+                    (f[0] & inheritScale) ? 1.0f : 0.0f, (f[1] & inheritScale) ? 1.0f : 0.0f,
+                    (f[2] & inheritScale) ? 1.0f : 0.0f, (f[3] & inheritScale) ? 1.0f : 0.0f), zero);
+
+                _mm_storeu_ps(derived.sclX + i, __SELECT_PS(inheritS, _mm_mul_ps(psx, lsx), lsx));
+                _mm_storeu_ps(derived.sclY + i, __SELECT_PS(inheritS, _mm_mul_ps(psy, lsy), lsy));
+                _mm_storeu_ps(derived.sclZ + i, __SELECT_PS(inheritS, _mm_mul_ps(psz, lsz), lsz));
+
+                // Position: parent orientation * (parent scale * local) + parent position
+                __m128 vx = _mm_mul_ps(psx, _mm_loadu_ps(local.posX + i));
+                __m128 vy = _mm_mul_ps(psy, _mm_loadu_ps(local.posY + i));
+                __m128 vz = _mm_mul_ps(psz, _mm_loadu_ps(local.posZ + i));
+
+                // uv = q.xyz x v, uuv = q.xyz x uv
+                __m128 uvx = _mm_sub_ps(_mm_mul_ps(py, vz), _mm_mul_ps(pz, vy));
+                __m128 uvy = _mm_sub_ps(_mm_mul_ps(pz, vx), _mm_mul_ps(px, vz));
+                __m128 uvz = _mm_sub_ps(_mm_mul_ps(px, vy), _mm_mul_ps(py, vx));
+                __m128 uuvx = _mm_sub_ps(_mm_mul_ps(py, uvz), _mm_mul_ps(pz, uvy));
+                __m128 uuvy = _mm_sub_ps(_mm_mul_ps(pz, uvx), _mm_mul_ps(px, uvz));
+                __m128 uuvz = _mm_sub_ps(_mm_mul_ps(px, uvy), _mm_mul_ps(py, uvx));
+
+                // v + uv * 2w + uuv * 2
+                __m128 w2 = _mm_mul_ps(pw, two);
+                vx = _mm_add_ps(_mm_add_ps(vx, _mm_mul_ps(uvx, w2)), _mm_mul_ps(uuvx, two));
+                vy = _mm_add_ps(_mm_add_ps(vy, _mm_mul_ps(uvy, w2)), _mm_mul_ps(uuvy, two));
+                vz = _mm_add_ps(_mm_add_ps(vz, _mm_mul_ps(uvz, w2)), _mm_mul_ps(uuvz, two));
+
+                _mm_storeu_ps(derived.posX + i, _mm_add_ps(vx, __GATHER_PS(derived.posX, p)));
+                _mm_storeu_ps(derived.posY + i, _mm_add_ps(vy, __GATHER_PS(derived.posY, p)));
+                _mm_storeu_ps(derived.posZ + i, _mm_add_ps(vz, __GATHER_PS(derived.posZ, p)));
+            }
+
+            return i;
+        }
+        #undef __GATHER_PS
+        #undef __SELECT_PS
+#endif
+        //---------------------------------------------------------------------
+        TransformArrays getArrays(vector<Real>::type& posX, vector<Real>::type& posY, vector<Real>::type& posZ,
+            vector<Real>::type& rotW, vector<Real>::type& rotX, vector<Real>::type& rotY, vector<Real>::type& rotZ,
+            vector<Real>::type& sclX, vector<Real>::type& sclY, vector<Real>::type& sclZ)
+        {
+            TransformArrays ret = {
+                &posX[0], &posY[0], &posZ[0],
+                &rotW[0], &rotX[0], &rotY[0], &rotZ[0],
+                &sclX[0], &sclY[0], &sclZ[0] };
+            return ret;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::Transforms::resize(size_t n)
+    {
+        posX.resize(n); posY.resize(n); posZ.resize(n);
+        rotW.resize(n); rotX.resize(n); rotY.resize(n); rotZ.resize(n);
+        sclX.resize(n); sclY.resize(n); sclZ.resize(n);
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::Transforms::set(size_t i, const Vector3& pos, const Quaternion& orient,
+                                             const Vector3& scale)
+    {
+        posX[i] = pos.x; posY[i] = pos.y; posZ[i] = pos.z;
+        rotW[i] = orient.w; rotX[i] = orient.x; rotY[i] = orient.y; rotZ[i] = orient.z;
+        sclX[i] = scale.x; sclY[i] = scale.y; sclZ[i] = scale.z;
+    }
+    //-----------------------------------------------------------------------
+    NodeTransformStore::NodeTransformStore(Node* root)
+        : mRoot(root), mLayoutDirty(true)
+    {
+        OgreAssert(root, "root must not be NULL");
+    }
+    //-----------------------------------------------------------------------
+    NodeTransformStore::~NodeTransformStore()
+    {
+        for (NodeList::iterator i = mNodes.begin(); i != mNodes.end(); ++i)
+        {
+            if (*i)
+                (*i)->mTransformStore = 0;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::_notifyLocalTransformChanged(Node* node)
+    {
+        // everything is reloaded with the new layout anyway
+        if (mLayoutDirty)
+            return;
+
+        loadLocal(node->mTransformStoreIndex, node);
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::_notifyNodeDestroyed(Node* node)
+    {
+        assert(mNodes[node->mTransformStoreIndex] == node);
+        mNodes[node->mTransformStoreIndex] = 0;
+        mLayoutDirty = true;
+
+        if (node == mRoot)
+            mRoot = 0;
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::loadLocal(size_t index, const Node* node)
+    {
+        mLocal.set(index, node->mPosition, node->mOrientation, node->mScale);
+
+        uint8 flags = mFlags[index] & (FLAG_CHANGED | FLAG_BRANCH_CHANGED);
+        flags |= FLAG_DIRTY;
+        if (node->mInheritOrientation)
+            flags |= FLAG_INHERIT_ORIENTATION;
+        if (node->mInheritScale)
+            flags |= FLAG_INHERIT_SCALE;
+        mFlags[index] = flags;
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::rebuildLayout(void)
+    {
+        // Release nodes of the previous layout, some may not be below the root anymore
+        for (NodeList::iterator i = mNodes.begin(); i != mNodes.end(); ++i)
+        {
+            if (*i)
+                (*i)->mTransformStore = 0;
+        }
+        mNodes.clear();
+        mParents.clear();
+        mLevelStart.clear();
+        mLayoutDirty = false;
+
+        if (!mRoot)
+            return;
+
+        // Breadth-first walk, so every level is contiguous and parents come first
+        mNodes.push_back(mRoot);
+        mParents.push_back(0);
+        mLevelStart.push_back(0);
+
+        size_t levelBegin = 0;
+        while (levelBegin < mNodes.size())
+        {
+            size_t levelEnd = mNodes.size();
+            for (size_t i = levelBegin; i < levelEnd; ++i)
+            {
+                const Node::ChildNodeMap& children = mNodes[i]->getChildren();
+                for (Node::ChildNodeMap::const_iterator c = children.begin(); c != children.end(); ++c)
+                {
+                    mNodes.push_back(*c);
+                    mParents.push_back(static_cast<uint32>(i));
+                }
+            }
+            mLevelStart.push_back(levelEnd);
+            levelBegin = levelEnd;
+        }
+
+        size_t numNodes = mNodes.size();
+        mFlags.assign(numNodes, 0);
+        mLocal.resize(numNodes);
+        mDerived.resize(numNodes);
+        mDerivedTransforms.resize(numNodes);
+
+        for (size_t i = 0; i < numNodes; ++i)
+        {
+            Node* node = mNodes[i];
+            node->mTransformStore = this;
+            node->mTransformStoreIndex = static_cast<uint32>(i);
+            loadLocal(i, node);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::updateRange(size_t begin, size_t end)
+    {
+        TransformArrays local = getArrays(mLocal.posX, mLocal.posY, mLocal.posZ,
+            mLocal.rotW, mLocal.rotX, mLocal.rotY, mLocal.rotZ, mLocal.sclX, mLocal.sclY, mLocal.sclZ);
+        TransformArrays derived = getArrays(mDerived.posX, mDerived.posY, mDerived.posZ,
+            mDerived.rotW, mDerived.rotX, mDerived.rotY, mDerived.rotZ, mDerived.sclX, mDerived.sclY, mDerived.sclZ);
+
+#if __OGRE_HAVE_SSE
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_SSE))
+        {
+            begin = updateTransformsSSE(local, derived, &mParents[0], &mFlags[0],
+                FLAG_INHERIT_ORIENTATION, FLAG_INHERIT_SCALE, begin, end);
+        }
+#endif
+        updateTransformsGeneral(local, derived, &mParents[0], &mFlags[0],
+            FLAG_INHERIT_ORIENTATION, FLAG_INHERIT_SCALE, begin, end);
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::update(void)
+    {
+        if (mLayoutDirty)
+            rebuildLayout();
+
+        if (mNodes.empty())
+            return;
+
+        const uint8 changedMask = FLAG_CHANGED | FLAG_BRANCH_CHANGED;
+        size_t numNodes = mNodes.size();
+
+        // The root has nothing to inherit from
+        mFlags[0] &= ~changedMask;
+        if (mFlags[0] & FLAG_DIRTY)
+        {
+            mFlags[0] = (mFlags[0] & ~FLAG_DIRTY) | changedMask;
+            mDerived.set(0, mRoot->mPosition, mRoot->mOrientation, mRoot->mScale);
+        }
+
+        // Propagate changes down level by level, skipping levels without any
+        for (size_t level = 1; level + 1 < mLevelStart.size(); ++level)
+        {
+            size_t begin = mLevelStart[level];
+            size_t end = mLevelStart[level + 1];
+            bool levelChanged = false;
+            for (size_t i = begin; i < end; ++i)
+            {
+                uint8 flags = mFlags[i] & ~changedMask;
+                if ((flags & FLAG_DIRTY) || (mFlags[mParents[i]] & FLAG_CHANGED))
+                {
+                    flags = (flags & ~FLAG_DIRTY) | changedMask;
+                    levelChanged = true;
+                }
+                mFlags[i] = flags;
+            }
+
+            if (levelChanged)
+                updateRange(begin, end);
+        }
+
+        // Propagate branch changes up, children always come after their parent
+        for (size_t i = numNodes - 1; i > 0; --i)
+        {
+            if (mFlags[i] & FLAG_BRANCH_CHANGED)
+                mFlags[mParents[i]] |= FLAG_BRANCH_CHANGED;
+        }
+
+        // Write back into the nodes
+        for (size_t i = 0; i < numNodes; ++i)
+        {
+            uint8 flags = mFlags[i];
+            if (!(flags & FLAG_BRANCH_CHANGED))
+                continue;
+
+            Node* node = mNodes[i];
+            if (flags & FLAG_CHANGED)
+            {
+                node->mDerivedPosition = Vector3(mDerived.posX[i], mDerived.posY[i], mDerived.posZ[i]);
+                node->mDerivedOrientation =
+                    Quaternion(mDerived.rotW[i], mDerived.rotX[i], mDerived.rotY[i], mDerived.rotZ[i]);
+                node->mDerivedScale = Vector3(mDerived.sclX[i], mDerived.sclY[i], mDerived.sclZ[i]);
+
+                mDerivedTransforms[i].makeTransform(
+                    node->mDerivedPosition, node->mDerivedScale, node->mDerivedOrientation);
+                node->mCachedTransform = mDerivedTransforms[i];
+                node->mCachedTransformOutOfDate = false;
+                node->mNeedParentUpdate = false;
+
+                node->updateFromTransformStoreImpl();
+                if (node->mListener)
+                    node->mListener->nodeUpdated(node);
+            }
+
+            node->mParentNotified = false;
+            node->mNeedChildUpdate = false;
+            node->mChildrenToUpdate.clear();
+        }
+    }
+}
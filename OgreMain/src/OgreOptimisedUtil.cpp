@@ -37,6 +37,7 @@ namespace Ogre {
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
 #if __OGRE_HAVE_SSE
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
+    extern OptimisedUtil* _getOptimisedUtilAVX(void);
 //#elif __OGRE_HAVE_NEON
 //    extern OptimisedUtil* _getOptimisedUtilNEON(void);
 //#elif __OGRE_HAVE_VFP
@@ -398,6 +399,14 @@ namespace Ogre {
 #if __OGRE_HAVE_SSE
         if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE)
         {
+            // The AVX2 version is null if the compiler couldn't build it
+            const uint avx2Features =
+                PlatformInformation::CPU_FEATURE_AVX2 | PlatformInformation::CPU_FEATURE_FMA;
+            if ((PlatformInformation::getCpuFeatures() & avx2Features) == avx2Features &&
+                _getOptimisedUtilAVX())
+            {
+                return _getOptimisedUtilAVX();
+            }
             return _getOptimisedUtilSSE();
         }
         else
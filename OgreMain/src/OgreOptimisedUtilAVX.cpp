@@ -0,0 +1,465 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreOptimisedUtil.h"
+
+//-------------------------------------------------------------------------
+//
+// gcc and clang only generate AVX2/FMA code for this file when the build
+// passes -mavx2 -mfma for it, msvc allows the intrinsics anywhere. Whether
+// the CPU can run it is checked at run-time by OptimisedUtil.
+//
+// Since the whole file is compiled for AVX2, don't call non-static inline
+// functions of other headers here: the linker may pick the AVX2 copy of
+// them for the rest of the library, which then would no longer run on
+// older CPUs.
+//
+//-------------------------------------------------------------------------
+
+#if __OGRE_HAVE_SSE && ((defined(__AVX2__) && defined(__FMA__)) || \
+    (OGRE_COMPILER == OGRE_COMPILER_MSVC && _MSC_VER >= 1800))
+#   define __OGRE_HAVE_AVX2 1
+#else
+#   define __OGRE_HAVE_AVX2 0
+#endif
+
+#if __OGRE_HAVE_AVX2
+
+#include <immintrin.h>
+
+namespace Ogre {
+
+    extern OptimisedUtil* _getOptimisedUtilSSE(void);
+
+//-------------------------------------------------------------------------
+// Local classes
+//-------------------------------------------------------------------------
+
+    /** AVX2 implementation of OptimisedUtil.
+    @remarks
+        Only the routines that gain from the wider registers and fused
+        multiply-add are implemented here, everything else is left to the
+        SSE implementation.
+    @note
+        Don't use this class directly, use OptimisedUtil instead.
+    */
+    class _OgrePrivate OptimisedUtilAVX : public OptimisedUtil
+    {
+    protected:
+        /// The implementation used for all routines not implemented here
+        OptimisedUtil* mFallback;
+
+    public:
+        /// Constructor
+        OptimisedUtilAVX(void) : mFallback(_getOptimisedUtilSSE()) {}
+
+        /// @copydoc OptimisedUtil::softwareVertexSkinning
+        virtual void softwareVertexSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const Affine3* const* blendMatrices,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::softwareVertexMorph
+        virtual void softwareVertexMorph(
+            Real t,
+            const float *srcPos1, const float *srcPos2,
+            float *dstPos,
+            size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+            size_t numVertices,
+            bool morphNormals)
+        {
+            mFallback->softwareVertexMorph(
+                t, srcPos1, srcPos2, dstPos,
+                pos1VSize, pos2VSize, dstVSize, numVertices, morphNormals);
+        }
+
+        /// @copydoc OptimisedUtil::concatenateAffineMatrices
+        virtual void concatenateAffineMatrices(
+            const Affine3& baseMatrix,
+            const Affine3* srcMatrices,
+            Affine3* dstMatrices,
+            size_t numMatrices)
+        {
+            mFallback->concatenateAffineMatrices(baseMatrix, srcMatrices, dstMatrices, numMatrices);
+        }
+
+        /// @copydoc OptimisedUtil::calculateFaceNormals
+        virtual void calculateFaceNormals(
+            const float *positions,
+            const EdgeData::Triangle *triangles,
+            Vector4 *faceNormals,
+            size_t numTriangles)
+        {
+            mFallback->calculateFaceNormals(positions, triangles, faceNormals, numTriangles);
+        }
+
+        /// @copydoc OptimisedUtil::calculateLightFacing
+        virtual void calculateLightFacing(
+            const Vector4& lightPos,
+            const Vector4* faceNormals,
+            char* lightFacings,
+            size_t numFaces)
+        {
+            mFallback->calculateLightFacing(lightPos, faceNormals, lightFacings, numFaces);
+        }
+
+        /// @copydoc OptimisedUtil::extrudeVertices
+        virtual void extrudeVertices(
+            const Vector4& lightPos,
+            Real extrudeDist,
+            const float* srcPositions,
+            float* destPositions,
+            size_t numVertices)
+        {
+            mFallback->extrudeVertices(lightPos, extrudeDist, srcPositions, destPositions, numVertices);
+        }
+
+        /// @copydoc OptimisedUtil::convertUByteToFloat
+        virtual void convertUByteToFloat(const uint8* src, float* dst, size_t count)
+        {
+            mFallback->convertUByteToFloat(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertFloatToUByte
+        virtual void convertFloatToUByte(const float* src, uint8* dst, size_t count)
+        {
+            mFallback->convertFloatToUByte(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertHalfToFloat
+        virtual void convertHalfToFloat(const uint16* src, float* dst, size_t count)
+        {
+            mFallback->convertHalfToFloat(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertFloatToHalf
+        virtual void convertFloatToHalf(const float* src, uint16* dst, size_t count)
+        {
+            mFallback->convertFloatToHalf(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::linearResampleRowUByte4
+        virtual void linearResampleRowUByte4(
+            const uint8* srcRow1,
+            const uint8* srcRow2,
+            uint32 syf,
+            const uint32* sx1,
+            const uint32* sx2,
+            const uint32* sxf,
+            uint8* dst,
+            size_t count)
+        {
+            mFallback->linearResampleRowUByte4(srcRow1, srcRow2, syf, sx1, sx2, sxf, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::accumulateUBytes
+        virtual void accumulateUBytes(const uint8* src, uint32* accum, size_t count)
+        {
+            mFallback->accumulateUBytes(src, accum, count);
+        }
+
+        /// @copydoc OptimisedUtil::generateBillboardQuads
+        virtual void generateBillboardQuads(
+            const float* centres, const float* texcoords, const float* offsets,
+            float* dest, size_t count)
+        {
+            mFallback->generateBillboardQuads(centres, texcoords, offsets, dest, count);
+        }
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual size_t cullSpheres(
+            const float* planes,
+            size_t numPlanes,
+            const float* spheres,
+            uint32* visible,
+            size_t count);
+    };
+
+//-------------------------------------------------------------------------
+// Local helpers
+//-------------------------------------------------------------------------
+
+    /// Advances the pointer by a number of bytes, local since this file is compiled for AVX2
+    template <class T>
+    static OGRE_FORCE_INLINE void _advanceRawPointer(T*& ptr, size_t offset)
+    {
+        ptr = (T*)((const char*)(ptr) + offset);
+    }
+
+    /// Transposes the 8x8 matrix held in the rows r, in place
+    static OGRE_FORCE_INLINE void _transpose8(__m256 r[8])
+    {
+        __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+        __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+        __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+        __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+        __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+        __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+        __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+        __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+        __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+        r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+        r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+        r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+        r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+        r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+        r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+        r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+    }
+
+    /// Computes r0 * x + r1 * y + r2 * z for eight vectors at once
+    static OGRE_FORCE_INLINE __m256 _dot3(__m256 r0, __m256 r1, __m256 r2, __m256 x, __m256 y, __m256 z)
+    {
+        return _mm256_fmadd_ps(r0, x, _mm256_fmadd_ps(r1, y, _mm256_mul_ps(r2, z)));
+    }
+
+//-------------------------------------------------------------------------
+// OptimisedUtilAVX implementation
+//-------------------------------------------------------------------------
+
+    void OptimisedUtilAVX::softwareVertexSkinning(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        // Eight vertices per iteration, the last one padded with zero lanes.
+        // The matrix entries are accessed directly, see the note at the top.
+        float x[8], y[8], z[8];
+        float lastRows[8][4];
+        for (size_t first = 0; first < numVertices; first += 8)
+        {
+            size_t count = numVertices - first < 8 ? numVertices - first : 8;
+
+            // Collapse the weighted matrices of each vertex, the first two rows
+            // in one 256 bit register and the last one in a 128 bit register
+            __m256 rows[8];
+            for (size_t lane = 0; lane < 8; ++lane)
+            {
+                __m256 m01 = _mm256_setzero_ps();
+                __m128 m2 = _mm_setzero_ps();
+                if (lane < count)
+                {
+                    for (size_t blendIdx = 0; blendIdx < numWeightsPerVertex; ++blendIdx)
+                    {
+                        float weight = pBlendWeight[blendIdx];
+                        if (weight)
+                        {
+                            const float* mat = reinterpret_cast<const float*>(blendMatrices[pBlendIndex[blendIdx]]);
+                            m01 = _mm256_fmadd_ps(_mm256_set1_ps(weight), _mm256_loadu_ps(mat), m01);
+                            m2 = _mm_fmadd_ps(_mm_set1_ps(weight), _mm_loadu_ps(mat + 8), m2);
+                        }
+                    }
+                    x[lane] = pSrcPos[0];
+                    y[lane] = pSrcPos[1];
+                    z[lane] = pSrcPos[2];
+                    _advanceRawPointer(pSrcPos, srcPosStride);
+                    _advanceRawPointer(pBlendWeight, blendWeightStride);
+                    _advanceRawPointer(pBlendIndex, blendIndexStride);
+                }
+                else
+                {
+                    x[lane] = y[lane] = z[lane] = 0.0f;
+                }
+                rows[lane] = m01;
+                _mm_storeu_ps(lastRows[lane], m2);
+            }
+
+            // One register per matrix entry, holding it for all eight vertices
+            __m256 m[12];
+            _transpose8(rows);
+            for (size_t i = 0; i < 8; ++i)
+                m[i] = rows[i];
+            __m128 a0 = _mm_loadu_ps(lastRows[0]), a1 = _mm_loadu_ps(lastRows[1]);
+            __m128 a2 = _mm_loadu_ps(lastRows[2]), a3 = _mm_loadu_ps(lastRows[3]);
+            __m128 b0 = _mm_loadu_ps(lastRows[4]), b1 = _mm_loadu_ps(lastRows[5]);
+            __m128 b2 = _mm_loadu_ps(lastRows[6]), b3 = _mm_loadu_ps(lastRows[7]);
+            _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+            _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+            m[8] = _mm256_insertf128_ps(_mm256_castps128_ps256(a0), b0, 1);
+            m[9] = _mm256_insertf128_ps(_mm256_castps128_ps256(a1), b1, 1);
+            m[10] = _mm256_insertf128_ps(_mm256_castps128_ps256(a2), b2, 1);
+            m[11] = _mm256_insertf128_ps(_mm256_castps128_ps256(a3), b3, 1);
+
+            __m256 px = _mm256_loadu_ps(x), py = _mm256_loadu_ps(y), pz = _mm256_loadu_ps(z);
+            _mm256_storeu_ps(x, _mm256_add_ps(_dot3(m[0], m[1], m[2], px, py, pz), m[3]));
+            _mm256_storeu_ps(y, _mm256_add_ps(_dot3(m[4], m[5], m[6], px, py, pz), m[7]));
+            _mm256_storeu_ps(z, _mm256_add_ps(_dot3(m[8], m[9], m[10], px, py, pz), m[11]));
+            for (size_t lane = 0; lane < count; ++lane)
+            {
+                pDestPos[0] = x[lane];
+                pDestPos[1] = y[lane];
+                pDestPos[2] = z[lane];
+                _advanceRawPointer(pDestPos, destPosStride);
+            }
+
+            if (pSrcNorm)
+            {
+                for (size_t lane = 0; lane < 8; ++lane)
+                {
+                    if (lane < count)
+                    {
+                        x[lane] = pSrcNorm[0];
+                        y[lane] = pSrcNorm[1];
+                        z[lane] = pSrcNorm[2];
+                        _advanceRawPointer(pSrcNorm, srcNormStride);
+                    }
+                    else
+                    {
+                        x[lane] = y[lane] = z[lane] = 0.0f;
+                    }
+                }
+
+                // Rotation only, then normalise since the weighted sum of rotations
+                // doesn't keep the length
+                __m256 nx = _mm256_loadu_ps(x), ny = _mm256_loadu_ps(y), nz = _mm256_loadu_ps(z);
+                __m256 tx = _dot3(m[0], m[1], m[2], nx, ny, nz);
+                __m256 ty = _dot3(m[4], m[5], m[6], nx, ny, nz);
+                __m256 tz = _dot3(m[8], m[9], m[10], nx, ny, nz);
+                __m256 length = _mm256_sqrt_ps(_dot3(tx, ty, tz, tx, ty, tz));
+                __m256 nonZero = _mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_GT_OQ);
+                __m256 scale = _mm256_blendv_ps(_mm256_set1_ps(1.0f),
+                    _mm256_div_ps(_mm256_set1_ps(1.0f), length), nonZero);
+                _mm256_storeu_ps(x, _mm256_mul_ps(tx, scale));
+                _mm256_storeu_ps(y, _mm256_mul_ps(ty, scale));
+                _mm256_storeu_ps(z, _mm256_mul_ps(tz, scale));
+                for (size_t lane = 0; lane < count; ++lane)
+                {
+                    pDestNorm[0] = x[lane];
+                    pDestNorm[1] = y[lane];
+                    pDestNorm[2] = z[lane];
+                    _advanceRawPointer(pDestNorm, destNormStride);
+                }
+            }
+        }
+        _mm256_zeroupper();
+    }
+    //---------------------------------------------------------------------
+    size_t OptimisedUtilAVX::cullSpheres(
+        const float* planes,
+        size_t numPlanes,
+        const float* spheres,
+        uint32* visible,
+        size_t count)
+    {
+        size_t numVisible = 0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8, spheres += 32)
+        {
+            // Spheres i and i + 4 share a register, transposing each lane the
+            // way _MM_TRANSPOSE4_PS does gives x, y, z and radius of all eight
+            __m256 s04 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(spheres + 0)), _mm_loadu_ps(spheres + 16), 1);
+            __m256 s15 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(spheres + 4)), _mm_loadu_ps(spheres + 20), 1);
+            __m256 s26 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(spheres + 8)), _mm_loadu_ps(spheres + 24), 1);
+            __m256 s37 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(spheres + 12)), _mm_loadu_ps(spheres + 28), 1);
+            __m256 t0 = _mm256_unpacklo_ps(s04, s15);
+            __m256 t1 = _mm256_unpacklo_ps(s26, s37);
+            __m256 t2 = _mm256_unpackhi_ps(s04, s15);
+            __m256 t3 = _mm256_unpackhi_ps(s26, s37);
+            __m256 x = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 y = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 z = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(),
+                _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+
+            // No fused multiply-add, so the distances round like the general version
+            __m256 outside = _mm256_setzero_ps();
+            const float* plane = planes;
+            for (size_t p = 0; p < numPlanes; ++p, plane += 4)
+            {
+                __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(_mm256_set1_ps(plane[0]), x),
+                    _mm256_mul_ps(_mm256_set1_ps(plane[1]), y)),
+                    _mm256_mul_ps(_mm256_set1_ps(plane[2]), z)),
+                    _mm256_set1_ps(plane[3]));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negRadius, _CMP_LT_OQ));
+                if (_mm256_movemask_ps(outside) == 0xFF)
+                    break;
+            }
+
+            // Compact the indices of the visible ones without branching
+            int mask = _mm256_movemask_ps(outside);
+            for (uint32 j = 0; j < 8; ++j)
+            {
+                visible[numVisible] = static_cast<uint32>(i) + j;
+                numVisible += ((mask >> j) & 1) ^ 1;
+            }
+        }
+        _mm256_zeroupper();
+
+        // The remaining spheres, their indices come back relative to the first of them
+        size_t tailVisible = mFallback->cullSpheres(planes, numPlanes, spheres, visible + numVisible, count - i);
+        for (size_t j = 0; j < tailVisible; ++j)
+            visible[numVisible + j] += static_cast<uint32>(i);
+        return numVisible + tailVisible;
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    extern OptimisedUtil* _getOptimisedUtilAVX(void);
+    extern OptimisedUtil* _getOptimisedUtilAVX(void)
+    {
+        static OptimisedUtilAVX msOptimisedUtilAVX;
+        return &msOptimisedUtilAVX;
+    }
+
+}
+
+#elif __OGRE_HAVE_SSE
+
+namespace Ogre {
+
+    extern OptimisedUtil* _getOptimisedUtilAVX(void);
+    extern OptimisedUtil* _getOptimisedUtilAVX(void)
+    {
+        // Not compiled with AVX2 support
+        return 0;
+    }
+
+}
+
+#endif // __OGRE_HAVE_AVX2
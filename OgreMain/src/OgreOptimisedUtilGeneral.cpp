@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 
 #include "OgreOptimisedUtil.h"
+#include "OgreBitwise.h"
 
 namespace Ogre {
 
@@ -91,6 +92,63 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::convertUByteToFloat
+        virtual void convertUByteToFloat(
+            const uint8* src,
+            float* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertFloatToUByte
+        virtual void convertFloatToUByte(
+            const float* src,
+            uint8* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertHalfToFloat
+        virtual void convertHalfToFloat(
+            const uint16* src,
+            float* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertFloatToHalf
+        virtual void convertFloatToHalf(
+            const float* src,
+            uint16* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::linearResampleRowUByte4
+        virtual void linearResampleRowUByte4(
+            const uint8* srcRow1,
+            const uint8* srcRow2,
+            uint32 syf,
+            const uint32* sx1,
+            const uint32* sx2,
+            const uint32* sxf,
+            uint8* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::accumulateUBytes
+        virtual void accumulateUBytes(
+            const uint8* src,
+            uint32* accum,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::generateBillboardQuads
+        virtual void generateBillboardQuads(
+            const float* centres,
+            const float* texcoords,
+            const float* offsets,
+            float* dest,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual size_t cullSpheres(
+            const float* planes,
+            size_t numPlanes,
+            const float* spheres,
+            uint32* visible,
+            size_t count);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -364,6 +422,140 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::convertUByteToFloat(
+        const uint8* src,
+        float* dst,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = Bitwise::fixedToFloat(src[i], 8);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::convertFloatToUByte(
+        const float* src,
+        uint8* dst,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = static_cast<uint8>(Bitwise::floatToFixed(src[i], 8));
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::convertHalfToFloat(
+        const uint16* src,
+        float* dst,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = Bitwise::halfToFloat(src[i]);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::convertFloatToHalf(
+        const float* src,
+        uint16* dst,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = Bitwise::floatToHalf(src[i]);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::linearResampleRowUByte4(
+        const uint8* srcRow1,
+        const uint8* srcRow2,
+        uint32 syf,
+        const uint32* sx1,
+        const uint32* sx2,
+        const uint32* sxf,
+        uint8* dst,
+        size_t count)
+    {
+        for (size_t x = 0; x < count; ++x)
+        {
+            const uint8* p11 = srcRow1 + sx1[x] * 4;
+            const uint8* p21 = srcRow1 + sx2[x] * 4;
+            const uint8* p12 = srcRow2 + sx1[x] * 4;
+            const uint8* p22 = srcRow2 + sx2[x] * 4;
+            uint32 sxfsyf = sxf[x] * syf;
+            uint32 w11 = 0x1000000 - (sxf[x] << 12) - (syf << 12) + sxfsyf;
+            uint32 w21 = (sxf[x] << 12) - sxfsyf;
+            uint32 w12 = (syf << 12) - sxfsyf;
+            for (size_t k = 0; k < 4; ++k)
+            {
+                // 8/24 bit fixed point, maximum is 0xFF000000 so rounding
+                // will not overflow
+                uint32 accum = p11[k] * w11 + p21[k] * w21 + p12[k] * w12 + p22[k] * sxfsyf;
+                *dst++ = static_cast<uint8>((accum + 0x800000) >> 24);
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::accumulateUBytes(
+        const uint8* src,
+        uint32* accum,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            accum[i] += src[i];
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::generateBillboardQuads(
+        const float* centres,
+        const float* texcoords,
+        const float* offsets,
+        float* dest,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i, centres += 4, texcoords += 4)
+        {
+            for (size_t corner = 0; corner < 4; ++corner)
+            {
+                const float* offset = offsets + corner * 3;
+                *dest++ = centres[0] + offset[0];
+                *dest++ = centres[1] + offset[1];
+                *dest++ = centres[2] + offset[2];
+                // The colour is copied as is
+                memcpy(dest++, centres + 3, sizeof(float));
+                // Left or right, top or bottom
+                *dest++ = texcoords[(corner & 1) * 2];
+                *dest++ = texcoords[(corner & 2) + 1];
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    size_t OptimisedUtilGeneral::cullSpheres(
+        const float* planes,
+        size_t numPlanes,
+        const float* spheres,
+        uint32* visible,
+        size_t count)
+    {
+        size_t numVisible = 0;
+        for (size_t i = 0; i < count; ++i, spheres += 4)
+        {
+            const float* plane = planes;
+            size_t p = 0;
+            for (; p < numPlanes; ++p, plane += 4)
+            {
+                float distance = plane[0] * spheres[0] + plane[1] * spheres[1] +
+                    plane[2] * spheres[2] + plane[3];
+                if (distance < -spheres[3])
+                    break;
+            }
+            if (p == numPlanes)
+                visible[numVisible++] = static_cast<uint32>(i);
+        }
+        return numVisible;
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
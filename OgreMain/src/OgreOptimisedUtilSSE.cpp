@@ -62,6 +62,8 @@ THE SOFTWARE.
 
 namespace Ogre {
 
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+
 //-------------------------------------------------------------------------
 // Local classes
 //-------------------------------------------------------------------------
@@ -75,6 +77,8 @@ namespace Ogre {
     protected:
         /// Do we prefer to use a general SSE version for position/normal shared buffers?
         bool mPreferGeneralVersionForSharedBuffers;
+        /// Can we use the SSE2 integer routines for pixel processing?
+        bool mHaveSSE2;
 
     public:
         /// Constructor
@@ -129,6 +133,63 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::convertUByteToFloat
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE convertUByteToFloat(
+            const uint8* src,
+            float* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertFloatToUByte
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE convertFloatToUByte(
+            const float* src,
+            uint8* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertHalfToFloat
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE convertHalfToFloat(
+            const uint16* src,
+            float* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertFloatToHalf
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE convertFloatToHalf(
+            const float* src,
+            uint16* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::linearResampleRowUByte4
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE linearResampleRowUByte4(
+            const uint8* srcRow1,
+            const uint8* srcRow2,
+            uint32 syf,
+            const uint32* sx1,
+            const uint32* sx2,
+            const uint32* sxf,
+            uint8* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::accumulateUBytes
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE accumulateUBytes(
+            const uint8* src,
+            uint32* accum,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::generateBillboardQuads
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE generateBillboardQuads(
+            const float* centres,
+            const float* texcoords,
+            const float* offsets,
+            float* dest,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual size_t __OGRE_SIMD_ALIGN_ATTRIBUTE cullSpheres(
+            const float* planes,
+            size_t numPlanes,
+            const float* spheres,
+            uint32* visible,
+            size_t count);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -268,6 +329,106 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::convertUByteToFloat
+        virtual void convertUByteToFloat(
+            const uint8* src,
+            float* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->convertUByteToFloat(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertFloatToUByte
+        virtual void convertFloatToUByte(
+            const float* src,
+            uint8* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->convertFloatToUByte(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertHalfToFloat
+        virtual void convertHalfToFloat(
+            const uint16* src,
+            float* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->convertHalfToFloat(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertFloatToHalf
+        virtual void convertFloatToHalf(
+            const float* src,
+            uint16* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->convertFloatToHalf(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::linearResampleRowUByte4
+        virtual void linearResampleRowUByte4(
+            const uint8* srcRow1,
+            const uint8* srcRow2,
+            uint32 syf,
+            const uint32* sx1,
+            const uint32* sx2,
+            const uint32* sxf,
+            uint8* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->linearResampleRowUByte4(
+                srcRow1, srcRow2, syf,
+                sx1, sx2, sxf,
+                dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::accumulateUBytes
+        virtual void accumulateUBytes(
+            const uint8* src,
+            uint32* accum,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->accumulateUBytes(src, accum, count);
+        }
+
+        /// @copydoc OptimisedUtil::generateBillboardQuads
+        virtual void generateBillboardQuads(
+            const float* centres,
+            const float* texcoords,
+            const float* offsets,
+            float* dest,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->generateBillboardQuads(centres, texcoords, offsets, dest, count);
+        }
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual size_t cullSpheres(
+            const float* planes,
+            size_t numPlanes,
+            const float* spheres,
+            uint32* visible,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            return mImpl->cullSpheres(planes, numPlanes, spheres, visible, count);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -1038,7 +1199,12 @@ namespace Ogre {
     //---------------------------------------------------------------------
     OptimisedUtilSSE::OptimisedUtilSSE(void)
         : mPreferGeneralVersionForSharedBuffers(false)
+        , mHaveSSE2(false)
     {
+#if __OGRE_HAVE_SSE2
+        mHaveSSE2 = (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE2) != 0;
+#endif
+
         // For AMD Athlon XP (but not that for Althon 64), it's prefer to never use
         // unrolled version for shared buffers at all, I guess because that version
         // run out of usable CPU registers, or L1/L2 cache related problem, causing
@@ -2129,6 +2295,357 @@ namespace Ogre {
             }
         }
     }
+#if __OGRE_HAVE_SSE2
+    //---------------------------------------------------------------------
+    // SSE2 helpers for pixel processing
+    //---------------------------------------------------------------------
+    static OGRE_FORCE_INLINE __m128i _mulloEpi32(__m128i a, __m128i b)
+    {
+        // SSE2 has no 32 bit low multiply, combine the even and odd lanes
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+        return _mm_unpacklo_epi32(
+            _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+    //---------------------------------------------------------------------
+    static OGRE_FORCE_INLINE __m128i _packUnsignedEpi32(__m128i lo, __m128i hi)
+    {
+        // _mm_packs_epi32 saturates signed, so bias into signed range and back
+        const __m128i bias = _mm_set1_epi32(0x8000);
+        __m128i packed = _mm_packs_epi32(_mm_sub_epi32(lo, bias), _mm_sub_epi32(hi, bias));
+        return _mm_xor_si128(packed, _mm_set1_epi16((short)0x8000));
+    }
+    //---------------------------------------------------------------------
+    static OGRE_FORCE_INLINE __m128i _loadPixelUByte4(const uint8* src)
+    {
+        int32 pixel;
+        memcpy(&pixel, src, sizeof(pixel));
+        return _mm_cvtsi32_si128(pixel);
+    }
+    //---------------------------------------------------------------------
+    static OGRE_FORCE_INLINE __m128 _halfToFloat(__m128i half)
+    {
+        // Matches Bitwise::halfToFloat bit for bit
+        const __m128i expMant = _mm_and_si128(half, _mm_set1_epi32(0x7fff));
+        const __m128i sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+
+        // Normalised numbers only need the exponent rebiased, infinity and
+        // NaN are rebiased twice to reach the maximum exponent
+        const __m128i rebias = _mm_set1_epi32(0x38000000);
+        __m128i infNan = _mm_cmpgt_epi32(expMant, _mm_set1_epi32(0x7bff));
+        __m128i normal = _mm_add_epi32(_mm_slli_epi32(expMant, 13), rebias);
+        normal = _mm_add_epi32(normal, _mm_and_si128(infNan, rebias));
+
+        // Zeros and denormals are exact as scaled integers
+        __m128i denorm = _mm_castps_si128(
+            _mm_mul_ps(_mm_cvtepi32_ps(expMant), _mm_set_ps1(1.0f / 16777216.0f)));
+        __m128i isDenorm = _mm_cmplt_epi32(expMant, _mm_set1_epi32(0x400));
+
+        __m128i result = _mm_or_si128(
+            _mm_and_si128(isDenorm, denorm),
+            _mm_andnot_si128(isDenorm, normal));
+        return _mm_castsi128_ps(_mm_or_si128(result, sign));
+    }
+    //---------------------------------------------------------------------
+    static OGRE_FORCE_INLINE __m128i _floatToHalf(__m128 value)
+    {
+        // Matches Bitwise::floatToHalf bit for bit, including its truncation
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bits = _mm_castps_si128(value);
+        const __m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+        const __m128i e = _mm_sub_epi32(
+            _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xff)), _mm_set1_epi32(127 - 15));
+        const __m128i m = _mm_and_si128(bits, _mm_set1_epi32(0x7fffff));
+        const __m128i m13 = _mm_srli_epi32(m, 13);
+
+        // Normalised halfs, rebias the exponent and truncate the mantissa
+        __m128i normal = _mm_or_si128(_mm_slli_epi32(e, 10), m13);
+        __m128i isNormal = _mm_and_si128(
+            _mm_cmpgt_epi32(e, zero), _mm_cmplt_epi32(e, _mm_set1_epi32(31)));
+
+        // Denormal halfs, truncating |value| * 2^24 gives the same bits as
+        // shifting the mantissa with its implicit one
+        __m128 absValue = _mm_castsi128_ps(_mm_and_si128(bits, _mm_set1_epi32(0x7fffffff)));
+        __m128i denorm = _mm_cvttps_epi32(_mm_mul_ps(absValue, _mm_set_ps1(16777216.0f)));
+        __m128i isDenorm = _mm_and_si128(
+            _mm_cmpgt_epi32(e, _mm_set1_epi32(-11)), _mm_cmplt_epi32(e, _mm_set1_epi32(1)));
+
+        // Overflow and infinity saturate, NaN keeps a non zero mantissa
+        __m128i isNaN = _mm_andnot_si128(
+            _mm_cmpeq_epi32(m, zero), _mm_cmpeq_epi32(e, _mm_set1_epi32(0xff - (127 - 15))));
+        __m128i nanMant = _mm_or_si128(m13,
+            _mm_and_si128(_mm_cmpeq_epi32(m13, zero), _mm_set1_epi32(1)));
+        __m128i over = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(isNaN, nanMant));
+        __m128i isOver = _mm_cmpgt_epi32(e, _mm_set1_epi32(30));
+
+        __m128i result = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(isNormal, normal), _mm_and_si128(isDenorm, denorm)),
+            _mm_and_si128(isOver, over));
+
+        // Values too small for a denormal flush to positive zero
+        __m128i keepSign = _mm_cmpgt_epi32(e, _mm_set1_epi32(-11));
+        return _mm_or_si128(result, _mm_and_si128(keepSign, sign));
+    }
+#endif  // __OGRE_HAVE_SSE2
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::convertUByteToFloat(
+        const uint8* src,
+        float* dst,
+        size_t count)
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE2
+        if (mHaveSSE2)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 maxValue = _mm_set_ps1(255.0f);
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+                __m128i lo = _mm_unpacklo_epi8(v, zero);
+                __m128i hi = _mm_unpackhi_epi8(v, zero);
+                // Divide rather than multiply by the reciprocal to match fixedToFloat
+                _mm_storeu_ps(dst + i + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), maxValue));
+                _mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), maxValue));
+                _mm_storeu_ps(dst + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), maxValue));
+                _mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), maxValue));
+            }
+        }
+#endif
+        _getOptimisedUtilGeneral()->convertUByteToFloat(src + i, dst + i, count - i);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::convertFloatToUByte(
+        const float* src,
+        uint8* dst,
+        size_t count)
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE2
+        if (mHaveSSE2)
+        {
+            // Clamping before truncation gives the same results as floatToFixed,
+            // max with zero as second operand also maps NaN to zero
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 maxValue = _mm_set_ps1(255.0f);
+            const __m128 scale = _mm_set_ps1(256.0f);
+            __m128i v[4];
+            for (; i + 16 <= count; i += 16)
+            {
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    __m128 f = _mm_mul_ps(_mm_loadu_ps(src + i + j * 4), scale);
+                    v[j] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(f, zero), maxValue));
+                }
+                __m128i packed = _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3]));
+                _mm_storeu_si128((__m128i*)(dst + i), packed);
+            }
+        }
+#endif
+        _getOptimisedUtilGeneral()->convertFloatToUByte(src + i, dst + i, count - i);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::convertHalfToFloat(
+        const uint16* src,
+        float* dst,
+        size_t count)
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE2
+        if (mHaveSSE2)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+                _mm_storeu_ps(dst + i + 0, _halfToFloat(_mm_unpacklo_epi16(v, zero)));
+                _mm_storeu_ps(dst + i + 4, _halfToFloat(_mm_unpackhi_epi16(v, zero)));
+            }
+        }
+#endif
+        _getOptimisedUtilGeneral()->convertHalfToFloat(src + i, dst + i, count - i);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::convertFloatToHalf(
+        const float* src,
+        uint16* dst,
+        size_t count)
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE2
+        if (mHaveSSE2)
+        {
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i lo = _floatToHalf(_mm_loadu_ps(src + i + 0));
+                __m128i hi = _floatToHalf(_mm_loadu_ps(src + i + 4));
+                _mm_storeu_si128((__m128i*)(dst + i), _packUnsignedEpi32(lo, hi));
+            }
+        }
+#endif
+        _getOptimisedUtilGeneral()->convertFloatToHalf(src + i, dst + i, count - i);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::linearResampleRowUByte4(
+        const uint8* srcRow1,
+        const uint8* srcRow2,
+        uint32 syf,
+        const uint32* sx1,
+        const uint32* sx2,
+        const uint32* sxf,
+        uint8* dst,
+        size_t count)
+    {
+#if __OGRE_HAVE_SSE2
+        if (mHaveSSE2)
+        {
+            // Filter horizontally with a 16 bit multiply-add, the weights sum
+            // to 0x1000 so each row stays below 20 bits. The vertical pass
+            // then gives exactly the 8/24 bit fixed point sum of the scalar
+            // version.
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i wy1 = _mm_set1_epi32(0x1000 - syf);
+            const __m128i wy2 = _mm_set1_epi32(syf);
+            const __m128i rounding = _mm_set1_epi32(0x800000);
+            for (size_t x = 0; x < count; ++x)
+            {
+                const uint32 l = sx1[x] * 4, r = sx2[x] * 4;
+                __m128i wx = _mm_set1_epi32((int)((sxf[x] << 16) | (0x1000 - sxf[x])));
+                __m128i top = _mm_unpacklo_epi8(
+                    _mm_unpacklo_epi8(_loadPixelUByte4(srcRow1 + l), _loadPixelUByte4(srcRow1 + r)), zero);
+                __m128i bottom = _mm_unpacklo_epi8(
+                    _mm_unpacklo_epi8(_loadPixelUByte4(srcRow2 + l), _loadPixelUByte4(srcRow2 + r)), zero);
+                top = _mm_madd_epi16(top, wx);
+                bottom = _mm_madd_epi16(bottom, wx);
+
+                __m128i accum = _mm_add_epi32(_mulloEpi32(top, wy1), _mulloEpi32(bottom, wy2));
+                accum = _mm_srli_epi32(_mm_add_epi32(accum, rounding), 24);
+                accum = _mm_packs_epi32(accum, accum);
+                int32 pixel = _mm_cvtsi128_si32(_mm_packus_epi16(accum, accum));
+                memcpy(dst, &pixel, sizeof(pixel));
+                dst += 4;
+            }
+            return;
+        }
+#endif
+        _getOptimisedUtilGeneral()->linearResampleRowUByte4(
+            srcRow1, srcRow2, syf, sx1, sx2, sxf, dst, count);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::accumulateUBytes(
+        const uint8* src,
+        uint32* accum,
+        size_t count)
+    {
+        size_t i = 0;
+#if __OGRE_HAVE_SSE2
+        if (mHaveSSE2)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            __m128i* pAccum;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+                __m128i lo = _mm_unpacklo_epi8(v, zero);
+                __m128i hi = _mm_unpackhi_epi8(v, zero);
+                pAccum = (__m128i*)(accum + i);
+                _mm_storeu_si128(pAccum + 0, _mm_add_epi32(_mm_loadu_si128(pAccum + 0), _mm_unpacklo_epi16(lo, zero)));
+                _mm_storeu_si128(pAccum + 1, _mm_add_epi32(_mm_loadu_si128(pAccum + 1), _mm_unpackhi_epi16(lo, zero)));
+                _mm_storeu_si128(pAccum + 2, _mm_add_epi32(_mm_loadu_si128(pAccum + 2), _mm_unpacklo_epi16(hi, zero)));
+                _mm_storeu_si128(pAccum + 3, _mm_add_epi32(_mm_loadu_si128(pAccum + 3), _mm_unpackhi_epi16(hi, zero)));
+            }
+        }
+#endif
+        _getOptimisedUtilGeneral()->accumulateUBytes(src + i, accum + i, count - i);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::generateBillboardQuads(
+        const float* centres,
+        const float* texcoords,
+        const float* offsets,
+        float* dest,
+        size_t count)
+    {
+        // The offsets with a zero w, and a mask keeping x, y, z of the sums
+        // so that the colour bits are taken over untouched
+        const __m128 offset0 = _mm_setr_ps(offsets[0], offsets[1], offsets[2], 0);
+        const __m128 offset1 = _mm_setr_ps(offsets[3], offsets[4], offsets[5], 0);
+        const __m128 offset2 = _mm_setr_ps(offsets[6], offsets[7], offsets[8], 0);
+        const __m128 offset3 = _mm_setr_ps(offsets[9], offsets[10], offsets[11], 0);
+        OGRE_SIMD_ALIGNED_DECL(static const uint32, msXYZMask[4]) =
+        {
+            0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0
+        };
+        const __m128 xyzMask = *(const __m128 *)&msXYZMask;
+
+        for (size_t i = 0; i < count; ++i, centres += 4, texcoords += 4, dest += 24)
+        {
+            __m128 centre = _mm_loadu_ps(centres);
+            __m128 colour = _mm_andnot_ps(xyzMask, centre);
+            // left, top, right, bottom
+            __m128 rect = _mm_loadu_ps(texcoords);
+
+            _mm_storeu_ps(dest + 0, _mm_or_ps(_mm_and_ps(_mm_add_ps(centre, offset0), xyzMask), colour));
+            _mm_storel_pi((__m64*)(dest + 4), rect);
+            _mm_storeu_ps(dest + 6, _mm_or_ps(_mm_and_ps(_mm_add_ps(centre, offset1), xyzMask), colour));
+            _mm_storel_pi((__m64*)(dest + 10), _mm_shuffle_ps(rect, rect, _MM_SHUFFLE(3, 3, 1, 2)));
+            _mm_storeu_ps(dest + 12, _mm_or_ps(_mm_and_ps(_mm_add_ps(centre, offset2), xyzMask), colour));
+            _mm_storel_pi((__m64*)(dest + 16), _mm_shuffle_ps(rect, rect, _MM_SHUFFLE(3, 3, 3, 0)));
+            _mm_storeu_ps(dest + 18, _mm_or_ps(_mm_and_ps(_mm_add_ps(centre, offset3), xyzMask), colour));
+            _mm_storeh_pi((__m64*)(dest + 22), rect);
+        }
+    }
+    //---------------------------------------------------------------------
+    size_t OptimisedUtilSSE::cullSpheres(
+        const float* planes,
+        size_t numPlanes,
+        const float* spheres,
+        uint32* visible,
+        size_t count)
+    {
+        size_t numVisible = 0;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, spheres += 16)
+        {
+            // x, y, z and radius of four spheres
+            __m128 x = _mm_loadu_ps(spheres + 0);
+            __m128 y = _mm_loadu_ps(spheres + 4);
+            __m128 z = _mm_loadu_ps(spheres + 8);
+            __m128 radius = _mm_loadu_ps(spheres + 12);
+            _MM_TRANSPOSE4_PS(x, y, z, radius);
+            __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+            __m128 outside = _mm_setzero_ps();
+            const float* plane = planes;
+            for (size_t p = 0; p < numPlanes; ++p, plane += 4)
+            {
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(plane[0]), x),
+                    _mm_mul_ps(_mm_set1_ps(plane[1]), y)),
+                    _mm_mul_ps(_mm_set1_ps(plane[2]), z)),
+                    _mm_set1_ps(plane[3]));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negRadius));
+                if (_mm_movemask_ps(outside) == 0xF)
+                    break;
+            }
+
+            // Compact the indices of the visible ones without branching
+            int mask = _mm_movemask_ps(outside);
+            for (uint32 j = 0; j < 4; ++j)
+            {
+                visible[numVisible] = static_cast<uint32>(i) + j;
+                numVisible += ((mask >> j) & 1) ^ 1;
+            }
+        }
+
+        // The remaining spheres, their indices come back relative to the first of them
+        size_t tailVisible = _getOptimisedUtilGeneral()->cullSpheres(
+            planes, numPlanes, spheres, visible + numVisible, count - i);
+        for (size_t j = 0; j < tailVisible; ++j)
+            visible[numVisible + j] += static_cast<uint32>(i);
+        return numVisible + tailVisible;
+    }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
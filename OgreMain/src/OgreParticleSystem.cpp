@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "OgreParticleAffectorFactory.h"
 #include "OgreParticleSystemRenderer.h"
 #include "OgreControllerManager.h"
+#include "OgreParticleSystemManager.h"
 
 namespace Ogre {
     // Init statics
@@ -49,8 +50,7 @@ namespace Ogre {
     ParticleSystem::CmdLocalSpace ParticleSystem::msLocalSpaceCmd;
     ParticleSystem::CmdIterationInterval ParticleSystem::msIterationIntervalCmd;
     ParticleSystem::CmdNonvisibleTimeout ParticleSystem::msNonvisibleTimeoutCmd;
-
-    RadixSort<ParticleSystem::ActiveParticleList, Particle*, float> ParticleSystem::mRadixSorter;
+    ParticleSystem::CmdSoAStorage ParticleSystem::msSoAStorageCmd;
 
     Real ParticleSystem::msDefaultIterationInterval = 0;
     Real ParticleSystem::msDefaultNonvisibleTimeout = 0;
@@ -66,8 +66,34 @@ namespace Ogre {
 
         Real getValue(void) const { return 0; } // N/A
 
-        void setValue(Real value) { mTarget->_update(value); }
+        void setValue(Real value)
+        {
+            ParticleSystemManager& mgr = ParticleSystemManager::getSingleton();
+            if (mgr.getParallelUpdatesEnabled())
+                mgr._queueUpdate(mTarget, value);
+            else
+                mTarget->_update(value);
+        }
+
+    };
+    //-----------------------------------------------------------------------
+    // Local class drawing random numbers from the stream of a system, see
+    // ParticleSystem::setRandomSeed
+    class ParticleSystemRandomStream : public Math::RandomValueProvider
+    {
+    protected:
+        uint32& mState;
+    public:
+        ParticleSystemRandomStream(uint32& state) : mState(state) {}
 
+        Real getRandomUnit()
+        {
+            // xorshift32
+            mState ^= mState << 13;
+            mState ^= mState >> 17;
+            mState ^= mState << 5;
+            return Real(mState / 4294967295.0);
+        }
     };
     //-----------------------------------------------------------------------
     ParticleSystem::ParticleSystem() 
@@ -90,12 +116,22 @@ namespace Ogre {
         mTimeController(0),
         mEmittedEmitterPoolInitialised(false),
         mIsEmitting(true),
+        mSoAStorage(false),
+        mParticleArraysDirtyFrom(0),
+        mParticleInstancesOutdated(false),
+        mActiveParticlesOutdated(false),
+        mRandomSeed(0),
+        mRandomState(0),
+        mParallelUpdatePending(false),
+        mParallelUpdateTime(0),
+        mParallelBoundsChanged(false),
         mRenderer(0),
         mCullIndividual(false),
         mPoolSize(0),
         mEmittedEmitterPoolSize(0)
     {
         initParameters();
+        setRandomSeed(0);
 
         // Default to billboard renderer
         setRenderer("billboard");
@@ -123,6 +159,15 @@ namespace Ogre {
         mTimeController(0),
         mEmittedEmitterPoolInitialised(false),
         mIsEmitting(true),
+        mSoAStorage(false),
+        mParticleArraysDirtyFrom(0),
+        mParticleInstancesOutdated(false),
+        mActiveParticlesOutdated(false),
+        mRandomSeed(0),
+        mRandomState(0),
+        mParallelUpdatePending(false),
+        mParallelUpdateTime(0),
+        mParallelBoundsChanged(false),
         mRenderer(0), 
         mCullIndividual(false),
         mPoolSize(0),
@@ -134,6 +179,7 @@ namespace Ogre {
         setParticleQuota( 10 );
         setEmittedEmitterQuota( 3 );
         initParameters();
+        setRandomSeed(FastHash(name.c_str(), name.size()));
 
         // Default to billboard renderer
         setRenderer("billboard");
@@ -141,6 +187,9 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ParticleSystem::~ParticleSystem()
     {
+        if (ParticleSystemManager* mgr = ParticleSystemManager::getSingletonPtr())
+            mgr->_cancelQueuedUpdates(this);
+
         if (mTimeController)
         {
             // Destroy controller
@@ -289,6 +338,7 @@ namespace Ogre {
         mIterationIntervalSet = rhs.mIterationIntervalSet;
         mNonvisibleTimeout = rhs.mNonvisibleTimeout;
         mNonvisibleTimeoutSet = rhs.mNonvisibleTimeoutSet;
+        setSoAStorageEnabled(rhs.mSoAStorage);
         // last frame visible and time since last visible should be left default
 
         setRenderer(rhs.getRendererName());
@@ -360,10 +410,54 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_update(Real timeElapsed)
+    {
+        if (prepareUpdate(timeElapsed))
+        {
+            updateParticles(timeElapsed);
+            _updateBounds();
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool ParticleSystem::_prepareParallelUpdate(Real timeElapsed)
+    {
+        if (mParallelUpdatePending)
+        {
+            mParallelUpdateTime += timeElapsed * mSpeedFactor;
+            return false;
+        }
+
+        if (!prepareUpdate(timeElapsed))
+            return false;
+
+        mParallelUpdatePending = true;
+        mParallelUpdateTime = timeElapsed;
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_updateParallel(void)
+    {
+        ParticleSystemRandomStream random(mRandomState);
+        Math::RandomValueProvider* previous = Math::SetThreadRandomValueProvider(&random);
+
+        updateParticles(mParallelUpdateTime);
+        mParallelBoundsChanged = calculateBounds();
+
+        Math::SetThreadRandomValueProvider(previous);
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_finishParallelUpdate(void)
+    {
+        if (mParallelBoundsChanged)
+            mParentNode->needUpdate();
+        mParallelUpdatePending = false;
+        mParallelBoundsChanged = false;
+    }
+    //-----------------------------------------------------------------------
+    bool ParticleSystem::prepareUpdate(Real& timeElapsed)
     {
         // Only update if attached to a node
         if (!mParentNode)
-            return;
+            return false;
 
         Real nonvisibleTimeout = mNonvisibleTimeoutSet ?
             mNonvisibleTimeout : msDefaultNonvisibleTimeout;
@@ -379,7 +473,7 @@ namespace Ogre {
                 if (mTimeSinceLastVisible >= nonvisibleTimeout)
                 {
                     // No update
-                    return;
+                    return false;
                 }
             }
         }
@@ -393,6 +487,16 @@ namespace Ogre {
         // Initialise emitted emitters list if not done already
         initialiseEmittedEmitters();
 
+        // Bring the cached transforms of the node up to date, the updates
+        // of several systems attached to it may read them at the same time
+        mParentNode->_getDerivedPosition();
+        mParentNode->_getFullTransform();
+
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::updateParticles(Real timeElapsed)
+    {
         Real iterationInterval = mIterationIntervalSet ? 
             mIterationInterval : msDefaultIterationInterval;
         if (iterationInterval > 0)
@@ -431,12 +535,16 @@ namespace Ogre {
 
         if (!mBoundsAutoUpdate && mBoundsUpdateTime > 0.0f)
             mBoundsUpdateTime -= timeElapsed; // count down 
-        _updateBounds();
-
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_expire(Real timeElapsed)
     {
+        if (mSoAStorage)
+        {
+            _expireArrays(timeElapsed);
+            return;
+        }
+
         ActiveParticleList::iterator i, itEnd;
         Particle* pParticle;
         ParticleEmitter* pParticleEmitter;
@@ -484,8 +592,8 @@ namespace Ogre {
     void ParticleSystem::_triggerEmitters(Real timeElapsed)
     {
         // Add up requests for emission
-        static vector<unsigned>::type requested;
-        static vector<unsigned>::type emittedRequested;
+        vector<unsigned>::type& requested = mEmissionRequests;
+        vector<unsigned>::type& emittedRequested = mEmittedEmissionRequests;
 
         if( requested.size() != mEmitters.size() )
             requested.resize( mEmitters.size() );
@@ -617,6 +725,12 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ParticleSystem::_applyMotion(Real timeElapsed)
     {
+        if (mSoAStorage)
+        {
+            _applyMotionArrays(timeElapsed);
+            return;
+        }
+
         ActiveParticleList::iterator i, itEnd;
         Particle* pParticle;
         ParticleEmitter* pParticleEmitter;
@@ -648,9 +762,310 @@ namespace Ogre {
         itEnd = mAffectors.end();
         for (i = mAffectors.begin(); i != itEnd; ++i)
         {
-            (*i)->_affectParticles(this, timeElapsed);
+            if (mSoAStorage)
+            {
+                // Get the batch for each affector, the ones falling back to the
+                // per particle path may cause the arrays to be reallocated
+                _syncParticleArrays();
+                mParticleInstancesOutdated = true;
+                ParticleBatch batch = mParticleArrays.getBatch(0, mParticleArrays.count);
+                (*i)->_affectParticleBatch(this, batch, timeElapsed);
+            }
+            else
+            {
+                (*i)->_affectParticles(this, timeElapsed);
+            }
+        }
+
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_expireArrays(Real timeElapsed)
+    {
+        _syncParticleArrays();
+
+        ParticleArrays& arrays = mParticleArrays;
+        size_t count = arrays.count;
+
+        // Age all particles first, this is the part worth vectorising; the
+        // ones which had less than timeElapsed left end up below zero
+        Real* timeToLive = count ? &arrays.timeToLive[0] : 0;
+        for (size_t i = 0; i < count; ++i)
+            timeToLive[i] -= timeElapsed;
+
+        size_t i = 0;
+        while (i < count && timeToLive[i] >= 0)
+            ++i;
+
+        // Compact the survivors following the first expired particle
+        size_t live = i;
+        for (; i < count; ++i)
+        {
+            if (timeToLive[i] >= 0)
+            {
+                arrays.move(live++, i);
+                continue;
+            }
+
+            Particle* pParticle = arrays.particles[i];
+
+            // Notify renderer
+            mRenderer->_notifyParticleExpired(pParticle);
+
+            // The values of the active list are only rewritten by _syncParticleInstances,
+            // so any of its nodes will do to return the particle to the free list
+            if (pParticle->mParticleType == Particle::Visual)
+            {
+                mFreeParticles.splice(mFreeParticles.end(), mActiveParticles, --mActiveParticles.end());
+                mFreeParticles.back() = pParticle;
+            }
+            else
+            {
+                // For now, it can only be an emitted emitter
+                ParticleEmitter* pParticleEmitter = static_cast<ParticleEmitter*>(pParticle);
+                findFreeEmittedEmitter(pParticleEmitter->getName())->push_back(pParticleEmitter);
+                removeFromActiveEmittedEmitters(pParticleEmitter);
+                mActiveParticles.pop_back();
+            }
+        }
+        mActiveParticlesOutdated |= live != count;
+        arrays.count = live;
+        mParticleArraysDirtyFrom = live;
+        mParticleInstancesOutdated = true;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_applyMotionArrays(Real timeElapsed)
+    {
+        _syncParticleArrays();
+
+        size_t count = mParticleArrays.count;
+        if (!count)
+            return;
+
+        mParticleInstancesOutdated = true;
+
+        ParticleBatch batch = mParticleArrays.getBatch(0, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            batch.positionX[i] += batch.directionX[i] * timeElapsed;
+            batch.positionY[i] += batch.directionY[i] * timeElapsed;
+            batch.positionZ[i] += batch.directionZ[i] * timeElapsed;
         }
 
+        if (!mActiveEmittedEmitters.empty())
+        {
+            // The emitted emitters emit from their own position, keep it up to date
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (batch.particles[i]->mParticleType == Particle::Emitter)
+                {
+                    static_cast<ParticleEmitter*>(batch.particles[i])->setPosition(
+                        Vector3(batch.positionX[i], batch.positionY[i], batch.positionZ[i]));
+                }
+            }
+        }
+        // The renderer is notified of the motion once the particle instances
+        // are brought up to date, see _syncParticleInstances
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::setSoAStorageEnabled(bool enabled)
+    {
+        if (enabled == mSoAStorage)
+            return;
+
+        if (enabled)
+        {
+            mParticleArrays.count = 0;
+            ActiveParticleList::iterator i;
+            for (i = mActiveParticles.begin(); i != mActiveParticles.end(); ++i)
+            {
+                mParticleArrays.append(*i);
+            }
+            mParticleArraysDirtyFrom = 0;
+            mSoAStorage = true;
+            _syncParticleArrays();
+        }
+        else
+        {
+            _syncParticleInstances();
+            mSoAStorage = false;
+            mParticleArrays = ParticleArrays();
+            mParticleArraysDirtyFrom = 0;
+            mParticleInstancesOutdated = false;
+            mActiveParticlesOutdated = false;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::setRandomSeed(uint32 seed)
+    {
+        mRandomSeed = seed;
+
+        // Scramble the seed so that similar seeds don't give similar
+        // streams, the state of the xorshift generator must not be 0
+        uint32 state = seed + 0x9E3779B9;
+        state = (state ^ (state >> 16)) * 0x85EBCA6B;
+        state = (state ^ (state >> 13)) * 0xC2B2AE35;
+        state ^= state >> 16;
+        mRandomState = state ? state : 1;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_syncParticleInstances(void)
+    {
+        if (!mSoAStorage)
+            return;
+
+        _syncParticleArrays();
+        if (!mParticleInstancesOutdated)
+            return;
+
+        assert(mActiveParticles.size() == mParticleArrays.count &&
+            "Active particle list out of sync with the particle arrays");
+
+        for (size_t i = 0; i < mParticleArrays.count; ++i)
+        {
+            mParticleArrays.write(i);
+        }
+        mParticleInstancesOutdated = false;
+
+        if (mActiveParticlesOutdated)
+        {
+            ActiveParticleList::iterator p = mActiveParticles.begin();
+            for (size_t i = 0; i < mParticleArrays.count; ++i, ++p)
+            {
+                *p = mParticleArrays.particles[i];
+            }
+            mActiveParticlesOutdated = false;
+        }
+
+        // Deferred from _applyMotion
+        if (mRenderer)
+            mRenderer->_notifyParticleMoved(mActiveParticles);
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_syncParticleArrays(void)
+    {
+        if (!mSoAStorage)
+            return;
+
+        for (size_t i = mParticleArraysDirtyFrom; i < mParticleArrays.count; ++i)
+        {
+            mParticleArrays.read(i);
+        }
+        mParticleArraysDirtyFrom = mParticleArrays.count;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::ParticleArrays::append(Particle* p)
+    {
+        if (count == particles.size())
+        {
+            size_t size = std::max<size_t>(16, count * 2);
+            particles.resize(size);
+            positionX.resize(size);
+            positionY.resize(size);
+            positionZ.resize(size);
+            directionX.resize(size);
+            directionY.resize(size);
+            directionZ.resize(size);
+            colourR.resize(size);
+            colourG.resize(size);
+            colourB.resize(size);
+            colourA.resize(size);
+            timeToLive.resize(size);
+            totalTimeToLive.resize(size);
+            rotation.resize(size);
+            rotationSpeed.resize(size);
+            width.resize(size);
+            height.resize(size);
+            ownDimensions.resize(size);
+        }
+        particles[count++] = p;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::ParticleArrays::read(size_t i)
+    {
+        const Particle* p = particles[i];
+        positionX[i] = p->mPosition.x;
+        positionY[i] = p->mPosition.y;
+        positionZ[i] = p->mPosition.z;
+        directionX[i] = p->mDirection.x;
+        directionY[i] = p->mDirection.y;
+        directionZ[i] = p->mDirection.z;
+        colourR[i] = p->mColour.r;
+        colourG[i] = p->mColour.g;
+        colourB[i] = p->mColour.b;
+        colourA[i] = p->mColour.a;
+        timeToLive[i] = p->mTimeToLive;
+        totalTimeToLive[i] = p->mTotalTimeToLive;
+        rotation[i] = p->mRotation.valueRadians();
+        rotationSpeed[i] = p->mRotationSpeed.valueRadians();
+        width[i] = p->mWidth;
+        height[i] = p->mHeight;
+        ownDimensions[i] = p->mOwnDimensions;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::ParticleArrays::write(size_t i) const
+    {
+        Particle* p = particles[i];
+        p->mPosition = Vector3(positionX[i], positionY[i], positionZ[i]);
+        p->mDirection = Vector3(directionX[i], directionY[i], directionZ[i]);
+        p->mColour = ColourValue(colourR[i], colourG[i], colourB[i], colourA[i]);
+        p->mTimeToLive = timeToLive[i];
+        p->mTotalTimeToLive = totalTimeToLive[i];
+        p->mRotation = Radian(rotation[i]);
+        p->mRotationSpeed = Radian(rotationSpeed[i]);
+        p->mWidth = width[i];
+        p->mHeight = height[i];
+        p->mOwnDimensions = ownDimensions[i] != 0;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::ParticleArrays::move(size_t dst, size_t src)
+    {
+        particles[dst] = particles[src];
+        positionX[dst] = positionX[src];
+        positionY[dst] = positionY[src];
+        positionZ[dst] = positionZ[src];
+        directionX[dst] = directionX[src];
+        directionY[dst] = directionY[src];
+        directionZ[dst] = directionZ[src];
+        colourR[dst] = colourR[src];
+        colourG[dst] = colourG[src];
+        colourB[dst] = colourB[src];
+        colourA[dst] = colourA[src];
+        timeToLive[dst] = timeToLive[src];
+        totalTimeToLive[dst] = totalTimeToLive[src];
+        rotation[dst] = rotation[src];
+        rotationSpeed[dst] = rotationSpeed[src];
+        width[dst] = width[src];
+        height[dst] = height[src];
+        ownDimensions[dst] = ownDimensions[src];
+    }
+    //-----------------------------------------------------------------------
+    ParticleBatch ParticleSystem::ParticleArrays::getBatch(size_t begin, size_t end)
+    {
+        ParticleBatch batch;
+        memset(&batch, 0, sizeof(batch));
+        if (begin == end)
+            return batch;
+
+        batch.count = end - begin;
+        batch.particles = &particles[begin];
+        batch.positionX = &positionX[begin];
+        batch.positionY = &positionY[begin];
+        batch.positionZ = &positionZ[begin];
+        batch.directionX = &directionX[begin];
+        batch.directionY = &directionY[begin];
+        batch.directionZ = &directionZ[begin];
+        batch.colourR = &colourR[begin];
+        batch.colourG = &colourG[begin];
+        batch.colourB = &colourB[begin];
+        batch.colourA = &colourA[begin];
+        batch.timeToLive = &timeToLive[begin];
+        batch.totalTimeToLive = &totalTimeToLive[begin];
+        batch.rotation = &rotation[begin];
+        batch.rotationSpeed = &rotationSpeed[begin];
+        batch.width = &width[begin];
+        batch.height = &height[begin];
+        batch.ownDimensions = &ownDimensions[begin];
+        return batch;
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::increasePool(size_t size)
@@ -677,12 +1092,18 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ParticleIterator ParticleSystem::_getIterator(void)
     {
+        // The caller may change any of the particles
+        _syncParticleInstances();
+        mParticleArraysDirtyFrom = 0;
         return ParticleIterator(mActiveParticles.begin(), mActiveParticles.end());
     }
     //-----------------------------------------------------------------------
     Particle* ParticleSystem::getParticle(size_t index) 
     {
         assert (index < mActiveParticles.size() && "Index out of bounds!");
+        // The caller may change the particle
+        _syncParticleInstances();
+        mParticleArraysDirtyFrom = 0;
         ActiveParticleList::iterator i = mActiveParticles.begin();
         std::advance(i, index);
         return *i;
@@ -698,6 +1119,12 @@ namespace Ogre {
             mActiveParticles.splice(mActiveParticles.end(), mFreeParticles, mFreeParticles.begin());
 
             p->_notifyOwner(this);
+
+            if (mSoAStorage)
+            {
+                // Attributes are read once the caller has initialised the particle
+                mParticleArrays.append(p);
+            }
         }
 
         return p;
@@ -722,6 +1149,12 @@ namespace Ogre {
             mActiveEmittedEmitters.push_back(static_cast<ParticleEmitter*>(p));
             
             p->_notifyOwner(this);
+
+            if (mSoAStorage)
+            {
+                // Attributes are read once the caller has initialised the particle
+                mParticleArrays.append(p);
+            }
         }
 
         return p;
@@ -731,6 +1164,7 @@ namespace Ogre {
     {
         if (mRenderer)
         {
+            _syncParticleInstances();
             mRenderer->_updateRenderQueue(queue, mActiveParticles, mCullIndividual);
         }
     }
@@ -807,12 +1241,23 @@ namespace Ogre {
                 PT_REAL),
                 &msNonvisibleTimeoutCmd);
 
+            dict->addParameter(ParameterDef("soa_storage", 
+                "Sets whether the particles are kept in structure of arrays storage, "
+                "which speeds up the update of large systems.",
+                PT_BOOL),
+                &msSoAStorageCmd);
+
         }
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_updateBounds()
     {
-
+        if (calculateBounds())
+            mParentNode->needUpdate();
+    }
+    //-----------------------------------------------------------------------
+    bool ParticleSystem::calculateBounds(void)
+    {
         if (mParentNode && (mBoundsAutoUpdate || mBoundsUpdateTime > 0.0f))
         {
             if (mActiveParticles.empty())
@@ -843,19 +1288,39 @@ namespace Ogre {
                 Vector3 halfScale = Vector3::UNIT_SCALE * 0.5;
                 Vector3 defaultPadding = 
                     halfScale * std::max(mDefaultHeight, mDefaultWidth);
-                for (p = mActiveParticles.begin(); p != mActiveParticles.end(); ++p)
+                if (mSoAStorage)
                 {
-                    if ((*p)->mOwnDimensions)
+                    // Same as below, but straight from the arrays
+                    const ParticleArrays& arrays = mParticleArrays;
+                    const Real defaultPad = defaultPadding.x;
+                    for (size_t i = 0; i < arrays.count; ++i)
                     {
-                        Vector3 padding = 
-                            halfScale * std::max((*p)->mWidth, (*p)->mHeight);
-                        min.makeFloor((*p)->mPosition - padding);
-                        max.makeCeil((*p)->mPosition + padding);
+                        Real pad = arrays.ownDimensions[i] ?
+                            0.5f * std::max(arrays.width[i], arrays.height[i]) : defaultPad;
+                        min.x = std::min(min.x, arrays.positionX[i] - pad);
+                        min.y = std::min(min.y, arrays.positionY[i] - pad);
+                        min.z = std::min(min.z, arrays.positionZ[i] - pad);
+                        max.x = std::max(max.x, arrays.positionX[i] + pad);
+                        max.y = std::max(max.y, arrays.positionY[i] + pad);
+                        max.z = std::max(max.z, arrays.positionZ[i] + pad);
                     }
-                    else
+                }
+                else
+                {
+                    for (p = mActiveParticles.begin(); p != mActiveParticles.end(); ++p)
                     {
-                        min.makeFloor((*p)->mPosition - defaultPadding);
-                        max.makeCeil((*p)->mPosition + defaultPadding);
+                        if ((*p)->mOwnDimensions)
+                        {
+                            Vector3 padding = 
+                                halfScale * std::max((*p)->mWidth, (*p)->mHeight);
+                            min.makeFloor((*p)->mPosition - padding);
+                            max.makeCeil((*p)->mPosition + padding);
+                        }
+                        else
+                        {
+                            min.makeFloor((*p)->mPosition - defaultPadding);
+                            max.makeCeil((*p)->mPosition + defaultPadding);
+                        }
                     }
                 }
                 mWorldAABB.setExtents(min, max);
@@ -879,8 +1344,9 @@ namespace Ogre {
                 mAABB.merge(newAABB);
             }
 
-            mParentNode->needUpdate();
+            return true;
         }
+        return false;
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::fastForward(Real time, Real interval)
@@ -1037,11 +1503,16 @@ namespace Ogre {
         // Notify renderer if exists
         if (mRenderer)
         {
+            _syncParticleInstances();
             mRenderer->_notifyParticleCleared(mActiveParticles);
         }
 
         // Move actives to free list
         mFreeParticles.splice(mFreeParticles.end(), mActiveParticles);
+        mParticleArrays.count = 0;
+        mParticleArraysDirtyFrom = 0;
+        mParticleInstancesOutdated = false;
+        mActiveParticlesOutdated = false;
 
         // Add active emitted emitters to free list
         addActiveEmittedEmittersToFreeList();
@@ -1204,6 +1675,7 @@ namespace Ogre {
     {
         if (mRenderer)
         {
+            _syncParticleInstances();
             SortMode sortMode = mRenderer->_getSortMode();
             if (sortMode == SM_DIRECTION)
             {
@@ -1600,11 +2072,30 @@ namespace Ogre {
         static_cast<ParticleSystem*>(target)->setNonVisibleUpdateTimeout(
             StringConverter::parseReal(val));
     }
+    //-----------------------------------------------------------------------
+    String ParticleSystem::CmdSoAStorage::doGet(const void* target) const
+    {
+        return StringConverter::toString(
+            static_cast<const ParticleSystem*>(target)->getSoAStorageEnabled());
+    }
+    void ParticleSystem::CmdSoAStorage::doSet(void* target, const String& val)
+    {
+        static_cast<ParticleSystem*>(target)->setSoAStorageEnabled(
+            StringConverter::parseBool(val));
+    }
    //-----------------------------------------------------------------------
     ParticleAffector::~ParticleAffector() 
     {
     }
     //-----------------------------------------------------------------------
+    void ParticleAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        (void)batch;
+        pSystem->_syncParticleInstances();
+        _affectParticles(pSystem, timeElapsed);
+        pSystem->_syncParticleArrays();
+    }
+    //-----------------------------------------------------------------------
     ParticleAffectorFactory::~ParticleAffectorFactory() 
     {
         // Destroy all affectors
@@ -34,6 +34,20 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 
 namespace Ogre {
+    namespace
+    {
+        /// Updates a range of particle systems, for WorkQueue::parallelFor
+        struct ParticleSystemUpdateTask
+        {
+            const vector<ParticleSystem*>::type* systems;
+
+            void operator()(size_t begin, size_t end) const
+            {
+                for (size_t i = begin; i < end; ++i)
+                    (*systems)[i]->_updateParallel();
+            }
+        };
+    }
     //-----------------------------------------------------------------------
     // Shortcut to set up billboard particle renderer
     BillboardParticleRendererFactory* mBillboardRendererFactory = 0;
@@ -49,6 +63,7 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     ParticleSystemManager::ParticleSystemManager()
+        : mParallelUpdates(false)
     {
         OGRE_LOCK_AUTO_MUTEX;
         mFactory = OGRE_NEW ParticleSystemFactory();
@@ -353,6 +368,58 @@ namespace Ogre {
         pFact->second->destroyInstance(renderer);
     }
     //-----------------------------------------------------------------------
+    void ParticleSystemManager::setParallelUpdatesEnabled(bool enabled)
+    {
+        // Don't leave queued updates behind
+        if (!enabled)
+            _updateQueuedSystems();
+        mParallelUpdates = enabled;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::_queueUpdate(ParticleSystem* sys, Real timeElapsed)
+    {
+        mQueuedUpdates.push_back(std::make_pair(sys, timeElapsed));
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::_cancelQueuedUpdates(ParticleSystem* sys)
+    {
+        QueuedUpdateList::iterator i = mQueuedUpdates.begin();
+        while (i != mQueuedUpdates.end())
+        {
+            if (i->first == sys)
+                i = mQueuedUpdates.erase(i);
+            else
+                ++i;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::_updateQueuedSystems(void)
+    {
+        if (mQueuedUpdates.empty())
+            return;
+
+        // Whatever touches state shared between systems, like the renderers
+        // and the scene nodes, is done here on the calling thread
+        mDueSystems.clear();
+        QueuedUpdateList::iterator i;
+        for (i = mQueuedUpdates.begin(); i != mQueuedUpdates.end(); ++i)
+        {
+            if (i->first->_prepareParallelUpdate(i->second))
+                mDueSystems.push_back(i->first);
+        }
+        mQueuedUpdates.clear();
+
+        if (!mDueSystems.empty())
+        {
+            ParticleSystemUpdateTask task = {&mDueSystems};
+            Root::getSingleton().getWorkQueue()->parallelFor(0, mDueSystems.size(), 1, task);
+
+            vector<ParticleSystem*>::type::iterator s;
+            for (s = mDueSystems.begin(); s != mDueSystems.end(); ++s)
+                (*s)->_finishParallelUpdate();
+        }
+    }
+    //-----------------------------------------------------------------------
     void ParticleSystemManager::_initialise(void)
     {
         OGRE_LOCK_AUTO_MUTEX;
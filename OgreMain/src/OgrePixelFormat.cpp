@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgrePixelFormat.h"
 #include "OgrePixelFormatDescriptions.h"
+#include "OgreOptimisedUtil.h"
 
 namespace {
 #include "OgrePixelConversions.h"
@@ -702,6 +703,75 @@ namespace Ogre {
         bulkPixelConversion(src, dst);
     }
     //-----------------------------------------------------------------------
+    /** Number of components of the formats which store each of them as a plain
+        8 bit, half or float value, in the same order. Zero for other formats.
+    */
+    static size_t getPlainComponentCount(PixelFormat format)
+    {
+        switch(format)
+        {
+        case PF_FLOAT16_R: case PF_FLOAT32_R:
+            return 1;
+        case PF_FLOAT16_GR: case PF_FLOAT32_GR:
+            return 2;
+        case PF_BYTE_RGB: case PF_FLOAT16_RGB: case PF_FLOAT32_RGB:
+            return 3;
+        case PF_BYTE_RGBA: case PF_FLOAT16_RGBA: case PF_FLOAT32_RGBA:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+    //-----------------------------------------------------------------------
+    /** Converts between formats with the same plain component layout a row at
+        a time, using the OptimisedUtil routines.
+    @return true if the conversion was done
+    */
+    static bool doComponentConversion(const PixelBox &src, const PixelBox &dst)
+    {
+        const size_t components = getPlainComponentCount(src.format);
+        if(components == 0 || components != getPlainComponentCount(dst.format))
+            return false;
+
+        const PixelComponentType srcType = PixelUtil::getComponentType(src.format);
+        const PixelComponentType dstType = PixelUtil::getComponentType(dst.format);
+        const size_t srcPixelSize = PixelUtil::getNumElemBytes(src.format);
+        const size_t dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
+        const size_t rowComponents = src.getWidth() * components;
+
+        // 8 bit <-> half goes through a float row
+        vector<float>::type temp;
+        if(srcType != PCT_FLOAT32 && dstType != PCT_FLOAT32)
+            temp.resize(rowComponents);
+
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+        for(size_t z = 0; z < src.getDepth(); z++)
+        {
+            for(size_t y = 0; y < src.getHeight(); y++)
+            {
+                const uint8* srcptr = src.data + srcPixelSize *
+                    (src.left + (src.top + y) * src.rowPitch + (src.front + z) * src.slicePitch);
+                uint8* dstptr = dst.data + dstPixelSize *
+                    (dst.left + (dst.top + y) * dst.rowPitch + (dst.front + z) * dst.slicePitch);
+
+                float* floats = dstType == PCT_FLOAT32 ? reinterpret_cast<float*>(dstptr) :
+                    srcType == PCT_FLOAT32 ? const_cast<float*>(reinterpret_cast<const float*>(srcptr)) :
+                    &temp[0];
+
+                if(srcType == PCT_BYTE)
+                    util->convertUByteToFloat(srcptr, floats, rowComponents);
+                else if(srcType == PCT_FLOAT16)
+                    util->convertHalfToFloat(reinterpret_cast<const uint16*>(srcptr), floats, rowComponents);
+
+                if(dstType == PCT_BYTE)
+                    util->convertFloatToUByte(floats, dstptr, rowComponents);
+                else if(dstType == PCT_FLOAT16)
+                    util->convertFloatToHalf(floats, reinterpret_cast<uint16*>(dstptr), rowComponents);
+            }
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
     void PixelUtil::bulkPixelConversion(const PixelBox &src, const PixelBox &dst)
     {
         assert(src.getWidth() == dst.getWidth() &&
@@ -801,6 +871,12 @@ namespace Ogre {
         }
 #endif
 
+        // Plain 8 bit, half and float components, converted a row at a time
+        if(doComponentConversion(src, dst))
+        {
+            return;
+        }
+
         const size_t srcPixelSize = PixelUtil::getNumElemBytes(src.format);
         const size_t dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
         uint8 *srcptr = src.data
@@ -148,13 +148,17 @@ namespace Ogre {
     }
 
     //---------------------------------------------------------------------
-    // Performs CPUID instruction with 'query', fill the results, and return value of eax.
-    static uint _performCpuid(int query, CpuidResult& result)
+    // Performs CPUID instruction with 'query' and 'subquery', fill the results, and return value of eax.
+    static uint _performCpuid(int query, CpuidResult& result, int subquery = 0)
     {
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
     #if _MSC_VER >= 1400 
         int CPUInfo[4];
+        #if _MSC_VER >= 1600
+        __cpuidex(CPUInfo, query, subquery);
+        #else
         __cpuid(CPUInfo, query);
+        #endif
         result._eax = CPUInfo[0];
         result._ebx = CPUInfo[1];
         result._ecx = CPUInfo[2];
@@ -165,6 +169,7 @@ namespace Ogre {
         {
             mov     edi, result
             mov     eax, query
+            mov     ecx, subquery
             cpuid
             mov     [edi]._eax, eax
             mov     [edi]._ebx, ebx
@@ -177,7 +182,7 @@ namespace Ogre {
         #if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
         __asm__
         (
-            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query)
+            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query), "c" (subquery)
         );
         #else
         __asm__
@@ -187,7 +192,7 @@ namespace Ogre {
             "movl   %%ebx, %%edi    \n\t"
             "popl   %%ebx           \n\t"
             : "=a" (result._eax), "=D" (result._ebx), "=c" (result._ecx), "=d" (result._edx)
-            : "a" (query)
+            : "a" (query), "c" (subquery)
         );
        #endif // OGRE_ARCHITECTURE_64
         return result._eax;
@@ -274,10 +279,69 @@ namespace Ogre {
 #endif
     }
 
+    //---------------------------------------------------------------------
+    // Reads the extended control register 0, which tells the register states
+    // the os saves on context switches. Only valid if CPUID reports OSXSAVE.
+    static uint _queryExtendedControlRegister(void)
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+    #if _MSC_FULL_VER >= 160040219
+        return (uint)_xgetbv(0);
+    #else
+        return 0;
+    #endif
+#elif (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_EMSCRIPTEN
+        uint eax, edx;
+        // xgetbv, encoded for assemblers which don't know the mnemonic
+        __asm__ __volatile__
+        (
+            ".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0)
+        );
+        return eax;
+#else
+        // TODO: Supports other compiler
+        return 0;
+#endif
+    }
+
     //---------------------------------------------------------------------
     // Compiler-independent routines
     //---------------------------------------------------------------------
 
+#define CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES 0x7
+
+#define CPUID_STD_FMA               (1<<12)     // ECX[12] - Bit 12 of standard function 1 indicate FMA supported
+#define CPUID_STD_OSXSAVE           (1<<27)     // ECX[27] - Bit 27 of standard function 1 indicate xgetbv usable
+#define CPUID_STD_AVX               (1<<28)     // ECX[28] - Bit 28 of standard function 1 indicate AVX supported
+#define CPUID_SEF_AVX2              (1<<5)      // EBX[5]  - Bit 5 of structured extended function 7 indicate AVX2 supported
+
+#define XCR0_SSE_AVX_STATE          0x6         // Bit 1 and 2 - os saves xmm and ymm registers
+
+    // Checks the AVX family from the results of the standard features function, all
+    // of them also need the os to save the ymm registers.
+    static uint _queryAvxFeatures(const CpuidResult& standardFeatures)
+    {
+        uint features = 0;
+
+        if ((standardFeatures._ecx & (CPUID_STD_OSXSAVE | CPUID_STD_AVX)) == (CPUID_STD_OSXSAVE | CPUID_STD_AVX) &&
+            (_queryExtendedControlRegister() & XCR0_SSE_AVX_STATE) == XCR0_SSE_AVX_STATE)
+        {
+            features |= PlatformInformation::CPU_FEATURE_AVX;
+            if (standardFeatures._ecx & CPUID_STD_FMA)
+                features |= PlatformInformation::CPU_FEATURE_FMA;
+
+            CpuidResult result;
+            if (_performCpuid(0, result) >= CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES)
+            {
+                _performCpuid(CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES, result, 0);
+                if (result._ebx & CPUID_SEF_AVX2)
+                    features |= PlatformInformation::CPU_FEATURE_AVX2;
+            }
+        }
+
+        return features;
+    }
+    //---------------------------------------------------------------------
     static uint queryCpuFeatures(void)
     {
 
@@ -347,6 +411,7 @@ namespace Ogre {
                         features |= PlatformInformation::CPU_FEATURE_SSE41;
                     if (result._ecx & CPUID_STD_SSE42)
                         features |= PlatformInformation::CPU_FEATURE_SSE42;
+                    features |= _queryAvxFeatures(result);
 
                     // Check to see if this is a Pentium 4 or later processor
                     if ((result._eax & CPUID_EXT_FAMILY_ID_MASK) ||
@@ -389,6 +454,7 @@ namespace Ogre {
 
                     if (result._ecx & CPUID_STD_SSE3)
                         features |= PlatformInformation::CPU_FEATURE_SSE3;
+                    features |= _queryAvxFeatures(result);
 
                     // Has extended feature ?
                     const uint maxExtensionFunctionSupport = _performCpuid(CPUID_FUNC_EXTENSION_QUERY, result);
@@ -429,7 +495,10 @@ namespace Ogre {
             | PlatformInformation::CPU_FEATURE_SSE2
             | PlatformInformation::CPU_FEATURE_SSE3
             | PlatformInformation::CPU_FEATURE_SSE41
-            | PlatformInformation::CPU_FEATURE_SSE42;
+            | PlatformInformation::CPU_FEATURE_SSE42
+            | PlatformInformation::CPU_FEATURE_AVX
+            | PlatformInformation::CPU_FEATURE_AVX2
+            | PlatformInformation::CPU_FEATURE_FMA;
 
         if ((features & sse_features) && !_checkOperatingSystemSupportSSE())
         {
@@ -703,6 +772,12 @@ namespace Ogre {
                 " *        SSE41: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE41), true));
             pLog->logMessage(
                 " *        SSE42: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE42), true));
+            pLog->logMessage(
+                " *          AVX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX), true));
+            pLog->logMessage(
+                " *         AVX2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX2), true));
+            pLog->logMessage(
+                " *          FMA: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_FMA), true));
             pLog->logMessage(
                 " *          MMX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_MMX), true));
             pLog->logMessage(
@@ -31,9 +31,23 @@ THE SOFTWARE.
 namespace Ogre {
     // Init statics
     RadixSort<QueuedRenderableCollection::RenderablePassList,
-        RenderablePass, uint32> QueuedRenderableCollection::msRadixSorter1;
-    RadixSort<QueuedRenderableCollection::RenderablePassList,
-        RenderablePass, float> QueuedRenderableCollection::msRadixSorter2;
+        RenderablePass, uint64> QueuedRenderableCollection::msRadixSorter;
+
+    namespace
+    {
+        /// Predicate for entries using a given pass
+        struct RenderablePassUsesPass
+        {
+            const Pass* pass;
+            bool operator()(const RenderablePass& rp) const { return rp.pass == pass; }
+        };
+
+        /// Orders entries by pass identity only, to regroup passes sharing a hash
+        struct RenderablePassPassLess
+        {
+            bool operator()(const RenderablePass& a, const RenderablePass& b) const { return a.pass < b.pass; }
+        };
+    }
 
 
     //-----------------------------------------------------------------------
@@ -205,43 +219,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderPriorityGroup::clear(void)
     {
-        // Delete queue groups which are using passes which are to be
-        // deleted, we won't need these any more and they clutter up 
-        // the list and can cause problems with future clones
-        {
-            // Hmm, a bit hacky but least obtrusive for now
-                    OGRE_LOCK_MUTEX(Pass::msPassGraveyardMutex);
-            const Pass::PassSet& graveyardList = Pass::getPassGraveyard();
-            Pass::PassSet::const_iterator gi, giend;
-            giend = graveyardList.end();
-            for (gi = graveyardList.begin(); gi != giend; ++gi)
-            {
-                removePassEntry(*gi);
-            }
-        }
-
-        // Now remove any dirty passes, these will have their hashes recalculated
-        // by the parent queue after all groups have been processed
-        // If we don't do this, the std::map will become inconsistent for new insterts
-        {
-            // Hmm, a bit hacky but least obtrusive for now
-                    OGRE_LOCK_MUTEX(Pass::msDirtyHashListMutex);
-            const Pass::PassSet& dirtyList = Pass::getDirtyHashList();
-            Pass::PassSet::const_iterator di, diend;
-            diend = dirtyList.end();
-            for (di = dirtyList.begin(); di != diend; ++di)
-            {
-                removePassEntry(*di);
-            }
-        }
-        // NB we do NOT clear the graveyard or the dirty list here, because 
-        // it needs to be acted on for all groups, the parent queue takes 
-        // care of this afterwards
-
-        // Now empty the remaining collections
-        // Note that groups don't get deleted, just emptied hence the difference
-        // between the pass groups which are removed above, and clearing done
-        // here
+        // Collections keep nothing per pass once cleared, so passes which are
+        // destroyed or get their hash recalculated need no special treatment
         mSolidsBasic.clear();
         mSolidsDecal.clear();
         mSolidsDiffuseSpecular.clear();
@@ -279,55 +258,59 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::clear(void)
     {
-        PassGroupRenderableMap::iterator i, iend;
-        iend = mGrouped.end();
-        for (i = mGrouped.begin(); i != iend; ++i)
-        {
-            // Clear the list associated with this pass, but leave the pass entry
-            i->second.clear();
-        }
-
-        // Clear sorted list
+        mGrouped.clear();
         mSortedDescending.clear();
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::removePassGroup(Pass* p)
     {
-        PassGroupRenderableMap::iterator i;
-
-        i = mGrouped.find(p);
-        if (i != mGrouped.end())
-        {
-            // erase from map
-            mGrouped.erase(i);
-        }
+        RenderablePassUsesPass pred = {p};
+        mGrouped.erase(std::remove_if(mGrouped.begin(), mGrouped.end(), pred), mGrouped.end());
+        mSortedDescending.erase(
+            std::remove_if(mSortedDescending.begin(), mSortedDescending.end(), pred),
+            mSortedDescending.end());
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::sort(const Camera* cam)
     {
+        if (mOrganisationMode & OM_PASS_GROUP)
+        {
+            // a single radix sort both groups by pass hash and orders each group
+            msRadixSorter.sort(mGrouped, RadixSortFunctorPassDistance(cam));
+
+            // Different passes can share a hash, and are then interleaved by depth.
+            // Regroup them by pass, the stable sort keeps the depth order inside each.
+            RenderablePassList::iterator runBegin = mGrouped.begin(), end = mGrouped.end();
+            while (runBegin != end)
+            {
+                const uint32 hash = runBegin->pass->getHash();
+                bool mixed = false;
+                RenderablePassList::iterator runEnd = runBegin + 1;
+                for (; runEnd != end && runEnd->pass->getHash() == hash; ++runEnd)
+                {
+                    mixed |= runEnd->pass != runBegin->pass;
+                }
+                if (mixed)
+                {
+                    std::stable_sort(runBegin, runEnd, RenderablePassPassLess());
+                }
+                runBegin = runEnd;
+            }
+        }
+
         // ascending and descending sort both set bit 1
         // We always sort descending, because the only difference is in the
         // acceptVisitor method, where we iterate in reverse in ascending mode
         if (mOrganisationMode & OM_SORT_DESCENDING)
         {
-            
             // We can either use a stable_sort and the 'less' implementation,
-            // or a 2-pass radix sort (once by pass, then by distance, since
-            // radix sorting is inherently stable this will work)
-            // We use stable_sort if the number of items is 512 or less, since
-            // the complexity of the radix sort is approximately O(10N), since 
-            // each sort is O(5N) (1 pass histograms, 4 passes sort)
-            // Since stable_sort has a worst-case performance of O(N(logN)^2)
-            // the performance tipping point is from about 1500 items, but in
-            // stable_sorts best-case scenario O(NlogN) it would be much higher.
-            // Take a stab at 2000 items.
-            
+            // or a radix sort on a 64 bit key (distance, then pass)
+            // We use stable_sort if the number of items is 2000 or less, since
+            // the radix sort needs up to 9 linear passes and copies the
+            // items twice, while stable_sort is O(NlogN) at best.
             if (mSortedDescending.size() > 2000)
             {
-                // sort by pass
-                msRadixSorter1.sort(mSortedDescending, RadixSortFunctorPass());
-                // sort by depth
-                msRadixSorter2.sort(mSortedDescending, RadixSortFunctorDistance(cam));
+                msRadixSorter.sort(mSortedDescending, RadixSortFunctorDistancePass(cam));
             }
             else
             {
@@ -336,9 +319,6 @@ namespace Ogre {
                     DepthSortDescendingLess(cam));
             }
         }
-
-        // Nothing needs to be done for pass groups, they auto-organise
-
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::addRenderable(Pass* pass, Renderable* rend)
@@ -351,25 +331,8 @@ namespace Ogre {
 
         if (mOrganisationMode & OM_PASS_GROUP)
         {
-            PassGroupRenderableMap::iterator i = mGrouped.find(pass);
-            if (i == mGrouped.end())
-            {
-                std::pair<PassGroupRenderableMap::iterator, bool> retPair;
-                // Create new pass entry, build a new list
-                // Note that this pass and list are never destroyed until the 
-                // engine shuts down, or a pass is destroyed or has it's hash
-                // recalculated, although the lists will be cleared
-                retPair = mGrouped.insert(
-                    PassGroupRenderableMap::value_type(pass, RenderableList()));
-                assert(retPair.second && 
-                    "Error inserting new pass entry into PassGroupRenderableMap");
-                i = retPair.first;
-            }
-            // Insert renderable
-            i->second.push_back(rend);
-            
+            mGrouped.push_back(RenderablePass(rend, pass));
         }
-        
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::acceptVisitor(
@@ -409,27 +372,27 @@ namespace Ogre {
     void QueuedRenderableCollection::acceptVisitorGrouped(
         QueuedRenderableVisitor* visitor) const
     {
-        PassGroupRenderableMap::const_iterator ipass, ipassend;
-        ipassend = mGrouped.end();
-        for (ipass = mGrouped.begin(); ipass != ipassend; ++ipass)
+        // Items are sorted by pass hash and then by pass, so those sharing a pass are adjacent
+        RenderablePassList::const_iterator i, iend;
+        iend = mGrouped.end();
+        for (i = mGrouped.begin(); i != iend; )
         {
-            // Fast bypass if this group is now empty
-            if (ipass->second.empty()) continue;
+            Pass* pass = i->pass;
 
             // Visit Pass - allow skip
-            if (!visitor->visit(ipass->first))
+            if (!visitor->visit(pass))
+            {
+                while (i != iend && i->pass == pass)
+                    ++i;
                 continue;
+            }
 
-            const RenderableList& rendList = ipass->second;
-            RenderableList::const_iterator irend, irendend;
-            irendend = rendList.end();
-            for (irend = rendList.begin(); irend != irendend; ++irend)
+            for (; i != iend && i->pass == pass; ++i)
             {
                 // Visit Renderable
-                visitor->visit(const_cast<Renderable*>(*irend));
+                visitor->visit(i->renderable);
             }
-        } 
-
+        }
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::acceptVisitorDescending(
@@ -462,30 +425,8 @@ namespace Ogre {
     void QueuedRenderableCollection::merge( const QueuedRenderableCollection& rhs )
     {
         mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
-
-        PassGroupRenderableMap::const_iterator srcGroup;
-        for( srcGroup = rhs.mGrouped.begin(); srcGroup != rhs.mGrouped.end(); ++srcGroup )
-        {
-            PassGroupRenderableMap::iterator dstGroup = mGrouped.find( srcGroup->first );
-            if (dstGroup == mGrouped.end())
-            {
-                std::pair<PassGroupRenderableMap::iterator, bool> retPair;
-                // Create new pass entry, build a new list
-                // Note that this pass and list are never destroyed until the 
-                // engine shuts down, or a pass is destroyed or has it's hash
-                // recalculated, although the lists will be cleared
-                retPair = mGrouped.insert(
-                    PassGroupRenderableMap::value_type(srcGroup->first, RenderableList()));
-                assert(retPair.second && 
-                    "Error inserting new pass entry into PassGroupRenderableMap");
-                dstGroup = retPair.first;
-            }
-
-            // Insert renderable
-            dstGroup->second.insert( dstGroup->second.end(), srcGroup->second.begin(), srcGroup->second.end() );
-        }
+        mGrouped.insert( mGrouped.end(), rhs.mGrouped.begin(), rhs.mGrouped.end() );
     }
 
-
 }
 
@@ -27,9 +27,134 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreScriptLoader.h"
+#include "OgreWorkQueue.h"
+#include "OgreTimer.h"
+#include "OgreAtomicScalar.h"
 
 namespace Ogre {
 
+    namespace {
+        /// A script read ahead of parsing
+        struct PreparedScript
+        {
+            ScriptLoader* loader;
+            DataStreamPtr stream;
+            Any prepared;
+        };
+        typedef vector<PreparedScript>::type PreparedScriptList;
+
+        /// Body of the parallel script parsing
+        struct PrepareScriptsTask
+        {
+            PreparedScript* scripts;
+            const String* groupName;
+
+            void operator()(size_t begin, size_t end) const
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (scripts[i].stream)
+                        scripts[i].prepared = scripts[i].loader->_prepareScript(scripts[i].stream, *groupName);
+                }
+            }
+        };
+    }
+
+    struct ResourceGroupManager::PipelineState : public ResourceAlloc
+    {
+        enum { PENDING, READING, READ };
+
+        vector<ResourcePtr>::type resources;
+        /// The archive holding the source file of each resource, 0 to leave it to openResource
+        vector<Archive*>::type archives;
+        /// The source file of each resource, read ahead into memory
+        vector<DataStreamPtr>::type streams;
+        /// PENDING, READING or READ for each resource
+        vector<AtomicScalar<int> >::type status;
+        /// The resource being loaded, whose stream openResource hands out
+        size_t current;
+        AtomicScalar<size_t> readCount;
+        AtomicScalar<unsigned long> readTime;
+        Timer timer;
+        OGRE_WQ_MUTEX(mutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(sync);
+        /// Serialises using the archives, which are not thread safe
+        OGRE_WQ_MUTEX(archiveMutex);
+
+        explicit PipelineState(vector<ResourcePtr>::type& resourceList)
+            : archives(resourceList.size()), streams(resourceList.size()), status(resourceList.size()),
+              current(0), readCount(0), readTime(0)
+        {
+            resources.swap(resourceList);
+            for (size_t i = 0; i < status.size(); ++i)
+                status[i] = PENDING;
+        }
+
+        /// Reads the source file of resource i, unless another thread already started it
+        bool read(size_t i)
+        {
+            int expected = PENDING;
+            if (!status[i].compare_exchange_strong(expected, READING))
+                return false;
+
+            if (archives[i])
+            {
+                unsigned long start = timer.getMicroseconds();
+                try
+                {
+                    OGRE_WQ_LOCK_MUTEX(archiveMutex);
+                    DataStreamPtr stream = archives[i]->open(resources[i]->getName());
+                    if (stream)
+                        streams[i].reset(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+                }
+                catch (...)
+                {
+                    // openResource tries again when the resource is loaded, and reports the error
+                    streams[i].reset();
+                }
+                readTime += timer.getMicroseconds() - start;
+            }
+            ++readCount;
+
+            OGRE_WQ_LOCK_MUTEX(mutex);
+            status[i] = READ;
+            OGRE_THREAD_NOTIFY_ALL(sync);
+            return true;
+        }
+
+        /// Waits until resource i is read, reading it here if no task started it yet
+        void waitRead(size_t i)
+        {
+            if (read(i))
+                return;
+
+            OGRE_WQ_LOCK_MUTEX_NAMED(mutex, lock);
+            while (status[i] != READ)
+                OGRE_THREAD_WAIT(sync, mutex, lock);
+        }
+
+        /// Keeps the tasks from reading resource i, or waits until the one doing it is done
+        void cancel(size_t i)
+        {
+            int expected = PENDING;
+            if (status[i].compare_exchange_strong(expected, READ))
+                return;
+
+            OGRE_WQ_LOCK_MUTEX_NAMED(mutex, lock);
+            while (status[i] != READ)
+                OGRE_THREAD_WAIT(sync, mutex, lock);
+        }
+
+        /// Reads one source file of a pipelined group load
+        struct ReadTask
+        {
+            SharedPtr<PipelineState> state;
+            size_t index;
+
+            void operator()() const { state->read(index); }
+        };
+    };
+
     //-----------------------------------------------------------------------
     template<> ResourceGroupManager* Singleton<ResourceGroupManager>::msSingleton = 0;
     ResourceGroupManager* ResourceGroupManager::getSingletonPtr(void)
@@ -54,7 +179,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mParallelScriptParsing(false), mPipelineStatistics(), mPipelineState(0), mCurrentGroup(0)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME, true); // the "General" group is synonymous to global pool
@@ -347,6 +472,136 @@ namespace Ogre {
         LogManager::getSingleton().logMessage("Finished loading resource group " + name);
     }
     //-----------------------------------------------------------------------
+    void ResourceGroupManager::loadResourceGroupPipelined(const String& name, size_t inFlightBytes)
+    {
+        LogManager::getSingleton().logMessage("Loading resource group '" + name + "' pipelined");
+        ResourceGroup* grp = getResourceGroup(name);
+        if (!grp)
+        {
+            OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
+                "Cannot find a group named " + name, 
+                "ResourceGroupManager::loadResourceGroupPipelined");
+        }
+
+        // The locks are only held while taking the resources, loading them may need the same ones
+        vector<ResourcePtr>::type resources;
+        {
+            OGRE_LOCK_AUTO_MUTEX;
+            OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex 
+
+            // Take the resources in loading order, so a resource changing group does not matter
+            ResourceGroup::LoadResourceOrderMap::iterator oi;
+            for (oi = grp->loadResourceOrderMap.begin(); oi != grp->loadResourceOrderMap.end(); ++oi)
+            {
+                resources.insert(resources.end(), oi->second.begin(), oi->second.end());
+            }
+        }
+        size_t resourceCount = resources.size();
+
+        // Estimate the size of each resource by its source file
+        map<String, size_t>::type fileSizes;
+        FileInfoListPtr files = listResourceFileInfo(name);
+        for (FileInfoList::iterator fi = files->begin(); fi != files->end(); ++fi)
+        {
+            fileSizes[fi->filename] = fi->uncompressedSize;
+            fileSizes[fi->basename] = fi->uncompressedSize;
+        }
+        vector<size_t>::type sizes(resourceCount);
+        for (size_t i = 0; i < resourceCount; ++i)
+        {
+            map<String, size_t>::type::iterator si = fileSizes.find(resources[i]->getName());
+            sizes[i] = si != fileSizes.end() ? si->second : 0;
+        }
+
+        SharedPtr<PipelineState> state(OGRE_NEW PipelineState(resources));
+        for (size_t i = 0; i < resourceCount; ++i)
+        {
+            // Resources without a file of their own, like manual ones, are not read ahead
+            if (!state->resources[i]->isManuallyLoaded())
+                state->archives[i] = resourceExists(grp, state->resources[i]->getName());
+        }
+        mPipelineStatistics = PipelineStatistics();
+        mPipelineStatistics.resourceCount = resourceCount;
+
+        // Set current group
+        mCurrentGroup = grp;
+        fireResourceGroupLoadStarted(name, resourceCount);
+
+        WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+        bool parallel = queue && queue->getTaskConcurrency() > 0;
+        // Makes openResource hand out the files read ahead, and use the archives one thread at a time
+        mPipelineState = state.get();
+        size_t submitted = 0;
+        size_t bytesInFlight = 0;
+        try
+        {
+            for (size_t i = 0; i < resourceCount; ++i)
+            {
+                // Keep reading ahead of loading, as far as the budget allows
+                while (submitted < resourceCount &&
+                       (submitted == i || bytesInFlight + sizes[submitted] <= inFlightBytes))
+                {
+                    bytesInFlight += sizes[submitted];
+                    if (parallel)
+                    {
+                        PipelineState::ReadTask task = {state, submitted};
+                        queue->addTask(task);
+                    }
+                    ++submitted;
+                }
+                mPipelineStatistics.peakBytesInFlight =
+                    std::max(mPipelineStatistics.peakBytesInFlight, bytesInFlight);
+
+                state->waitRead(i);
+                state->current = i;
+
+                const ResourcePtr& res = state->resources[i];
+                fireResourceLoadStarted(res);
+                unsigned long start = state->timer.getMicroseconds();
+                res->load();
+                mPipelineStatistics.loadTime += state->timer.getMicroseconds() - start;
+                fireResourceLoadEnded();
+                // in case the resource didn't open its file
+                state->streams[i].reset();
+
+                bytesInFlight -= sizes[i];
+                mPipelineStatistics.readCount = state->readCount;
+                mPipelineStatistics.loadedCount = i + 1;
+                mPipelineStatistics.loadedBytes += sizes[i];
+                mPipelineStatistics.readTime = state->readTime;
+                mPipelineStatistics.elapsedTime = state->timer.getMicroseconds();
+            }
+        }
+        catch (...)
+        {
+            // Tasks still queued must not start reading, and those running must
+            // be done with the archives before the caller can change them
+            for (size_t i = 0; i < submitted; ++i)
+                state->cancel(i);
+            mPipelineState = 0;
+            mCurrentGroup = 0;
+            throw;
+        }
+        mPipelineState = 0;
+        mPipelineStatistics.elapsedTime = state->timer.getMicroseconds();
+
+        fireResourceGroupLoadEnded(name);
+
+        {
+            OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex 
+            // group is loaded
+            grp->groupStatus = ResourceGroup::LOADED;
+        }
+
+        // reset current group
+        mCurrentGroup = 0;
+
+        LogManager::getSingleton().stream()
+            << "Finished loading resource group " << name << " - " << resourceCount
+            << " resources, " << mPipelineStatistics.loadedBytes << " bytes in "
+            << mPipelineStatistics.elapsedTime / 1000 << " ms";
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::unloadResourceGroup(const String& name, bool reloadableOnly)
     {
         LogManager::getSingleton().logMessage("Unloading resource group " + name);
@@ -687,7 +942,31 @@ namespace Ogre {
 
         if (pArch)
         {
-            DataStreamPtr stream = pArch->open(resourceName);
+            DataStreamPtr stream;
+            if (mPipelineState)
+            {
+                const size_t current = mPipelineState->current;
+                const ResourcePtr& res = mPipelineState->resources[current];
+                if (resourceBeingLoaded == res.get() && resourceName == res->getName() &&
+                    pArch == mPipelineState->archives[current] && mPipelineState->streams[current])
+                {
+                    // Read ahead by loadResourceGroupPipelined
+                    stream.swap(mPipelineState->streams[current]);
+                }
+                else
+                {
+                    // Archives are not thread safe, so while loadResourceGroupPipelined
+                    // reads ahead on worker threads they are used one at a time, in one go
+                    OGRE_WQ_LOCK_MUTEX(mPipelineState->archiveMutex);
+                    stream = pArch->open(resourceName);
+                    if (stream)
+                        stream.reset(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+                }
+            }
+            else
+            {
+                stream = pArch->open(resourceName);
+            }
             if (mLoadingListener)
                 mLoadingListener->resourceStreamOpened(resourceName, groupName, resourceBeingLoaded, stream);
             return stream;
@@ -982,14 +1261,43 @@ namespace Ogre {
         // Fire scripting event
         fireResourceGroupScriptingStarted(grp->name, scriptCount);
 
+        // Read all scripts up front and prepare them on the work queue
+        PreparedScriptList preparedScripts;
+        if (mParallelScriptParsing)
+        {
+            preparedScripts.reserve(scriptCount);
+            for (ScriptLoaderFileList::iterator slfli = scriptLoaderFileList.begin();
+                slfli != scriptLoaderFileList.end(); ++slfli)
+            {
+                for (FileInfoList::iterator fii = slfli->second.begin(); fii != slfli->second.end(); ++fii)
+                {
+                    PreparedScript script;
+                    script.loader = slfli->first;
+                    // archives are not thread safe, so reading stays on this thread
+                    DataStreamPtr stream = fii->archive->open(fii->filename);
+                    if (stream)
+                        script.stream.reset(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+                    preparedScripts.push_back(script);
+                }
+            }
+
+            PrepareScriptsTask task = {preparedScripts.empty() ? 0 : &preparedScripts[0], &grp->name};
+            WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+            if (queue)
+                queue->parallelFor(0, preparedScripts.size(), 1, task);
+            else
+                task(0, preparedScripts.size());
+        }
+
         // Iterate over scripts and parse
         // Note we respect original ordering
+        size_t scriptIndex = 0;
         for (ScriptLoaderFileList::iterator slfli = scriptLoaderFileList.begin();
             slfli != scriptLoaderFileList.end(); ++slfli)
         {
             ScriptLoader* su = slfli->first;
             // Iterate over each item in the list
-            for (FileInfoList::iterator fii = slfli->second.begin(); fii != slfli->second.end(); ++fii)
+            for (FileInfoList::iterator fii = slfli->second.begin(); fii != slfli->second.end(); ++fii, ++scriptIndex)
             {
                 bool skipScript = false;
                 fireScriptStarted(fii->filename, skipScript);
@@ -1002,19 +1310,46 @@ namespace Ogre {
                 {
                     LogManager::getSingleton().logMessage(
                         "Parsing script " + fii->filename);
-                    DataStreamPtr stream = fii->archive->open(fii->filename);
-                    if (stream)
+                    if (!preparedScripts.empty())
                     {
-                        if (mLoadingListener)
-                            mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
-
-                        if(fii->archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+                        PreparedScript& script = preparedScripts[scriptIndex];
+                        if (script.stream)
                         {
-                            DataStreamPtr cachedCopy(OGRE_NEW MemoryDataStream(stream->getName(), stream));
-                            su->parseScript(cachedCopy, grp->name);
+                            // the listener only hears about scripts that are parsed, as in the serial path
+                            DataStreamPtr stream = script.stream;
+                            if (mLoadingListener)
+                                mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
+
+                            if (stream == script.stream)
+                            {
+                                stream->seek(0);
+                                su->_parsePreparedScript(stream, grp->name, script.prepared);
+                            }
+                            else
+                            {
+                                // replaced by the listener, so what was prepared doesn't apply
+                                su->parseScript(stream, grp->name);
+                            }
+                        }
+                        // done with the copy
+                        script = PreparedScript();
+                    }
+                    else
+                    {
+                        DataStreamPtr stream = fii->archive->open(fii->filename);
+                        if (stream)
+                        {
+                            if (mLoadingListener)
+                                mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
+
+                            if(fii->archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+                            {
+                                DataStreamPtr cachedCopy(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+                                su->parseScript(cachedCopy, grp->name);
+                            }
+                            else
+                                su->parseScript(stream, grp->name);
                         }
-                        else
-                            su->parseScript(stream, grp->name);
                     }
                 }
                 fireScriptEnded(fii->filename, skipScript);
@@ -1561,6 +1896,12 @@ namespace Ogre {
         return resourceExists(grp, resourceName) != 0;
     }
     //-----------------------------------------------------------------------
+    Archive* ResourceGroupManager::_getArchiveToResource(const String& resourceName, const String& groupName) const
+    {
+        ResourceGroup* grp = getResourceGroup(groupName);
+        return grp ? resourceExists(grp, resourceName) : 0;
+    }
+    //-----------------------------------------------------------------------
     Archive* ResourceGroupManager::resourceExists(ResourceGroup* grp, const String& resourceName) const
     {
 
@@ -154,7 +154,11 @@ namespace Ogre {
         mResourceGroupManager = OGRE_NEW ResourceGroupManager();
 
         // WorkQueue (note: users can replace this if they want)
+#if OGRE_THREAD_PROVIDER == 4 && OGRE_THREAD_WORK_STEALING
+        DefaultWorkQueueBase* defaultQ = OGRE_NEW StealingWorkQueue("Root");
+#else
         DefaultWorkQueue* defaultQ = OGRE_NEW DefaultWorkQueue("Root");
+#endif
         // never process responses in main thread for longer than 10ms by default
         defaultQ->setResponseProcessingTimeLimit(10);
         // match threads to hardware
@@ -206,6 +210,8 @@ namespace Ogre {
 
         mFileSystemArchiveFactory = OGRE_NEW FileSystemArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mFileSystemArchiveFactory );
+        mMappedFileSystemArchiveFactory = OGRE_NEW MappedFileSystemArchiveFactory();
+        ArchiveManager::getSingleton().addArchiveFactory( mMappedFileSystemArchiveFactory );
 #   if OGRE_NO_ZIP_ARCHIVE == 0
         mZipArchiveFactory = OGRE_NEW ZipArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mZipArchiveFactory );
@@ -313,6 +319,7 @@ namespace Ogre {
         OGRE_DELETE mEmbeddedZipArchiveFactory;
 #   endif
         OGRE_DELETE mFileSystemArchiveFactory;
+        OGRE_DELETE mMappedFileSystemArchiveFactory;
 
         OGRE_DELETE mSkeletonManager;
         OGRE_DELETE mMeshManager;
@@ -72,9 +72,21 @@ THE SOFTWARE.
 // We don't support gcc 3.x anymore anyway, although that had SSE it was a bit flaky?
 #include <xmmintrin.h>
 
+// SSE2 integer intrinsics are only usable when the compiler targets SSE2,
+// which is always the case for x86-64. Callers still have to check
+// PlatformInformation::CPU_FEATURE_SSE2 before running them.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define __OGRE_HAVE_SSE2 1
+#   include <emmintrin.h>
+#endif
+
 
 #endif // OGRE_DOUBLE_PRECISION == 0 && OGRE_CPU == OGRE_CPU_X86
 
+#ifndef __OGRE_HAVE_SSE2
+#   define __OGRE_HAVE_SSE2 0
+#endif
+
 
 
 //---------------------------------------------------------------------
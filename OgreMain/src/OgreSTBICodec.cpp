@@ -154,11 +154,25 @@ namespace Ogre {
     //---------------------------------------------------------------------
     Codec::DecodeResult STBIImageCodec::decode(const DataStreamPtr& input) const
     {
-        String contents = input->getAsString();
+        // decode straight from memory backed streams, copy anything else
+        String contents;
+        const uchar* pSrc;
+        size_t srcSize;
+        if (MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(input.get()))
+        {
+            pSrc = memStream->getCurrentPtr();
+            srcSize = memStream->size() - memStream->tell();
+        }
+        else
+        {
+            contents = input->getAsString();
+            pSrc = (const uchar*)contents.data();
+            srcSize = contents.size();
+        }
 
         int width, height, components;
-        stbi_uc* pixelData = stbi_load_from_memory((uchar*)contents.data(),
-                static_cast<int>(contents.size()), &width, &height, &components, 0);
+        stbi_uc* pixelData = stbi_load_from_memory(pSrc,
+                static_cast<int>(srcSize), &width, &height, &components, 0);
 
         if (!pixelData)
         {
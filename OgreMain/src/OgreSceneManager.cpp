@@ -52,6 +52,8 @@ THE SOFTWARE.
 #include "OgreLodListener.h"
 #include "OgreInstancedGeometry.h"
 #include "OgreUnifiedHighLevelGpuProgram.h"
+#include "OgreNodeTransformStore.h"
+#include "OgreWorkQueue.h"
 
 // This class implements the most basic scene manager
 
@@ -68,6 +70,79 @@ uint32 SceneManager::LIGHT_TYPE_MASK            = 0x08000000;
 uint32 SceneManager::FRUSTUM_TYPE_MASK          = 0x04000000;
 uint32 SceneManager::USER_TYPE_MASK_LIMIT         = SceneManager::FRUSTUM_TYPE_MASK;
 //-----------------------------------------------------------------------
+namespace
+{
+    /// Updates the subtrees below a range of nodes, for WorkQueue::parallelFor
+    struct SceneGraphUpdateTask
+    {
+        const Node::ChildNodeMap* nodes;
+        /// Whether the parent of each node has changed
+        const vector<char>::type* parentHasChanged;
+
+        void operator()(size_t begin, size_t end) const
+        {
+            for (size_t i = begin; i < end; ++i)
+                (*nodes)[i]->_update(true, (*parentHasChanged)[i] != 0);
+        }
+    };
+
+    /** Gathers the visible objects below a range of subtrees, for WorkQueue::parallelFor.
+        Each chunk of grainSize subtrees has lists of its own, in which the end of
+        each subtree is noted.
+    */
+    struct SceneGraphCullTask
+    {
+        const vector<SceneNode*>::type* subtrees;
+        size_t grainSize;
+        const Camera* camera;
+        vector<SceneNode::ObjectMap>::type* objects;
+        vector<vector<SceneNode*>::type>::type* visibleNodes;
+        vector<size_t>::type* objectEnds;
+
+        void operator()(size_t begin, size_t end) const
+        {
+            size_t batch = begin / grainSize;
+            for (size_t i = begin; i < end; ++i)
+            {
+                (*subtrees)[i]->_collectVisibleObjects(camera, (*objects)[batch], (*visibleNodes)[batch]);
+                (*objectEnds)[i] = (*objects)[batch].size();
+            }
+        }
+    };
+
+    /// A step of the part of the culling traversal done on the calling thread
+    struct SceneGraphCullStep
+    {
+        enum Type
+        {
+            /// Add the objects attached to the node
+            OBJECTS,
+            /// Add what a task gathered below the node
+            SUBTREE,
+            /// Add the debug renderables of the node
+            DEBUG_RENDERABLES
+        };
+        Type type;
+        SceneNode* node;
+    };
+
+    /// Levels of the scene graph walked on the calling thread at most, looking for enough subtrees
+    const size_t SCENE_GRAPH_MAX_SPLIT_DEPTH = 8;
+
+    /// Gets the number of subtrees to aim for, a few per thread so that uneven subtrees even out
+    inline size_t getSceneGraphTaskCount(size_t concurrency)
+    {
+        return (concurrency + 1) * 4;
+    }
+
+    /// Gets the number of subtrees per chunk
+    inline size_t getSceneGraphGrainSize(size_t nodeCount, size_t concurrency)
+    {
+        size_t batchCount = std::min(nodeCount, getSceneGraphTaskCount(concurrency));
+        return (nodeCount + batchCount - 1) / batchCount;
+    }
+}
+//-----------------------------------------------------------------------
 SceneManager::SceneManager(const String& name) :
 mName(name),
 mRenderQueue(0),
@@ -76,6 +151,8 @@ mAmbientLight(ColourValue::Black),
 mCameraInProgress(0),
 mCurrentViewport(0),
 mSceneRoot(0),
+mTransformStore(0),
+mParallelSceneGraph(false),
 mSkyPlaneEntity(0),
 mSkyBoxObj(0),
 mSkyPlaneNode(0),
@@ -133,6 +210,7 @@ mShadowTextureCustomCasterPass(0),
 mShadowTextureCustomReceiverPass(0),
 mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
+mSoftwareVertexBlendBatch(0),
 mSuppressRenderStateChanges(false),
 mSuppressShadows(false),
 mCameraRelativeRendering(false),
@@ -194,6 +272,7 @@ SceneManager::~SceneManager()
     OGRE_DELETE mSkyBoxObj;
 
     OGRE_DELETE mShadowCasterQueryListener;
+    OGRE_DELETE mTransformStore;
     OGRE_DELETE mSceneRoot;
     OGRE_DELETE mFullScreenQuad;
     OGRE_DELETE mShadowCasterSphereQuery;
@@ -1555,8 +1634,21 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
             // Parse the scene and tag visibles
             firePreFindVisibleObjects(vp);
-            _findVisibleObjects(camera, &(camVisObjIt->second),
-                mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+            Mesh::SoftwareVertexBlendBatch blendBatch;
+            mSoftwareVertexBlendBatch = &blendBatch;
+            try
+            {
+                _findVisibleObjects(camera, &(camVisObjIt->second),
+                    mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+            }
+            catch (...)
+            {
+                mSoftwareVertexBlendBatch = 0;
+                throw;
+            }
+            mSoftwareVertexBlendBatch = 0;
+            // Skin everything queued at once
+            blendBatch.execute(Root::getSingleton().getWorkQueue());
             firePostFindVisibleObjects(vp);
 
             mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
@@ -2313,11 +2405,31 @@ void SceneManager::_updateSceneGraph(Camera* cam)
     // Process queued needUpdate calls 
     Node::processQueuedUpdates();
 
-    // Cascade down the graph updating transforms & world bounds
-    // In this implementation, just update from the root
-    // Smarter SceneManager subclasses may choose to update only
-    //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+    if (mTransformStore)
+    {
+        // Update all transforms in one go, then the bounds of changed
+        // branches bottom-up (children always come after their parents)
+        mTransformStore->update();
+
+        const NodeTransformStore::NodeList& nodes = mTransformStore->getNodes();
+        for (size_t i = nodes.size(); i > 0; --i)
+        {
+            if (mTransformStore->isBranchChanged(i - 1))
+                static_cast<SceneNode*>(nodes[i - 1])->_updateBounds();
+        }
+    }
+    else if (mParallelSceneGraph && Root::getSingleton().getWorkQueue()->getTaskConcurrency())
+    {
+        updateSceneGraphParallel();
+    }
+    else
+    {
+        // Cascade down the graph updating transforms & world bounds
+        // In this implementation, just update from the root
+        // Smarter SceneManager subclasses may choose to update only
+        //   certain scene graph branches
+        getRootSceneNode()->_update(true, false);
+    }
 
     firePostUpdateSceneGraph(cam);
 }
@@ -2325,12 +2437,167 @@ void SceneManager::_updateSceneGraph(Camera* cam)
 void SceneManager::_findVisibleObjects(
     Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+    if (mParallelSceneGraph && Root::getSingleton().getWorkQueue()->getTaskConcurrency())
+    {
+        findVisibleObjectsParallel(cam, visibleBounds, onlyShadowCasters);
+        return;
+    }
+
     // Tell nodes to find, cascade down all nodes
     getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
         mDisplayNodes, onlyShadowCasters);
 
 }
 //-----------------------------------------------------------------------
+void SceneManager::updateSceneGraphParallel(void)
+{
+    WorkQueue* queue = Root::getSingleton().getWorkQueue();
+    size_t taskCount = getSceneGraphTaskCount(queue->getTaskConcurrency());
+
+    // Update the top of the graph here, a level at a time, until it is split
+    // into enough subtrees to update in parallel
+    Node::ChildNodeMap subtrees(1, getRootSceneNode());
+    vector<char>::type parentHasChanged(1, false);
+    Node::ChildNodeMap splitNodes;
+    for (size_t depth = 0; !subtrees.empty() && subtrees.size() < taskCount &&
+         depth < SCENE_GRAPH_MAX_SPLIT_DEPTH; ++depth)
+    {
+        Node::ChildNodeMap children;
+        vector<char>::type childParentHasChanged;
+        for (size_t i = 0; i < subtrees.size(); ++i)
+        {
+            Node* node = subtrees[i];
+            node->_update(false, parentHasChanged[i] != 0);
+            splitNodes.push_back(node);
+
+            bool changed = node->_collectChildrenToUpdate(parentHasChanged[i] != 0, children);
+            childParentHasChanged.resize(children.size(), changed);
+        }
+        subtrees.swap(children);
+        parentHasChanged.swap(childParentHasChanged);
+    }
+
+    if (!subtrees.empty())
+    {
+        SceneGraphUpdateTask task = {&subtrees, &parentHasChanged};
+        queue->parallelFor(0, subtrees.size(),
+            getSceneGraphGrainSize(subtrees.size(), queue->getTaskConcurrency()), task);
+    }
+
+    // Children come after their parents, so this goes bottom-up
+    for (size_t i = splitNodes.size(); i > 0; --i)
+        static_cast<SceneNode*>(splitNodes[i - 1])->_updateBounds();
+}
+//-----------------------------------------------------------------------
+void SceneManager::findVisibleObjectsParallel(
+    Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+{
+    RenderQueue* queue = getRenderQueue();
+    WorkQueue* workQueue = Root::getSingleton().getWorkQueue();
+    size_t taskCount = getSceneGraphTaskCount(workQueue->getTaskConcurrency());
+
+    // Bring the lazily computed frustum planes up to date before the
+    // workers read them
+    const Frustum* cullFrustum = cam->getCullingFrustum();
+    (cullFrustum ? cullFrustum : cam)->getFrustumPlanes();
+
+    // Walk down the top of the graph as the serial traversal would, a level
+    // at a time, until it is split into enough subtrees to gather in parallel
+    SceneGraphCullStep rootStep = {SceneGraphCullStep::SUBTREE, getRootSceneNode()};
+    vector<SceneGraphCullStep>::type steps(1, rootStep);
+    size_t subtreeCount = 1;
+    for (size_t depth = 0; subtreeCount > 0 && subtreeCount < taskCount &&
+         depth < SCENE_GRAPH_MAX_SPLIT_DEPTH; ++depth)
+    {
+        vector<SceneGraphCullStep>::type split;
+        subtreeCount = 0;
+        for (size_t i = 0; i < steps.size(); ++i)
+        {
+            SceneNode* node = steps[i].node;
+            if (steps[i].type != SceneGraphCullStep::SUBTREE)
+            {
+                split.push_back(steps[i]);
+            }
+            else if (cam->isVisible(node->_getWorldAABB()))
+            {
+                SceneGraphCullStep objects = {SceneGraphCullStep::OBJECTS, node};
+                split.push_back(objects);
+
+                const Node::ChildNodeMap& children = node->getChildren();
+                for (size_t c = 0; c < children.size(); ++c)
+                {
+                    SceneGraphCullStep subtree =
+                        {SceneGraphCullStep::SUBTREE, static_cast<SceneNode*>(children[c])};
+                    split.push_back(subtree);
+                }
+                subtreeCount += children.size();
+
+                SceneGraphCullStep debug = {SceneGraphCullStep::DEBUG_RENDERABLES, node};
+                split.push_back(debug);
+            }
+        }
+        steps.swap(split);
+    }
+
+    vector<SceneNode*>::type subtrees;
+    subtrees.reserve(subtreeCount);
+    for (size_t i = 0; i < steps.size(); ++i)
+    {
+        if (steps[i].type == SceneGraphCullStep::SUBTREE)
+            subtrees.push_back(steps[i].node);
+    }
+
+    size_t grainSize = 1;
+    vector<SceneNode::ObjectMap>::type objectLists;
+    vector<vector<SceneNode*>::type>::type nodeLists;
+    vector<size_t>::type objectEnds(subtrees.size());
+    if (!subtrees.empty())
+    {
+        grainSize = getSceneGraphGrainSize(subtrees.size(), workQueue->getTaskConcurrency());
+        size_t batchCount = (subtrees.size() + grainSize - 1) / grainSize;
+        objectLists.resize(batchCount);
+        nodeLists.resize(batchCount);
+
+        SceneGraphCullTask task = {&subtrees, grainSize, cam, &objectLists, &nodeLists, &objectEnds};
+        workQueue->parallelFor(0, subtrees.size(), grainSize, task);
+    }
+
+    // Merge everything into the queue in the order the serial traversal adds it
+    size_t subtree = 0, object = 0, node = 0;
+    for (size_t i = 0; i < steps.size(); ++i)
+    {
+        const SceneGraphCullStep& step = steps[i];
+        if (step.type == SceneGraphCullStep::OBJECTS)
+        {
+            SceneNode::ObjectIterator it = step.node->getAttachedObjectIterator();
+            while (it.hasMoreElements())
+                queue->processVisibleObject(it.getNext(), cam, onlyShadowCasters, visibleBounds);
+        }
+        else if (step.type == SceneGraphCullStep::DEBUG_RENDERABLES)
+        {
+            step.node->_addDebugRenderablesToQueue(queue, mDisplayNodes);
+        }
+        else
+        {
+            // The lists of a chunk hold its subtrees one after the other
+            size_t batch = subtree / grainSize;
+            if (subtree % grainSize == 0)
+                object = node = 0;
+
+            const SceneNode::ObjectMap& objects = objectLists[batch];
+            const vector<SceneNode*>::type& nodes = nodeLists[batch];
+            for (; object < objectEnds[subtree]; ++object)
+            {
+                if (objects[object])
+                    queue->processVisibleObject(objects[object], cam, onlyShadowCasters, visibleBounds);
+                else
+                    nodes[node++]->_addDebugRenderablesToQueue(queue, mDisplayNodes);
+            }
+            ++subtree;
+        }
+    }
+}
+//-----------------------------------------------------------------------
 void SceneManager::_renderVisibleObjects(void)
 {
     RenderQueueInvocationSequence* invocationSequence = 
@@ -3740,6 +4007,37 @@ void SceneManager::setDisplaySceneNodes(bool display)
     mDisplayNodes = display;
 }
 //-----------------------------------------------------------------------
+void SceneManager::setTransformStoreEnabled(bool enabled)
+{
+#if OGRE_NODE_INHERIT_TRANSFORM
+    if (enabled)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+            "The transform store is not available with OGRE_NODE_INHERIT_TRANSFORM",
+            "SceneManager::setTransformStoreEnabled");
+    }
+#endif
+    if (enabled == isTransformStoreEnabled())
+        return;
+
+    if (enabled)
+    {
+        mTransformStore = OGRE_NEW NodeTransformStore(getRootSceneNode());
+    }
+    else
+    {
+        OGRE_DELETE mTransformStore;
+        mTransformStore = 0;
+        // nodes are no longer tracked, so bring everything up to date on the next update
+        getRootSceneNode()->needUpdate();
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::setParallelSceneGraphEnabled(bool enabled)
+{
+    mParallelSceneGraph = enabled;
+}
+//-----------------------------------------------------------------------
 Animation* SceneManager::createAnimation(const String& name, Real length)
 {
     OGRE_LOCK_MUTEX(mAnimationsListMutex);
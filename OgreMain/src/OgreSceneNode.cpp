@@ -296,6 +296,33 @@ namespace Ogre {
             }
         }
 
+        _addDebugRenderablesToQueue(queue, displayNodes);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_collectVisibleObjects(const Camera* cam, ObjectMap& objects,
+        vector<SceneNode*>::type& nodes)
+    {
+        // Check self visible
+        if (!cam->isVisible(mWorldAABB))
+            return;
+
+        objects.insert(objects.end(), mObjectsByName.begin(), mObjectsByName.end());
+
+        ChildNodeMap::iterator child, childend;
+        childend = mChildren.end();
+        for (child = mChildren.begin(); child != childend; ++child)
+        {
+            SceneNode* sceneChild = static_cast<SceneNode*>(*child);
+            sceneChild->_collectVisibleObjects(cam, objects, nodes);
+        }
+
+        // Marks where _findVisibleObjects adds the debug renderables of this node
+        objects.push_back(0);
+        nodes.push_back(this);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_addDebugRenderablesToQueue(RenderQueue* queue, bool displayNodes)
+    {
         if (displayNodes)
         {
             // Include self in the render queue
@@ -309,8 +336,6 @@ namespace Ogre {
         { 
             _addBoundingBoxToQueue(queue);
         }
-
-
     }
 
     Node::DebugRenderable* SceneNode::getDebugRenderable()
@@ -344,6 +369,15 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void SceneNode::updateFromTransformStoreImpl(void) const
+    {
+        // Notify objects that it has been moved
+        for (ObjectMap::const_iterator i = mObjectsByName.begin(); i != mObjectsByName.end(); ++i)
+        {
+            (*i)->_notifyMoved();
+        }
+    }
+    //-----------------------------------------------------------------------
     Node* SceneNode::createChildImpl(void)
     {
         assert(mCreator);
@@ -1565,6 +1565,95 @@ namespace Ogre
     }
     
 
+    // ConcreteNodeListSerializer
+    /// stream header id written by Serializer::writeFileHeader
+    const uint16 CACHE_HEADER_ID = 0x1000;
+
+    ConcreteNodeListSerializer::ConcreteNodeListSerializer()
+    {
+        // Version number
+        // NB bump this whenever the parser output changes
+        mVersion = "[ConcreteNodeListSerializer_v1.0]";
+    }
+
+    void ConcreteNodeListSerializer::exportConcreteNodeList(const ConcreteNodeListPtr& nodes, const String& str, const DataStreamPtr& stream)
+    {
+        mStream = stream;
+        determineEndianness(ENDIAN_NATIVE);
+
+        writeFileHeader();
+
+        // The source is identified by its hash and length
+        uint32 source[2] = {FastHash(str.data(), str.size()), static_cast<uint32>(str.size())};
+        writeInts(source, 2);
+
+        writeNodes(*nodes);
+
+        mStream.reset();
+    }
+
+    ConcreteNodeListPtr ConcreteNodeListSerializer::importConcreteNodeList(DataStreamPtr& stream, const String& str, const String& source)
+    {
+        // Caches are always native endian, anything else is treated as stale
+        mFlipEndian = false;
+
+        uint16 headerID = 0;
+        readShorts(stream, &headerID, 1);
+        if(headerID != CACHE_HEADER_ID || readString(stream) != mVersion)
+            return ConcreteNodeListPtr();
+
+        uint32 hash[2] = {0, 0};
+        readInts(stream, hash, 2);
+        if(hash[0] != FastHash(str.data(), str.size()) || hash[1] != str.size())
+            return ConcreteNodeListPtr();
+
+        ConcreteNodeListPtr nodes(OGRE_NEW_T(ConcreteNodeList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        if(!readNodes(stream, *nodes, 0, source))
+            return ConcreteNodeListPtr();
+        return nodes;
+    }
+
+    void ConcreteNodeListSerializer::writeNodes(const ConcreteNodeList& nodes)
+    {
+        uint32 count = static_cast<uint32>(nodes.size());
+        writeInts(&count, 1);
+        for(ConcreteNodeList::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+        {
+            const ConcreteNode* node = (*i).get();
+            // Tokens may contain line breaks, so they are length prefixed
+            uint32 header[3] = {static_cast<uint32>(node->token.size()), node->line, static_cast<uint32>(node->type)};
+            writeInts(header, 3);
+            writeData(node->token.data(), 1, node->token.size());
+            writeNodes(node->children);
+        }
+    }
+
+    bool ConcreteNodeListSerializer::readNodes(DataStreamPtr& stream, ConcreteNodeList& nodes, ConcreteNode* parent, const String& source)
+    {
+        uint32 count = 0;
+        readInts(stream, &count, 1);
+        for(uint32 i = 0; i < count; ++i)
+        {
+            uint32 header[3] = {0, 0, 0};
+            readInts(stream, header, 3);
+            if(stream->eof() || header[2] > CNT_COLON || header[0] > stream->size() - stream->tell())
+                return false;
+
+            ConcreteNodePtr node(OGRE_NEW ConcreteNode());
+            node->token.resize(header[0]);
+            if(header[0])
+                stream->read(&node->token[0], header[0]);
+            node->file = source;
+            node->line = header[1];
+            node->type = static_cast<ConcreteNodeType>(header[2]);
+            node->parent = parent;
+            if(!readNodes(stream, node->children, node.get(), source))
+                return false;
+            nodes.push_back(node);
+        }
+        return true;
+    }
+
     // ScriptCompilerManager
     template<> ScriptCompilerManager *Singleton<ScriptCompilerManager>::msSingleton = 0;
     
@@ -1579,7 +1668,7 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------
     ScriptCompilerManager::ScriptCompilerManager()
-        :mListener(0), OGRE_THREAD_POINTER_INIT(mScriptCompiler)
+        :mListener(0), OGRE_THREAD_POINTER_INIT(mScriptCompiler), mScriptCacheEnabled(false)
     {
             OGRE_LOCK_AUTO_MUTEX;
         mScriptPatterns.push_back("*.program");
@@ -1659,6 +1748,16 @@ namespace Ogre
 		return OGRE_THREAD_POINTER_GET(mScriptCompiler)->registerCustomWordId(word);
     }
     //-----------------------------------------------------------------------
+    void ScriptCompilerManager::setScriptCacheEnabled(bool enabled)
+    {
+        mScriptCacheEnabled = enabled;
+    }
+    //-----------------------------------------------------------------------
+    bool ScriptCompilerManager::getScriptCacheEnabled() const
+    {
+        return mScriptCacheEnabled;
+    }
+    //-----------------------------------------------------------------------
     void ScriptCompilerManager::addScriptPattern(const String &pattern)
     {
         mScriptPatterns.push_back(pattern);
@@ -1676,6 +1775,29 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------
     void ScriptCompilerManager::parseScript(DataStreamPtr& stream, const String& groupName)
+    {
+        _parsePreparedScript(stream, groupName, Any());
+    }
+    //-----------------------------------------------------------------------
+    Any ScriptCompilerManager::_prepareScript(const DataStreamPtr& stream, const String& groupName)
+    {
+        if(mScriptCacheEnabled)
+            return Any();
+
+        ConcreteNodeListPtr nodes;
+        try
+        {
+            nodes = ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), stream->getName()));
+        }
+        catch(Exception&)
+        {
+            // Left to _parsePreparedScript, so errors are reported in script order
+        }
+        stream->seek(0);
+        return nodes ? Any(nodes) : Any();
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::_parsePreparedScript(DataStreamPtr& stream, const String& groupName, const Any& prepared)
     {
 #if OGRE_THREAD_SUPPORT
         // check we have an instance for this thread (should always have one for main thread)
@@ -1691,7 +1813,53 @@ namespace Ogre
                     OGRE_LOCK_AUTO_MUTEX;
             OGRE_THREAD_POINTER_GET(mScriptCompiler)->setListener(mListener);
         }
-        OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(stream->getAsString(), stream->getName(), groupName);
+        if(prepared.has_value())
+        {
+            OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(any_cast<ConcreteNodeListPtr>(prepared), groupName);
+            return;
+        }
+
+        if(!mScriptCacheEnabled)
+        {
+            OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(stream->getAsString(), stream->getName(), groupName);
+            return;
+        }
+
+        ConcreteNodeListPtr nodes = parseCached(stream->getAsString(), stream->getName(), groupName);
+        OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(nodes, groupName);
+    }
+    //-----------------------------------------------------------------------
+    ConcreteNodeListPtr ScriptCompilerManager::parseCached(const String& str, const String& source, const String& group)
+    {
+        ConcreteNodeListSerializer serializer;
+        const String cacheName = source + ".cache";
+
+        // The cache lives next to the script, scripts from elsewhere are just parsed
+        Archive* arch = ResourceGroupManager::getSingleton()._getArchiveToResource(source, group);
+        if(arch && arch->exists(cacheName))
+        {
+            DataStreamPtr file = arch->open(cacheName);
+            DataStreamPtr cache(OGRE_NEW MemoryDataStream(cacheName, file));
+            ConcreteNodeListPtr nodes = serializer.importConcreteNodeList(cache, str, source);
+            if(nodes)
+                return nodes;
+        }
+
+        ConcreteNodeListPtr nodes = ScriptParser::parse(ScriptLexer::tokenize(str, source));
+
+        if(arch && !arch->isReadOnly())
+        {
+            try
+            {
+                serializer.exportConcreteNodeList(nodes, str, arch->create(cacheName));
+            }
+            catch(Exception& e)
+            {
+                LogManager::getSingleton().logMessage("Could not write script cache " + cacheName +
+                    ": " + e.getDescription(), LML_CRITICAL);
+            }
+        }
+        return nodes;
     }
 
     //-------------------------------------------------------------------------
@@ -276,10 +276,14 @@ namespace Ogre {
 #if OGRE_SERIALIZER_VALIDATE_CHUNKSIZE
         size_t pos = stream->tell();
 #endif
+        // id and length in a single read, chunks are small and numerous
+        unsigned char header[sizeof(uint16) + sizeof(uint32)];
+        stream->read(header, sizeof(header));
         unsigned short id;
-        readShorts(stream, &id, 1);
-        
-        readInts(stream, &mCurrentstreamLen, 1);
+        memcpy(&id, header, sizeof(uint16));
+        memcpy(&mCurrentstreamLen, header + sizeof(uint16), sizeof(uint32));
+        flipFromLittleEndian(&id, sizeof(uint16), 1);
+        flipFromLittleEndian(&mCurrentstreamLen, sizeof(uint32), 1);
 #if OGRE_SERIALIZER_VALIDATE_CHUNKSIZE
         if (!mChunkSizeStack.empty() && !stream->eof()){
             if (pos != static_cast<size_t>(mChunkSizeStack.back()) && mReportChunkErrors){
@@ -32,9 +32,54 @@ THE SOFTWARE.
 #include "OgreLodStrategy.h"
 #include "OgreIteratorWrappers.h"
 #include "OgreSubEntity.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
+    namespace {
+        /// Formulates an identifying string for the format of some geometry
+        String geometryFormatString(const StaticGeometry::SubMeshLodGeometryLink* geom)
+        {
+            // Must take into account the vertex declaration and the index type
+            // Format is (all lines separated by '|'):
+            // Index type
+            // Vertex element (repeating)
+            //   source
+            //   semantic
+            //   type
+            StringStream str;
+
+            str << geom->indexData->indexBuffer->getType() << "|";
+            const VertexDeclaration::VertexElementList& elemList =
+                geom->vertexData->vertexDeclaration->getElements();
+            VertexDeclaration::VertexElementList::const_iterator ei, eiend;
+            eiend = elemList.end();
+            for (ei = elemList.begin(); ei != eiend; ++ei)
+            {
+                const VertexElement& elem = *ei;
+                str << elem.getSource() << "|";
+                str << elem.getSource() << "|";
+                str << elem.getSemantic() << "|";
+                str << elem.getType() << "|";
+            }
+
+            return str.str();
+        }
+
+        /// Fills a range of geometry buckets, for WorkQueue::parallelFor
+        struct GeometryBucketFillTask
+        {
+            StaticGeometry::GeometryBucket* const* buckets;
+            const StaticGeometry::SourceBufferLockMap* sourceLocks;
+
+            void operator()(size_t begin, size_t end) const
+            {
+                for (size_t i = begin; i < end; ++i)
+                    buckets[i]->_copyGeometry(*sourceLocks);
+            }
+        };
+    }
+
     #define REGION_RANGE 1024
     #define REGION_HALF_RANGE 512
     #define REGION_MAX_INDEX 511
@@ -54,7 +99,8 @@ namespace Ogre {
         mVisible(true),
         mRenderQueueID(RENDER_QUEUE_MAIN),
         mRenderQueueIDSet(false),
-        mVisibilityFlags(Ogre::MovableObject::getDefaultVisibilityFlags())
+        mVisibilityFlags(Ogre::MovableObject::getDefaultVisibilityFlags()),
+        mDeferredBuckets(0)
     {
     }
     //--------------------------------------------------------------------------
@@ -371,6 +417,8 @@ namespace Ogre {
             assert (geomLink.vertexData->vertexStart == 0 &&
                 "Cannot use vertexStart > 0 on indexed geometry due to "
                 "rendersystem incompatibilities - see the docs!");
+            // Worked out once here rather than for every queued copy
+            geomLink.formatString = geometryFormatString(&geomLink);
         }
 
 
@@ -554,16 +602,68 @@ namespace Ogre {
             stencilShadows = true;
         }
 
+        // Without stencil shadows the geometry is not needed during the build,
+        // so the buckets only create their buffers and are all filled at the end
+        MaterialBucket::GeometryBucketList deferredBuckets;
+        if (!stencilShadows)
+        {
+            mDeferredBuckets = &deferredBuckets;
+        }
+
         // Now tell each region to build itself
-        for (RegionMap::iterator ri = mRegionMap.begin();
-            ri != mRegionMap.end(); ++ri)
+        try
+        {
+            for (RegionMap::iterator ri = mRegionMap.begin();
+                ri != mRegionMap.end(); ++ri)
+            {
+                ri->second->build(stencilShadows);
+
+                // Set the visibility flags on these regions
+                ri->second->setVisibilityFlags(mVisibilityFlags);
+            }
+        }
+        catch (...)
         {
-            ri->second->build(stencilShadows);
-            
-            // Set the visibility flags on these regions
-            ri->second->setVisibilityFlags(mVisibilityFlags);
+            mDeferredBuckets = 0;
+            for (size_t i = 0; i < deferredBuckets.size(); ++i)
+            {
+                deferredBuckets[i]->_unlockBuffers(false);
+            }
+            throw;
         }
+        mDeferredBuckets = 0;
 
+        if (!deferredBuckets.empty())
+        {
+            // Lock each source buffer once, however many copies are made of it
+            SourceBufferLockMap sourceLocks;
+            for (size_t i = 0; i < deferredBuckets.size(); ++i)
+            {
+                deferredBuckets[i]->_lockSourceBuffers(sourceLocks);
+            }
+
+            // Each bucket writes to its own buffers only
+            GeometryBucketFillTask task = {&deferredBuckets[0], &sourceLocks};
+            WorkQueue* queue = Root::getSingleton().getWorkQueue();
+            if (queue)
+            {
+                queue->parallelFor(0, deferredBuckets.size(), 1, task);
+            }
+            else
+            {
+                task(0, deferredBuckets.size());
+            }
+
+            for (SourceBufferLockMap::iterator li = sourceLocks.begin();
+                li != sourceLocks.end(); ++li)
+            {
+                li->first->unlock();
+            }
+            for (size_t i = 0; i < deferredBuckets.size(); ++i)
+            {
+                deferredBuckets[i]->_unlockBuffers(false);
+            }
+        }
     }
     //--------------------------------------------------------------------------
     void StaticGeometry::destroy(void)
@@ -1274,7 +1374,7 @@ namespace Ogre {
     void StaticGeometry::MaterialBucket::assign(QueuedGeometry* qgeom)
     {
         // Look up any current geometry
-        String formatString = getGeometryFormatString(qgeom->geometry);
+        const String& formatString = qgeom->geometry->formatString;
         CurrentGeometryMap::iterator gi = mCurrentGeometryMap.find(formatString);
         bool newBucket = true;
         if (gi != mCurrentGeometryMap.end())
@@ -1314,11 +1414,21 @@ namespace Ogre {
                 "StaticGeometry::MaterialBucket::build");
         }
         mMaterial->load();
-        // tell the geometry buckets to build
+        // tell the geometry buckets to build, or just to get their buffers
+        // ready if StaticGeometry::build fills them later
+        GeometryBucketList* deferredBuckets = mParent->getParent()->getParent()->mDeferredBuckets;
         for (GeometryBucketList::iterator i = mGeometryBucketList.begin();
             i != mGeometryBucketList.end(); ++i)
         {
-            (*i)->build(stencilShadows);
+            if (deferredBuckets)
+            {
+                (*i)->_lockBuffers(stencilShadows);
+                deferredBuckets->push_back(*i);
+            }
+            else
+            {
+                (*i)->build(stencilShadows);
+            }
         }
     }
     //--------------------------------------------------------------------------
@@ -1350,32 +1460,7 @@ namespace Ogre {
     String StaticGeometry::MaterialBucket::getGeometryFormatString(
         SubMeshLodGeometryLink* geom)
     {
-        // Formulate an identifying string for the geometry format
-        // Must take into account the vertex declaration and the index type
-        // Format is (all lines separated by '|'):
-        // Index type
-        // Vertex element (repeating)
-        //   source
-        //   semantic
-        //   type
-        StringStream str;
-
-        str << geom->indexData->indexBuffer->getType() << "|";
-        const VertexDeclaration::VertexElementList& elemList =
-            geom->vertexData->vertexDeclaration->getElements();
-        VertexDeclaration::VertexElementList::const_iterator ei, eiend;
-        eiend = elemList.end();
-        for (ei = elemList.begin(); ei != eiend; ++ei)
-        {
-            const VertexElement& elem = *ei;
-            str << elem.getSource() << "|";
-            str << elem.getSource() << "|";
-            str << elem.getSemantic() << "|";
-            str << elem.getType() << "|";
-        }
-
-        return str.str();
-
+        return geometryFormatString(geom);
     }
     //--------------------------------------------------------------------------
     StaticGeometry::MaterialBucket::GeometryIterator
@@ -1414,7 +1499,7 @@ namespace Ogre {
     StaticGeometry::GeometryBucket::GeometryBucket(MaterialBucket* parent,
         const String& formatString, const VertexData* vData,
         const IndexData* iData)
-        : Renderable(), mParent(parent), mFormatString(formatString)
+        : Renderable(), mParent(parent), mFormatString(formatString), mIndexLock(0)
     {
         // Clone the structure from the example
         mVertexData = vData->clone(false);
@@ -1534,6 +1619,22 @@ namespace Ogre {
     {
         // Ok, here's where we transfer the vertices and indexes to the shared
         // buffers
+        _lockBuffers(stencilShadows);
+
+        SourceBufferLockMap sourceLocks;
+        _lockSourceBuffers(sourceLocks);
+        _copyGeometry(sourceLocks);
+        for (SourceBufferLockMap::iterator li = sourceLocks.begin();
+            li != sourceLocks.end(); ++li)
+        {
+            li->first->unlock();
+        }
+
+        _unlockBuffers(stencilShadows);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::_lockBuffers(bool stencilShadows)
+    {
         // Shortcuts
         VertexDeclaration* dcl = mVertexData->vertexDeclaration;
         VertexBufferBinding* binds = mVertexData->vertexBufferBinding;
@@ -1542,25 +1643,12 @@ namespace Ogre {
         mIndexData->indexBuffer = HardwareBufferManager::getSingleton()
             .createIndexBuffer(mIndexType, mIndexData->indexCount,
                 HardwareBuffer::HBU_STATIC_WRITE_ONLY);
-        uint32* p32Dest = 0;
-        uint16* p16Dest = 0;
-        if (mIndexType == HardwareIndexBuffer::IT_32BIT)
-        {
-            p32Dest = static_cast<uint32*>(
-                mIndexData->indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
-        }
-        else
-        {
-            p16Dest = static_cast<uint16*>(
-                mIndexData->indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
-        }
+        mIndexLock = mIndexData->indexBuffer->lock(HardwareBuffer::HBL_DISCARD);
+
         // create all vertex buffers, and lock
-        ushort b;
         ushort posBufferIdx = dcl->findElementBySemantic(VES_POSITION)->getSource();
-
-        vector<uchar*>::type destBufferLocks;
-        vector<VertexDeclaration::VertexElementList>::type bufferElements;
-        for (b = 0; b < binds->getBufferCount(); ++b)
+        mVertexLocks.clear();
+        for (ushort b = 0; b < binds->getBufferCount(); ++b)
         {
             size_t vertexCount = mVertexData->vertexCount;
             // Need to double the vertex count for the position buffer
@@ -1578,13 +1666,63 @@ namespace Ogre {
                     vertexCount,
                     HardwareBuffer::HBU_STATIC_WRITE_ONLY);
             binds->setBinding(b, vbuf);
-            uchar* pLock = static_cast<uchar*>(
-                vbuf->lock(HardwareBuffer::HBL_DISCARD));
-            destBufferLocks.push_back(pLock);
-            // Pre-cache vertex elements per buffer
-            bufferElements.push_back(dcl->findElementsBySource(b));
+            mVertexLocks.push_back(static_cast<uchar*>(
+                vbuf->lock(HardwareBuffer::HBL_DISCARD)));
         }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::_lockSourceBuffers(SourceBufferLockMap& sourceLocks)
+    {
+        QueuedGeometryList::iterator gi, giend;
+        giend = mQueuedGeometry.end();
+        for (gi = mQueuedGeometry.begin(); gi != giend; ++gi)
+        {
+            SubMeshLodGeometryLink* geom = (*gi)->geometry;
+            HardwareBuffer* buf = geom->indexData->indexBuffer.get();
+            if (sourceLocks.find(buf) == sourceLocks.end())
+            {
+                sourceLocks[buf] = static_cast<uchar*>(
+                    buf->lock(HardwareBuffer::HBL_READ_ONLY));
+            }
+            const VertexBufferBinding::VertexBufferBindingMap& srcBinds =
+                geom->vertexData->vertexBufferBinding->getBindings();
+            VertexBufferBinding::VertexBufferBindingMap::const_iterator bi;
+            for (bi = srcBinds.begin(); bi != srcBinds.end(); ++bi)
+            {
+                buf = bi->second.get();
+                if (sourceLocks.find(buf) == sourceLocks.end())
+                {
+                    sourceLocks[buf] = static_cast<uchar*>(
+                        buf->lock(HardwareBuffer::HBL_READ_ONLY));
+                }
+            }
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::_copyGeometry(const SourceBufferLockMap& sourceLocks)
+    {
+        // Shortcuts
+        VertexDeclaration* dcl = mVertexData->vertexDeclaration;
+        VertexBufferBinding* binds = mVertexData->vertexBufferBinding;
 
+        uint32* p32Dest = 0;
+        uint16* p16Dest = 0;
+        if (mIndexType == HardwareIndexBuffer::IT_32BIT)
+        {
+            p32Dest = static_cast<uint32*>(mIndexLock);
+        }
+        else
+        {
+            p16Dest = static_cast<uint16*>(mIndexLock);
+        }
+        ushort b;
+        vector<uchar*>::type destBufferLocks = mVertexLocks;
+        // Pre-cache vertex elements per buffer
+        vector<VertexDeclaration::VertexElementList>::type bufferElements;
+        for (b = 0; b < binds->getBufferCount(); ++b)
+        {
+            bufferElements.push_back(dcl->findElementsBySource(b));
+        }
 
         // Iterate over the geometry items
         size_t indexOffset = 0;
@@ -1596,31 +1734,20 @@ namespace Ogre {
             QueuedGeometry* geom = *gi;
             // Copy indexes across with offset
             IndexData* srcIdxData = geom->geometry->indexData;
+            const uchar* pSrcIdx =
+                sourceLocks.find(srcIdxData->indexBuffer.get())->second +
+                srcIdxData->indexStart * srcIdxData->indexBuffer->getIndexSize();
             if (mIndexType == HardwareIndexBuffer::IT_32BIT)
             {
-                // Lock source indexes
-                uint32* pSrc = static_cast<uint32*>(
-                    srcIdxData->indexBuffer->lock(
-                        srcIdxData->indexStart * srcIdxData->indexBuffer->getIndexSize(), 
-                        srcIdxData->indexCount * srcIdxData->indexBuffer->getIndexSize(),
-                        HardwareBuffer::HBL_READ_ONLY));
-
-                copyIndexes(pSrc, p32Dest, srcIdxData->indexCount, indexOffset);
+                copyIndexes(reinterpret_cast<const uint32*>(pSrcIdx), p32Dest,
+                    srcIdxData->indexCount, indexOffset);
                 p32Dest += srcIdxData->indexCount;
-                srcIdxData->indexBuffer->unlock();
             }
             else
             {
-                // Lock source indexes
-                uint16* pSrc = static_cast<uint16*>(
-                    srcIdxData->indexBuffer->lock(
-                    srcIdxData->indexStart * srcIdxData->indexBuffer->getIndexSize(), 
-                    srcIdxData->indexCount * srcIdxData->indexBuffer->getIndexSize(),
-                    HardwareBuffer::HBL_READ_ONLY));
-
-                copyIndexes(pSrc, p16Dest, srcIdxData->indexCount, indexOffset);
+                copyIndexes(reinterpret_cast<const uint16*>(pSrcIdx), p16Dest,
+                    srcIdxData->indexCount, indexOffset);
                 p16Dest += srcIdxData->indexCount;
-                srcIdxData->indexBuffer->unlock();
             }
 
             // Now deal with vertex buffers
@@ -1629,11 +1756,10 @@ namespace Ogre {
             VertexBufferBinding* srcBinds = srcVData->vertexBufferBinding;
             for (b = 0; b < binds->getBufferCount(); ++b)
             {
-                // lock source
+                // source was locked up front
                 HardwareVertexBufferSharedPtr srcBuf =
                     srcBinds->getBuffer(b);
-                uchar* pSrcBase = static_cast<uchar*>(
-                    srcBuf->lock(HardwareBuffer::HBL_READ_ONLY));
+                uchar* pSrcBase = sourceLocks.find(srcBuf.get())->second;
                 // Get buffer lock pointer, we'll update this later
                 uchar* pDstBase = destBufferLocks[b];
                 size_t bufInc = srcBuf->getVertexSize();
@@ -1702,23 +1828,30 @@ namespace Ogre {
 
                 // Update pointer
                 destBufferLocks[b] = pDstBase;
-                srcBuf->unlock();
             }
 
             indexOffset += geom->geometry->vertexData->vertexCount;
         }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::_unlockBuffers(bool stencilShadows)
+    {
+        VertexBufferBinding* binds = mVertexData->vertexBufferBinding;
 
         // Unlock everything
         mIndexData->indexBuffer->unlock();
-        for (b = 0; b < binds->getBufferCount(); ++b)
+        mIndexLock = 0;
+        for (ushort b = 0; b < binds->getBufferCount(); ++b)
         {
             binds->getBuffer(b)->unlock();
         }
+        mVertexLocks.clear();
 
         // If we're dealing with stencil shadows, copy the position data from
         // the early half of the buffer to the latter part
         if (stencilShadows)
         {
+            ushort posBufferIdx = mVertexData->vertexDeclaration->findElementBySemantic(VES_POSITION)->getSource();
             HardwareVertexBufferSharedPtr buf = binds->getBuffer(posBufferIdx);
             void* pSrc = buf->lock(HardwareBuffer::HBL_NORMAL);
             // Point dest at second half (remember vertexcount is original count)
@@ -43,6 +43,104 @@ namespace Ogre {
         return i->second;
     }
     //---------------------------------------------------------------------
+    namespace
+    {
+        /// State shared by the caller and the helper tasks of one parallelFor
+        struct ParallelForState : public UtilityAlloc
+        {
+            WorkQueue::RangeTask body;
+            size_t begin;
+            size_t end;
+            size_t grainSize;
+            size_t chunkCount;
+            AtomicScalar<size_t> nextChunk;
+            AtomicScalar<size_t> doneChunks;
+            AtomicScalar<bool> failed;
+            std::exception_ptr error;
+            OGRE_WQ_MUTEX(mutex);
+            OGRE_WQ_THREAD_SYNCHRONISER(sync);
+
+            ParallelForState(size_t b, size_t e, size_t grain, const WorkQueue::RangeTask& f)
+                : body(f), begin(b), end(e), grainSize(grain)
+                , chunkCount((e - b + grain - 1) / grain), nextChunk(0), doneChunks(0), failed(false)
+            {
+            }
+
+            /// Processes chunks until none are left to start
+            void run(void)
+            {
+                for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+                {
+                    if (!failed)
+                    {
+                        size_t chunkBegin = begin + chunk * grainSize;
+                        try
+                        {
+                            body(chunkBegin, std::min(chunkBegin + grainSize, end));
+                        }
+                        catch (...)
+                        {
+                                    OGRE_WQ_LOCK_MUTEX(mutex);
+                            if (!failed)
+                                error = std::current_exception();
+                            failed = true;
+                        }
+                    }
+
+                    if (++doneChunks == chunkCount)
+                    {
+                                OGRE_WQ_LOCK_MUTEX(mutex);
+                        OGRE_THREAD_NOTIFY_ALL(sync);
+                    }
+                }
+            }
+        };
+        typedef SharedPtr<ParallelForState> ParallelForStatePtr;
+
+        /// Helper task of parallelFor
+        struct ParallelForTask
+        {
+            ParallelForStatePtr state;
+            explicit ParallelForTask(const ParallelForStatePtr& s) : state(s) {}
+            void operator()() const { state->run(); }
+        };
+    }
+    //---------------------------------------------------------------------
+    void WorkQueue::parallelFor(size_t begin, size_t end, size_t grainSize, const RangeTask& body,
+                                TaskPriority priority)
+    {
+        if (begin >= end)
+            return;
+
+        size_t count = end - begin;
+        size_t concurrency = getTaskConcurrency();
+        if (grainSize == 0)
+            grainSize = std::max<size_t>(1, count / ((concurrency + 1) * 4));
+
+        if (concurrency == 0 || grainSize >= count)
+        {
+            body(begin, end);
+            return;
+        }
+
+        ParallelForStatePtr state(OGRE_NEW ParallelForState(begin, end, grainSize, body));
+        size_t helpers = std::min(concurrency, state->chunkCount - 1);
+        for (size_t i = 0; i < helpers; ++i)
+            addTask(ParallelForTask(state), priority);
+
+        state->run();
+
+        // whatever is left is being processed by helpers already
+        {
+                    OGRE_WQ_LOCK_MUTEX_NAMED(state->mutex, lock);
+            while (state->doneChunks < state->chunkCount)
+                OGRE_THREAD_WAIT(state->sync, state->mutex, lock);
+        }
+
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+    //---------------------------------------------------------------------
     WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid)
         : mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false)
     {
@@ -121,12 +121,68 @@ namespace Ogre
         mWorkers.clear();
 #endif
 
+        for (int p = 0; p < TASK_PRIORITY_COUNT; ++p)
+            mTasks[p].clear();
+
         OGRE_DELETE_T(mWorkerFunc, WorkerFunc, MEMCATEGORY_GENERAL);
         mWorkerFunc = 0;
 
         mIsRunning = false;
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueue::addTask(const Task& task, TaskPriority priority)
+    {
+#if OGRE_THREAD_SUPPORT
+        if (mIsRunning && !mShuttingDown && !mWorkers.empty())
+        {
+                    OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            mTasks[priority].push_back(task);
+            notifyWorkers();
+            return;
+        }
+#endif
+        task();
+    }
+    //---------------------------------------------------------------------
+    size_t DefaultWorkQueue::getTaskConcurrency(void) const
+    {
+#if OGRE_THREAD_SUPPORT
+        return mIsRunning ? mWorkers.size() : 0;
+#else
+        return 0;
+#endif
+    }
+    //---------------------------------------------------------------------
+    bool DefaultWorkQueue::processNextTask(void)
+    {
+        Task task;
+        {
+                    OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            for (int p = 0; p < TASK_PRIORITY_COUNT && !task; ++p)
+            {
+                if (!mTasks[p].empty())
+                {
+                    task.swap(mTasks[p].front());
+                    mTasks[p].pop_front();
+                }
+            }
+        }
+
+        if (!task)
+            return false;
+
+        try
+        {
+            task();
+        }
+        catch (std::exception& e)
+        {
+            LogManager::getSingleton().stream(LML_CRITICAL) <<
+                "DefaultWorkQueue('" << mName << "') task failed: " << e.what();
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueue::notifyWorkers()
     {
         // wake up waiting thread
@@ -139,7 +195,8 @@ namespace Ogre
 #if OGRE_THREAD_SUPPORT
         // Lock; note that OGRE_THREAD_WAIT will free the lock
             OGRE_WQ_LOCK_MUTEX_NAMED(mRequestMutex, queueLock);
-        if (mRequestQueue.empty())
+        if (mRequestQueue.empty() && mTasks[TASK_PRIORITY_HIGH].empty() &&
+            mTasks[TASK_PRIORITY_NORMAL].empty() && mTasks[TASK_PRIORITY_LOW].empty())
         {
             // frees lock and suspends the thread
             OGRE_THREAD_WAIT(mRequestCondition, mRequestMutex, queueLock);
@@ -171,7 +228,8 @@ namespace Ogre
         while (!isShuttingDown())
         {
             waitForNextRequest();
-            _processNextRequest();
+            if (!processNextTask())
+                _processNextRequest();
         }
 
         LogManager::getSingleton().stream() << 
@@ -0,0 +1,316 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+namespace Ogre
+{
+    namespace
+    {
+        /// The queue and index of the worker running on this thread, if any
+        thread_local const StealingWorkQueue* tlsWorkerQueue = 0;
+        thread_local size_t tlsWorkerIndex = 0;
+
+        void runTask(const WorkQueue::Task& task, const String& queueName)
+        {
+            try
+            {
+                task();
+            }
+            catch (std::exception& e)
+            {
+                LogManager::getSingleton().stream(LML_CRITICAL) <<
+                    "StealingWorkQueue('" << queueName << "') task failed: " << e.what();
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    StealingWorkQueue::StealingWorkQueue(const String& name)
+    : DefaultWorkQueueBase(name), mNextDeque(0), mNextWorker(0), mWakeCount(0)
+    , mSleepingWorkers(0), mNumThreadsRegisteredWithRS(0)
+    {
+        for (int p = 0; p < TASK_PRIORITY_COUNT; ++p)
+            mPendingTasks[p] = 0;
+    }
+    //---------------------------------------------------------------------
+    StealingWorkQueue::~StealingWorkQueue()
+    {
+        shutdown();
+    }
+    //---------------------------------------------------------------------
+    void StealingWorkQueue::startup(bool forceRestart)
+    {
+        if (mIsRunning)
+        {
+            if (forceRestart)
+                shutdown();
+            else
+                return;
+        }
+
+        mShuttingDown = false;
+
+        mWorkerFunc = OGRE_NEW_T(WorkerFunc(this), MEMCATEGORY_GENERAL);
+
+        LogManager::getSingleton().stream() <<
+            "StealingWorkQueue('" << mName << "') initialising on thread " <<
+            OGRE_THREAD_CURRENT_ID
+            << " (work stealing).";
+
+        // the deques must exist before the first worker looks for tasks
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+            mTaskDeques.push_back(OGRE_NEW TaskDeque());
+        mNextWorker = 0;
+
+#if OGRE_THREAD_SUPPORT
+        if (mWorkerRenderSystemAccess)
+            Root::getSingleton().getRenderSystem()->preExtraThreadsStarted();
+
+        mNumThreadsRegisteredWithRS = 0;
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+        {
+            OGRE_THREAD_CREATE(t, *mWorkerFunc);
+            mWorkers.push_back(t);
+        }
+
+        if (mWorkerRenderSystemAccess)
+        {
+                    OGRE_WQ_LOCK_MUTEX_NAMED(mInitMutex, initLock);
+            // have to wait until all threads are registered with the render system
+            while (mNumThreadsRegisteredWithRS < mWorkerThreadCount)
+                OGRE_THREAD_WAIT(mInitSync, mInitMutex, initLock);
+
+            Root::getSingleton().getRenderSystem()->postExtraThreadsStarted();
+
+        }
+#endif
+
+        mIsRunning = true;
+    }
+    //---------------------------------------------------------------------
+    void StealingWorkQueue::notifyThreadRegistered()
+    {
+            OGRE_WQ_LOCK_MUTEX(mInitMutex);
+
+        ++mNumThreadsRegisteredWithRS;
+
+        // wake up main thread
+        OGRE_THREAD_NOTIFY_ALL(mInitSync);
+
+    }
+    //---------------------------------------------------------------------
+    void StealingWorkQueue::shutdown()
+    {
+        if( !mIsRunning )
+            return;
+
+        LogManager::getSingleton().stream() <<
+            "StealingWorkQueue('" << mName << "') shutting down on thread " <<
+            OGRE_THREAD_CURRENT_ID
+            << ".";
+
+        mShuttingDown = true;
+        abortAllRequests();
+#if OGRE_THREAD_SUPPORT
+        // wake all threads (they should check shutting down as first thing after wait)
+        wakeWorkers(true);
+
+        // all our threads should have been woken now, so join
+        for (WorkerThreadList::iterator i = mWorkers.begin(); i != mWorkers.end(); ++i)
+        {
+            (*i)->join();
+            OGRE_THREAD_DESTROY(*i);
+        }
+        mWorkers.clear();
+#endif
+
+        // tasks nobody picked up are dropped
+        for (TaskDequeList::iterator i = mTaskDeques.begin(); i != mTaskDeques.end(); ++i)
+        {
+            OGRE_DELETE *i;
+        }
+        mTaskDeques.clear();
+        for (int p = 0; p < TASK_PRIORITY_COUNT; ++p)
+            mPendingTasks[p] = 0;
+
+        OGRE_DELETE_T(mWorkerFunc, WorkerFunc, MEMCATEGORY_GENERAL);
+        mWorkerFunc = 0;
+
+        mIsRunning = false;
+    }
+    //---------------------------------------------------------------------
+    void StealingWorkQueue::addTask(const Task& task, TaskPriority priority)
+    {
+        if (!mIsRunning || mShuttingDown || mTaskDeques.empty())
+        {
+            task();
+            return;
+        }
+
+        // workers keep their own tasks local, other threads spread them out
+        size_t worker = tlsWorkerQueue == this ?
+            tlsWorkerIndex : mNextDeque++ % mTaskDeques.size();
+        {
+            TaskDeque* taskDeque = mTaskDeques[worker];
+                    OGRE_WQ_LOCK_MUTEX(taskDeque->mutex);
+            taskDeque->tasks[priority].push_back(task);
+            ++mPendingTasks[priority];
+        }
+
+        wakeWorkers(false);
+    }
+    //---------------------------------------------------------------------
+    bool StealingWorkQueue::popTask(size_t worker, Task& task)
+    {
+        size_t count = mTaskDeques.size();
+        for (int p = 0; p < TASK_PRIORITY_COUNT; ++p)
+        {
+            if (mPendingTasks[p] == 0)
+                continue;
+
+            // the newest own task first, its data is the most likely to be cached
+            if (worker < count)
+            {
+                TaskDeque* taskDeque = mTaskDeques[worker];
+                        OGRE_WQ_LOCK_MUTEX(taskDeque->mutex);
+                if (!taskDeque->tasks[p].empty())
+                {
+                    task.swap(taskDeque->tasks[p].back());
+                    taskDeque->tasks[p].pop_back();
+                    --mPendingTasks[p];
+                    return true;
+                }
+            }
+
+            // then the oldest task of another worker
+            for (size_t i = 1; i <= count; ++i)
+            {
+                size_t victim = (worker + i) % count;
+                if (victim == worker)
+                    continue;
+
+                TaskDeque* taskDeque = mTaskDeques[victim];
+                        OGRE_WQ_LOCK_MUTEX(taskDeque->mutex);
+                if (!taskDeque->tasks[p].empty())
+                {
+                    task.swap(taskDeque->tasks[p].front());
+                    taskDeque->tasks[p].pop_front();
+                    --mPendingTasks[p];
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+    //---------------------------------------------------------------------
+    size_t StealingWorkQueue::getTaskConcurrency(void) const
+    {
+        return mIsRunning ? mTaskDeques.size() : 0;
+    }
+    //---------------------------------------------------------------------
+    bool StealingWorkQueue::hasPendingRequests(void)
+    {
+        {
+                    OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            if (!mRequestQueue.empty())
+                return true;
+        }
+
+                OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+        return !mIdleRequestQueue.empty() && !mIdleThreadRunning;
+    }
+    //---------------------------------------------------------------------
+    void StealingWorkQueue::wakeWorkers(bool all)
+    {
+        // a worker about to sleep either sees the new count or is counted as sleeping
+        ++mWakeCount;
+        if (mSleepingWorkers == 0 && !all)
+            return;
+
+                OGRE_WQ_LOCK_MUTEX(mWakeMutex);
+        if (all)
+            OGRE_THREAD_NOTIFY_ALL(mWakeSync);
+        else
+            OGRE_THREAD_NOTIFY_ONE(mWakeSync);
+    }
+    //---------------------------------------------------------------------
+    void StealingWorkQueue::notifyWorkers()
+    {
+        wakeWorkers(false);
+    }
+    //---------------------------------------------------------------------
+    void StealingWorkQueue::waitForWork(size_t wakeCount)
+    {
+        ++mSleepingWorkers;
+        {
+                    OGRE_WQ_LOCK_MUTEX_NAMED(mWakeMutex, wakeLock);
+            while (mWakeCount == wakeCount && !mShuttingDown)
+                OGRE_THREAD_WAIT(mWakeSync, mWakeMutex, wakeLock);
+        }
+        --mSleepingWorkers;
+    }
+    //---------------------------------------------------------------------
+    void StealingWorkQueue::_threadMain()
+    {
+        LogManager::getSingleton().stream() << 
+            "StealingWorkQueue('" << getName() << "')::WorkerFunc - thread " 
+            << OGRE_THREAD_CURRENT_ID << " starting.";
+
+        // Initialise the thread for RS if necessary
+        if (mWorkerRenderSystemAccess)
+        {
+            Root::getSingleton().getRenderSystem()->registerThread();
+            notifyThreadRegistered();
+        }
+
+        size_t worker = mNextWorker++;
+        tlsWorkerQueue = this;
+        tlsWorkerIndex = worker;
+
+        // Spin forever until we're told to shut down
+        while (!isShuttingDown())
+        {
+            size_t wakeCount = mWakeCount;
+
+            Task task;
+            if (popTask(worker, task))
+                runTask(task, mName);
+            else if (hasPendingRequests())
+                _processNextRequest();
+            else
+                waitForWork(wakeCount);
+        }
+
+        tlsWorkerQueue = 0;
+
+        LogManager::getSingleton().stream() << 
+            "StealingWorkQueue('" << getName() << "')::WorkerFunc - thread " 
+            << OGRE_THREAD_CURRENT_ID << " stopped.";
+    }
+
+}
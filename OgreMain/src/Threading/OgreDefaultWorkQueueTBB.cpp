@@ -153,6 +153,22 @@ namespace Ogre
         _processNextRequest();
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueue::addTask(const Task& task, TaskPriority priority)
+    {
+        if (!mIsRunning || mShuttingDown)
+        {
+            task();
+            return;
+        }
+
+        mTaskGroup.run(task);
+    }
+    //---------------------------------------------------------------------
+    size_t DefaultWorkQueue::getTaskConcurrency(void) const
+    {
+        return mIsRunning ? mWorkerThreadCount : 0;
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueue::notifyWorkers()
     {
         // create a new task
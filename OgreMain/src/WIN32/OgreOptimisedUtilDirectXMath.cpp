@@ -99,6 +99,8 @@ namespace DirectX
 
 namespace Ogre {
 
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+
 //-------------------------------------------------------------------------
 // Local classes
 //-------------------------------------------------------------------------
@@ -159,6 +161,64 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        // Pixel routines have no DirectXMath version, use the general one
+
+        /// @copydoc OptimisedUtil::convertUByteToFloat
+        virtual void convertUByteToFloat(const uint8* src, float* dst, size_t count)
+        {
+            _getOptimisedUtilGeneral()->convertUByteToFloat(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertFloatToUByte
+        virtual void convertFloatToUByte(const float* src, uint8* dst, size_t count)
+        {
+            _getOptimisedUtilGeneral()->convertFloatToUByte(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertHalfToFloat
+        virtual void convertHalfToFloat(const uint16* src, float* dst, size_t count)
+        {
+            _getOptimisedUtilGeneral()->convertHalfToFloat(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::convertFloatToHalf
+        virtual void convertFloatToHalf(const float* src, uint16* dst, size_t count)
+        {
+            _getOptimisedUtilGeneral()->convertFloatToHalf(src, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::linearResampleRowUByte4
+        virtual void linearResampleRowUByte4(
+            const uint8* srcRow1, const uint8* srcRow2, uint32 syf,
+            const uint32* sx1, const uint32* sx2, const uint32* sxf,
+            uint8* dst, size_t count)
+        {
+            _getOptimisedUtilGeneral()->linearResampleRowUByte4(
+                srcRow1, srcRow2, syf, sx1, sx2, sxf, dst, count);
+        }
+
+        /// @copydoc OptimisedUtil::accumulateUBytes
+        virtual void accumulateUBytes(const uint8* src, uint32* accum, size_t count)
+        {
+            _getOptimisedUtilGeneral()->accumulateUBytes(src, accum, count);
+        }
+
+        /// @copydoc OptimisedUtil::generateBillboardQuads
+        virtual void generateBillboardQuads(
+            const float* centres, const float* texcoords, const float* offsets,
+            float* dest, size_t count)
+        {
+            _getOptimisedUtilGeneral()->generateBillboardQuads(centres, texcoords, offsets, dest, count);
+        }
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual size_t cullSpheres(
+            const float* planes, size_t numPlanes, const float* spheres,
+            uint32* visible, size_t count)
+        {
+            return _getOptimisedUtilGeneral()->cullSpheres(planes, numPlanes, spheres, visible, count);
+        }
     };
 
 //---------------------------------------------------------------------
@@ -155,6 +155,13 @@ namespace Ogre {
         void _findVisibleObjects(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, 
             bool onlyShadowCasters);
 
+        /** Overridden from SceneManager, not supported since BspSceneNode
+            tracks object movement in _update. */
+        void setTransformStoreEnabled(bool enabled);
+        /** Overridden from SceneManager, not supported since BspSceneNode
+            updates the level in _update. */
+        void setParallelSceneGraphEnabled(bool enabled);
+
         /** Creates a specialized BspSceneNode */
         SceneNode * createSceneNodeImpl ( void );
         /** Creates a specialized BspSceneNode */
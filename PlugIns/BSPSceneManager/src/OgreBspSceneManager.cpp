@@ -600,6 +600,26 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void BspSceneManager::setTransformStoreEnabled(bool enabled)
+    {
+        if (enabled)
+        {
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+                "The transform store is not supported by this scene manager",
+                "BspSceneManager::setTransformStoreEnabled");
+        }
+    }
+    //-----------------------------------------------------------------------
+    void BspSceneManager::setParallelSceneGraphEnabled(bool enabled)
+    {
+        if (enabled)
+        {
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+                "Parallel scene graph updates are not supported by this scene manager",
+                "BspSceneManager::setParallelSceneGraphEnabled");
+        }
+    }
+    //-----------------------------------------------------------------------
     SceneNode * BspSceneManager::createSceneNodeImpl( void )
     {
         return OGRE_NEW BspSceneNode( this );
@@ -74,6 +74,9 @@ public:
     void _addNode( OctreeNode * );
 
     /** Removes an Octree scene node to this octree level.
+    @remarks
+    The last node of this level takes its place, so this doesn't depend on the
+    number of nodes.
     */
     void _removeNode( OctreeNode * );
 
@@ -84,6 +87,20 @@ public:
         return mNumNodes;
     };
 
+    /** Returns the parent of this octree, null for the root
+    */
+    Octree * getParent() const
+    {
+        return mParent;
+    };
+
+    /** Returns the depth of this octree, 0 for the root
+    */
+    int getDepth() const
+    {
+        return mDepth;
+    };
+
     /** The bounding box of the octree
     @remarks
     This is used for octant index determination and rendering, but not culling
@@ -159,6 +176,9 @@ protected:
     ///parent octree
     Octree * mParent;
 
+    ///depth of this octree, 0 for the root
+    int mDepth;
+
 };
 /** @} */
 /** @} */
@@ -92,6 +92,20 @@ public:
         mOctant = o;
     };
 
+    /** Returns the position of this OctreeNode in the node list of its Octree
+    */
+    size_t _getOctantIndex() const
+    {
+        return mOctantIndex;
+    };
+
+    /** Sets the position of this OctreeNode in the node list of its Octree
+    */
+    void _setOctantIndex( size_t index )
+    {
+        mOctantIndex = index;
+    };
+
     /** Determines if the center of this node is within the given box
     */
     bool _isIn( AxisAlignedBox &box );
@@ -137,6 +151,9 @@ protected:
     ///Octree this node is attached to.
     Octree *mOctant;
 
+    ///Position of this node in the node list of mOctant
+    size_t mOctantIndex;
+
     /// Preallocated corners for rendering
     Real mCorners[ 24 ];
     /// Shared colors for rendering
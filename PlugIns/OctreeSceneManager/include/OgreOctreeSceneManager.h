@@ -74,6 +74,41 @@ class _OgreOctreePluginExport OctreeSceneManager : public SceneManager
 
 public:
     static int intersect_call;
+
+    /** An octree level, as stored in the linear octree.
+    @remarks
+    The linear octree holds all the levels depth first, with the children of each
+    level in Morton order, so the whole subtree of a level directly follows it.
+    */
+    struct LinearOctant
+    {
+        /// The octree level
+        Octree *octant;
+        /// The bounds used for culling it, see Octree::_getCullBounds
+        AxisAlignedBox cullBounds;
+        /// Its depth in the octree
+        int depth;
+        /// The index after its subtree in the linear octree
+        size_t subtreeEnd;
+    };
+    typedef vector< LinearOctant >::type LinearOctree;
+
+    /** A range of the linear octree culled as a unit. */
+    struct CullRange
+    {
+        size_t begin;
+        size_t end;
+        /// Whether the range is known to be fully visible
+        bool full;
+    };
+
+    /** The visible nodes found in a CullRange. */
+    struct VisibleNodes
+    {
+        Octree::NodeList nodes;
+        vector< Octree * >::type octants;
+    };
+
     /** Standard Constructor.  Initializes the octree to -10000,-10000,-10000 to 10000,10000,10000 with a depth of 8. */
     OctreeSceneManager(const String& name);
     /** Standard Constructor */
@@ -102,6 +137,9 @@ public:
 
     /** Does nothing more */
     virtual void _updateSceneGraph( Camera * cam );
+    /** Overridden from SceneManager, not supported since OctreeNode
+        relocates itself in the octree from _updateBounds. */
+    virtual void setParallelSceneGraphEnabled( bool enabled );
     /** Recurses through the octree determining which nodes are visible. */
     virtual void _findVisibleObjects ( Camera * cam, 
         VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters );
@@ -116,13 +154,17 @@ public:
     @remarks
     If any octant in the octree if completely within the view frustum,
     all subchildren are automatically added with no visibility tests.
+    When parallel culling is enabled, the subtrees below the top levels are
+    culled on the WorkQueue, and their nodes are added in the same order.
     */
-    void walkOctree( OctreeCamera *, RenderQueue *, Octree *, 
-        VisibleObjectsBoundsInfo* visibleBounds, bool foundvisible, 
-        bool onlyShadowCasters);
+    void walkOctree( OctreeCamera *, RenderQueue *, 
+        VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters );
 
     /** Checks the given OctreeNode, and determines if it needs to be moved
     * to a different octant.
+    @remarks
+    A node which left its octant is moved up to the closest octant still holding
+    it, and only inserted again from there.
     */
     void _updateOctreeNode( OctreeNode * );
     /** Removes the given octree node */
@@ -131,6 +173,26 @@ public:
     */
     void _addOctreeNode( OctreeNode *, Octree *octree, int depth = 0 );
 
+    /** Walks the octree, adding any nodes intersecting with the box into the given vector.
+    It ignores the exclude scene node.
+    */
+    void findNodesIn( const AxisAlignedBox &box, vector< SceneNode * >::type &nodes, SceneNode *exclude = 0 );
+
+    /** Walks the octree, adding any nodes intersecting with the sphere into the given vector.
+    It ignores the exclude scene node.
+    */
+    void findNodesIn( const Sphere &sphere, vector< SceneNode * >::type &nodes, SceneNode *exclude = 0 );
+
+    /** Walks the octree, adding any nodes intersecting with the volume into the given vector.
+      It ignores the exclude scene node.
+      */
+    void findNodesIn( const PlaneBoundedVolume &volume, vector< SceneNode * >::type &nodes, SceneNode *exclude = 0 );
+
+    /** Walks the octree, adding any nodes intersecting with the ray into the given vector.
+      It ignores the exclude scene node.
+      */
+    void findNodesIn( const Ray &ray, vector< SceneNode * >::type &nodes, SceneNode *exclude = 0 );
+
     /** Recurses the octree, adding any nodes intersecting with the box into the given list.
     It ignores the exclude scene node.
     */
@@ -166,6 +228,7 @@ public:
         "Size", AxisAlignedBox *;
         "Depth", int *;
         "ShowOctree", bool *;
+        "ParallelCulling", bool *;
     */
 
     virtual bool setOption( const String &, const void * );
@@ -194,6 +257,20 @@ protected:
     /// The root octree
     Octree *mOctree;
 
+    /// All the levels of mOctree, depth first
+    LinearOctree mLinearOctree;
+
+    /// Whether levels were added to mOctree since mLinearOctree was built
+    bool mLinearOctreeDirty;
+
+    /// Whether the octree is culled on the WorkQueue
+    bool mParallelCulling;
+
+    /// The ranges culled by the last walkOctree, kept to reuse their memory
+    vector< CullRange >::type mCullRanges;
+    /// The nodes found in each of mCullRanges
+    vector< VisibleNodes >::type mCullResults;
+
     /// List of boxes to be rendered
     BoxList mBoxes;
 
@@ -214,6 +291,9 @@ protected:
 
     Matrix4 mScaleFactor;
 
+    /** Builds mLinearOctree again if levels were added to the octree. */
+    void updateLinearOctree( void );
+
 };
 
 /// Factory for OctreeSceneManager
@@ -99,6 +99,7 @@ Octree::Octree( Octree * parent )
     }
 
     mParent = parent;
+    mDepth = parent ? parent->mDepth + 1 : 0;
     mNumNodes = 0;
 }
 
@@ -125,6 +126,7 @@ Octree::~Octree()
 
 void Octree::_addNode( OctreeNode * n )
 {
+    n -> _setOctantIndex( mNodes.size() );
     mNodes.push_back( n );
     n -> setOctant( this );
 
@@ -135,7 +137,12 @@ void Octree::_addNode( OctreeNode * n )
 
 void Octree::_removeNode( OctreeNode * n )
 {
-    mNodes.erase( std::find( mNodes.begin(), mNodes.end(), n ) );
+    // swap the last node into the removed one's place
+    size_t index = n -> _getOctantIndex();
+    assert( mNodes[ index ] == n );
+    mNodes[ index ] = mNodes.back();
+    mNodes[ index ] -> _setOctantIndex( index );
+    mNodes.pop_back();
     n -> setOctant( 0 );
 
     //update total counts.
@@ -39,6 +39,8 @@ email                : janders@users.sf.net
 #include "OgreOctreeNode.h"
 #include "OgreOctreeCamera.h"
 #include "OgreWireBoundingBox.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre
 {
@@ -263,6 +265,175 @@ static Intersection intersect( const Sphere &one, const AxisAlignedBox &two )
 
 }
 
+/** Walks the levels [begin, end) of the linear octree, skipping the subtrees which
+are empty or outside. Once a level is found fully inside, its whole subtree is
+added without further tests.
+*/
+template < typename Culler >
+static void walkLinearOctree( const OctreeSceneManager::LinearOctree &octants,
+    size_t begin, size_t end, bool full, Culler &culler )
+{
+    size_t fullEnd = full ? end : begin;
+    size_t i = begin;
+
+    while ( i < end )
+    {
+        const OctreeSceneManager::LinearOctant &lo = octants[ i ];
+
+        //skip the subtree if nothing is in it.
+        if ( lo.octant -> numNodes() == 0 )
+        {
+            i = lo.subtreeEnd;
+            continue;
+        }
+
+        if ( i >= fullEnd )
+        {
+            Intersection isect = culler.test( lo );
+
+            if ( isect == OUTSIDE )
+            {
+                i = lo.subtreeEnd;
+                continue;
+            }
+
+            if ( isect == INSIDE )
+                fullEnd = lo.subtreeEnd;
+        }
+
+        culler.addNodes( lo.octant, i < fullEnd );
+        ++i;
+    }
+}
+
+/** Collects the nodes intersecting with a volume, for walkLinearOctree */
+template < typename Volume >
+struct OctreeNodeFinder
+{
+    const Volume &volume;
+    vector< SceneNode * >::type &nodes;
+    SceneNode *exclude;
+
+    Intersection test( const OctreeSceneManager::LinearOctant &lo ) const
+    {
+        return intersect( volume, lo.cullBounds );
+    }
+
+    void addNodes( Octree *octant, bool full )
+    {
+        Octree::NodeList::iterator it = octant -> mNodes.begin();
+
+        while ( it != octant -> mNodes.end() )
+        {
+            OctreeNode * on = ( *it );
+
+            if ( on != exclude &&
+                    ( full || intersect( volume, on -> _getWorldAABB() ) != OUTSIDE ) )
+            {
+                nodes.push_back( on );
+            }
+
+            ++it;
+        }
+    }
+};
+
+typedef OctreeSceneManager::VisibleNodes OctreeVisibleNodes;
+
+/** Collects the nodes visible from a camera, for walkLinearOctree */
+struct OctreeVisibleNodeFinder
+{
+    OctreeCamera *camera;
+    Octree *root;
+    OctreeVisibleNodes *visible;
+
+    Intersection test( const OctreeSceneManager::LinearOctant &lo ) const
+    {
+        // the root is never culled
+        if ( lo.octant == root )
+            return INTERSECT;
+
+        switch ( camera -> getVisibility( lo.cullBounds ) )
+        {
+        case OctreeCamera::NONE:
+            return OUTSIDE;
+        case OctreeCamera::FULL:
+            return INSIDE;
+        default:
+            return INTERSECT;
+        }
+    }
+
+    void addNodes( Octree *octant, bool full )
+    {
+        visible -> octants.push_back( octant );
+
+        Octree::NodeList::iterator it = octant -> mNodes.begin();
+
+        while ( it != octant -> mNodes.end() )
+        {
+            OctreeNode * sn = *it;
+
+            // if this octree is partially visible, manually cull all
+            // scene nodes attached directly to this level.
+            if ( full || camera -> isVisible( sn -> _getWorldAABB() ) )
+                visible -> nodes.push_back( sn );
+
+            ++it;
+        }
+    }
+};
+
+typedef OctreeSceneManager::CullRange OctreeCullRange;
+
+/** Culls a range of OctreeCullRanges, for WorkQueue::parallelFor */
+struct OctreeCullTask
+{
+    const OctreeSceneManager::LinearOctree *octants;
+    const OctreeCullRange *ranges;
+    OctreeVisibleNodes *results;
+    OctreeCamera *camera;
+    Octree *root;
+
+    void operator()( size_t begin, size_t end ) const
+    {
+        for ( size_t r = begin; r < end; ++r )
+        {
+            OctreeVisibleNodeFinder finder = { camera, root, &results[ r ] };
+            walkLinearOctree( *octants, ranges[ r ].begin, ranges[ r ].end, ranges[ r ].full, finder );
+        }
+    }
+};
+
+/// Depth of the octree levels whose subtrees are culled in parallel
+static const int PARALLEL_CULL_DEPTH = 2;
+
+/** Appends the octant and its subtree to the linear octree */
+static void appendLinearOctants( OctreeSceneManager::LinearOctree &octants, Octree *octant )
+{
+    size_t index = octants.size();
+    OctreeSceneManager::LinearOctant lo;
+    lo.octant = octant;
+    octant -> _getCullBounds( &lo.cullBounds );
+    lo.depth = octant -> getDepth();
+    octants.push_back( lo );
+
+    // Morton order, x first
+    for ( int z = 0; z < 2; ++z )
+    {
+        for ( int y = 0; y < 2; ++y )
+        {
+            for ( int x = 0; x < 2; ++x )
+            {
+                if ( octant -> mChildren[ x ][ y ][ z ] != 0 )
+                    appendLinearOctants( octants, octant -> mChildren[ x ][ y ][ z ] );
+            }
+        }
+    }
+
+    octants[ index ].subtreeEnd = octants.size();
+}
+
 unsigned long white = 0xFFFFFFFF;
 
 unsigned short OctreeSceneManager::mIndexes[ 24 ] = {0, 1, 1, 2, 2, 3, 3, 0,       //back
@@ -277,6 +448,7 @@ OctreeSceneManager::OctreeSceneManager(const String& name) : SceneManager(name)
     AxisAlignedBox b( -10000, -10000, -10000, 10000, 10000, 10000 );
     int depth = 8; 
     mOctree = 0;
+    mParallelCulling = false;
     init( b, depth );
 }
 
@@ -284,6 +456,7 @@ OctreeSceneManager::OctreeSceneManager(const String& name, AxisAlignedBox &box,
 : SceneManager(name)
 {
     mOctree = 0;
+    mParallelCulling = false;
     init( box, max_depth );
 }
 
@@ -299,6 +472,7 @@ void OctreeSceneManager::init( AxisAlignedBox &box, int depth )
         OGRE_DELETE mOctree;
 
     mOctree = OGRE_NEW Octree( 0 );
+    mLinearOctreeDirty = true;
 
     mMaxDepth = depth;
     mBox = box;
@@ -381,6 +555,7 @@ bool OctreeSceneManager::getOptionKeys( StringVector & refKeys )
     refKeys.push_back( "Size" );
     refKeys.push_back( "ShowOctree" );
     refKeys.push_back( "Depth" );
+    refKeys.push_back( "ParallelCulling" );
 
     return true;
 }
@@ -407,15 +582,23 @@ void OctreeSceneManager::_updateOctreeNode( OctreeNode * onode )
         return ;
     }
 
-    if ( ! onode -> _isIn( onode -> getOctant() -> mBox ) )
+    Octree * octant = onode -> getOctant();
+
+    if ( ! onode -> _isIn( octant -> mBox ) )
     {
         _removeOctreeNode( onode );
 
+        // Inserting from the root would go through the closest octant which
+        // still holds the node, so only go down again from there
+        octant = octant -> getParent();
+        while ( octant != 0 && ! onode -> _isIn( octant -> mBox ) )
+            octant = octant -> getParent();
+
         //if outside the octree, force into the root node.
-        if ( ! onode -> _isIn( mOctree -> mBox ) )
+        if ( octant == 0 )
             mOctree->_addNode( onode );
         else
-            _addOctreeNode( onode, mOctree );
+            _addOctreeNode( onode, octant, octant -> getDepth() );
     }
 }
 
@@ -458,6 +641,7 @@ void OctreeSceneManager::_addOctreeNode( OctreeNode * n, Octree *octant, int dep
         if ( octant -> mChildren[ x ][ y ][ z ] == 0 )
         {
             octant -> mChildren[ x ][ y ][ z ] = OGRE_NEW Octree( octant );
+            mLinearOctreeDirty = true;
             const Vector3& octantMin = octant -> mBox.getMinimum();
             const Vector3& octantMax = octant -> mBox.getMaximum();
             Vector3 min, max;
@@ -528,6 +712,16 @@ void OctreeSceneManager::_updateSceneGraph( Camera * cam )
     SceneManager::_updateSceneGraph( cam );
 }
 
+void OctreeSceneManager::setParallelSceneGraphEnabled( bool enabled )
+{
+    if ( enabled )
+    {
+        OGRE_EXCEPT( Exception::ERR_NOT_IMPLEMENTED,
+            "Parallel scene graph updates are not supported by this scene manager",
+            "OctreeSceneManager::setParallelSceneGraphEnabled" );
+    }
+}
+
 void OctreeSceneManager::_alertVisibleObjects( void )
 {
     OGRE_EXCEPT( Exception::ERR_NOT_IMPLEMENTED,
@@ -555,8 +749,8 @@ void OctreeSceneManager::_findVisibleObjects(Camera * cam,
     mNumObjects = 0;
 
     //walk the octree, adding all visible Octreenodes nodes to the render queue.
-    walkOctree( static_cast < OctreeCamera * > ( cam ), getRenderQueue(), mOctree, 
-                visibleBounds, false, onlyShadowCasters );
+    walkOctree( static_cast < OctreeCamera * > ( cam ), getRenderQueue(), 
+                visibleBounds, onlyShadowCasters );
 
     // Show the octree boxes & cull camera if required
     if ( mShowBoxes )
@@ -568,433 +762,200 @@ void OctreeSceneManager::_findVisibleObjects(Camera * cam,
     }
 }
 
-void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue, 
-    Octree *octant, VisibleObjectsBoundsInfo* visibleBounds, 
-    bool foundvisible, bool onlyShadowCasters )
+void OctreeSceneManager::updateLinearOctree( void )
 {
-
-    //return immediately if nothing is in the node.
-    if ( octant -> numNodes() == 0 )
-        return ;
-
-    OctreeCamera::Visibility v = OctreeCamera::NONE;
-
-    if ( foundvisible )
-    {
-        v = OctreeCamera::FULL;
-    }
-
-    else if ( octant == mOctree )
-    {
-        v = OctreeCamera::PARTIAL;
-    }
-
-    else
-    {
-        AxisAlignedBox box;
-        octant -> _getCullBounds( &box );
-        v = camera -> getVisibility( box );
-    }
-
-
-    // if the octant is visible, or if it's the root node...
-    if ( v != OctreeCamera::NONE )
+    if ( mLinearOctreeDirty )
     {
-
-        //Add stuff to be rendered;
-        Octree::NodeList::iterator it = octant -> mNodes.begin();
-
-        if ( mShowBoxes )
-        {
-            mBoxes.push_back( octant->getWireBoundingBox() );
-        }
-
-        bool vis = true;
-
-        while ( it != octant -> mNodes.end() )
-        {
-            OctreeNode * sn = *it;
-
-            // if this octree is partially visible, manually cull all
-            // scene nodes attached directly to this level.
-
-            if ( v == OctreeCamera::PARTIAL )
-                vis = camera -> isVisible( sn -> _getWorldAABB() );
-
-            if ( vis )
-            {
-
-                mNumObjects++;
-                sn -> _addToRenderQueue(camera, queue, onlyShadowCasters, visibleBounds );
-
-                mVisible.push_back( sn );
-
-                if ( mDisplayNodes )
-                    queue -> addRenderable( sn->getDebugRenderable() );
-
-                // check if the scene manager or this node wants the bounding box shown.
-                if (sn->getShowBoundingBox() || mShowBoundingBoxes)
-                    sn->_addBoundingBoxToQueue(queue);
-            }
-
-            ++it;
-        }
-
-        Octree* child;
-        bool childfoundvisible = (v == OctreeCamera::FULL);
-        if ( (child = octant -> mChildren[ 0 ][ 0 ][ 0 ]) != 0 )
-            walkOctree( camera, queue, child, visibleBounds, childfoundvisible, onlyShadowCasters );
-
-        if ( (child = octant -> mChildren[ 1 ][ 0 ][ 0 ]) != 0 )
-            walkOctree( camera, queue, child, visibleBounds, childfoundvisible, onlyShadowCasters );
-
-        if ( (child = octant -> mChildren[ 0 ][ 1 ][ 0 ]) != 0 )
-            walkOctree( camera, queue, child, visibleBounds, childfoundvisible, onlyShadowCasters );
-
-        if ( (child = octant -> mChildren[ 1 ][ 1 ][ 0 ]) != 0 )
-            walkOctree( camera, queue, child, visibleBounds, childfoundvisible, onlyShadowCasters );
-
-        if ( (child = octant -> mChildren[ 0 ][ 0 ][ 1 ]) != 0 )
-            walkOctree( camera, queue, child, visibleBounds, childfoundvisible, onlyShadowCasters );
-
-        if ( (child = octant -> mChildren[ 1 ][ 0 ][ 1 ]) != 0 )
-            walkOctree( camera, queue, child, visibleBounds, childfoundvisible, onlyShadowCasters );
-
-        if ( (child = octant -> mChildren[ 0 ][ 1 ][ 1 ]) != 0 )
-            walkOctree( camera, queue, child, visibleBounds, childfoundvisible, onlyShadowCasters );
-
-        if ( (child = octant -> mChildren[ 1 ][ 1 ][ 1 ]) != 0 )
-            walkOctree( camera, queue, child, visibleBounds, childfoundvisible, onlyShadowCasters );
-
+        mLinearOctree.clear();
+        appendLinearOctants( mLinearOctree, mOctree );
+        mLinearOctreeDirty = false;
     }
-
 }
 
-// --- non template versions
-static void _findNodes( const AxisAlignedBox &t, list< SceneNode * >::type &list, SceneNode *exclude, bool full, Octree *octant )
+void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue, 
+    VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters )
 {
+    updateLinearOctree();
 
-    if ( !full )
-    {
-        AxisAlignedBox obox;
-        octant -> _getCullBounds( &obox );
-
-        Intersection isect = intersect( t, obox );
-
-        if ( isect == OUTSIDE )
-            return ;
-
-        full = ( isect == INSIDE );
-    }
-
+    WorkQueue* workQueue = Root::getSingleton().getWorkQueue();
+    bool parallel = mParallelCulling && workQueue -> getTaskConcurrency();
 
-    Octree::NodeList::iterator it = octant -> mNodes.begin();
-
-    while ( it != octant -> mNodes.end() )
+    // Split the octree into ranges: the levels above PARALLEL_CULL_DEPTH on
+    // their own, and the subtrees below, in the order of the serial walk
+    vector< OctreeCullRange >::type &ranges = mCullRanges;
+    ranges.clear();
+    if ( parallel )
     {
-        OctreeNode * on = ( *it );
-
-        if ( on != exclude )
+        // Bring the lazily computed frustum planes up to date before the
+        // workers read them
+        camera -> getFrustumPlanes();
+        const Frustum* cullFrustum = camera -> getCullingFrustum();
+        if ( cullFrustum )
+            cullFrustum -> getFrustumPlanes();
+
+        OctreeVisibleNodeFinder finder = { camera, mOctree, 0 };
+        size_t fullEnd = 0;
+        size_t i = 0;
+        while ( i < mLinearOctree.size() )
         {
-            if ( full )
-            {
-                list.push_back( on );
-            }
+            const LinearOctant &lo = mLinearOctree[ i ];
 
-            else
+            if ( lo.octant -> numNodes() == 0 )
             {
-                Intersection nsect = intersect( t, on -> _getWorldAABB() );
-
-                if ( nsect != OUTSIDE )
-                {
-                    list.push_back( on );
-                }
+                i = lo.subtreeEnd;
+                continue;
             }
 
-        }
-
-        ++it;
-    }
-
-    Octree* child;
-
-    if ( (child=octant -> mChildren[ 0 ][ 0 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 0 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 1 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 1 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 0 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 0 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 1 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 1 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-}
-
-static void _findNodes( const Sphere &t, list< SceneNode * >::type &list, SceneNode *exclude, bool full, Octree *octant )
-{
-
-    if ( !full )
-    {
-        AxisAlignedBox obox;
-        octant -> _getCullBounds( &obox );
-
-        Intersection isect = intersect( t, obox );
-
-        if ( isect == OUTSIDE )
-            return ;
-
-        full = ( isect == INSIDE );
-    }
-
-
-    Octree::NodeList::iterator it = octant -> mNodes.begin();
-
-    while ( it != octant -> mNodes.end() )
-    {
-        OctreeNode * on = ( *it );
-
-        if ( on != exclude )
-        {
-            if ( full )
+            if ( lo.depth >= PARALLEL_CULL_DEPTH )
             {
-                list.push_back( on );
+                OctreeCullRange range = { i, lo.subtreeEnd, i < fullEnd };
+                ranges.push_back( range );
+                i = lo.subtreeEnd;
+                continue;
             }
 
-            else
+            if ( i >= fullEnd )
             {
-                Intersection nsect = intersect( t, on -> _getWorldAABB() );
-
-                if ( nsect != OUTSIDE )
+                Intersection isect = finder.test( lo );
+                if ( isect == OUTSIDE )
                 {
-                    list.push_back( on );
+                    i = lo.subtreeEnd;
+                    continue;
                 }
+                if ( isect == INSIDE )
+                    fullEnd = lo.subtreeEnd;
             }
 
+            OctreeCullRange range = { i, i + 1, i < fullEnd };
+            ranges.push_back( range );
+            ++i;
         }
-
-        ++it;
     }
-
-    Octree* child;
-
-    if ( (child=octant -> mChildren[ 0 ][ 0 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 0 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 1 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 1 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 0 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 0 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 1 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 1 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-}
-
-
-static void _findNodes( const PlaneBoundedVolume &t, list< SceneNode * >::type &list, SceneNode *exclude, bool full, Octree *octant )
-{
-
-    if ( !full )
-    {
-        AxisAlignedBox obox;
-        octant -> _getCullBounds( &obox );
-
-        Intersection isect = intersect( t, obox );
-
-        if ( isect == OUTSIDE )
-            return ;
-
-        full = ( isect == INSIDE );
-    }
-
-
-    Octree::NodeList::iterator it = octant -> mNodes.begin();
-
-    while ( it != octant -> mNodes.end() )
+    else
     {
-        OctreeNode * on = ( *it );
-
-        if ( on != exclude )
-        {
-            if ( full )
-            {
-                list.push_back( on );
-            }
-
-            else
-            {
-                Intersection nsect = intersect( t, on -> _getWorldAABB() );
-
-                if ( nsect != OUTSIDE )
-                {
-                    list.push_back( on );
-                }
-            }
-
-        }
-
-        ++it;
+        OctreeCullRange range = { 0, mLinearOctree.size(), false };
+        ranges.push_back( range );
     }
 
-    Octree* child;
-
-    if ( (child=octant -> mChildren[ 0 ][ 0 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 0 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 1 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 1 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 0 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 0 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 0 ][ 1 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-    if ( (child=octant -> mChildren[ 1 ][ 1 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
-
-}
-
-static void _findNodes( const Ray &t, list< SceneNode * >::type &list, SceneNode *exclude, bool full, Octree *octant )
-{
+    if ( ranges.empty() )
+        return;
 
-    if ( !full )
+    // The lists of earlier frames keep their memory, they are only cleared
+    vector< OctreeVisibleNodes >::type &results = mCullResults;
+    if ( results.size() < ranges.size() )
+        results.resize( ranges.size() );
+    for ( size_t r = 0; r < ranges.size(); ++r )
     {
-        AxisAlignedBox obox;
-        octant -> _getCullBounds( &obox );
-
-        Intersection isect = intersect( t, obox );
-
-        if ( isect == OUTSIDE )
-            return ;
-
-        full = ( isect == INSIDE );
+        results[ r ].nodes.clear();
+        results[ r ].octants.clear();
     }
 
+    OctreeCullTask task = { &mLinearOctree, &ranges[ 0 ], &results[ 0 ], camera, mOctree };
+    if ( parallel && ranges.size() > 1 )
+        workQueue -> parallelFor( 0, ranges.size(), 1, task );
+    else
+        task( 0, ranges.size() );
 
-    Octree::NodeList::iterator it = octant -> mNodes.begin();
-
-    while ( it != octant -> mNodes.end() )
+    //Add stuff to be rendered;
+    for ( size_t r = 0; r < ranges.size(); ++r )
     {
-        OctreeNode * on = ( *it );
+        const OctreeVisibleNodes &visible = results[ r ];
 
-        if ( on != exclude )
+        if ( mShowBoxes )
         {
-            if ( full )
-            {
-                list.push_back( on );
-            }
-
-            else
-            {
-                Intersection nsect = intersect( t, on -> _getWorldAABB() );
-
-                if ( nsect != OUTSIDE )
-                {
-                    list.push_back( on );
-                }
-            }
-
+            for ( size_t i = 0; i < visible.octants.size(); ++i )
+                mBoxes.push_back( visible.octants[ i ]->getWireBoundingBox() );
         }
 
-        ++it;
-    }
-
-    Octree* child;
-
-    if ( (child=octant -> mChildren[ 0 ][ 0 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
+        for ( size_t i = 0; i < visible.nodes.size(); ++i )
+        {
+            OctreeNode * sn = visible.nodes[ i ];
 
-    if ( (child=octant -> mChildren[ 1 ][ 0 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
+            mNumObjects++;
+            sn -> _addToRenderQueue(camera, queue, onlyShadowCasters, visibleBounds );
 
-    if ( (child=octant -> mChildren[ 0 ][ 1 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
+            mVisible.push_back( sn );
 
-    if ( (child=octant -> mChildren[ 1 ][ 1 ][ 0 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
+            if ( mDisplayNodes )
+                queue -> addRenderable( sn->getDebugRenderable() );
 
-    if ( (child=octant -> mChildren[ 0 ][ 0 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
+            // check if the scene manager or this node wants the bounding box shown.
+            if (sn->getShowBoundingBox() || mShowBoundingBoxes)
+                sn->_addBoundingBoxToQueue(queue);
+        }
+    }
+}
 
-    if ( (child=octant -> mChildren[ 1 ][ 0 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
+void OctreeSceneManager::findNodesIn( const AxisAlignedBox &box, vector< SceneNode * >::type &nodes, SceneNode *exclude )
+{
+    updateLinearOctree();
+    OctreeNodeFinder< AxisAlignedBox > finder = { box, nodes, exclude };
+    walkLinearOctree( mLinearOctree, 0, mLinearOctree.size(), false, finder );
+}
 
-    if ( (child=octant -> mChildren[ 0 ][ 1 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
+void OctreeSceneManager::findNodesIn( const Sphere &sphere, vector< SceneNode * >::type &nodes, SceneNode *exclude )
+{
+    updateLinearOctree();
+    OctreeNodeFinder< Sphere > finder = { sphere, nodes, exclude };
+    walkLinearOctree( mLinearOctree, 0, mLinearOctree.size(), false, finder );
+}
 
-    if ( (child=octant -> mChildren[ 1 ][ 1 ][ 1 ]) != 0 )
-        _findNodes( t, list, exclude, full, child );
+void OctreeSceneManager::findNodesIn( const PlaneBoundedVolume &volume, vector< SceneNode * >::type &nodes, SceneNode *exclude )
+{
+    updateLinearOctree();
+    OctreeNodeFinder< PlaneBoundedVolume > finder = { volume, nodes, exclude };
+    walkLinearOctree( mLinearOctree, 0, mLinearOctree.size(), false, finder );
+}
 
+void OctreeSceneManager::findNodesIn( const Ray &r, vector< SceneNode * >::type &nodes, SceneNode *exclude )
+{
+    updateLinearOctree();
+    OctreeNodeFinder< Ray > finder = { r, nodes, exclude };
+    walkLinearOctree( mLinearOctree, 0, mLinearOctree.size(), false, finder );
 }
 
 void OctreeSceneManager::findNodesIn( const AxisAlignedBox &box, list< SceneNode * >::type &list, SceneNode *exclude )
 {
-    _findNodes( box, list, exclude, false, mOctree );
+    vector< SceneNode * >::type nodes;
+    findNodesIn( box, nodes, exclude );
+    list.insert( list.end(), nodes.begin(), nodes.end() );
 }
 
 void OctreeSceneManager::findNodesIn( const Sphere &sphere, list< SceneNode * >::type &list, SceneNode *exclude )
 {
-    _findNodes( sphere, list, exclude, false, mOctree );
+    vector< SceneNode * >::type nodes;
+    findNodesIn( sphere, nodes, exclude );
+    list.insert( list.end(), nodes.begin(), nodes.end() );
 }
 
 void OctreeSceneManager::findNodesIn( const PlaneBoundedVolume &volume, list< SceneNode * >::type &list, SceneNode *exclude )
 {
-    _findNodes( volume, list, exclude, false, mOctree );
+    vector< SceneNode * >::type nodes;
+    findNodesIn( volume, nodes, exclude );
+    list.insert( list.end(), nodes.begin(), nodes.end() );
 }
 
 void OctreeSceneManager::findNodesIn( const Ray &r, list< SceneNode * >::type &list, SceneNode *exclude )
 {
-    _findNodes( r, list, exclude, false, mOctree );
+    vector< SceneNode * >::type nodes;
+    findNodesIn( r, nodes, exclude );
+    list.insert( list.end(), nodes.begin(), nodes.end() );
 }
 
 void OctreeSceneManager::resize( const AxisAlignedBox &box )
 {
-    list< SceneNode * >::type nodes;
-    list< SceneNode * >::type ::iterator it;
+    vector< SceneNode * >::type nodes;
+    vector< SceneNode * >::type ::iterator it;
 
-    _findNodes( mOctree->mBox, nodes, 0, true, mOctree );
+    updateLinearOctree();
+    OctreeNodeFinder< AxisAlignedBox > finder = { mOctree->mBox, nodes, 0 };
+    walkLinearOctree( mLinearOctree, 0, mLinearOctree.size(), true, finder );
 
     OGRE_DELETE mOctree;
 
     mOctree = OGRE_NEW Octree( 0 );
     mOctree->mBox = box;
+    mLinearOctreeDirty = true;
 
     const Vector3 &min = box.getMinimum();
     const Vector3 &max = box.getMaximum();
@@ -1035,6 +996,12 @@ bool OctreeSceneManager::setOption( const String & key, const void * val )
         return true;
     }
 
+    else if ( key == "ParallelCulling" )
+    {
+        mParallelCulling = * static_cast < const bool * > ( val );
+        return true;
+    }
+
 
     return SceneManager::setOption( key, val );
 
@@ -1063,6 +1030,12 @@ bool OctreeSceneManager::getOption( const String & key, void *val )
         return true;
     }
 
+    else if ( key == "ParallelCulling" )
+    {
+        * static_cast < bool * > ( val ) = mParallelCulling;
+        return true;
+    }
+
 
     return SceneManager::getOption( key, val );
 
@@ -62,6 +62,8 @@ void OctreeIntersectionSceneQuery::execute(IntersectionSceneQueryListener* liste
         < std::pair<MovableObject *, MovableObject *> > MovableSet;
 
     MovableSet set;
+    // reused for every movable to avoid reallocating
+    Ogre::vector< SceneNode * >::type list;
 
     // Iterate over all movable types
     Root::MovableObjectFactoryIterator factIt = 
@@ -76,11 +78,11 @@ void OctreeIntersectionSceneQuery::execute(IntersectionSceneQueryListener* liste
 
             MovableObject * e = it.getNext();
 
-            Ogre::list< SceneNode * >::type list;
+            list.clear();
             //find the nodes that intersect the AAB
             static_cast<OctreeSceneManager*>( mParentSceneMgr ) -> findNodesIn( e->getWorldBoundingBox(), list, 0 );
             //grab all moveables from the node that intersect...
-            Ogre::list< SceneNode * >::type::iterator nit = list.begin();
+            Ogre::vector< SceneNode * >::type::iterator nit = list.begin();
             while( nit != list.end() )
             {
                 SceneNode::ObjectIterator oit = (*nit) -> getAttachedObjectIterator();
@@ -134,12 +136,12 @@ OctreeAxisAlignedBoxSceneQuery::~OctreeAxisAlignedBoxSceneQuery()
 /** Finds any entities that intersect the AAB for the query. */
 void OctreeAxisAlignedBoxSceneQuery::execute(SceneQueryListener* listener)
 {
-    list< SceneNode * >::type _list;
+    vector< SceneNode * >::type _list;
     //find the nodes that intersect the AAB
     static_cast<OctreeSceneManager*>( mParentSceneMgr ) -> findNodesIn( mAABB, _list, 0 );
 
     //grab all moveables from the node that intersect...
-    list< SceneNode * >::type::iterator it = _list.begin();
+    vector< SceneNode * >::type::iterator it = _list.begin();
     while( it != _list.end() )
     {
         SceneNode::ObjectIterator oit = (*it) -> getAttachedObjectIterator();
@@ -185,12 +187,12 @@ OctreeRaySceneQuery::~OctreeRaySceneQuery()
 //---------------------------------------------------------------------
 void OctreeRaySceneQuery::execute(RaySceneQueryListener* listener)
 {
-    list< SceneNode * >::type _list;
+    vector< SceneNode * >::type _list;
     //find the nodes that intersect the AAB
     static_cast<OctreeSceneManager*>( mParentSceneMgr ) -> findNodesIn( mRay, _list, 0 );
 
     //grab all moveables from the node that intersect...
-    list< SceneNode * >::type::iterator it = _list.begin();
+    vector< SceneNode * >::type::iterator it = _list.begin();
     while( it != _list.end() )
     {
         SceneNode::ObjectIterator oit = (*it) -> getAttachedObjectIterator();
@@ -244,12 +246,12 @@ OctreeSphereSceneQuery::~OctreeSphereSceneQuery()
 //---------------------------------------------------------------------
 void OctreeSphereSceneQuery::execute(SceneQueryListener* listener)
 {
-    list< SceneNode * >::type _list;
+    vector< SceneNode * >::type _list;
     //find the nodes that intersect the AAB
     static_cast<OctreeSceneManager*>( mParentSceneMgr ) -> findNodesIn( mSphere, _list, 0 );
 
     //grab all moveables from the node that intersect...
-    list< SceneNode * >::type::iterator it = _list.begin();
+    vector< SceneNode * >::type::iterator it = _list.begin();
     while( it != _list.end() )
     {
         SceneNode::ObjectIterator oit = (*it) -> getAttachedObjectIterator();
@@ -302,12 +304,12 @@ void OctreePlaneBoundedVolumeListSceneQuery::execute(SceneQueryListener* listene
     piend = mVolumes.end();
     for (pi = mVolumes.begin(); pi != piend; ++pi)
     {
-        list< SceneNode * >::type _list;
+        vector< SceneNode * >::type _list;
         //find the nodes that intersect the AAB
         static_cast<OctreeSceneManager*>( mParentSceneMgr ) -> findNodesIn( *pi, _list, 0 );
 
         //grab all moveables from the node that intersect...
-        list< SceneNode * >::type::iterator it, itend;
+        vector< SceneNode * >::type::iterator it, itend;
         itend = _list.end();
         for (it = _list.begin(); it != itend; ++it)
         {
@@ -151,6 +151,13 @@ namespace Ogre
         /** Update Scene Graph (does several things now) */
         virtual void _updateSceneGraph( Camera * cam );
 
+        /** Overridden from SceneManager, not supported since PCZSceneNode
+            tracks its movement in _update. */
+        virtual void setTransformStoreEnabled(bool enabled);
+        /** Overridden from SceneManager, not supported since PCZSceneNode
+            updates its zones in _update. */
+        virtual void setParallelSceneGraphEnabled(bool enabled);
+
         /** Recurses through the PCZTree determining which nodes are visible. */
         virtual void _findVisibleObjects ( Camera * cam, 
             VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters );
@@ -559,6 +559,26 @@ namespace Ogre
         _clearAllZonesPortalUpdateFlag(); 
     }
 
+    void PCZSceneManager::setTransformStoreEnabled(bool enabled)
+    {
+        if (enabled)
+        {
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+                "The transform store is not supported by this scene manager",
+                "PCZSceneManager::setTransformStoreEnabled");
+        }
+    }
+
+    void PCZSceneManager::setParallelSceneGraphEnabled(bool enabled)
+    {
+        if (enabled)
+        {
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+                "Parallel scene graph updates are not supported by this scene manager",
+                "PCZSceneManager::setParallelSceneGraphEnabled");
+        }
+    }
+
     /** Update the zone data for every zone portal in the scene */
 
     void PCZSceneManager::_updatePortalZoneData(void)
@@ -88,6 +88,9 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        void _affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed);
+
         /** Sets the colour adjustment to be made per second to particles. 
         @param red, green, blue, alpha
             Sets the adjustment to be made to each of the colour components per second. These
@@ -162,6 +165,15 @@ namespace Ogre {
             }
         }
 
+        /** Internal method for adjusting an array of components while clamping to [0,1] */
+        inline void applyAdjustWithClamp(float* components, size_t count, float adjust)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                components[i] = std::min(std::max(components[i] + adjust, 0.0f), 1.0f);
+            }
+        }
+
     };
 
     /** @} */
@@ -57,6 +57,14 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        void _affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed);
+
+        /** Sets the image the colours come from.
+        @remarks
+            The image is loaded right away from the resource group of the particle
+            system, since the particles may be updated on a worker thread.
+        */
         void setImageAdjust(String name);
         String getImageAdjust(void) const;
         
@@ -90,6 +90,15 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void ColourFaderAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        // Scale adjustments by time
+        applyAdjustWithClamp(batch.colourR, batch.count, mRedAdj * timeElapsed);
+        applyAdjustWithClamp(batch.colourG, batch.count, mGreenAdj * timeElapsed);
+        applyAdjustWithClamp(batch.colourB, batch.count, mBlueAdj * timeElapsed);
+        applyAdjustWithClamp(batch.colourA, batch.count, mAlphaAdj * timeElapsed);
+    }
+    //-----------------------------------------------------------------------
     void ColourFaderAffector::setAdjust(float red, float green, float blue, float alpha)
     {
         mRedAdj = red;
@@ -139,6 +139,27 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void ColourFaderAffector2::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        float* components[4] = { batch.colourR, batch.colourG, batch.colourB, batch.colourA };
+        // Scale adjustments by time
+        const float adjust1[4] = { mRedAdj1 * timeElapsed, mGreenAdj1 * timeElapsed,
+            mBlueAdj1 * timeElapsed, mAlphaAdj1 * timeElapsed };
+        const float adjust2[4] = { mRedAdj2 * timeElapsed, mGreenAdj2 * timeElapsed,
+            mBlueAdj2 * timeElapsed, mAlphaAdj2 * timeElapsed };
+        const Real* timeToLive = batch.timeToLive;
+
+        for (int c = 0; c < 4; ++c)
+        {
+            float* component = components[c];
+            for (size_t i = 0; i < batch.count; ++i)
+            {
+                float value = component[i] + (timeToLive[i] > StateChangeVal ? adjust1[c] : adjust2[c]);
+                component[i] = std::min(std::max(value, 0.0f), 1.0f);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
     void ColourFaderAffector2::setAdjust1(float red, float green, float blue, float alpha)
     {
         mRedAdj1 = red;
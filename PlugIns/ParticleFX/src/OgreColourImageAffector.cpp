@@ -55,9 +55,7 @@ namespace Ogre {
     void ColourImageAffector::_initParticle(Particle* pParticle)
     {
         if (!mColourImageLoaded)
-        {
-            _loadImage();
-        }
+            return;
 
         pParticle->mColour = mColourImage.getColourAt(0, 0, 0);
     
@@ -69,9 +67,7 @@ namespace Ogre {
         ParticleIterator    pi              = pSystem->_getIterator();
 
         if (!mColourImageLoaded)
-        {
-            _loadImage();
-        }
+            return;
 
         int                width            = (int)mColourImage.getWidth()  - 1;
         
@@ -114,12 +110,67 @@ namespace Ogre {
             }
         }
     }
+    //-----------------------------------------------------------------------
+    void ColourImageAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        if (!mColourImageLoaded)
+            return;
+
+        int                width            = (int)mColourImage.getWidth()  - 1;
+        
+        for (size_t p = 0; p < batch.count; ++p)
+        {
+            Real            particle_time   = 1.0f - (batch.timeToLive[p] / batch.totalTimeToLive[p]);
+
+            if (particle_time > 1.0f)
+                particle_time = 1.0f;
+            if (particle_time < 0.0f)
+                particle_time = 0.0f;
+
+            const Real      float_index     = particle_time * width;
+            const int       index           = (int)float_index;
+
+            ColourValue colour;
+            if(index < 0)
+            {
+                colour = mColourImage.getColourAt(0, 0, 0);
+            }
+            else if(index >= width) 
+            {
+                colour = mColourImage.getColourAt(width, 0, 0);
+            }
+            else
+            {
+                // Linear interpolation
+                const Real      fract       = float_index - (Real)index;
+                const Real      to_colour   = fract;
+                const Real      from_colour = 1.0f - to_colour;
+             
+                ColourValue from=mColourImage.getColourAt(index, 0, 0),
+                            to=mColourImage.getColourAt(index+1, 0, 0);
+
+                colour.r = from.r*from_colour + to.r*to_colour;
+                colour.g = from.g*from_colour + to.g*to_colour;
+                colour.b = from.b*from_colour + to.b*to_colour;
+                colour.a = from.a*from_colour + to.a*to_colour;
+            }
+
+            batch.colourR[p] = colour.r;
+            batch.colourG[p] = colour.g;
+            batch.colourB[p] = colour.b;
+            batch.colourA[p] = colour.a;
+        }
+    }
     
     //-----------------------------------------------------------------------
     void ColourImageAffector::setImageAdjust(String name)
     {
         mColourImageName = name;
         mColourImageLoaded = false;
+
+        // Load right away, the particles may be updated on a worker thread
+        if (!mColourImageName.empty())
+            _loadImage();
     }
     //-----------------------------------------------------------------------
     void ColourImageAffector::_loadImage(void)
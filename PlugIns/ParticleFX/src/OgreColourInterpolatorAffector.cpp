@@ -111,6 +111,45 @@ namespace Ogre {
             }
         }
     }
+    //-----------------------------------------------------------------------
+    void ColourInterpolatorAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        for (size_t p = 0; p < batch.count; ++p)
+        {
+            Real particle_time = 1.0f - (batch.timeToLive[p] / batch.totalTimeToLive[p]);
+            ColourValue colour;
+
+            if (particle_time <= mTimeAdj[0])
+            {
+                colour = mColourAdj[0];
+            } else
+            if (particle_time >= mTimeAdj[MAX_STAGES - 1])
+            {
+                colour = mColourAdj[MAX_STAGES-1];
+            } else
+            {
+                colour = ColourValue(batch.colourR[p], batch.colourG[p], batch.colourB[p], batch.colourA[p]);
+                for (int i=0;i<MAX_STAGES-1;i++)
+                {
+                    if (particle_time >= mTimeAdj[i] && particle_time < mTimeAdj[i + 1])
+                    {
+                        particle_time -= mTimeAdj[i];
+                        particle_time /= (mTimeAdj[i+1]-mTimeAdj[i]);
+                        colour.r = ((mColourAdj[i+1].r * particle_time) + (mColourAdj[i].r * (1.0f - particle_time)));
+                        colour.g = ((mColourAdj[i+1].g * particle_time) + (mColourAdj[i].g * (1.0f - particle_time)));
+                        colour.b = ((mColourAdj[i+1].b * particle_time) + (mColourAdj[i].b * (1.0f - particle_time)));
+                        colour.a = ((mColourAdj[i+1].a * particle_time) + (mColourAdj[i].a * (1.0f - particle_time)));
+                        break;
+                    }
+                }
+            }
+
+            batch.colourR[p] = colour.r;
+            batch.colourG[p] = colour.g;
+            batch.colourB[p] = colour.b;
+            batch.colourA[p] = colour.a;
+        }
+    }
     
     //-----------------------------------------------------------------------
     void ColourInterpolatorAffector::setColourAdjust(size_t index, ColourValue colour)
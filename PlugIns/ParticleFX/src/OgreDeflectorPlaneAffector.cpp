@@ -92,6 +92,48 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void DeflectorPlaneAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        // precalculate distance of plane from origin
+        const Real planeDistance = - mPlaneNormal.dotProduct(mPlanePoint) / Math::Sqrt(mPlaneNormal.dotProduct(mPlaneNormal));
+        const Real nx = mPlaneNormal.x, ny = mPlaneNormal.y, nz = mPlaneNormal.z;
+
+        for (size_t i = 0; i < batch.count; ++i)
+        {
+            // Cheap rejection of the particles staying in front of the plane,
+            // working on the arrays directly
+            const Real dx = batch.directionX[i] * timeElapsed;
+            const Real dy = batch.directionY[i] * timeElapsed;
+            const Real dz = batch.directionZ[i] * timeElapsed;
+            const Real px = batch.positionX[i], py = batch.positionY[i], pz = batch.positionZ[i];
+            if (nx * (px + dx) + ny * (py + dy) + nz * (pz + dz) + planeDistance > 0.0)
+                continue;
+
+            Real a = nx * px + ny * py + nz * pz + planeDistance;
+            if (a > 0.0)
+            {
+                Vector3 position(px, py, pz);
+                Vector3 direction(dx, dy, dz);
+                Vector3 velocity(batch.directionX[i], batch.directionY[i], batch.directionZ[i]);
+
+                // for intersection point
+                Vector3 directionPart = direction * (- a / direction.dotProduct( mPlaneNormal ));
+                // set new position
+                position = (position + ( directionPart )) + (((directionPart) - direction) * mBounce);
+
+                // reflect direction vector
+                velocity = (velocity - (2.0f * velocity.dotProduct( mPlaneNormal ) * mPlaneNormal)) * mBounce;
+
+                batch.positionX[i] = position.x;
+                batch.positionY[i] = position.y;
+                batch.positionZ[i] = position.z;
+                batch.directionX[i] = velocity.x;
+                batch.directionY[i] = velocity.y;
+                batch.directionZ[i] = velocity.z;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
     void DeflectorPlaneAffector::setPlanePoint(const Vector3& pos)
     {
         mPlanePoint = pos;
@@ -98,6 +98,39 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void DirectionRandomiserAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        // Draws the random numbers in the same order as _affectParticles
+        for (size_t i = 0; i < batch.count; ++i)
+        {
+            if (mScope > Math::UnitRandom())
+            {
+                Vector3 direction(batch.directionX[i], batch.directionY[i], batch.directionZ[i]);
+                if (!direction.isZeroLength())
+                {
+                    Real length = 0;
+                    if (mKeepVelocity)
+                    {
+                        length = direction.length();
+                    }
+
+                    direction += Vector3(Math::RangeRandom(-mRandomness, mRandomness) * timeElapsed,
+                        Math::RangeRandom(-mRandomness, mRandomness) * timeElapsed,
+                        Math::RangeRandom(-mRandomness, mRandomness) * timeElapsed);
+
+                    if (mKeepVelocity)
+                    {
+                        direction *= length / direction.length();
+                    }
+
+                    batch.directionX[i] = direction.x;
+                    batch.directionY[i] = direction.y;
+                    batch.directionZ[i] = direction.z;
+                }
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
     void DirectionRandomiserAffector::setRandomness(Real force)
     {
         mRandomness = force;
@@ -95,6 +95,30 @@ namespace Ogre {
         
     }
     //-----------------------------------------------------------------------
+    void LinearForceAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        Real* dirs[3] = { batch.directionX, batch.directionY, batch.directionZ };
+
+        // One loop per component, so each only touches a single array
+        for (int c = 0; c < 3; ++c)
+        {
+            Real* dir = dirs[c];
+            if (mForceApplication == FA_ADD)
+            {
+                // Scale force by time
+                const Real scaled = mForceVector[c] * timeElapsed;
+                for (size_t i = 0; i < batch.count; ++i)
+                    dir[i] += scaled;
+            }
+            else // FA_AVERAGE
+            {
+                const Real force = mForceVector[c];
+                for (size_t i = 0; i < batch.count; ++i)
+                    dir[i] = (dir[i] + force) / 2;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
     void LinearForceAffector::setForceVector(const Vector3& force)
     {
         mForceVector = force;
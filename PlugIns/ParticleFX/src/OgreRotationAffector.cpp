@@ -107,6 +107,23 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void RotationAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        Real* rotation = batch.rotation;
+        const Real* rotationSpeed = batch.rotationSpeed;
+        bool rotated = false;
+
+        for (size_t i = 0; i < batch.count; ++i)
+        {
+            rotation[i] += timeElapsed * rotationSpeed[i];
+            rotated |= rotation[i] != 0;
+        }
+
+        // Particle::setRotation would have done this for each rotated particle
+        if (rotated)
+            pSystem->_notifyParticleRotated();
+    }
+    //-----------------------------------------------------------------------
     const Radian& RotationAffector::getRotationSpeedRangeStart(void) const
     {
         return mRotationSpeedRangeStart;
@@ -85,6 +85,32 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void ScaleAffector::_affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        if (!batch.count)
+            return;
+
+        // Scale adjustments by time
+        const Real ds = mScaleAdj * timeElapsed;
+        const Real defaultWidth = pSystem->getDefaultWidth();
+        const Real defaultHeight = pSystem->getDefaultHeight();
+
+        for (size_t i = 0; i < batch.count; ++i)
+        {
+            if (!batch.ownDimensions[i])
+            {
+                batch.width[i] = defaultWidth;
+                batch.height[i] = defaultHeight;
+                batch.ownDimensions[i] = 1;
+            }
+            batch.width[i] += ds;
+            batch.height[i] += ds;
+        }
+
+        // Particle::setDimensions would have done this for each particle
+        pSystem->_notifyParticleResized();
+    }
+    //-----------------------------------------------------------------------
     void ScaleAffector::setAdjust( Real rate )
     {
         mScaleAdj = rate;
@@ -0,0 +1,123 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __Benchmark_H__
+#define __Benchmark_H__
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <ostream>
+#include <string>
+
+#include "OgreTimer.h"
+
+/** Timings of one benchmark, as written to the JSON report.
+*/
+struct BenchmarkResult
+{
+    std::string name;
+    /// Number of timed runs of the benchmark body
+    size_t iterations;
+    /// Mean wall clock time of a run and the one of the fastest batch, in nanoseconds
+    double meanTime;
+    double minTime;
+    /// Items processed per second by the mean run, 0 if not applicable
+    double itemsPerSecond;
+    /// Any additional values, like the number of threads used
+    std::map<std::string, double> counters;
+};
+
+/** Runs benchmark bodies and collects their results.
+@remarks
+    The benchmarks are gtest tests, so they can use the usual fixtures and be
+    selected with --gtest_filter. Each of them calls run for every measurement,
+    the results are reported by the benchmark main once all tests are done.
+*/
+class Benchmark
+{
+public:
+    /** Times body, which must be a functor taking no arguments.
+    @remarks
+        The body is run once to warm up, then in batches long enough for the
+        timer resolution, until at least the minimum time has passed and at
+        least three batches were timed.
+    @param name Unique name of the measurement, e.g. "RadixSort/float/100000".
+    @param body The code to time.
+    @param itemsPerRun Number of items one run of body processes, to report the throughput.
+    @return The recorded result, so that counters can be added.
+    */
+    template<typename Body>
+    static BenchmarkResult& run(const std::string& name, Body& body, size_t itemsPerRun = 0)
+    {
+        body();
+
+        Ogre::Timer timer;
+        size_t runsPerBatch = 1;
+        for (;;)
+        {
+            timer.reset();
+            for (size_t i = 0; i < runsPerBatch; ++i)
+                body();
+            if (timer.getMicroseconds() >= 1000)
+                break;
+            runsPerBatch *= 2;
+        }
+
+        unsigned long total = 0, fastest = ~0ul;
+        size_t batches = 0;
+        while (batches < 3 || total < sMinTime)
+        {
+            timer.reset();
+            for (size_t i = 0; i < runsPerBatch; ++i)
+                body();
+            unsigned long elapsed = timer.getMicroseconds();
+            total += elapsed;
+            fastest = std::min(fastest, elapsed);
+            ++batches;
+        }
+        return addResult(name, batches, runsPerBatch, total, fastest, itemsPerRun);
+    }
+
+    /// Sets the minimum time each measurement is repeated for, in microseconds
+    static void setMinTime(unsigned long microseconds) { sMinTime = microseconds; }
+
+    /// Writes all results recorded so far as a JSON document
+    static void writeJson(std::ostream& os);
+
+private:
+    static BenchmarkResult& addResult(const std::string& name, size_t batches, size_t runsPerBatch,
+                                      unsigned long total, unsigned long fastest, size_t itemsPerRun);
+
+    static unsigned long sMinTime;
+    static std::deque<BenchmarkResult> sResults;
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgrePlatformInformation.h"
+#include "OgreStringConverter.h"
+#include "Threading/OgreThreadHeaders.h"
+
+#include <cstdio>
+
+using namespace Ogre;
+
+unsigned long Benchmark::sMinTime = 500000;
+std::deque<BenchmarkResult> Benchmark::sResults;
+
+//--------------------------------------------------------------------------
+BenchmarkResult& Benchmark::addResult(const std::string& name, size_t batches, size_t runsPerBatch,
+                                      unsigned long total, unsigned long fastest, size_t itemsPerRun)
+{
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = batches * runsPerBatch;
+    result.meanTime = 1000.0 * total / result.iterations;
+    result.minTime = 1000.0 * fastest / runsPerBatch;
+    result.itemsPerSecond = itemsPerRun ? 1e9 * itemsPerRun / result.meanTime : 0;
+    sResults.push_back(result);
+    return sResults.back();
+}
+//--------------------------------------------------------------------------
+static std::string quoted(const std::string& str)
+{
+    std::string ret = "\"";
+    for (size_t i = 0; i < str.size(); ++i)
+    {
+        char c = str[i];
+        if (c == '"' || c == '\\')
+        {
+            ret += '\\';
+            ret += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            ret += escaped;
+        }
+        else
+        {
+            ret += c;
+        }
+    }
+    return ret + "\"";
+}
+//--------------------------------------------------------------------------
+static std::string number(double value)
+{
+    char str[32];
+    snprintf(str, sizeof(str), "%.6g", value);
+    return str;
+}
+//--------------------------------------------------------------------------
+void Benchmark::writeJson(std::ostream& os)
+{
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"ogre_version\": " << quoted(StringConverter::toString(OGRE_VERSION_MAJOR) + "." +
+                                             StringConverter::toString(OGRE_VERSION_MINOR) + "." +
+                                             StringConverter::toString(OGRE_VERSION_PATCH) +
+                                             OGRE_VERSION_SUFFIX) << ",\n";
+    os << "    \"debug_build\": " << (OGRE_DEBUG_MODE ? "true" : "false") << ",\n";
+    os << "    \"cpu\": " << quoted(PlatformInformation::getCpuIdentifier()) << ",\n";
+    os << "    \"cpu_features\": " << PlatformInformation::getCpuFeatures() << ",\n";
+    os << "    \"hardware_concurrency\": " << OGRE_THREAD_HARDWARE_CONCURRENCY << "\n";
+    os << "  },\n";
+    os << "  \"benchmarks\": [";
+    for (size_t i = 0; i < sResults.size(); ++i)
+    {
+        const BenchmarkResult& result = sResults[i];
+        os << (i ? ",\n" : "\n") << "    {\n";
+        os << "      \"name\": " << quoted(result.name) << ",\n";
+        os << "      \"iterations\": " << result.iterations << ",\n";
+        os << "      \"mean_time_ns\": " << number(result.meanTime) << ",\n";
+        os << "      \"min_time_ns\": " << number(result.minTime);
+        if (result.itemsPerSecond)
+            os << ",\n      \"items_per_second\": " << number(result.itemsPerSecond);
+        for (std::map<std::string, double>::const_iterator it = result.counters.begin();
+             it != result.counters.end(); ++it)
+        {
+            os << ",\n      " << quoted(it->first) << ": " << number(it->second);
+        }
+        os << "\n    }";
+    }
+    os << "\n  ]\n}\n";
+}
@@ -0,0 +1,894 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include "OgreRoot.h"
+#include "OgreRadixSort.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreAnimationState.h"
+#include "OgrePixelFormat.h"
+#include "OgreMeshManager.h"
+#include "OgreMeshSerializer.h"
+#include "OgreScriptCompiler.h"
+#include "OgreStringConverter.h"
+#include "OgreWorkQueue.h"
+#include "OgreDataStream.h"
+#include "OgreEdgeListBuilder.h"
+#include "OgreParticleSystem.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreParticleAffector.h"
+#include "OgreParticleAffectorFactory.h"
+#include "OgreParticle.h"
+#include "OgreBillboardSet.h"
+#include "OgreBillboard.h"
+#include "OgreCamera.h"
+#include "OgreControllerManager.h"
+#include "OgreStaticGeometry.h"
+#include "Threading/OgreThreadHeaders.h"
+
+#include <fstream>
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#include <random>
+using std::minstd_rand;
+#else
+#include <tr1/random>
+using std::tr1::minstd_rand;
+#endif
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture OgreMainBenchmark;
+
+//--------------------------------------------------------------------------
+struct FloatSortFunctor
+{
+    float operator()(const float& p) const { return p; }
+};
+struct UIntSortFunctor
+{
+    uint32 operator()(const uint32& p) const { return p; }
+};
+
+template<typename T, typename Functor>
+struct RadixSortBody
+{
+    const std::vector<T>* source;
+    std::vector<T> container;
+    RadixSort<std::vector<T>, T, T> sorter;
+
+    void operator()()
+    {
+        container = *source;
+        sorter.sort(container, Functor());
+    }
+};
+
+TEST_F(OgreMainBenchmark, RadixSort)
+{
+    const size_t count = 100000;
+    minstd_rand rng;
+
+    std::vector<float> floats(count);
+    std::vector<uint32> uints(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        floats[i] = float(rng()) / rng.max() * 2000.0f - 1000.0f;
+        uints[i] = uint32(rng());
+    }
+
+    RadixSortBody<float, FloatSortFunctor> sortFloats;
+    sortFloats.source = &floats;
+    Benchmark::run("RadixSort/float/100000", sortFloats, count);
+
+    RadixSortBody<uint32, UIntSortFunctor> sortUInts;
+    sortUInts.source = &uints;
+    Benchmark::run("RadixSort/uint32/100000", sortUInts, count);
+}
+
+//--------------------------------------------------------------------------
+struct SkinningBody
+{
+    std::vector<float> src, dest;
+    std::vector<const Affine3*> matrices;
+    size_t numVertices;
+
+    void operator()()
+    {
+        // interleaved position, normal, 4 weights and 4 indices like most meshes
+        const size_t stride = 11 * sizeof(float);
+        OptimisedUtil::getImplementation()->softwareVertexSkinning(
+            &src[0], &dest[0], &src[3], &dest[3], &src[6],
+            reinterpret_cast<const unsigned char*>(&src[10]), &matrices[0],
+            stride, 6 * sizeof(float), stride, 6 * sizeof(float), stride, stride,
+            4, numVertices);
+    }
+};
+
+struct ConcatenateBody
+{
+    Affine3 base;
+    std::vector<Affine3> src, dest;
+
+    void operator()()
+    {
+        OptimisedUtil::getImplementation()->concatenateAffineMatrices(
+            base, &src[0], &dest[0], src.size());
+    }
+};
+
+struct FaceNormalsBody
+{
+    std::vector<float> positions;
+    std::vector<EdgeData::Triangle> triangles;
+    std::vector<Vector4> normals;
+    std::vector<char> lightFacings;
+
+    void operator()()
+    {
+        OptimisedUtil::getImplementation()->calculateFaceNormals(
+            &positions[0], &triangles[0], &normals[0], triangles.size());
+        OptimisedUtil::getImplementation()->calculateLightFacing(
+            Vector4(100, 200, 300, 1), &normals[0], &lightFacings[0], triangles.size());
+    }
+};
+
+struct ExtrudeBody
+{
+    std::vector<float> positions;
+
+    void operator()()
+    {
+        size_t numVertices = positions.size() / 6;
+        OptimisedUtil::getImplementation()->extrudeVertices(
+            Vector4(100, 200, 300, 1), 1000, &positions[0], &positions[numVertices * 3], numVertices);
+    }
+};
+
+struct CullSpheresBody
+{
+    std::vector<float> planes;
+    std::vector<float> spheres;
+    std::vector<uint32> visible;
+
+    void operator()()
+    {
+        OptimisedUtil::getImplementation()->cullSpheres(
+            &planes[0], planes.size() / 4, &spheres[0], &visible[0], visible.size());
+    }
+};
+
+TEST_F(OgreMainBenchmark, OptimisedUtil)
+{
+    const size_t count = 10000;
+    minstd_rand rng;
+
+    SkinningBody skinning;
+    skinning.numVertices = count;
+    std::vector<Affine3> bones(64);
+    for (size_t i = 0; i < bones.size(); ++i)
+    {
+        bones[i].makeTransform(Vector3(float(i), 1, 2), Vector3::UNIT_SCALE,
+                               Quaternion(Radian(0.1f * i), Vector3::UNIT_Y));
+        skinning.matrices.push_back(&bones[i]);
+    }
+    skinning.src.resize(count * 11);
+    skinning.dest.resize(count * 6);
+    for (size_t v = 0; v < count; ++v)
+    {
+        float* vert = &skinning.src[v * 11];
+        for (int i = 0; i < 6; ++i)
+            vert[i] = float(rng()) / rng.max();
+        for (int i = 0; i < 4; ++i)
+            vert[6 + i] = 0.25f;
+        unsigned char* indices = reinterpret_cast<unsigned char*>(vert + 10);
+        for (int i = 0; i < 4; ++i)
+            indices[i] = (unsigned char)(rng() % bones.size());
+    }
+    Benchmark::run("OptimisedUtil/softwareVertexSkinning/10000", skinning, count);
+
+    ConcatenateBody concatenate;
+    concatenate.base.makeTransform(Vector3(1, 2, 3), Vector3(2, 2, 2), Quaternion::IDENTITY);
+    concatenate.src = bones;
+    concatenate.dest.resize(bones.size());
+    Benchmark::run("OptimisedUtil/concatenateAffineMatrices/64", concatenate, bones.size());
+
+    FaceNormalsBody faceNormals;
+    for (size_t i = 0; i < count * 3; ++i)
+        faceNormals.positions.push_back(float(rng()) / rng.max() * 100);
+    faceNormals.triangles.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+            faceNormals.triangles[i].vertIndex[j] = rng() % count;
+    }
+    faceNormals.normals.resize(count);
+    faceNormals.lightFacings.resize(count);
+    Benchmark::run("OptimisedUtil/calculateFaceNormals+LightFacing/10000", faceNormals, count);
+
+    ExtrudeBody extrude;
+    extrude.positions.resize(count * 6);
+    for (size_t i = 0; i < count * 3; ++i)
+        extrude.positions[i] = float(rng()) / rng.max() * 100;
+    Benchmark::run("OptimisedUtil/extrudeVertices/10000", extrude, count);
+
+    CullSpheresBody cullSpheres;
+    Frustum frustum;
+    frustum.setFarClipDistance(100);
+    for (int p = 0; p < 6; ++p)
+    {
+        const Plane& plane = frustum.getFrustumPlanes()[p];
+        cullSpheres.planes.push_back(plane.normal.x);
+        cullSpheres.planes.push_back(plane.normal.y);
+        cullSpheres.planes.push_back(plane.normal.z);
+        cullSpheres.planes.push_back(plane.d);
+    }
+    for (size_t i = 0; i < count * 4; ++i)
+        cullSpheres.spheres.push_back(i % 4 == 3 ? 2.0f : float(rng()) / rng.max() * 200 - 100);
+    cullSpheres.visible.resize(count);
+    Benchmark::run("OptimisedUtil/cullSpheres/10000", cullSpheres, count);
+}
+
+//--------------------------------------------------------------------------
+static void createHierarchy(SceneNode* node, int depth)
+{
+    if (!depth)
+        return;
+    for (int i = 0; i < 10; ++i)
+    {
+        SceneNode* child = node->createChildSceneNode(Vector3(float(i), 0, 1),
+                                                      Quaternion(Degree(10.0f * i), Vector3::UNIT_Y));
+        createHierarchy(child, depth - 1);
+    }
+}
+
+struct NodeUpdateBody
+{
+    SceneNode* root;
+
+    void operator()()
+    {
+        root->translate(Vector3(0, 0, 1));
+        root->_update(true, false);
+    }
+};
+
+TEST_F(OgreMainBenchmark, NodeUpdate)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+
+    NodeUpdateBody update;
+    update.root = sm->getRootSceneNode()->createChildSceneNode();
+    createHierarchy(update.root, 4);
+    Benchmark::run("Node/_update/11111", update, 11111);
+
+    mRoot->destroySceneManager(sm);
+}
+
+//--------------------------------------------------------------------------
+struct PixelConversionBody
+{
+    PixelBox src, dst;
+
+    void operator()()
+    {
+        PixelUtil::bulkPixelConversion(src, dst);
+    }
+};
+
+TEST_F(OgreMainBenchmark, BulkPixelConversion)
+{
+    const uint32 size = 1024;
+    std::vector<uint8> rgba8(size * size * 4), otherRgba8(size * size * 4);
+    std::vector<float> float32(size * size * 4);
+    std::vector<uint16> float16(size * size * 4);
+    for (size_t i = 0; i < rgba8.size(); ++i)
+        rgba8[i] = uint8(i * 7);
+
+    PixelConversionBody convert;
+    convert.src = PixelBox(size, size, 1, PF_A8R8G8B8, &rgba8[0]);
+    convert.dst = PixelBox(size, size, 1, PF_A8B8G8R8, &otherRgba8[0]);
+    Benchmark::run("PixelUtil/bulkPixelConversion/A8R8G8B8-A8B8G8R8/1024x1024", convert, size * size);
+
+    convert.dst = PixelBox(size, size, 1, PF_FLOAT32_RGBA, &float32[0]);
+    Benchmark::run("PixelUtil/bulkPixelConversion/A8R8G8B8-FLOAT32_RGBA/1024x1024", convert, size * size);
+
+    convert.src = convert.dst;
+    convert.dst = PixelBox(size, size, 1, PF_FLOAT16_RGBA, &float16[0]);
+    Benchmark::run("PixelUtil/bulkPixelConversion/FLOAT32_RGBA-FLOAT16_RGBA/1024x1024", convert, size * size);
+
+    convert.dst = PixelBox(size, size, 1, PF_R8G8B8, &rgba8[0]);
+    Benchmark::run("PixelUtil/bulkPixelConversion/FLOAT32_RGBA-R8G8B8/1024x1024", convert, size * size);
+}
+
+//--------------------------------------------------------------------------
+struct MeshImportBody
+{
+    DataStreamPtr stream;
+    MeshSerializer serializer;
+
+    void operator()()
+    {
+        stream->seek(0);
+        MeshPtr mesh = MeshManager::getSingleton().createManual(
+            "MeshImportBenchmark", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        serializer.importMesh(stream, mesh.get());
+        MeshManager::getSingleton().remove(mesh);
+    }
+};
+
+TEST_F(OgreMainBenchmark, MeshSerializerImport)
+{
+    MeshImportBody import;
+    DataStreamPtr file = ResourceGroupManager::getSingleton().openResource("ogrehead.mesh");
+    import.stream.reset(OGRE_NEW MemoryDataStream(file));
+    Benchmark::run("MeshSerializer/importMesh/ogrehead.mesh", import, import.stream->size());
+}
+
+//--------------------------------------------------------------------------
+struct ScriptParseBody
+{
+    String script;
+    ScriptCompiler compiler;
+
+    void operator()()
+    {
+        compiler._generateAST(script, "Examples.material");
+    }
+};
+
+TEST_F(OgreMainBenchmark, ScriptCompilerParse)
+{
+    ScriptParseBody parse;
+    parse.script = ResourceGroupManager::getSingleton().openResource("Examples.material")->getAsString();
+    Benchmark::run("ScriptCompiler/_generateAST/Examples.material", parse, parse.script.size());
+}
+
+//--------------------------------------------------------------------------
+struct ToStringBody
+{
+    std::vector<Real> values;
+    StringVector strings;
+
+    void operator()()
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+            strings[i] = StringConverter::toString(values[i]);
+    }
+};
+
+struct ParseRealBody
+{
+    StringVector strings;
+    Real sum;
+
+    void operator()()
+    {
+        for (size_t i = 0; i < strings.size(); ++i)
+            sum += StringConverter::parseReal(strings[i]);
+    }
+};
+
+struct ParseVector3Body
+{
+    StringVector strings;
+    Vector3 sum;
+
+    void operator()()
+    {
+        for (size_t i = 0; i < strings.size(); ++i)
+            sum += StringConverter::parseVector3(strings[i]);
+    }
+};
+
+TEST_F(OgreMainBenchmark, StringConverter)
+{
+    const size_t count = 10000;
+    minstd_rand rng;
+
+    ToStringBody toString;
+    for (size_t i = 0; i < count; ++i)
+        toString.values.push_back(float(rng()) / rng.max() * 2000.0f - 1000.0f);
+    toString.strings.resize(count);
+    Benchmark::run("StringConverter/toString(Real)/10000", toString, count);
+
+    ParseRealBody parseReal;
+    parseReal.strings = toString.strings;
+    parseReal.sum = 0;
+    Benchmark::run("StringConverter/parseReal/10000", parseReal, count);
+
+    ParseVector3Body parseVector3;
+    for (size_t i = 0; i + 2 < count; i += 3)
+        parseVector3.strings.push_back(toString.strings[i] + " " + toString.strings[i + 1] + " " +
+                                       toString.strings[i + 2]);
+    parseVector3.sum = Vector3::ZERO;
+    Benchmark::run("StringConverter/parseVector3/3333", parseVector3, parseVector3.strings.size());
+}
+
+//--------------------------------------------------------------------------
+struct AnimationUpdateBody
+{
+    vector<Entity*>::type entities;
+
+    void operator()()
+    {
+        for (size_t i = 0; i < entities.size(); ++i)
+            entities[i]->getAnimationState("Walk")->addTime(0.01f);
+        Entity::_updateAnimations(entities);
+    }
+};
+
+TEST_F(OgreMainBenchmark, SoftwareSkinningScaling)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+
+    AnimationUpdateBody update;
+    for (int i = 0; i < 256; ++i)
+    {
+        Entity* ent = sm->createEntity("robot.mesh");
+        ent->addSoftwareAnimationRequest(true);
+        ent->getAnimationState("Walk")->setEnabled(true);
+        update.entities.push_back(ent);
+    }
+
+    // the calling thread takes part in the work, so use one worker less than cores
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+    size_t maxThreads = std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double singleThreadTime = 0;
+    for (size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        size_t threads = threadCounts[t];
+        wq->shutdown();
+        wq->setWorkerThreadCount(threads - 1);
+        wq->startup();
+
+        BenchmarkResult& result = Benchmark::run(
+            "Entity/_updateAnimations/robot.mesh/256/threads:" + StringConverter::toString(threads),
+            update, update.entities.size());
+        if (threads == 1)
+            singleThreadTime = result.meanTime;
+        result.counters["threads"] = double(threads);
+        result.counters["speedup"] = singleThreadTime / result.meanTime;
+    }
+
+    mRoot->destroySceneManager(sm);
+}
+
+//--------------------------------------------------------------------------
+/// Same as the ParticleFX linear force affector, which isn't available here
+class ForceAffector : public ParticleAffector
+{
+public:
+    ForceAffector(ParticleSystem* parent) : ParticleAffector(parent) { mType = "BenchmarkForce"; }
+
+    void _affectParticles(ParticleSystem* pSystem, Real timeElapsed)
+    {
+        Vector3 scaledVector = Vector3(0, -9.81f, 0) * timeElapsed;
+        ParticleIterator pi = pSystem->_getIterator();
+        while (!pi.end())
+            pi.getNext()->mDirection += scaledVector;
+    }
+
+    void _affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+    {
+        const Real scaled = -9.81f * timeElapsed;
+        for (size_t i = 0; i < batch.count; ++i)
+            batch.directionY[i] += scaled;
+    }
+};
+
+class ForceAffectorFactory : public ParticleAffectorFactory
+{
+public:
+    String getName() const { return "BenchmarkForce"; }
+
+    ParticleAffector* createAffector(ParticleSystem* psys)
+    {
+        ParticleAffector* affector = OGRE_NEW ForceAffector(psys);
+        mAffectors.push_back(affector);
+        return affector;
+    }
+};
+
+struct ParticleUpdateBody
+{
+    ParticleSystem* system;
+    bool visible;
+
+    void operator()()
+    {
+        system->_update(0.001f);
+        // what rendering the system does on top of the update
+        if (visible)
+            system->_syncParticleInstances();
+    }
+};
+
+TEST_F(OgreMainBenchmark, ParticleSystemUpdate)
+{
+    // normally done by Root::initialise
+    ParticleSystemManager::getSingleton()._initialise();
+    ControllerManager* controllerMgr = OGRE_NEW ControllerManager();
+    ForceAffectorFactory factory;
+    ParticleSystemManager::getSingleton().addAffectorFactory(&factory);
+
+    SceneManager* sm = mRoot->createSceneManager();
+
+    const size_t count = 100000;
+    minstd_rand rng;
+    for (int soa = 0; soa < 2; ++soa)
+    {
+        ParticleSystem* system = sm->createParticleSystem(
+            "Particles" + StringConverter::toString(soa), count);
+        system->setSoAStorageEnabled(soa != 0);
+        system->addAffector("BenchmarkForce");
+        sm->getRootSceneNode()->attachObject(system);
+
+        // fill the pool, the particles live for the whole run
+        system->_update(0);
+        while (Particle* p = system->createParticle())
+        {
+            p->mPosition = Vector3(Real(rng() % 1000), Real(rng() % 1000), Real(rng() % 1000));
+            p->mDirection = Vector3(Real(rng() % 20), Real(rng() % 20), Real(rng() % 20));
+            p->mTimeToLive = p->mTotalTimeToLive = 1e6f;
+        }
+
+        ParticleUpdateBody update;
+        update.system = system;
+        update.visible = false;
+        Benchmark::run(String("ParticleSystem/_update/") + (soa ? "soa" : "list") + "/100000",
+            update, count);
+        if (soa)
+        {
+            update.visible = true;
+            Benchmark::run("ParticleSystem/_update/soa/visible/100000", update, count);
+        }
+    }
+
+    sm->destroyAllParticleSystems();
+    mRoot->destroySceneManager(sm);
+    OGRE_DELETE controllerMgr;
+}
+
+struct ParticleManagerUpdateBody
+{
+    std::vector<ParticleSystem*> systems;
+
+    void operator()()
+    {
+        // what the controllers do every frame in parallel mode
+        ParticleSystemManager& mgr = ParticleSystemManager::getSingleton();
+        for (size_t i = 0; i < systems.size(); ++i)
+            mgr._queueUpdate(systems[i], 0.001f);
+        mgr._updateQueuedSystems();
+    }
+};
+
+TEST_F(OgreMainBenchmark, ParticleSystemManagerParallelUpdate)
+{
+    // normally done by Root::initialise
+    ParticleSystemManager::getSingleton()._initialise();
+    ControllerManager* controllerMgr = OGRE_NEW ControllerManager();
+    ForceAffectorFactory factory;
+    ParticleSystemManager::getSingleton().addAffectorFactory(&factory);
+    ParticleSystemManager::getSingleton().setParallelUpdatesEnabled(true);
+
+    SceneManager* sm = mRoot->createSceneManager();
+
+    const size_t systemCount = 64;
+    const size_t count = 4000;
+    minstd_rand rng;
+    ParticleManagerUpdateBody update;
+    for (size_t s = 0; s < systemCount; ++s)
+    {
+        ParticleSystem* system = sm->createParticleSystem(
+            "Particles" + StringConverter::toString(s), count);
+        system->addAffector("BenchmarkForce");
+        sm->getRootSceneNode()->createChildSceneNode()->attachObject(system);
+
+        system->_update(0);
+        while (Particle* p = system->createParticle())
+        {
+            p->mPosition = Vector3(Real(rng() % 1000), Real(rng() % 1000), Real(rng() % 1000));
+            p->mDirection = Vector3(Real(rng() % 20), Real(rng() % 20), Real(rng() % 20));
+            p->mTimeToLive = p->mTotalTimeToLive = 1e6f;
+        }
+        update.systems.push_back(system);
+    }
+
+    // the calling thread takes part in the work, so use one worker less than cores
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+    size_t maxThreads = std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double singleThreadTime = 0;
+    for (size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        size_t threads = threadCounts[t];
+        wq->shutdown();
+        wq->setWorkerThreadCount(threads - 1);
+        wq->startup();
+
+        BenchmarkResult& result = Benchmark::run(
+            "ParticleSystemManager/_updateQueuedSystems/64x4000/threads:" +
+            StringConverter::toString(threads), update, systemCount * count);
+        if (threads == 1)
+            singleThreadTime = result.meanTime;
+        result.counters["threads"] = double(threads);
+        result.counters["speedup"] = singleThreadTime / result.meanTime;
+    }
+
+    ParticleSystemManager::getSingleton().setParallelUpdatesEnabled(false);
+    sm->destroyAllParticleSystems();
+    mRoot->destroySceneManager(sm);
+    OGRE_DELETE controllerMgr;
+}
+
+//--------------------------------------------------------------------------
+struct BillboardInjectBody
+{
+    BillboardSet* set;
+    Camera* camera;
+    std::vector<const Billboard*> billboards;
+
+    void operator()()
+    {
+        // what _updateRenderQueue does when the billboards have changed
+        set->_notifyCurrentCamera(camera);
+        set->beginBillboards(billboards.size());
+        set->injectBillboards(&billboards[0], billboards.size());
+        set->endBillboards();
+    }
+};
+
+TEST_F(OgreMainBenchmark, BillboardSetInjectBillboards)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+
+    const unsigned int count = 100000;
+    minstd_rand rng;
+    BillboardInjectBody inject;
+    inject.camera = sm->createCamera("Camera");
+    sm->getRootSceneNode()->attachObject(inject.camera);
+    inject.set = sm->createBillboardSet(count);
+    sm->getRootSceneNode()->attachObject(inject.set);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        inject.billboards.push_back(inject.set->createBillboard(
+            Vector3(Real(rng() % 1000), Real(rng() % 1000), -Real(rng() % 1000)),
+            ColourValue(Real(rng() % 256) / 255, 1, 1)));
+    }
+
+    // the calling thread takes part in the work, so use one worker less than cores
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+    size_t maxThreads = std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double singleThreadTime = 0;
+    for (size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        size_t threads = threadCounts[t];
+        wq->shutdown();
+        wq->setWorkerThreadCount(threads - 1);
+        wq->startup();
+
+        BenchmarkResult& result = Benchmark::run(
+            "BillboardSet/injectBillboards/100000/threads:" + StringConverter::toString(threads),
+            inject, count);
+        if (threads == 1)
+            singleThreadTime = result.meanTime;
+        result.counters["threads"] = double(threads);
+        result.counters["speedup"] = singleThreadTime / result.meanTime;
+    }
+
+    mRoot->destroySceneManager(sm);
+}
+
+//--------------------------------------------------------------------------
+struct ScriptGroupBody
+{
+    void operator()()
+    {
+        ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+        rgm.addResourceLocation("./", "FileSystem", "BenchmarkScripts");
+        rgm.initialiseResourceGroup("BenchmarkScripts");
+        rgm.destroyResourceGroup("BenchmarkScripts");
+    }
+};
+
+TEST_F(OgreMainBenchmark, ParallelScriptParsing)
+{
+    // the sample scripts need a render system for their programs, so make up some
+    const int scriptCount = 64;
+    const int materialCount = 100;
+    for (int i = 0; i < scriptCount; ++i)
+    {
+        std::ofstream script(("BenchmarkScript" + StringConverter::toString(i) + ".material").c_str());
+        script << "abstract pass Base\n{\n    ambient 0.5 0.5 0.5\n    diffuse 1 1 1\n}\n";
+        for (int m = 0; m < materialCount; ++m)
+        {
+            script << "material BenchmarkScript" << i << "_" << m << "\n{\n"
+                   << "    technique\n    {\n"
+                   << "        pass : Base\n        {\n"
+                   << "            specular 1 1 1 " << m << "\n"
+                   << "            scene_blend alpha_blend\n"
+                   << "            depth_write off\n"
+                   << "        }\n    }\n}\n";
+        }
+    }
+
+    ScriptGroupBody parse;
+    ResourceGroupManager::getSingleton().setParallelScriptParsingEnabled(true);
+
+    // the calling thread takes part in the work, so use one worker less than cores
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+    size_t maxThreads = std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double singleThreadTime = 0;
+    for (size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        size_t threads = threadCounts[t];
+        wq->shutdown();
+        wq->setWorkerThreadCount(threads - 1);
+        wq->startup();
+
+        BenchmarkResult& result = Benchmark::run(
+            "ResourceGroupManager/initialiseResourceGroup/64x100/threads:" +
+            StringConverter::toString(threads), parse, scriptCount * materialCount);
+        if (threads == 1)
+            singleThreadTime = result.meanTime;
+        result.counters["threads"] = double(threads);
+        result.counters["speedup"] = singleThreadTime / result.meanTime;
+    }
+
+    ResourceGroupManager::getSingleton().setParallelScriptParsingEnabled(false);
+    for (int i = 0; i < scriptCount; ++i)
+        std::remove(("BenchmarkScript" + StringConverter::toString(i) + ".material").c_str());
+}
+
+//--------------------------------------------------------------------------
+struct StaticGeometryBuildBody
+{
+    StaticGeometry* sg;
+
+    void operator()() { sg->build(); }
+};
+
+TEST_F(OgreMainBenchmark, StaticGeometryBuild)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Entity* ent = sm->createEntity("cube.mesh");
+    ent->setMaterialName("BaseWhite");
+
+    // a forest of 20000 cubes over 10x10 regions
+    const int side = 141;
+    StaticGeometry* sg = sm->createStaticGeometry("Forest");
+    sg->setRegionDimensions(Vector3(side * 30 / 10));
+    for (int i = 0; i < side * side; ++i)
+    {
+        sg->addEntity(ent, Vector3(Real(i % side) * 30, 0, Real(i / side) * 30),
+                      Quaternion(Degree(Real(i % 360)), Vector3::UNIT_Y));
+    }
+    StaticGeometryBuildBody build = {sg};
+
+    // the calling thread takes part in the work, so use one worker less than cores
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+    size_t maxThreads = std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double singleThreadTime = 0;
+    for (size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        size_t threads = threadCounts[t];
+        wq->shutdown();
+        wq->setWorkerThreadCount(threads - 1);
+        wq->startup();
+
+        BenchmarkResult& result = Benchmark::run(
+            "StaticGeometry/build/20000/threads:" + StringConverter::toString(threads),
+            build, side * side);
+        if (threads == 1)
+            singleThreadTime = result.meanTime;
+        result.counters["threads"] = double(threads);
+        result.counters["speedup"] = singleThreadTime / result.meanTime;
+    }
+
+    sm->destroyStaticGeometry(sg);
+    mRoot->destroySceneManager(sm);
+}
+
+//--------------------------------------------------------------------------
+struct EdgeListBuildBody
+{
+    Mesh* mesh;
+
+    void operator()()
+    {
+        mesh->freeEdgeList();
+        mesh->buildEdgeList();
+    }
+};
+
+TEST_F(OgreMainBenchmark, EdgeListBuild)
+{
+    // the largest plane with 16 bit indices, 130050 triangles
+    const int segments = 255;
+    MeshPtr plane = MeshManager::getSingleton().createPlane(
+        "EdgeListPlane", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+        Plane(Vector3::UNIT_Z, 0), 1000, 1000, segments, segments);
+    EdgeListBuildBody build = {plane.get()};
+
+    // the calling thread takes part in the work, so use one worker less than cores
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+    size_t maxThreads = std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double singleThreadTime = 0;
+    for (size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        size_t threads = threadCounts[t];
+        wq->shutdown();
+        wq->setWorkerThreadCount(threads - 1);
+        wq->startup();
+
+        BenchmarkResult& result = Benchmark::run(
+            "EdgeListBuilder/build/255x255/threads:" + StringConverter::toString(threads),
+            build, segments * segments * 2);
+        if (threads == 1)
+            singleThreadTime = result.meanTime;
+        result.counters["threads"] = double(threads);
+        result.counters["speedup"] = singleThreadTime / result.meanTime;
+    }
+
+    MeshManager::getSingleton().remove(plane);
+}
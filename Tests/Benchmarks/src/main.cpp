@@ -0,0 +1,69 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+#include "Benchmark.h"
+
+// Usage: Benchmark_Ogre [gtest options] [--benchmark_out=<file>] [--benchmark_min_time=<seconds>]
+// The results are written as JSON to the given file, OgreBenchmark.json by default.
+int main(int argc, char *argv[])
+{
+    Ogre::LogManager* logMgr = new Ogre::LogManager();
+    logMgr->createLog("OgreBenchmark.log", true, false);
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    const char* outFile = "OgreBenchmark.json";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "--benchmark_out=", 16) == 0)
+            outFile = argv[i] + 16;
+        else if (strncmp(argv[i], "--benchmark_min_time=", 21) == 0)
+            Benchmark::setMinTime(static_cast<unsigned long>(
+                Ogre::StringConverter::parseReal(argv[i] + 21) * 1e6));
+    }
+
+    int ret = RUN_ALL_TESTS();
+
+    std::ofstream os(outFile);
+    Benchmark::writeJson(os);
+    if (!os)
+    {
+        std::cerr << "Could not write " << outFile << std::endl;
+        ret = 1;
+    }
+
+    delete logMgr;
+    return ret;
+}
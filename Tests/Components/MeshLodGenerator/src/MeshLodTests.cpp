@@ -18,6 +18,10 @@
 #include "OgreRenderWindow.h"
 #include "OgreLodConfigSerializer.h"
 #include "OgreWorkQueue.h"
+#include "OgreLodData.h"
+#include "OgreLodCollapseCostCurvature.h"
+#include "OgreLodBatchGenerator.h"
+#include "OgreFileSystemLayer.h"
 
 //--------------------------------------------------------------------------
 void MeshLodTests::SetUp()
@@ -185,3 +189,150 @@ void MeshLodTests::setTestLodConfig(LodConfig& config)
     config.advanced.useBackgroundQueue = false;
 }
 //--------------------------------------------------------------------------
+TEST(LodCollapseCostHeap, Order)
+{
+    srand(0);
+    vector<LodData::Vertex>::type vertices(999);
+    LodData::CollapseCostHeap heap;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        vertices[i].costHeapPosition = LodData::CollapseCostHeap::NOT_IN_HEAP;
+        heap.push(&vertices[i], Math::UnitRandom());
+    }
+    // cheapen, raise and remove some of the costs
+    for (size_t i = 0; i < vertices.size(); i += 3) {
+        heap.update(&vertices[i], heap.getCost(&vertices[i]) * 0.5f);
+        heap.update(&vertices[i + 1], heap.getCost(&vertices[i + 1]) + 0.5f);
+        heap.erase(&vertices[i + 2]);
+        EXPECT_EQ(LodData::CollapseCostHeap::NOT_IN_HEAP, vertices[i + 2].costHeapPosition);
+    }
+    ASSERT_EQ(vertices.size() - vertices.size() / 3, heap.size());
+
+    Real lastCost = 0;
+    while (!heap.empty()) {
+        LodData::CollapseCostHeap::Entry top = heap.top();
+        EXPECT_EQ(0u, top.vertex->costHeapPosition);
+        EXPECT_LE(lastCost, top.cost);
+        lastCost = top.cost;
+        heap.erase(top.vertex);
+    }
+}
+//--------------------------------------------------------------------------
+typedef vector<vector<uint32>::type>::type LodIndexList;
+
+static LodIndexList getLodIndices(const MeshPtr& mesh)
+{
+    LodIndexList ret;
+    for (unsigned short s = 0; s < mesh->getNumSubMeshes(); s++) {
+        const SubMesh::LODFaceList& lods = mesh->getSubMesh(s)->mLodFaceList;
+        for (size_t l = 0; l < lods.size(); l++) {
+            const IndexData* indexData = lods[l];
+            ret.push_back(vector<uint32>::type());
+            if (!indexData->indexBuffer)
+                continue;
+            bool use32 = indexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT;
+            const uchar* data = static_cast<const uchar*>(indexData->indexBuffer->lock(HardwareBuffer::HBL_READ_ONLY));
+            for (size_t i = indexData->indexStart; i < indexData->indexStart + indexData->indexCount; i++)
+                ret.back().push_back(use32 ? reinterpret_cast<const uint32*>(data)[i] : reinterpret_cast<const uint16*>(data)[i]);
+            indexData->indexBuffer->unlock();
+        }
+    }
+    return ret;
+}
+
+TEST_F(RootWithoutRenderSystemFixture, LodParallelCollapseCosts)
+{
+    new MeshLodGenerator;
+    MeshPtr mesh = MeshManager::getSingleton().createCurvedPlane(
+        "LodParallelCollapseCosts", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+        Plane(Vector3::UNIT_Z, 0), 1000, 1000, 100, 64, 64, true);
+
+    LodConfig config;
+    config.mesh = mesh;
+    config.strategy = PixelCountLodStrategy::getSingletonPtr();
+    config.createGeneratedLodLevel(10, 0.25);
+    config.createGeneratedLodLevel(9, 0.5);
+    config.createGeneratedLodLevel(8, 0.75);
+    config.advanced.useCompression = false;
+    config.advanced.useBackgroundQueue = false;
+
+    LodCollapseCostPtr costs[] = {LodCollapseCostPtr(new LodCollapseCostCurvature()),
+                                  LodCollapseCostPtr(new LodCollapseCostQuadric())};
+    for (int c = 0; c < 2; c++) {
+        // the initial costs are computed in parallel once the queue runs
+        vector<size_t>::type serialCounts;
+        MeshLodGenerator::getSingleton().generateLodLevels(config, costs[c]);
+        for (size_t i = 0; i < config.levels.size(); i++)
+            serialCounts.push_back(config.levels[i].outUniqueVertexCount);
+        LodIndexList serialIndices = getLodIndices(mesh);
+        ASSERT_EQ(config.levels.size(), serialIndices.size());
+
+        startWorkQueue();
+        MeshLodGenerator::getSingleton().generateLodLevels(config, costs[c]);
+        stopWorkQueue();
+
+        for (size_t i = 0; i < config.levels.size(); i++)
+            EXPECT_EQ(serialCounts[i], config.levels[i].outUniqueVertexCount);
+        EXPECT_LT(config.levels.back().outUniqueVertexCount, serialCounts.front());
+        // the same collapses in the same order give the same triangles
+        LodIndexList parallelIndices = getLodIndices(mesh);
+        ASSERT_EQ(serialIndices.size(), parallelIndices.size());
+        for (size_t i = 0; i < serialIndices.size(); i++) {
+            EXPECT_FALSE(serialIndices[i].empty());
+            EXPECT_TRUE(serialIndices[i] == parallelIndices[i]) << "LOD level " << i + 1;
+        }
+    }
+
+    mesh.reset();
+    MeshManager::getSingleton().remove("LodParallelCollapseCosts", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    OGRE_DELETE MeshLodGenerator::getSingletonPtr();
+}
+//--------------------------------------------------------------------------
+TEST_F(RootWithoutRenderSystemFixture, LodBatchGenerator)
+{
+    new MeshLodGenerator;
+    const String dir = "LodBatchGenerator";
+    const String group = "LodBatchGenerator";
+    FileSystemLayer::createDirectory(dir);
+    for (int i = 0; i < 4; i++) {
+        String name = "plane" + StringConverter::toString(i) + ".mesh";
+        MeshPtr mesh = MeshManager::getSingleton().createCurvedPlane(
+            name, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+            Plane(Vector3::UNIT_Z, 0), 1000, 1000, 100 * (i + 1), 16, 16, true);
+        MeshSerializer().exportMesh(mesh.get(), dir + "/" + name);
+        MeshManager::getSingleton().remove(mesh);
+    }
+    ResourceGroupManager::getSingleton().addResourceLocation(dir, "FileSystem", group);
+
+    LodBatchGenerator batch;
+    batch.setMemoryBudget(1);
+    batch.setOutputDirectory(dir);
+    batch.setConfigDirectory(dir);
+    batch.addResourceGroup(group);
+
+    startWorkQueue();
+    batch.generate();
+    EXPECT_EQ(4u, batch.getStatistics().meshCount);
+    EXPECT_EQ(4u, batch.getStatistics().generatedCount);
+    EXPECT_EQ(0u, batch.getStatistics().failedCount);
+    EXPECT_GT(batch.getStatistics().triangleCount, 0u);
+
+    // the saved meshes have the Lod levels, and are not generated again
+    MeshPtr mesh = MeshManager::getSingleton().load("plane0.mesh", group);
+    EXPECT_GT(mesh->getNumLodLevels(), 1);
+    mesh->unload();
+    batch.generate();
+    stopWorkQueue();
+    EXPECT_EQ(0u, batch.getStatistics().generatedCount);
+    EXPECT_EQ(4u, batch.getStatistics().skippedCount);
+
+    mesh.reset();
+    ResourceGroupManager::getSingleton().destroyResourceGroup(group);
+    for (int i = 0; i < 4; i++) {
+        String name = dir + "/plane" + StringConverter::toString(i) + ".mesh";
+        FileSystemLayer::removeFile(name);
+        FileSystemLayer::removeFile(name + ".lodconfig");
+    }
+    FileSystemLayer::removeDirectory(dir);
+    OGRE_DELETE MeshLodGenerator::getSingletonPtr();
+}
+//--------------------------------------------------------------------------
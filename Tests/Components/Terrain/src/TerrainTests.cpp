@@ -30,6 +30,9 @@ THE SOFTWARE.
 #include "OgreConfigFile.h"
 #include "OgreResourceGroupManager.h"
 #include "OgreLogManager.h"
+#include "OgrePlane.h"
+#include "OgreTerrainQuadTreeNode.h"
+#include "OgreWorkQueue.h"
 
 //--------------------------------------------------------------------------
 void TerrainTests::SetUp()
@@ -99,3 +102,111 @@ TEST_F(TerrainTests, create)
     ASSERT_TRUE(1);
 }
 //--------------------------------------------------------------------------
+TEST_F(TerrainTests, calculateNormals)
+{
+    const uint16 size = 65;
+    vector<float>::type heights(size * size);
+    for (uint16 y = 0; y < size; ++y)
+        for (uint16 x = 0; x < size; ++x)
+            heights[y * size + x] = 40.0f * Math::Sin(x * 0.2f) * Math::Cos(y * 0.3f) + x;
+
+    Terrain::Alignment aligns[] = {Terrain::ALIGN_X_Z, Terrain::ALIGN_X_Y, Terrain::ALIGN_Y_Z};
+    for (int a = 0; a < 3; ++a)
+    {
+        Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+        Terrain::ImportData imp;
+        imp.terrainAlign = aligns[a];
+        imp.inputFloat = &heights[0];
+        imp.terrainSize = size;
+        imp.worldSize = 1000;
+        imp.minBatchSize = 17;
+        imp.maxBatchSize = 33;
+        t->prepare(imp);
+
+        Rect finalRect;
+        PixelBox* normals = t->calculateNormals(Rect(0, 0, size, size), finalRect);
+        ASSERT_EQ(size, finalRect.width());
+        ASSERT_EQ(size, finalRect.height());
+
+        // compare with the plane normals of the 8 surrounding triangles
+        for (long y = 0; y < size; ++y)
+        {
+            for (long x = 0; x < size; ++x)
+            {
+                Vector3 centre, adjacent[8];
+                long offsets[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+                t->getPoint(x, y, &centre);
+                for (int i = 0; i < 8; ++i)
+                {
+                    t->getPoint(Math::Clamp(x + offsets[i][0], 0L, size - 1L),
+                                Math::Clamp(y + offsets[i][1], 0L, size - 1L), &adjacent[i]);
+                }
+                Vector3 expected = Vector3::ZERO;
+                for (int i = 0; i < 8; ++i)
+                    expected += Plane(centre, adjacent[i], adjacent[(i + 1) % 8]).normal;
+                expected.normalise();
+
+                const uint8* pStored = normals->data + ((size - y - 1) * size + x) * 3;
+                EXPECT_NEAR((expected.x + 1.0f) * 0.5f * 255.0f, pStored[0], 1.0f);
+                EXPECT_NEAR((expected.y + 1.0f) * 0.5f * 255.0f, pStored[1], 1.0f);
+                EXPECT_NEAR((expected.z + 1.0f) * 0.5f * 255.0f, pStored[2], 1.0f);
+            }
+        }
+
+        OGRE_FREE(normals->data, MEMCATEGORY_GENERAL);
+        OGRE_DELETE normals;
+        OGRE_DELETE t;
+    }
+}
+//--------------------------------------------------------------------------
+static void getMaxHeightDeltas(TerrainQuadTreeNode* node, vector<Real>::type& deltas)
+{
+    for (uint16 lod = 0; lod < node->getLodCount(); ++lod)
+        deltas.push_back(node->getLodLevel(lod)->maxHeightDelta);
+    if (!node->isLeaf())
+    {
+        for (unsigned short c = 0; c < 4; ++c)
+            getMaxHeightDeltas(node->getChild(c), deltas);
+    }
+}
+
+TEST_F(TerrainTests, calculateHeightDeltasParallel)
+{
+    const uint16 size = 129;
+    vector<float>::type heights(size * size);
+    for (uint16 y = 0; y < size; ++y)
+        for (uint16 x = 0; x < size; ++x)
+            heights[y * size + x] = 40.0f * Math::Sin(x * 0.2f) * Math::Cos(y * 0.3f) + x;
+
+    Terrain::ImportData imp;
+    imp.inputFloat = &heights[0];
+    imp.terrainSize = size;
+    imp.worldSize = 1000;
+    imp.minBatchSize = 17;
+    imp.maxBatchSize = 33;
+
+    // the same terrain without and with workers to spread the rows over
+    vector<float>::type deltas[2];
+    vector<Real>::type maxDeltas[2];
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+    for (int i = 0; i < 2; ++i)
+    {
+        if (i == 1)
+        {
+            wq->setWorkerThreadCount(3);
+            wq->startup();
+        }
+
+        Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+        t->prepare(imp);
+        deltas[i].assign(t->getDeltaData(), t->getDeltaData() + size * size);
+        getMaxHeightDeltas(t->getQuadTree(), maxDeltas[i]);
+        OGRE_DELETE t;
+    }
+    wq->shutdown();
+
+    EXPECT_EQ(deltas[0], deltas[1]);
+    EXPECT_EQ(maxDeltas[0], maxDeltas[1]);
+    EXPECT_LT(0.0f, *std::max_element(maxDeltas[0].begin(), maxDeltas[0].end()));
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,293 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "RootWithoutRenderSystemFixture.h"
+#include "OgreVolumeCacheSource.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeGridSource.h"
+#include "OgreVolumeOctreeNode.h"
+#include "OgreVolumeOctreeNodeSplitPolicy.h"
+#include "OgreWorkQueue.h"
+
+using namespace Ogre;
+using namespace Ogre::Volume;
+//--------------------------------------------------------------------------
+TEST(VolumeCacheSource, MatchesSource)
+{
+    CSGSphereSource sphere((Real)5.0, Vector3((Real)1.5, (Real)-2.0, (Real)0.25));
+    CacheSource cache(&sphere, (Real)0.25);
+
+    // lattice points of several widths, on both sides of the origin
+    vector<Vector3>::type positions;
+    for (int x = -12; x <= 12; ++x)
+        for (int y = -12; y <= 12; ++y)
+            for (int z = -12; z <= 12; z += 3)
+                positions.push_back(Vector3((Real)x, (Real)y * (Real)0.5, (Real)z * (Real)0.25));
+
+    for (size_t i = 0; i < positions.size(); ++i)
+        EXPECT_EQ(sphere.getValueAndGradient(positions[i]), cache.getValueAndGradient(positions[i]));
+    EXPECT_EQ(0u, cache.getHitCount());
+    EXPECT_EQ(positions.size(), cache.getMissCount());
+
+    for (size_t i = 0; i < positions.size(); ++i)
+        EXPECT_EQ(sphere.getValue(positions[i]), cache.getValue(positions[i]));
+    EXPECT_EQ(positions.size(), cache.getHitCount());
+    EXPECT_GT(cache.getBrickCount(), 0u);
+
+    // positions off the lattice are not cached
+    Vector3 off((Real)0.1, (Real)0.0, (Real)0.0);
+    EXPECT_EQ(sphere.getValue(off), cache.getValue(off));
+    EXPECT_EQ(sphere.getValue(off), cache.getValue(off));
+    EXPECT_EQ(positions.size(), cache.getHitCount());
+    EXPECT_EQ(positions.size() + 2, cache.getMissCount());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getBrickCount());
+    EXPECT_EQ(0u, cache.getHitCount());
+}
+//--------------------------------------------------------------------------
+TEST(VolumeCacheSource, Batch)
+{
+    CSGSphereSource sphere((Real)5.0, Vector3((Real)1.5, (Real)-2.0, (Real)0.25));
+    CacheSource cache(&sphere, (Real)0.25);
+
+    // a row of lattice points with one off the lattice, more than one chunk
+    const size_t count = 100;
+    Real x[count], y[count], z[count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        x[i] = (Real)i * (Real)0.25 - (Real)12.0;
+        y[i] = (Real)0.5;
+        z[i] = (Real)-1.0;
+    }
+    x[42] = (Real)0.1;
+
+    Real gradientX[count], gradientY[count], gradientZ[count], values[count];
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        cache.getValuesAndGradients(x, y, z, gradientX, gradientY, gradientZ, values, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vector4 expected = sphere.getValueAndGradient(Vector3(x[i], y[i], z[i]));
+            EXPECT_EQ(expected, Vector4(gradientX[i], gradientY[i], gradientZ[i], values[i]));
+        }
+    }
+    EXPECT_EQ(count - 1, cache.getHitCount());
+    EXPECT_EQ(count + 1, cache.getMissCount());
+}
+//--------------------------------------------------------------------------
+TEST(VolumeCacheSource, Eviction)
+{
+    CSGSphereSource sphere((Real)20.0, Vector3::ZERO);
+    CacheSource cache(&sphere, (Real)1.0, 32);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int x = 0; x < 64; ++x)
+            for (int y = 0; y < 64; ++y)
+            {
+                Vector3 position((Real)x, (Real)y, (Real)1.0);
+                ASSERT_EQ(sphere.getValue(position), cache.getValue(position));
+            }
+        EXPECT_LE(cache.getBrickCount(), 32u);
+    }
+    // most of the bricks were evicted before they were used again
+    EXPECT_LT(cache.getHitCount(), cache.getMissCount());
+}
+//--------------------------------------------------------------------------
+TEST_F(RootWithoutRenderSystemFixture, VolumeCacheSourceConcurrent)
+{
+    CSGSphereSource sphere((Real)10.0, Vector3((Real)16.0));
+    CacheSource cache(&sphere, (Real)0.5, 64);
+
+    startWorkQueue();
+    // every slice is read by two ranges, so threads share bricks and evict each other's
+    AtomicScalar<size_t> mismatches(0);
+    mRoot->getWorkQueue()->parallelFor(0, 128, 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            for (int y = 0; y < 64; ++y)
+                for (int z = 0; z < 64; ++z)
+                {
+                    Vector3 position((Real)(i % 64) * (Real)0.5, (Real)y * (Real)0.5, (Real)z * (Real)0.5);
+                    if (cache.getValueAndGradient(position) != sphere.getValueAndGradient(position))
+                        ++mismatches;
+                }
+    });
+    stopWorkQueue();
+
+    EXPECT_EQ(0u, size_t(mismatches));
+    EXPECT_EQ(size_t(128 * 64 * 64), cache.getHitCount() + cache.getMissCount());
+    EXPECT_LE(cache.getBrickCount(), 64u);
+}
+//--------------------------------------------------------------------------
+namespace {
+    /// A small grid of an analytic density, to test GridSource without a texture
+    class FunctionGridSource : public GridSource
+    {
+    public:
+        explicit FunctionGridSource(bool trilinear) : GridSource(trilinear, trilinear, false)
+        {
+            mWidth = mHeight = mDepth = 16;
+            mPosXScale = mPosYScale = mPosZScale = (Real)2.0;
+            mVolumeSpaceToWorldSpaceFactor = (Real)1.0;
+        }
+    protected:
+        virtual float getVolumeGridValue(size_t x, size_t y, size_t z) const
+        {
+            x = std::min(x, mWidth - 1);
+            y = std::min(y, mHeight - 1);
+            z = std::min(z, mDepth - 1);
+            int dX = int(x) - 7, dY = int(y) - 8;
+            return 6.0f - std::sqrt(float(dX * dX + dY * dY)) + 0.25f * z;
+        }
+        virtual void setVolumeGridValue(int x, int y, int z, float value) {}
+    };
+
+    /// Compares the batch functions of a source with the single position ones
+    void expectBatchMatches(const Source& src, const vector<Vector3>::type& positions)
+    {
+        size_t count = positions.size();
+        vector<Real>::type x(count), y(count), z(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            x[i] = positions[i].x;
+            y[i] = positions[i].y;
+            z[i] = positions[i].z;
+        }
+        vector<Real>::type values(count), gradientX(count), gradientY(count), gradientZ(count), values2(count);
+        src.getValues(&x[0], &y[0], &z[0], &values[0], count);
+        src.getValuesAndGradients(&x[0], &y[0], &z[0], &gradientX[0], &gradientY[0], &gradientZ[0], &values2[0], count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vector4 expected = src.getValueAndGradient(positions[i]);
+            Real tolerance = (Real)1e-4 * std::max((Real)1.0, Math::Abs(expected.w));
+            ASSERT_NEAR(src.getValue(positions[i]), values[i], tolerance) << i;
+            ASSERT_NEAR(expected.w, values2[i], tolerance) << i;
+            ASSERT_NEAR(expected.x, gradientX[i], tolerance) << i;
+            ASSERT_NEAR(expected.y, gradientY[i], tolerance) << i;
+            ASSERT_NEAR(expected.z, gradientZ[i], tolerance) << i;
+        }
+    }
+
+    /// A count which is neither a multiple of four nor of the batch size
+    vector<Vector3>::type getBatchPositions(Real scale)
+    {
+        vector<Vector3>::type positions;
+        for (int x = -3; x < 6; ++x)
+            for (int y = -2; y < 5; ++y)
+                for (int z = 0; z < 3; ++z)
+                    positions.push_back(Vector3((Real)x * (Real)1.37, (Real)y * (Real)0.71, (Real)z * (Real)2.3) * scale);
+        return positions;
+    }
+}
+//--------------------------------------------------------------------------
+TEST(VolumeBatch, CSGTree)
+{
+    CSGSphereSource sphere((Real)3.0, Vector3((Real)1.0, (Real)0.5, (Real)2.0));
+    CSGCubeSource cube(Vector3((Real)-1.0), Vector3((Real)2.0, (Real)3.0, (Real)4.0));
+    CSGPlaneSource plane((Real)1.5, Vector3((Real)0.2, (Real)1.0, (Real)0.1));
+    CSGUnionSource unionSrc(&sphere, &cube);
+    CSGIntersectionSource intersection(&unionSrc, &plane);
+    CSGNegateSource negate(&plane);
+    CSGDifferenceSource difference(&intersection, &negate);
+    CSGScaleSource scale(&difference, (Real)1.5);
+    Real frequencies[] = {(Real)1.01, (Real)0.1};
+    Real amplitudes[] = {(Real)0.25, (Real)1.0};
+    CSGNoiseSource noise(&scale, frequencies, amplitudes, 2, 7);
+
+    vector<Vector3>::type positions = getBatchPositions((Real)1.0);
+    ASSERT_EQ(189u, positions.size());
+    expectBatchMatches(sphere, positions);
+    expectBatchMatches(cube, positions);
+    expectBatchMatches(plane, positions);
+    expectBatchMatches(difference, positions);
+    expectBatchMatches(noise, positions);
+}
+//--------------------------------------------------------------------------
+TEST(VolumeBatch, SimplexNoise)
+{
+    SimplexNoise noise(1234);
+    vector<Vector3>::type positions = getBatchPositions((Real)3.3);
+    vector<Real>::type x, y, z;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        x.push_back(positions[i].x);
+        y.push_back(positions[i].y);
+        z.push_back(positions[i].z);
+    }
+    vector<Real>::type results(positions.size());
+    noise.noise(&x[0], &y[0], &z[0], &results[0], positions.size());
+    for (size_t i = 0; i < positions.size(); ++i)
+        ASSERT_NEAR(noise.noise(x[i], y[i], z[i]), results[i], (Real)1e-5) << i;
+}
+//--------------------------------------------------------------------------
+TEST(VolumeBatch, GridSource)
+{
+    vector<Vector3>::type positions;
+    for (int x = 0; x < 13; ++x)
+        for (int y = 0; y < 7; ++y)
+            for (int z = 0; z < 5; ++z)
+                positions.push_back(Vector3((Real)x * (Real)0.53, (Real)y * (Real)0.97, (Real)z * (Real)1.41));
+
+    FunctionGridSource trilinear(true);
+    expectBatchMatches(trilinear, positions);
+    FunctionGridSource nearest(false);
+    expectBatchMatches(nearest, positions);
+}
+//--------------------------------------------------------------------------
+TEST(VolumeBatch, OctreeCenterValues)
+{
+    CSGSphereSource sphere((Real)5.0, Vector3((Real)8.0));
+    OctreeNodeSplitPolicy policy(&sphere, (Real)1.0);
+    OctreeNode root(Vector3::ZERO, Vector3((Real)16.0));
+    root.split(&policy, &sphere, (Real)0.01);
+    ASSERT_TRUE(root.isSubdivided());
+
+    // every leaf got the value of its center, batched or not
+    size_t leafCount = 0;
+    vector<const OctreeNode*>::type nodes(1, &root);
+    while (!nodes.empty())
+    {
+        const OctreeNode* node = nodes.back();
+        nodes.pop_back();
+        if (node->isSubdivided())
+        {
+            for (size_t i = 0; i < OctreeNode::OCTREE_CHILDREN_COUNT; ++i)
+                nodes.push_back(node->getChild(i));
+            continue;
+        }
+        Vector4 expected = sphere.getValueAndGradient(node->getCenter());
+        Vector4 value = node->getCenterValue();
+        EXPECT_NEAR(expected.x, value.x, (Real)1e-5);
+        EXPECT_NEAR(expected.y, value.y, (Real)1e-5);
+        EXPECT_NEAR(expected.z, value.z, (Real)1e-5);
+        EXPECT_NEAR(expected.w, value.w, (Real)1e-5);
+        ++leafCount;
+    }
+    EXPECT_GT(leafCount, 8u);
+}
@@ -41,6 +41,11 @@ public:
     Ogre::FileSystemLayer* mFSLayer;
     void SetUp();
     void TearDown();
+
+    /// Starts worker threads on the WorkQueue of mRoot, so it runs tasks in parallel
+    void startWorkQueue(size_t threadCount = 3);
+    /// Stops the worker threads started by startWorkQueue
+    void stopWorkQueue();
 };
 
 #endif /* TESTS_OGREMAIN_INCLUDE_ROOTWITHOUTRENDERSYSTEMFIXTURE_H_ */
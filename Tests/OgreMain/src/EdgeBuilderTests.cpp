@@ -283,3 +283,119 @@ TEST_F(EdgeBuilderTests,MultiIndexBufMultiVertexBuf)
     delete edgeData;
 }
 //--------------------------------------------------------------------------
+TEST_F(EdgeBuilderTests,WeldTolerance)
+{
+    /* This tests the edge builders ability to weld vertices which are only nearly
+    at the same position, when given a weld tolerance
+    */
+    VertexData vd;
+    IndexData id;
+
+    // Test quad, with the vertices of the second triangle slightly off
+    vd.vertexCount = 6;
+    vd.vertexStart = 0;
+    vd.vertexDeclaration = HardwareBufferManager::getSingleton().createVertexDeclaration();
+    vd.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(sizeof(float)*3, 6, HardwareBuffer::HBU_STATIC,true);
+    vd.vertexBufferBinding->setBinding(0, vbuf);
+    float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    *pFloat++ = 0.1f   ; *pFloat++ = 0.1f   ; *pFloat++ = 0  ;
+    *pFloat++ = 10.1f  ; *pFloat++ = 0.1f   ; *pFloat++ = 0  ;
+    *pFloat++ = 0.1f   ; *pFloat++ = 10.1f  ; *pFloat++ = 0  ;
+    *pFloat++ = 10.101f; *pFloat++ = 0.1f   ; *pFloat++ = 0  ;
+    *pFloat++ = 10.1f  ; *pFloat++ = 10.1f  ; *pFloat++ = 0  ;
+    *pFloat++ = 0.1f   ; *pFloat++ = 10.101f; *pFloat++ = 0  ;
+    vbuf->unlock();
+
+    id.indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_16BIT, 6, HardwareBuffer::HBU_STATIC, true);
+    id.indexCount = 6;
+    id.indexStart = 0;
+    unsigned short* pIdx = static_cast<unsigned short*>(id.indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    *pIdx++ = 0; *pIdx++ = 1; *pIdx++ = 2;
+    *pIdx++ = 3; *pIdx++ = 4; *pIdx++ = 5;
+    id.indexBuffer->unlock();
+
+    EdgeListBuilder exactBuilder;
+    exactBuilder.addVertexData(&vd);
+    exactBuilder.addIndexData(&id);
+    EdgeData* edgeData = exactBuilder.build();
+
+    // Nothing welded, 6 open edges
+    EXPECT_EQ(6u, edgeData->edgeGroups[0].edges.size());
+    delete edgeData;
+
+    EdgeListBuilder weldBuilder;
+    weldBuilder.setWeldTolerance(0.25f);
+    weldBuilder.addVertexData(&vd);
+    weldBuilder.addIndexData(&id);
+    edgeData = weldBuilder.build();
+
+    // The diagonal is shared, 5 edges
+    EdgeData::EdgeGroup& eg = edgeData->edgeGroups[0];
+    ASSERT_EQ(5u, eg.edges.size());
+    EXPECT_FALSE(eg.edges[1].degenerate);
+    EXPECT_EQ(0u, eg.edges[1].triIndex[0]);
+    EXPECT_EQ(1u, eg.edges[1].triIndex[1]);
+    EXPECT_EQ(1u, eg.edges[1].vertIndex[0]);
+    EXPECT_EQ(2u, eg.edges[1].vertIndex[1]);
+
+    delete edgeData;
+}
+//--------------------------------------------------------------------------
+TEST_F(EdgeBuilderTests,WeldToleranceAcrossCells)
+{
+    /* This tests that vertices within the weld tolerance are welded even when they
+    fall on different sides of a cell boundary of the weld grid
+    */
+    VertexData vd;
+    IndexData id;
+
+    // Test quad, the diagonal of the second triangle straddles x = 41 * 0.25 and y = 41 * 0.25
+    vd.vertexCount = 6;
+    vd.vertexStart = 0;
+    vd.vertexDeclaration = HardwareBufferManager::getSingleton().createVertexDeclaration();
+    vd.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(sizeof(float)*3, 6, HardwareBuffer::HBU_STATIC,true);
+    vd.vertexBufferBinding->setBinding(0, vbuf);
+    float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    *pFloat++ = 0      ; *pFloat++ = 0      ; *pFloat++ = 0  ;
+    *pFloat++ = 10.249f; *pFloat++ = 0      ; *pFloat++ = 0  ;
+    *pFloat++ = 0      ; *pFloat++ = 10.249f; *pFloat++ = 0  ;
+    *pFloat++ = 10.251f; *pFloat++ = 0      ; *pFloat++ = 0  ;
+    *pFloat++ = 10     ; *pFloat++ = 10     ; *pFloat++ = 0  ;
+    *pFloat++ = 0      ; *pFloat++ = 10.251f; *pFloat++ = 0  ;
+    vbuf->unlock();
+
+    id.indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_16BIT, 6, HardwareBuffer::HBU_STATIC, true);
+    id.indexCount = 6;
+    id.indexStart = 0;
+    unsigned short* pIdx = static_cast<unsigned short*>(id.indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    *pIdx++ = 0; *pIdx++ = 1; *pIdx++ = 2;
+    *pIdx++ = 3; *pIdx++ = 4; *pIdx++ = 5;
+    id.indexBuffer->unlock();
+
+    EdgeListBuilder weldBuilder;
+    weldBuilder.setWeldTolerance(0.25f);
+    weldBuilder.addVertexData(&vd);
+    weldBuilder.addIndexData(&id);
+    EdgeData* edgeData = weldBuilder.build();
+
+    // The diagonal is shared, 5 edges
+    EdgeData::EdgeGroup& eg = edgeData->edgeGroups[0];
+    ASSERT_EQ(5u, eg.edges.size());
+    EXPECT_FALSE(eg.edges[1].degenerate);
+    EXPECT_EQ(1u, eg.edges[1].triIndex[1]);
+    delete edgeData;
+
+    // Further apart than the tolerance, so nothing is welded
+    EdgeListBuilder tightBuilder;
+    tightBuilder.setWeldTolerance(0.001f);
+    tightBuilder.addVertexData(&vd);
+    tightBuilder.addIndexData(&id);
+    edgeData = tightBuilder.build();
+    EXPECT_EQ(6u, edgeData->edgeGroups[0].edges.size());
+    delete edgeData;
+}
+//--------------------------------------------------------------------------
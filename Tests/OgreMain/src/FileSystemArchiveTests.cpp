@@ -306,3 +306,28 @@ TEST_F(FileSystemArchiveTests,CreateAndRemoveFile)
     EXPECT_TRUE(!mArch->exists(fileName));
 }
 //--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,MappedFileRead)
+{
+    MappedFileSystemArchiveFactory factory;
+    Archive* arch = factory.createInstance(mTestPath, true);
+    arch->load();
+
+    DataStreamPtr stream = arch->open("rootfile.txt");
+    MemoryDataStreamPtr memStream = dynamic_pointer_cast<MemoryDataStream>(stream);
+    ASSERT_TRUE(memStream);
+    EXPECT_EQ(mFileSizeRoot1, stream->size());
+    EXPECT_FALSE(stream->isWriteable());
+
+    // same bytes as the plain archive gives
+    String contents = mArch->open("rootfile.txt")->getAsString();
+    EXPECT_EQ(contents, String((const char*)memStream->getPtr(), memStream->size()));
+
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 2 in file 1"), stream->getLine());
+    stream->seek(0);
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    stream->close();
+
+    factory.destroyInstance(arch);
+}
+//--------------------------------------------------------------------------
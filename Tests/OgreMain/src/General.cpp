@@ -31,8 +31,34 @@ THE SOFTWARE.
 #include "OgreSceneNode.h"
 #include "OgreEntity.h"
 #include "OgreCamera.h"
+#include "OgreWorkQueue.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMaterialManager.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreSubEntity.h"
+#include "OgreSubMesh.h"
+#include "OgreAnimationState.h"
+#include "OgreParticleSystem.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreParticleAffector.h"
+#include "OgreParticleAffectorFactory.h"
+#include "OgreParticleEmitter.h"
+#include "OgreParticleEmitterFactory.h"
+#include "OgreParticle.h"
+#include "OgreBillboardSet.h"
+#include "OgreBillboard.h"
+#include "OgreControllerManager.h"
+#include "OgreMeshManager.h"
+#include "OgreMeshSerializer.h"
+#include "OgreStaticGeometry.h"
+#include "OgreEdgeListBuilder.h"
+#include "OgreTextureManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
 #include "RootWithoutRenderSystemFixture.h"
 
+#include <thread>
+
 #if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
 #include <random>
 using std::minstd_rand;
@@ -58,6 +84,220 @@ TEST(SceneManager,removeAndDestroyAllChildren)
     sm->getRootSceneNode()->removeAndDestroyAllChildren();
 }
 
+static void createRandomHierarchy(SceneNode* parent, int depth, minstd_rand& rng)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        SceneNode* node = parent->createChildSceneNode(
+            Vector3(float(rng() % 100), float(rng() % 100), float(rng() % 100)));
+        node->setOrientation(Quaternion(Degree(float(rng() % 360)), Vector3::UNIT_Y) *
+                             Quaternion(Degree(float(rng() % 360)), Vector3::UNIT_X));
+        node->setScale(Vector3(1.0f + (rng() % 4), 1.0f, 0.5f + (rng() % 2)));
+        node->setInheritOrientation(rng() % 4 != 0);
+        node->setInheritScale(rng() % 4 != 0);
+        if (depth > 0)
+            createRandomHierarchy(node, depth - 1, rng);
+    }
+}
+
+static void expectSameDerived(Node* a, Node* b)
+{
+    EXPECT_TRUE(a->_getDerivedPosition().positionEquals(b->_getDerivedPosition(), 1e-2f));
+    EXPECT_NEAR(std::abs(a->_getDerivedOrientation().Dot(b->_getDerivedOrientation())), 1.0f, 1e-4f);
+    EXPECT_TRUE(a->_getDerivedScale().positionEquals(b->_getDerivedScale(), 1e-4f));
+
+    ASSERT_EQ(a->getChildren().size(), b->getChildren().size());
+    for (size_t i = 0; i < a->getChildren().size(); ++i)
+        expectSameDerived(a->getChildren()[i], b->getChildren()[i]);
+}
+
+TEST(SceneManager,transformStore)
+{
+    Root root;
+    SceneManager* sm[2] = {root.createSceneManager(), root.createSceneManager()};
+    sm[1]->setTransformStoreEnabled(true);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        minstd_rand rng;
+        createRandomHierarchy(sm[i]->getRootSceneNode(), 4, rng);
+        sm[i]->_updateSceneGraph(NULL);
+    }
+    expectSameDerived(sm[0]->getRootSceneNode(), sm[1]->getRootSceneNode());
+
+    // local changes and reparenting
+    for (int i = 0; i < 2; ++i)
+    {
+        Node* a = sm[i]->getRootSceneNode()->getChildren()[0];
+        Node* b = sm[i]->getRootSceneNode()->getChildren()[1]->getChildren()[2];
+        a->translate(Vector3(10, 0, 0), Node::TS_LOCAL);
+        a->getChildren()[1]->yaw(Degree(30));
+        Node* moved = b->getParent()->removeChild(b);
+        a->getChildren()[0]->addChild(moved);
+        sm[i]->getRootSceneNode()->setScale(2, 2, 2);
+        sm[i]->_updateSceneGraph(NULL);
+    }
+    expectSameDerived(sm[0]->getRootSceneNode(), sm[1]->getRootSceneNode());
+
+    sm[1]->getRootSceneNode()->removeAndDestroyAllChildren();
+    sm[1]->_updateSceneGraph(NULL);
+    sm[1]->setTransformStoreEnabled(false);
+}
+
+struct RecordingObject : public MovableObject
+{
+    RecordingObject(const String& name, StringVector& log)
+        : MovableObject(name), mLog(log), mBox(-Vector3::UNIT_SCALE, Vector3::UNIT_SCALE) {}
+
+    const String& getMovableType(void) const
+    {
+        static String type = "Recording";
+        return type;
+    }
+    const AxisAlignedBox& getBoundingBox(void) const { return mBox; }
+    Real getBoundingRadius(void) const { return Math::Sqrt(3); }
+    void _updateRenderQueue(RenderQueue*) { mLog.push_back(mName); }
+    void visitRenderables(Renderable::Visitor*, bool) {}
+
+    StringVector& mLog;
+    AxisAlignedBox mBox;
+};
+
+static void attachRecordingObjects(SceneNode* node, StringVector& log,
+                                   std::vector<MovableObject*>& objects)
+{
+    objects.push_back(new RecordingObject(StringConverter::toString(objects.size()), log));
+    node->attachObject(objects.back());
+    for (size_t i = 0; i < node->getChildren().size(); ++i)
+        attachRecordingObjects(static_cast<SceneNode*>(node->getChildren()[i]), log, objects);
+}
+
+TEST(SceneManager,parallelSceneGraph)
+{
+    Root root;
+    DefaultHardwareBufferManager bufMgr; // needed by Camera
+    MaterialManager::getSingleton().initialise();
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(root.getWorkQueue());
+    wq->setWorkerThreadCount(3);
+    wq->startup();
+
+    SceneManager* sm[2] = {root.createSceneManager(), root.createSceneManager()};
+    sm[1]->setParallelSceneGraphEnabled(true);
+    EXPECT_TRUE(sm[1]->isParallelSceneGraphEnabled());
+
+    Camera* cam[2];
+    StringVector log[2];
+    std::vector<MovableObject*> objects[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        minstd_rand rng;
+        createRandomHierarchy(sm[i]->getRootSceneNode(), 3, rng);
+        attachRecordingObjects(sm[i]->getRootSceneNode(), log[i], objects[i]);
+
+        cam[i] = sm[i]->createCamera("cam");
+        cam[i]->setNearClipDistance(1);
+        cam[i]->setFarClipDistance(250);
+        sm[i]->getRootSceneNode()->attachObject(cam[i]);
+
+        sm[i]->_updateSceneGraph(cam[i]);
+        sm[i]->_findVisibleObjects(cam[i], NULL, false);
+    }
+    expectSameDerived(sm[0]->getRootSceneNode(), sm[1]->getRootSceneNode());
+    EXPECT_FALSE(log[0].empty());
+    EXPECT_LT(log[0].size(), objects[0].size());
+    EXPECT_EQ(log[0], log[1]);
+
+    // update only some branches
+    for (int i = 0; i < 2; ++i)
+    {
+        Node* rootNode = sm[i]->getRootSceneNode();
+        rootNode->getChildren()[0]->translate(Vector3(0, 0, -50));
+        rootNode->getChildren()[2]->getChildren()[1]->yaw(Degree(90));
+
+        log[i].clear();
+        sm[i]->_updateSceneGraph(cam[i]);
+        sm[i]->_findVisibleObjects(cam[i], NULL, false);
+    }
+    expectSameDerived(sm[0]->getRootSceneNode(), sm[1]->getRootSceneNode());
+    EXPECT_EQ(log[0], log[1]);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        for (size_t j = 0; j < objects[i].size(); ++j)
+            delete objects[i][j];
+    }
+    sm[1]->setParallelSceneGraphEnabled(false);
+    root.destroySceneManager(sm[0]);
+    root.destroySceneManager(sm[1]);
+}
+
+/// Logs the debug renderables the scene manager adds to the queue, by position
+struct DebugRenderableLog : public RenderQueue::RenderableListener
+{
+    explicit DebugRenderableLog(StringVector& log) : mLog(log) {}
+
+    bool renderableQueued(Renderable* rend, uint8, ushort, Technique**, RenderQueue*)
+    {
+        Matrix4 xform;
+        rend->getWorldTransforms(&xform);
+        mLog.push_back("debug " + StringConverter::toString(xform.getTrans()));
+        return false;
+    }
+
+    StringVector& mLog;
+};
+
+TEST(SceneManager,parallelSceneGraphSingleBranch)
+{
+    Root root;
+    DefaultHardwareBufferManager bufMgr; // needed by Camera and the debug renderables
+    MaterialManager::getSingleton().initialise();
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(root.getWorkQueue());
+    wq->setWorkerThreadCount(3);
+    wq->startup();
+
+    SceneManager* sm[2] = {root.createSceneManager(), root.createSceneManager()};
+    sm[1]->setParallelSceneGraphEnabled(true);
+
+    StringVector log[2];
+    std::vector<MovableObject*> objects[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        // everything below one top-level node, so the graph has to be split further down
+        minstd_rand rng;
+        SceneNode* branch = sm[i]->getRootSceneNode()->createChildSceneNode();
+        createRandomHierarchy(branch, 3, rng);
+        attachRecordingObjects(branch, log[i], objects[i]);
+        sm[i]->setDisplaySceneNodes(true);
+
+        Camera* cam = sm[i]->createCamera("cam");
+        cam->setNearClipDistance(1);
+        cam->setFarClipDistance(250);
+        sm[i]->getRootSceneNode()->attachObject(cam);
+
+        DebugRenderableLog listener(log[i]);
+        sm[i]->getRenderQueue()->setRenderableListener(&listener);
+        sm[i]->_updateSceneGraph(cam);
+        sm[i]->_findVisibleObjects(cam, NULL, false);
+        sm[i]->getRenderQueue()->setRenderableListener(NULL);
+    }
+    expectSameDerived(sm[0]->getRootSceneNode(), sm[1]->getRootSceneNode());
+    ASSERT_FALSE(log[0].empty());
+    EXPECT_EQ(0u, log[0].back().find("debug")); // the root comes last
+    EXPECT_EQ(log[0], log[1]);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        for (size_t j = 0; j < objects[i].size(); ++j)
+            delete objects[i][j];
+    }
+    sm[1]->setParallelSceneGraphEnabled(false);
+    root.destroySceneManager(sm[0]);
+    root.destroySceneManager(sm[1]);
+    // the buffers of the axes belong to bufMgr, which goes before root
+    MeshManager::getSingleton().remove("Ogre/Debug/AxesMesh", ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME);
+}
+
 static void createRandomEntityClones(Entity* ent, size_t cloneCount, const Vector3& min,
                                      const Vector3& max, SceneManager* mgr)
 {
@@ -148,3 +388,870 @@ TEST_F(SceneQueryTest, Ray) {
     ASSERT_EQ("501", results[0].movable->getName());
     ASSERT_EQ("397", results[1].movable->getName());
 }
+
+TEST(OptimisedUtil, softwareVertexSkinning)
+{
+    minstd_rand rng;
+    const size_t numVertices = 37;
+    const size_t numMatrices = 5;
+
+    Affine3 matrices[numMatrices];
+    const Affine3* blendMatrices[numMatrices];
+    for (size_t i = 0; i < numMatrices; ++i)
+    {
+        Quaternion q(Radian(float(rng()) / rng.max() * Math::TWO_PI), Vector3(1, float(i), 2).normalisedCopy());
+        matrices[i].makeTransform(Vector3(float(i), -2.0f * i, 0.5f), Vector3(1 + 0.1f * i), q);
+        blendMatrices[i] = &matrices[i];
+    }
+
+    // position, normal, 4 weights, 4 indices, some padding
+    const size_t stride = 3 + 3 + 4 + 1 + 1;
+    std::vector<float> src(numVertices * stride);
+    std::vector<float> dest(numVertices * 6, 42.0f);
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        float* vert = &src[v * stride];
+        for (int i = 0; i < 6; ++i)
+            vert[i] = float(rng()) / rng.max() * 20 - 10;
+        float weightSum = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            // leave some weights unused
+            vert[6 + i] = (v + i) % 3 ? float(rng()) / rng.max() : 0;
+            weightSum += vert[6 + i];
+        }
+        for (int i = 0; i < 4; ++i)
+            vert[6 + i] = weightSum ? vert[6 + i] / weightSum : 0.25f;
+        unsigned char* indices = reinterpret_cast<unsigned char*>(vert + 10);
+        for (int i = 0; i < 4; ++i)
+            indices[i] = (unsigned char)(rng() % numMatrices);
+    }
+
+    OptimisedUtil::getImplementation()->softwareVertexSkinning(
+        &src[0], &dest[0], &src[3], &dest[3], &src[6],
+        reinterpret_cast<unsigned char*>(&src[10]), blendMatrices,
+        stride * sizeof(float), 6 * sizeof(float), stride * sizeof(float), 6 * sizeof(float),
+        stride * sizeof(float), stride * sizeof(float), 4, numVertices);
+
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        const float* vert = &src[v * stride];
+        const unsigned char* indices = reinterpret_cast<const unsigned char*>(vert + 10);
+        Vector3 pos(vert), norm(vert + 3);
+        Vector3 expectedPos = Vector3::ZERO, expectedNorm = Vector3::ZERO;
+        for (int i = 0; i < 4; ++i)
+        {
+            expectedPos += (matrices[indices[i]] * pos) * vert[6 + i];
+            Matrix3 rotation;
+            matrices[indices[i]].extract3x3Matrix(rotation);
+            expectedNorm += (rotation * norm) * vert[6 + i];
+        }
+        expectedNorm.normalise();
+
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_NEAR(expectedPos[i], dest[v * 6 + i], 1e-4f * (1 + std::abs(expectedPos[i])));
+            EXPECT_NEAR(expectedNorm[i], dest[v * 6 + 3 + i], 1e-4f);
+        }
+    }
+}
+
+TEST_F(RootWithoutRenderSystemFixture, OptimisedUtilCullSpheres)
+{
+    minstd_rand rng;
+    // not a multiple of the SIMD width, so the tail is handled as well
+    const size_t numSpheres = 103;
+
+    std::vector<float> spheres(numSpheres * 4);
+    for (size_t i = 0; i < numSpheres; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+            spheres[i * 4 + j] = float(rng()) / rng.max() * 200 - 100;
+        spheres[i * 4 + 3] = float(rng()) / rng.max() * 10;
+    }
+
+    Frustum frustum;
+    frustum.setNearClipDistance(1);
+    for (int infinite = 0; infinite < 2; ++infinite)
+    {
+        // like InstanceBatch, skip the far plane when it is at infinity
+        frustum.setFarClipDistance(infinite ? 0 : 50);
+        float planes[6 * 4];
+        size_t numPlanes = 0;
+        for (int p = 0; p < 6; ++p)
+        {
+            if (infinite && p == FRUSTUM_PLANE_FAR)
+                continue;
+            const Plane& plane = frustum.getFrustumPlanes()[p];
+            planes[numPlanes * 4 + 0] = plane.normal.x;
+            planes[numPlanes * 4 + 1] = plane.normal.y;
+            planes[numPlanes * 4 + 2] = plane.normal.z;
+            planes[numPlanes * 4 + 3] = plane.d;
+            ++numPlanes;
+        }
+
+        std::vector<uint32> visible(numSpheres);
+        size_t numVisible = OptimisedUtil::getImplementation()->cullSpheres(
+            planes, numPlanes, &spheres[0], &visible[0], numSpheres);
+
+        std::vector<uint32> expected;
+        for (size_t i = 0; i < numSpheres; ++i)
+        {
+            if (frustum.isVisible(Sphere(Vector3(&spheres[i * 4]), spheres[i * 4 + 3])))
+                expected.push_back(uint32(i));
+        }
+
+        EXPECT_FALSE(expected.empty());
+        ASSERT_EQ(expected.size(), numVisible);
+        for (size_t i = 0; i < numVisible; ++i)
+            EXPECT_EQ(expected[i], visible[i]);
+    }
+}
+
+TEST_F(RootWithoutRenderSystemFixture, EntitySoftwareSkinningBatch)
+{
+    startWorkQueue();
+
+    SceneManager* sm = mRoot->createSceneManager();
+
+    // the same animations once through the batch and once entity by entity
+    std::vector<Entity*> batched, single;
+    for (int i = 0; i < 8; ++i)
+    {
+        for (int j = 0; j < 2; ++j)
+        {
+            Entity* ent = sm->createEntity("robot.mesh");
+            ent->addSoftwareAnimationRequest(true);
+            AnimationState* anim = ent->getAnimationState("Walk");
+            anim->setEnabled(true);
+            anim->setTimePosition(0.2f * i);
+            (j ? single : batched).push_back(ent);
+        }
+    }
+
+    Entity::_updateAnimations(batched);
+    for (size_t i = 0; i < single.size(); ++i)
+        single[i]->_updateAnimation();
+
+    for (size_t i = 0; i < batched.size(); ++i)
+    {
+        for (size_t s = 0; s < batched[i]->getNumSubEntities(); ++s)
+        {
+            const VertexData* vertexData[2] = {batched[i]->getSubEntity(s)->_getSkelAnimVertexData(),
+                                               single[i]->getSubEntity(s)->_getSkelAnimVertexData()};
+            if (!vertexData[0])
+                vertexData[0] = batched[i]->_getSkelAnimVertexData();
+            if (!vertexData[1])
+                vertexData[1] = single[i]->_getSkelAnimVertexData();
+            ASSERT_TRUE(vertexData[0] && vertexData[1]);
+            ASSERT_EQ(vertexData[0]->vertexCount, vertexData[1]->vertexCount);
+
+            const VertexElement* posElem =
+                vertexData[0]->vertexDeclaration->findElementBySemantic(VES_POSITION);
+            HardwareVertexBufferSharedPtr buf[2];
+            const unsigned char* data[2];
+            for (int j = 0; j < 2; ++j)
+            {
+                buf[j] = vertexData[j]->vertexBufferBinding->getBuffer(posElem->getSource());
+                data[j] = static_cast<const unsigned char*>(buf[j]->lock(HardwareBuffer::HBL_READ_ONLY));
+            }
+            EXPECT_EQ(0, memcmp(data[0], data[1], buf[0]->getSizeInBytes()));
+            buf[0]->unlock();
+            buf[1]->unlock();
+        }
+    }
+
+    // the source buffers are shared by all entities and must not stay locked
+    EXPECT_FALSE(batched[0]->getMesh()->getSubMesh(0)->vertexData &&
+                 batched[0]->getMesh()->getSubMesh(0)->vertexData->vertexBufferBinding->getBuffer(0)->isLocked());
+    EXPECT_FALSE(batched[0]->getMesh()->sharedVertexData &&
+                 batched[0]->getMesh()->sharedVertexData->vertexBufferBinding->getBuffer(0)->isLocked());
+
+    mRoot->destroySceneManager(sm);
+}
+
+namespace {
+    /// Affector relying on the default batch implementation
+    class DragAffector : public ParticleAffector
+    {
+    public:
+        DragAffector(ParticleSystem* parent) : ParticleAffector(parent) { mType = "TestDrag"; }
+
+        void _affectParticles(ParticleSystem* pSystem, Real timeElapsed)
+        {
+            ParticleIterator pi = pSystem->_getIterator();
+            while (!pi.end())
+            {
+                Particle* p = pi.getNext();
+                p->mDirection *= 1 - 0.5f * timeElapsed;
+                p->mColour.a -= 0.25f * timeElapsed;
+            }
+        }
+    };
+
+    /// Affector which works on the arrays as well
+    class GravityAffector : public ParticleAffector
+    {
+    public:
+        GravityAffector(ParticleSystem* parent) : ParticleAffector(parent) { mType = "TestGravity"; }
+
+        void _affectParticles(ParticleSystem* pSystem, Real timeElapsed)
+        {
+            ParticleIterator pi = pSystem->_getIterator();
+            while (!pi.end())
+            {
+                Particle* p = pi.getNext();
+                p->mDirection.y -= 9.81f * timeElapsed;
+                p->mRotation += p->mRotationSpeed * timeElapsed;
+            }
+        }
+
+        void _affectParticleBatch(ParticleSystem* pSystem, const ParticleBatch& batch, Real timeElapsed)
+        {
+            for (size_t i = 0; i < batch.count; ++i)
+            {
+                batch.directionY[i] -= 9.81f * timeElapsed;
+                batch.rotation[i] += batch.rotationSpeed[i] * timeElapsed;
+            }
+        }
+    };
+
+    template <class T> class TestAffectorFactory : public ParticleAffectorFactory
+    {
+        String mName;
+    public:
+        TestAffectorFactory(const String& name) : mName(name) {}
+
+        String getName() const { return mName; }
+
+        ParticleAffector* createAffector(ParticleSystem* psys)
+        {
+            ParticleAffector* affector = OGRE_NEW T(psys);
+            mAffectors.push_back(affector);
+            return affector;
+        }
+    };
+}
+
+TEST_F(RootWithoutRenderSystemFixture, ParticleSystemSoAStorage)
+{
+    // normally done by Root::initialise
+    ParticleSystemManager::getSingleton()._initialise();
+    ControllerManager* controllerMgr = OGRE_NEW ControllerManager();
+
+    TestAffectorFactory<DragAffector> dragFactory("TestDrag");
+    TestAffectorFactory<GravityAffector> gravityFactory("TestGravity");
+    ParticleSystemManager::getSingleton().addAffectorFactory(&dragFactory);
+    ParticleSystemManager::getSingleton().addAffectorFactory(&gravityFactory);
+
+    SceneManager* sm = mRoot->createSceneManager();
+
+    // the same particles once through the particle instances and once through the arrays
+    ParticleSystem* systems[2];
+    for (int s = 0; s < 2; ++s)
+    {
+        systems[s] = sm->createParticleSystem("Particles" + StringConverter::toString(s), 60);
+        systems[s]->setSoAStorageEnabled(s == 1);
+        systems[s]->addAffector("TestGravity");
+        systems[s]->addAffector("TestDrag");
+        sm->getRootSceneNode()->attachObject(systems[s]);
+    }
+    EXPECT_EQ("true", systems[1]->getParameter("soa_storage"));
+
+    minstd_rand rng;
+    size_t maxParticles = 0;
+    for (int frame = 0; frame < 40; ++frame)
+    {
+        for (int n = 0; n < 10; ++n)
+        {
+            Real ttl = Real(rng() % 100) / 50;
+            Vector3 pos(Real(rng() % 200), Real(rng() % 200), Real(rng() % 200));
+            Vector3 dir(Real(rng() % 20) - 10, Real(rng() % 20), 0);
+            for (int s = 0; s < 2; ++s)
+            {
+                Particle* p = systems[s]->createParticle();
+                if (!p)
+                    break;
+                p->mPosition = pos;
+                p->mDirection = dir;
+                p->mColour = ColourValue::White;
+                p->mTimeToLive = p->mTotalTimeToLive = ttl;
+                p->mRotation = 0;
+                p->mRotationSpeed = Radian(ttl);
+            }
+        }
+
+        if (frame == 20)
+        {
+            // changes to the instances in between updates are picked up
+            systems[0]->getParticle(3)->mTimeToLive = 0;
+            systems[1]->getParticle(3)->mTimeToLive = 0;
+        }
+
+        maxParticles = std::max(maxParticles, systems[0]->getNumParticles());
+
+        systems[0]->_update(0.1f);
+        systems[1]->_update(0.1f);
+
+        ASSERT_EQ(systems[0]->getNumParticles(), systems[1]->getNumParticles());
+        for (size_t i = 0; i < systems[0]->getNumParticles(); ++i)
+        {
+            Particle* p[2] = { systems[0]->getParticle(i), systems[1]->getParticle(i) };
+            EXPECT_EQ(p[0]->mTotalTimeToLive, p[1]->mTotalTimeToLive);
+            EXPECT_FLOAT_EQ(p[0]->mTimeToLive, p[1]->mTimeToLive);
+            for (int c = 0; c < 3; ++c)
+            {
+                EXPECT_FLOAT_EQ(p[0]->mPosition[c], p[1]->mPosition[c]);
+                EXPECT_FLOAT_EQ(p[0]->mDirection[c], p[1]->mDirection[c]);
+            }
+            EXPECT_FLOAT_EQ(p[0]->mColour.a, p[1]->mColour.a);
+            EXPECT_FLOAT_EQ(p[0]->mRotation.valueRadians(), p[1]->mRotation.valueRadians());
+        }
+    }
+    // the quota was hit
+    EXPECT_EQ(60u, maxParticles);
+
+    // switching back keeps the particles
+    size_t numParticles = systems[1]->getNumParticles();
+    Vector3 lastPos = systems[1]->getParticle(numParticles - 1)->mPosition;
+    systems[1]->setSoAStorageEnabled(false);
+    ASSERT_EQ(numParticles, systems[1]->getNumParticles());
+    EXPECT_EQ(lastPos, systems[1]->getParticle(numParticles - 1)->mPosition);
+
+    // switching on with live particles, they all expire eventually
+    systems[0]->setSoAStorageEnabled(true);
+    systems[0]->fastForward(2.5f);
+    EXPECT_EQ(0u, systems[0]->getNumParticles());
+
+    sm->destroyAllParticleSystems();
+    mRoot->destroySceneManager(sm);
+    OGRE_DELETE controllerMgr;
+}
+
+namespace {
+    /// Point emitter drawing all properties of the particles from the random functions
+    class RandomEmitter : public ParticleEmitter
+    {
+    public:
+        RandomEmitter(ParticleSystem* psys) : ParticleEmitter(psys)
+        {
+            mType = "TestRandom";
+            setAngle(Degree(60));
+            setParticleVelocity(1, 5);
+            setTimeToLive(0.5f, 2);
+            setColour(ColourValue::Black, ColourValue::White);
+            setEmissionRate(200);
+        }
+
+        void _initParticle(Particle* pParticle)
+        {
+            ParticleEmitter::_initParticle(pParticle);
+            pParticle->mPosition = mPosition;
+            genEmissionColour(pParticle->mColour);
+            genEmissionDirection(pParticle->mPosition, pParticle->mDirection);
+            genEmissionVelocity(pParticle->mDirection);
+            pParticle->mTimeToLive = pParticle->mTotalTimeToLive = genEmissionTTL();
+        }
+
+        unsigned short _getEmissionCount(Real timeElapsed)
+        {
+            return genConstantEmissionCount(timeElapsed);
+        }
+    };
+
+    class RandomEmitterFactory : public ParticleEmitterFactory
+    {
+    public:
+        String getName() const { return "TestRandom"; }
+
+        ParticleEmitter* createEmitter(ParticleSystem* psys)
+        {
+            ParticleEmitter* emitter = OGRE_NEW RandomEmitter(psys);
+            mEmitters.push_back(emitter);
+            return emitter;
+        }
+    };
+
+    /// Runs a few systems through parallel updates, returns the positions of their particles
+    std::vector<Vector3> simulateParallelParticles(SceneManager* sm)
+    {
+        ParticleSystemManager& mgr = ParticleSystemManager::getSingleton();
+        std::vector<ParticleSystem*> systems;
+        for (int s = 0; s < 8; ++s)
+        {
+            ParticleSystem* sys = sm->createParticleSystem("Parallel" + StringConverter::toString(s), 200);
+            sys->addEmitter("TestRandom");
+            sys->setSoAStorageEnabled(s % 2 == 1);
+            sm->getRootSceneNode()->createChildSceneNode(Vector3(Real(s), 0, 0))->attachObject(sys);
+            systems.push_back(sys);
+        }
+
+        for (int frame = 0; frame < 30; ++frame)
+        {
+            // the shared generator is left alone
+            rand();
+            for (size_t s = 0; s < systems.size(); ++s)
+                mgr._queueUpdate(systems[s], 0.05f);
+            mgr._updateQueuedSystems();
+        }
+
+        std::vector<Vector3> positions;
+        for (size_t s = 0; s < systems.size(); ++s)
+        {
+            EXPECT_LT(0u, systems[s]->getNumParticles());
+            for (size_t i = 0; i < systems[s]->getNumParticles(); ++i)
+                positions.push_back(systems[s]->getParticle(i)->mPosition);
+            // the bounds are kept up to date as well
+            EXPECT_FALSE(systems[s]->getBoundingBox().isNull());
+        }
+
+        sm->destroyAllParticleSystems();
+        sm->getRootSceneNode()->removeAndDestroyAllChildren();
+        return positions;
+    }
+}
+
+TEST_F(RootWithoutRenderSystemFixture, ParticleSystemParallelUpdates)
+{
+    // normally done by Root::initialise
+    ParticleSystemManager::getSingleton()._initialise();
+    ControllerManager* controllerMgr = OGRE_NEW ControllerManager();
+
+    RandomEmitterFactory emitterFactory;
+    ParticleSystemManager::getSingleton().addEmitterFactory(&emitterFactory);
+    ParticleSystemManager::getSingleton().setParallelUpdatesEnabled(true);
+
+    SceneManager* sm = mRoot->createSceneManager();
+
+    // all on this thread first, then spread over several threads
+    srand(1);
+    std::vector<Vector3> serial = simulateParallelParticles(sm);
+
+    startWorkQueue();
+
+    srand(2);
+    std::vector<Vector3> parallel = simulateParallelParticles(sm);
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i)
+        EXPECT_EQ(serial[i], parallel[i]);
+
+    // the stream depends on the seed
+    ParticleSystem* sys = sm->createParticleSystem("Seeded", 10);
+    sys->setRandomSeed(1234);
+    EXPECT_EQ(1234u, sys->getRandomSeed());
+
+    ParticleSystemManager::getSingleton().setParallelUpdatesEnabled(false);
+    sm->destroyAllParticleSystems();
+    mRoot->destroySceneManager(sm);
+    OGRE_DELETE controllerMgr;
+}
+
+namespace {
+    /// Generates the vertices of all billboards of the set through injectBillboards
+    std::vector<float> injectAllBillboards(BillboardSet* set, Camera* cam)
+    {
+        std::vector<const Billboard*> billboards;
+        for (int i = 0; i < set->getNumBillboards(); ++i)
+            billboards.push_back(set->getBillboard(i));
+
+        set->_notifyCurrentCamera(cam);
+        set->beginBillboards(billboards.size());
+        set->injectBillboards(&billboards[0], billboards.size());
+        set->endBillboards();
+
+        RenderOperation op;
+        set->getRenderOperation(op);
+        std::vector<float> vertices(billboards.size() * 4 * 6);
+        op.vertexData->vertexBufferBinding->getBuffer(0)->readData(
+            0, vertices.size() * sizeof(float), &vertices[0]);
+        return vertices;
+    }
+}
+
+TEST_F(RootWithoutRenderSystemFixture, BillboardSetInjectBillboards)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Camera* cam = sm->createCamera("cam");
+    sm->getRootSceneNode()->attachObject(cam);
+
+    // enough billboards for several chunks, mixing the batched and the per billboard paths
+    const unsigned int count = 5000;
+    BillboardSet* set = sm->createBillboardSet(count);
+    sm->getRootSceneNode()->attachObject(set);
+    set->setDefaultDimensions(2, 2);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        Billboard* bb = set->createBillboard(Vector3(Real(i), Real(i % 7), -Real(i % 13)),
+            ColourValue(0.5f, 0.25f, Real(i % 5) / 4));
+        if (i % 97 == 5)
+            bb->setDimensions(3, 1);
+        if (i % 89 == 2)
+            bb->setRotation(Degree(Real(i)));
+        if (i % 3 == 0)
+            bb->setTexcoordRect(0.25f, 0.5f, 0.75f, 1);
+    }
+
+    std::vector<float> serial = injectAllBillboards(set, cam);
+
+    // left-top corner of the first billboard, facing the camera
+    EXPECT_FLOAT_EQ(-1, serial[0]);
+    EXPECT_FLOAT_EQ(1, serial[1]);
+    EXPECT_FLOAT_EQ(0, serial[2]);
+    EXPECT_FLOAT_EQ(0.25f, serial[4]);
+    EXPECT_FLOAT_EQ(0.5f, serial[5]);
+    // right-bottom corner of the second one
+    EXPECT_FLOAT_EQ(2, serial[24 + 18]);
+    EXPECT_FLOAT_EQ(0, serial[24 + 19]);
+    EXPECT_FLOAT_EQ(-1, serial[24 + 20]);
+    EXPECT_FLOAT_EQ(1, serial[24 + 22]);
+    EXPECT_FLOAT_EQ(1, serial[24 + 23]);
+
+    startWorkQueue();
+
+    std::vector<float> parallel = injectAllBillboards(set, cam);
+    ASSERT_EQ(serial.size(), parallel.size());
+    EXPECT_EQ(0, memcmp(&serial[0], &parallel[0], serial.size() * sizeof(float)));
+
+    mRoot->destroySceneManager(sm);
+}
+
+namespace {
+    void expectSameBuffer(const SharedPtr<HardwareBuffer>& a, const SharedPtr<HardwareBuffer>& b)
+    {
+        ASSERT_EQ(a->getSizeInBytes(), b->getSizeInBytes());
+        std::vector<uchar> dataA(a->getSizeInBytes()), dataB(b->getSizeInBytes());
+        a->readData(0, dataA.size(), &dataA[0]);
+        b->readData(0, dataB.size(), &dataB[0]);
+        EXPECT_TRUE(dataA == dataB);
+    }
+
+    void expectSameVertexData(VertexData* a, VertexData* b)
+    {
+        ASSERT_EQ(a->vertexCount, b->vertexCount);
+        ASSERT_EQ(a->vertexBufferBinding->getBufferCount(), b->vertexBufferBinding->getBufferCount());
+        for (unsigned short i = 0; i < a->vertexBufferBinding->getBufferCount(); ++i)
+            expectSameBuffer(a->vertexBufferBinding->getBuffer(i), b->vertexBufferBinding->getBuffer(i));
+    }
+}
+
+TEST_F(RootWithoutRenderSystemFixture, MeshSerializerParallelImport)
+{
+    // the buffers are filled straight from the memory of the stream
+    DataStreamPtr data(OGRE_NEW MemoryDataStream(ResourceGroupManager::getSingleton().openResource(
+        "facial.mesh", ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME)));
+
+    MeshSerializer serializer;
+    MeshPtr serial = MeshManager::getSingleton().createManual(
+        "SerialImport", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    serializer.importMesh(data, serial.get());
+
+    // large enough to be copied in several chunks
+    startWorkQueue();
+
+    data->seek(0);
+    MeshPtr parallel = MeshManager::getSingleton().createManual(
+        "ParallelImport", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    serializer.importMesh(data, parallel.get());
+
+    ASSERT_EQ(serial->getNumSubMeshes(), parallel->getNumSubMeshes());
+    ASSERT_EQ(serial->sharedVertexData != 0, parallel->sharedVertexData != 0);
+    if (serial->sharedVertexData)
+        expectSameVertexData(serial->sharedVertexData, parallel->sharedVertexData);
+    for (unsigned short i = 0; i < serial->getNumSubMeshes(); ++i)
+    {
+        SubMesh* a = serial->getSubMesh(i);
+        SubMesh* b = parallel->getSubMesh(i);
+        if (!a->useSharedVertices)
+            expectSameVertexData(a->vertexData, b->vertexData);
+        ASSERT_EQ(a->indexData->indexCount, b->indexData->indexCount);
+        if (a->indexData->indexCount)
+            expectSameBuffer(a->indexData->indexBuffer, b->indexData->indexBuffer);
+    }
+
+    MeshManager::getSingleton().remove(serial);
+    MeshManager::getSingleton().remove(parallel);
+}
+//--------------------------------------------------------------------------
+TEST_F(RootWithoutRenderSystemFixture, LoadResourceGroupPipelined)
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    Archive* models = rgm._getArchiveToResource("knot.mesh", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    ASSERT_TRUE(models);
+
+    const char* names[] = {"knot.mesh", "ninja.mesh", "penguin.mesh", "razor.mesh", "robot.mesh", "fish.mesh"};
+    const size_t numMeshes = sizeof(names) / sizeof(names[0]);
+    rgm.addResourceLocation(models->getName(), models->getType(), "Pipelined");
+    for (size_t i = 0; i < numMeshes; ++i)
+        rgm.declareResource(names[i], "Mesh", "Pipelined");
+    rgm.initialiseResourceGroup("Pipelined");
+
+    startWorkQueue();
+
+    // less than the largest mesh, so preparing has to wait for loading
+    rgm.loadResourceGroupPipelined("Pipelined", 200 * 1024);
+
+    for (size_t i = 0; i < numMeshes; ++i)
+    {
+        MeshPtr mesh = MeshManager::getSingleton().getByName(names[i], "Pipelined");
+        ASSERT_TRUE(mesh);
+        EXPECT_TRUE(mesh->isLoaded());
+        EXPECT_GT(mesh->getNumSubMeshes(), 0u);
+    }
+
+    const ResourceGroupManager::PipelineStatistics& stats = rgm.getPipelineStatistics();
+    EXPECT_EQ(numMeshes, stats.resourceCount);
+    EXPECT_EQ(numMeshes, stats.readCount);
+    EXPECT_EQ(numMeshes, stats.loadedCount);
+    EXPECT_GT(stats.loadedBytes, stats.peakBytesInFlight);
+    EXPECT_LE(stats.loadTime, stats.elapsedTime);
+
+    rgm.destroyResourceGroup("Pipelined");
+
+    // a failure is only rethrown once no task touches the resources anymore
+    rgm.addResourceLocation(models->getName(), models->getType(), "PipelinedMissing");
+    rgm.declareResource("missing.mesh", "Mesh", "PipelinedMissing");
+    for (size_t i = 0; i < numMeshes; ++i)
+        rgm.declareResource(names[i], "Mesh", "PipelinedMissing");
+    rgm.initialiseResourceGroup("PipelinedMissing");
+    EXPECT_THROW(rgm.loadResourceGroupPipelined("PipelinedMissing"), Exception);
+    rgm.destroyResourceGroup("PipelinedMissing");
+}
+
+namespace {
+    /// Texture without a render system, noting the threads its data is read and loaded on
+    class ThreadRecordingTexture : public Texture
+    {
+    public:
+        std::thread::id prepareThread;
+        std::thread::id loadThread;
+        DataStreamPtr data;
+
+        ThreadRecordingTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+            const String& group)
+            : Texture(creator, name, handle, group) {}
+
+        HardwarePixelBufferSharedPtr getBuffer(size_t, size_t) { return HardwarePixelBufferSharedPtr(); }
+
+    protected:
+        void prepareImpl()
+        {
+            prepareThread = std::this_thread::get_id();
+            data = ResourceGroupManager::getSingleton().openResource(mName, mGroup, this);
+        }
+        void unprepareImpl() { data.reset(); }
+        void loadImpl() { loadThread = std::this_thread::get_id(); }
+        void createInternalResourcesImpl() {}
+        void freeInternalResourcesImpl() {}
+    };
+
+    class ThreadRecordingTextureManager : public TextureManager
+    {
+    public:
+        ThreadRecordingTextureManager() { ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this); }
+        ~ThreadRecordingTextureManager() { ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType); }
+
+        PixelFormat getNativeFormat(TextureType, PixelFormat format, int) { return format; }
+        bool isHardwareFilteringSupported(TextureType, PixelFormat, int, bool) { return false; }
+
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle, const String& group, bool,
+            ManualResourceLoader*, const NameValuePairList*)
+        {
+            return new ThreadRecordingTexture(this, name, handle, group);
+        }
+    };
+}
+
+TEST_F(RootWithoutRenderSystemFixture, LoadResourceGroupPipelinedMaterial)
+{
+    ThreadRecordingTextureManager texMgr;
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    Archive* models = rgm._getArchiveToResource("knot.mesh", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Archive* textures = rgm._getArchiveToResource("white.bmp", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    ASSERT_TRUE(models);
+    ASSERT_TRUE(textures);
+
+    // the managers are not thread safe, so only the files may be read on the workers
+    const char* texNames[] = {"white.bmp", "dkyellow.png"};
+    rgm.addResourceLocation(models->getName(), models->getType(), "PipelinedMaterial");
+    rgm.addResourceLocation(textures->getName(), textures->getType(), "PipelinedMaterial");
+    rgm.declareResource("knot.mesh", "Mesh", "PipelinedMaterial");
+    for (size_t i = 0; i < 2; ++i)
+        rgm.declareResource(texNames[i], "Texture", "PipelinedMaterial");
+    rgm.initialiseResourceGroup("PipelinedMaterial");
+    MaterialPtr mat = MaterialManager::getSingleton().create("PipelinedMaterial", "PipelinedMaterial");
+    for (size_t i = 0; i < 2; ++i)
+        mat->getTechnique(0)->getPass(0)->createTextureUnitState(texNames[i]);
+
+    startWorkQueue();
+    rgm.loadResourceGroupPipelined("PipelinedMaterial");
+
+    EXPECT_TRUE(mat->isLoaded());
+    for (size_t i = 0; i < 2; ++i)
+    {
+        SharedPtr<ThreadRecordingTexture> tex = static_pointer_cast<ThreadRecordingTexture>(
+            texMgr.getByName(texNames[i], "PipelinedMaterial"));
+        ASSERT_TRUE(tex);
+        EXPECT_TRUE(tex->isLoaded());
+        EXPECT_EQ(std::this_thread::get_id(), tex->prepareThread);
+        EXPECT_EQ(std::this_thread::get_id(), tex->loadThread);
+        ASSERT_TRUE(tex->data);
+        EXPECT_EQ(textures->open(texNames[i])->size(), tex->data->size());
+    }
+    EXPECT_EQ(4u, rgm.getPipelineStatistics().readCount);
+
+    mat.reset();
+    rgm.destroyResourceGroup("PipelinedMaterial");
+}
+//--------------------------------------------------------------------------
+typedef std::map<uint32, std::vector<float> > RegionVertices;
+
+static RegionVertices getStaticGeometryPositions(StaticGeometry* sg)
+{
+    RegionVertices ret;
+    StaticGeometry::RegionIterator ri = sg->getRegionIterator();
+    while (ri.hasMoreElements())
+    {
+        StaticGeometry::Region* region = ri.getNext();
+        std::vector<float>& positions = ret[region->getID()];
+        StaticGeometry::Region::LODIterator li = region->getLODIterator();
+        while (li.hasMoreElements())
+        {
+            StaticGeometry::LODBucket::MaterialIterator mi = li.getNext()->getMaterialIterator();
+            while (mi.hasMoreElements())
+            {
+                StaticGeometry::MaterialBucket::GeometryIterator gi = mi.getNext()->getGeometryIterator();
+                while (gi.hasMoreElements())
+                {
+                    const VertexData* vd = gi.getNext()->getVertexData();
+                    const VertexElement* posElem = vd->vertexDeclaration->findElementBySemantic(VES_POSITION);
+                    HardwareVertexBufferSharedPtr vbuf = vd->vertexBufferBinding->getBuffer(posElem->getSource());
+                    uchar* vertex = static_cast<uchar*>(vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
+                    for (size_t v = 0; v < vd->vertexCount; ++v, vertex += vbuf->getVertexSize())
+                    {
+                        float* pos;
+                        posElem->baseVertexPointerToElement(vertex, &pos);
+                        positions.insert(positions.end(), pos, pos + 3);
+                    }
+                    vbuf->unlock();
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+TEST_F(RootWithoutRenderSystemFixture, StaticGeometryParallelBuild)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Entity* ent = sm->createEntity("robot.mesh");
+    ent->setMaterialName("BaseWhite");
+
+    StaticGeometry* sg = sm->createStaticGeometry("Forest");
+    sg->setRegionDimensions(Vector3(200));
+    for (int i = 0; i < 64; ++i)
+    {
+        sg->addEntity(ent, Vector3(Real(i % 8) * 60, 0, Real(i / 8) * 60),
+                      Quaternion(Degree(Real(i * 10)), Vector3::UNIT_Y));
+    }
+
+    sg->build();
+    RegionVertices serial = getStaticGeometryPositions(sg);
+
+    startWorkQueue();
+
+    sg->build();
+    RegionVertices parallel = getStaticGeometryPositions(sg);
+
+    size_t numVertices = 0;
+    for (RegionVertices::iterator i = parallel.begin(); i != parallel.end(); ++i)
+        numVertices += i->second.size() / 3;
+
+    const Mesh* mesh = ent->getMesh().get();
+    size_t meshVertices = mesh->sharedVertexData ? mesh->sharedVertexData->vertexCount : 0;
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+    {
+        if (!mesh->getSubMesh(i)->useSharedVertices)
+            meshVertices += mesh->getSubMesh(i)->vertexData->vertexCount;
+    }
+    EXPECT_EQ(64 * meshVertices, numVertices);
+    EXPECT_EQ(serial, parallel);
+
+    sm->destroyStaticGeometry(sg);
+    mRoot->destroySceneManager(sm);
+}
+
+static EdgeData* buildGridEdgeList(const VertexData* vd, const IndexData* id)
+{
+    EdgeListBuilder builder;
+    builder.addVertexData(vd);
+    // the grid twice, so every edge has more than two triangles
+    builder.addIndexData(id);
+    builder.addIndexData(id);
+    return builder.build();
+}
+
+TEST_F(RootWithoutRenderSystemFixture, EdgeListBuilderParallelBuild)
+{
+    // a grid of quads, each with their own vertices so they have to be welded
+    const size_t size = 64;
+    VertexData vd;
+    vd.vertexCount = size * size * 4;
+    vd.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        sizeof(float) * 3, vd.vertexCount, HardwareBuffer::HBU_STATIC, true);
+    vd.vertexBufferBinding->setBinding(0, vbuf);
+
+    IndexData id;
+    id.indexCount = size * size * 6;
+    id.indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_32BIT, id.indexCount, HardwareBuffer::HBU_STATIC, true);
+
+    float* pos = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    uint32* idx = static_cast<uint32*>(id.indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t y = 0; y < size; ++y)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            uint32 base = uint32((y * size + x) * 4);
+            for (int c = 0; c < 4; ++c)
+            {
+                *pos++ = float(x + (c & 1));
+                *pos++ = float(y + (c >> 1));
+                *pos++ = 0;
+            }
+            *idx++ = base; *idx++ = base + 1; *idx++ = base + 3;
+            *idx++ = base; *idx++ = base + 3; *idx++ = base + 2;
+        }
+    }
+    id.indexBuffer->unlock();
+    vbuf->unlock();
+
+    EdgeData* serial = buildGridEdgeList(&vd, &id);
+
+    startWorkQueue();
+
+    EdgeData* parallel = buildGridEdgeList(&vd, &id);
+
+    ASSERT_EQ(size * size * 4, parallel->triangles.size());
+    EXPECT_TRUE(parallel->isClosed == serial->isClosed);
+    const EdgeData::EdgeList& edges = parallel->edgeGroups[0].edges;
+    const EdgeData::EdgeList& expected = serial->edgeGroups[0].edges;
+    ASSERT_EQ(expected.size(), edges.size());
+    // every side of the grid starts two edges, as the grid is added twice
+    EXPECT_EQ((size * (size + 1) * 2 + size * size) * 2, edges.size());
+    EXPECT_FALSE(parallel->isClosed);
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        EXPECT_EQ(expected[i].triIndex[0], edges[i].triIndex[0]);
+        EXPECT_EQ(expected[i].triIndex[1], edges[i].triIndex[1]);
+        EXPECT_EQ(expected[i].sharedVertIndex[0], edges[i].sharedVertIndex[0]);
+        EXPECT_EQ(expected[i].sharedVertIndex[1], edges[i].sharedVertIndex[1]);
+        EXPECT_EQ(expected[i].vertIndex[0], edges[i].vertIndex[0]);
+        EXPECT_EQ(expected[i].degenerate, edges[i].degenerate);
+    }
+
+    OGRE_DELETE serial;
+    OGRE_DELETE parallel;
+}
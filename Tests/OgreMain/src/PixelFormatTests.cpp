@@ -26,6 +26,8 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "PixelFormatTests.h"
+#include "OgreImage.h"
+#include "OgreBitwise.h"
 #include <cstdlib>
 #include <iomanip>
 
@@ -223,3 +225,264 @@ TEST_F(PixelFormatTests,BulkConversion)
 }
 //--------------------------------------------------------------------------
 
+TEST_F(PixelFormatTests,ComponentConversion)
+{
+    // 8 bit, half and float formats with matching layouts are converted a
+    // component at a time, which has to match unpacking and packing
+    const PixelFormat pairs[][2] = {
+        {PF_BYTE_RGBA, PF_FLOAT32_RGBA}, {PF_FLOAT32_RGBA, PF_BYTE_RGBA},
+        {PF_BYTE_RGBA, PF_FLOAT16_RGBA}, {PF_FLOAT16_RGBA, PF_BYTE_RGBA},
+        {PF_FLOAT16_RGBA, PF_FLOAT32_RGBA}, {PF_FLOAT32_RGBA, PF_FLOAT16_RGBA},
+        {PF_BYTE_RGB, PF_FLOAT32_RGB}, {PF_FLOAT32_RGB, PF_BYTE_RGB},
+        {PF_BYTE_RGB, PF_FLOAT16_RGB}, {PF_FLOAT16_RGB, PF_BYTE_RGB},
+        {PF_FLOAT16_RGB, PF_FLOAT32_RGB}, {PF_FLOAT32_RGB, PF_FLOAT16_RGB},
+        {PF_FLOAT16_GR, PF_FLOAT32_GR}, {PF_FLOAT32_GR, PF_FLOAT16_GR},
+        {PF_FLOAT16_R, PF_FLOAT32_R}, {PF_FLOAT32_R, PF_FLOAT16_R}
+    };
+
+    for(size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++)
+    {
+        for(int pass = 0; pass < 2; pass++)
+        {
+            // NaN conversion to 8 bit is undefined, so keep sources finite.
+            // The first pass covers all magnitudes, the second one the range
+            // that matters for 8 bit.
+            srand(0);
+            PixelComponentType type = PixelUtil::getComponentType(pairs[i][0]);
+            if(type == PCT_FLOAT32)
+            {
+                float* data = reinterpret_cast<float*>(mRandomData);
+                for(int x = 0; x < mSize / 4; x++)
+                {
+                    uint32 bits = ((uint32)rand() << 16) ^ (uint32)rand();
+                    if((bits & 0x7f800000) == 0x7f800000)
+                        bits &= ~0x00800000;
+                    memcpy(&data[x], &bits, sizeof(bits));
+                    if(pass == 1)
+                        data[x] = (float)rand() / RAND_MAX * 1.5f - 0.25f;
+                }
+            }
+            else if(type == PCT_FLOAT16)
+            {
+                uint16* data = reinterpret_cast<uint16*>(mRandomData);
+                for(int x = 0; x < mSize / 2; x++)
+                {
+                    data[x] = (uint16)rand();
+                    if((data[x] & 0x7c00) == 0x7c00)
+                        data[x] &= ~0x0400;
+                    if(pass == 1)
+                        data[x] = Bitwise::floatToHalf((float)rand() / RAND_MAX * 1.5f - 0.25f);
+                }
+            }
+            else
+            {
+                for(int x = 0; x < mSize; x++)
+                    mRandomData[x] = (uint8)rand();
+            }
+            testCase(pairs[i][0], pairs[i][1]);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,LinearScaleByte)
+{
+    // 4 channel images use the vectorised row filter, compare with the
+    // scalar filter for 3 and 1 channel images holding the same data
+    const size_t width = 37, height = 23;
+    PixelBox rgba(width, height, 1, PF_BYTE_RGBA, mRandomData);
+    std::vector<uint8> rgbData(width * height * 3), alphaData(width * height);
+    for(size_t p = 0; p < width * height; p++)
+    {
+        memcpy(&rgbData[p * 3], &mRandomData[p * 4], 3);
+        alphaData[p] = mRandomData[p * 4 + 3];
+    }
+    PixelBox rgb(width, height, 1, PF_BYTE_RGB, &rgbData[0]);
+    PixelBox alpha(width, height, 1, PF_L8, &alphaData[0]);
+
+    const size_t sizes[][2] = { {53, 31}, {17, 11}, {37, 5} };
+    for(size_t i = 0; i < 3; i++)
+    {
+        size_t w = sizes[i][0], h = sizes[i][1];
+        std::vector<uint8> rgbaOut(w * h * 4), rgbOut(w * h * 3), alphaOut(w * h);
+        Image::scale(rgba, PixelBox(w, h, 1, PF_BYTE_RGBA, &rgbaOut[0]), Image::FILTER_BILINEAR);
+        Image::scale(rgb, PixelBox(w, h, 1, PF_BYTE_RGB, &rgbOut[0]), Image::FILTER_BILINEAR);
+        Image::scale(alpha, PixelBox(w, h, 1, PF_L8, &alphaOut[0]), Image::FILTER_BILINEAR);
+
+        for(size_t p = 0; p < w * h; p++)
+        {
+            EXPECT_EQ(0, memcmp(&rgbaOut[p * 4], &rgbOut[p * 3], 3)) << "pixel " << p;
+            EXPECT_EQ(rgbaOut[p * 4 + 3], alphaOut[p]) << "pixel " << p;
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,BoxScale)
+{
+    // Halving averages each 2x2 block, with rounding for 8 bit formats
+    const size_t width = 10, height = 6;
+    PixelBox src(width, height, 1, PF_BYTE_RGBA, mRandomData);
+    std::vector<float> floatData(width * height * 4);
+    PixelBox floatSrc(width, height, 1, PF_FLOAT32_RGBA, &floatData[0]);
+    PixelUtil::bulkPixelConversion(src, floatSrc);
+
+    std::vector<uint8> out(width * height);
+    std::vector<float> floatOut(width * height);
+    Image::scale(src, PixelBox(width / 2, height / 2, 1, PF_BYTE_RGBA, &out[0]), Image::FILTER_BOX);
+    Image::scale(floatSrc, PixelBox(width / 2, height / 2, 1, PF_FLOAT32_RGBA, &floatOut[0]), Image::FILTER_BOX);
+
+    for(size_t y = 0; y < height / 2; y++)
+    {
+        for(size_t x = 0; x < width / 2; x++)
+        {
+            for(size_t k = 0; k < 4; k++)
+            {
+                size_t s = ((y * 2) * width + x * 2) * 4 + k;
+                unsigned int sum = mRandomData[s] + mRandomData[s + 4] +
+                    mRandomData[s + width * 4] + mRandomData[s + width * 4 + 4];
+                size_t d = (y * (width / 2) + x) * 4 + k;
+                EXPECT_EQ((sum + 2) / 4, out[d]);
+                EXPECT_NEAR(sum / (4 * 255.0f), floatOut[d], 1e-6f);
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,GenerateMipmapsBox)
+{
+    // Every level averages the corresponding block of the top level
+    const uint32 width = 8, height = 4;
+    Image mipmapped;
+    mipmapped.loadDynamicImage(OGRE_ALLOC_T(uchar, width * height * 16, MEMCATEGORY_GENERAL),
+        width, height, 1, PF_FLOAT32_RGBA, true);
+    float* data = reinterpret_cast<float*>(mipmapped.getData());
+    for(size_t i = 0; i < width * height * 4; i++)
+        data[i] = mRandomData[i] / 255.0f;
+
+    mipmapped.generateMipmaps(false, Image::FILTER_BOX);
+    ASSERT_EQ(3u, mipmapped.getNumMipmaps());
+    EXPECT_EQ(Image::calculateSize(3, 1, width, height, 1, PF_FLOAT32_RGBA), mipmapped.getSize());
+
+    for(size_t mip = 1; mip <= 3; mip++)
+    {
+        PixelBox box = mipmapped.getPixelBox(0, mip);
+        size_t blockWidth = width / box.getWidth(), blockHeight = height / box.getHeight();
+        const float* level = reinterpret_cast<const float*>(box.data);
+        for(size_t y = 0; y < box.getHeight(); y++)
+        {
+            for(size_t x = 0; x < box.getWidth(); x++)
+            {
+                for(size_t k = 0; k < 4; k++)
+                {
+                    float sum = 0;
+                    for(size_t sy = y * blockHeight; sy < (y + 1) * blockHeight; sy++)
+                        for(size_t sx = x * blockWidth; sx < (x + 1) * blockWidth; sx++)
+                            sum += mRandomData[(sy * width + sx) * 4 + k] / 255.0f;
+                    EXPECT_NEAR(sum / (blockWidth * blockHeight), level[(y * box.getWidth() + x) * 4 + k], 1e-5f);
+                }
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,GenerateMipmapsGamma)
+{
+    // A checkerboard of black and white averages to half intensity in
+    // linear space, alpha is always averaged as is
+    const uint32 size = 4;
+    Image linear, gamma;
+    linear.loadDynamicImage(OGRE_ALLOC_T(uchar, size * size * 4, MEMCATEGORY_GENERAL),
+        size, size, 1, PF_BYTE_RGBA, true);
+    for(size_t i = 0; i < size * size; i++)
+    {
+        uint8 value = ((i % size) + (i / size)) % 2 ? 255 : 0;
+        memset(linear.getData() + i * 4, value, 4);
+    }
+    gamma = linear;
+    linear.generateMipmaps(false);
+    gamma.generateMipmaps(true);
+
+    ASSERT_EQ(2u, gamma.getNumMipmaps());
+    for(size_t mip = 1; mip <= 2; mip++)
+    {
+        const uint8* l = linear.getPixelBox(0, mip).data;
+        const uint8* g = gamma.getPixelBox(0, mip).data;
+        EXPECT_EQ(128, l[0]);
+        EXPECT_EQ(128, l[3]);
+        EXPECT_EQ(188, g[0]);
+        EXPECT_EQ(188, g[2]);
+        EXPECT_EQ(128, g[3]);
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,GenerateMipmapsKaiser)
+{
+    // The weights are normalised, so a constant cubemap stays constant
+    const uint32 size = 16;
+    Image img;
+    size_t bytes = Image::calculateSize(0, 6, size, size, 1, PF_BYTE_RGBA);
+    img.loadDynamicImage(OGRE_ALLOC_T(uchar, bytes, MEMCATEGORY_GENERAL), size, size, 1, PF_BYTE_RGBA, true, 6);
+    for(size_t i = 0; i < bytes; i += 4)
+    {
+        img.getData()[i] = 10;
+        img.getData()[i + 1] = 100;
+        img.getData()[i + 2] = 200;
+        img.getData()[i + 3] = 255;
+    }
+
+    img.generateMipmaps(false, Image::FILTER_KAISER);
+    ASSERT_EQ(4u, img.getNumMipmaps());
+    EXPECT_TRUE(img.hasFlag(IF_CUBEMAP));
+    for(size_t face = 0; face < 6; face++)
+    {
+        for(size_t mip = 1; mip <= 4; mip++)
+        {
+            PixelBox box = img.getPixelBox(face, mip);
+            for(size_t i = 0; i < box.getConsecutiveSize(); i += 4)
+            {
+                EXPECT_NEAR(10, box.data[i], 1);
+                EXPECT_NEAR(100, box.data[i + 1], 1);
+                EXPECT_NEAR(200, box.data[i + 2], 1);
+                EXPECT_EQ(255, box.data[i + 3]);
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,GenerateMipmapsKaiserEdge)
+{
+    // A vertical step edge, filtered across by the windowed sinc with its
+    // ringing clamped away, in linear space if gamma corrected
+    const uint32 size = 16;
+    const uint8 expected[2][2][8] = {
+        {{0, 2, 0, 15, 240, 255, 253, 255}, {0, 18, 237, 255}},
+        {{0, 19, 0, 67, 249, 255, 254, 255}, {0, 75, 247, 255}}};
+    for(int gamma = 0; gamma < 2; gamma++)
+    {
+        Image img;
+        img.loadDynamicImage(OGRE_ALLOC_T(uchar, size * size * 4, MEMCATEGORY_GENERAL),
+            size, size, 1, PF_BYTE_RGBA, true);
+        for(size_t i = 0; i < size * size; i++)
+        {
+            memset(img.getData() + i * 4, i % size < size / 2 ? 0 : 255, 3);
+            img.getData()[i * 4 + 3] = 255;
+        }
+
+        img.generateMipmaps(gamma != 0, Image::FILTER_KAISER);
+        for(size_t mip = 1; mip <= 2; mip++)
+        {
+            PixelBox box = img.getPixelBox(0, mip);
+            for(size_t y = 0; y < box.getHeight(); y++)
+            {
+                for(size_t x = 0; x < box.getWidth(); x++)
+                {
+                    const uint8* texel = box.data + (y * box.getWidth() + x) * 4;
+                    EXPECT_NEAR(expected[gamma][mip - 1][x], texel[0], 1) << gamma << " " << mip << " " << x;
+                    EXPECT_EQ(texel[0], texel[1]);
+                    EXPECT_EQ(texel[0], texel[2]);
+                    EXPECT_EQ(255, texel[3]);
+                }
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
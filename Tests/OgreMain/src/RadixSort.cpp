@@ -203,5 +203,45 @@ TEST_F(RadixSortTests,IntVector)
     }
 }
 //--------------------------------------------------------------------------
+struct KeyIndex
+{
+    uint64 key;
+    int index;
+};
+//--------------------------------------------------------------------------
+class KeyIndexSortFunctor
+{
+public:
+    uint64 operator()(const KeyIndex& p) const
+    {
+        return p.key;
+    }
+};
+//--------------------------------------------------------------------------
+TEST_F(RadixSortTests,Uint64VectorStable)
+{
+    std::vector<KeyIndex> container;
+    KeyIndexSortFunctor func;
+    RadixSort<std::vector<KeyIndex>, KeyIndex, uint64> sorter;
 
+    // few distinct keys spread over the upper and lower bytes, so most
+    // passes are skipped and many keys are equal
+    for (int i = 0; i < 1000; ++i)
+    {
+        KeyIndex ki;
+        ki.key = (uint64(i % 7) << 48) | uint64((i * 13) % 5);
+        ki.index = i;
+        container.push_back(ki);
+    }
 
+    sorter.sort(container, func);
+
+    for (size_t i = 1; i < container.size(); ++i)
+    {
+        EXPECT_TRUE(container[i - 1].key <= container[i].key);
+        if (container[i - 1].key == container[i].key)
+        {
+            EXPECT_TRUE(container[i - 1].index < container[i].index);
+        }
+    }
+}
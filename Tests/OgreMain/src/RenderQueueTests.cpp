@@ -0,0 +1,205 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreRenderQueueSortingGrouping.h"
+#include "OgreRenderable.h"
+#include "OgrePass.h"
+
+using namespace Ogre;
+
+namespace
+{
+    /// Renderable at a fixed distance from any camera
+    class DepthRenderable : public Renderable
+    {
+    public:
+        Real depth;
+
+        DepthRenderable(Real d) : depth(d) {}
+
+        const MaterialPtr& getMaterial(void) const { return mMaterial; }
+        void getRenderOperation(RenderOperation& op) {}
+        void getWorldTransforms(Matrix4* xform) const { *xform = Matrix4::IDENTITY; }
+        Real getSquaredViewDepth(const Camera* cam) const { return depth; }
+        const LightList& getLights(void) const { return mLights; }
+    private:
+        MaterialPtr mMaterial;
+        LightList mLights;
+    };
+
+    /// Records the order of visits
+    class RecordingVisitor : public QueuedRenderableVisitor
+    {
+    public:
+        vector<const Pass*>::type passes;
+        vector<Renderable*>::type renderables;
+        const Pass* skippedPass;
+
+        RecordingVisitor() : skippedPass(0) {}
+
+        void visit(RenderablePass* rp)
+        {
+            passes.push_back(rp->pass);
+            renderables.push_back(rp->renderable);
+        }
+        bool visit(const Pass* p)
+        {
+            passes.push_back(p);
+            return p != skippedPass;
+        }
+        void visit(Renderable* r) { renderables.push_back(r); }
+    };
+}
+//--------------------------------------------------------------------------
+TEST(QueuedRenderableCollection, GroupsByPassNearFirst)
+{
+    Pass pass0(0, 0), pass1(0, 1), pass2(0, 2);
+    Pass* passes[] = {&pass2, &pass0, &pass1};
+
+    std::vector<DepthRenderable*> rends;
+    QueuedRenderableCollection collection;
+    collection.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+
+    // interleave passes and depths
+    for (int i = 0; i < 30; ++i)
+    {
+        rends.push_back(new DepthRenderable(Real((i * 17) % 30)));
+        collection.addRenderable(passes[i % 3], rends.back());
+    }
+    collection.sort(0);
+
+    RecordingVisitor visitor;
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+
+    ASSERT_EQ(3u, visitor.passes.size());
+    EXPECT_EQ(&pass0, visitor.passes[0]);
+    EXPECT_EQ(&pass1, visitor.passes[1]);
+    EXPECT_EQ(&pass2, visitor.passes[2]);
+    ASSERT_EQ(30u, visitor.renderables.size());
+    for (int p = 0; p < 3; ++p)
+    {
+        for (int i = 1; i < 10; ++i)
+        {
+            EXPECT_LT(visitor.renderables[p * 10 + i - 1]->getSquaredViewDepth(0),
+                      visitor.renderables[p * 10 + i]->getSquaredViewDepth(0));
+        }
+    }
+
+    // skipping a pass skips its renderables only
+    visitor = RecordingVisitor();
+    visitor.skippedPass = &pass1;
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+    EXPECT_EQ(3u, visitor.passes.size());
+    EXPECT_EQ(20u, visitor.renderables.size());
+
+    // entries of a removed pass are gone
+    collection.removePassGroup(&pass0);
+    visitor = RecordingVisitor();
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+    EXPECT_EQ(2u, visitor.passes.size());
+    EXPECT_EQ(20u, visitor.renderables.size());
+
+    collection.clear();
+    visitor = RecordingVisitor();
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+    EXPECT_TRUE(visitor.passes.empty());
+
+    for (size_t i = 0; i < rends.size(); ++i)
+        delete rends[i];
+}
+//--------------------------------------------------------------------------
+TEST(QueuedRenderableCollection, GroupsPassesSharingHash)
+{
+    // same index and no textures, so both get the same hash
+    Pass passA(0, 0), passB(0, 0);
+    ASSERT_EQ(passA.getHash(), passB.getHash());
+
+    std::vector<DepthRenderable*> rends;
+    QueuedRenderableCollection collection;
+    collection.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+    for (int i = 0; i < 20; ++i)
+    {
+        rends.push_back(new DepthRenderable(Real(i)));
+        collection.addRenderable(i % 2 ? &passB : &passA, rends.back());
+    }
+    collection.sort(0);
+
+    RecordingVisitor visitor;
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+
+    // one state change per pass, near first inside each
+    ASSERT_EQ(2u, visitor.passes.size());
+    EXPECT_NE(visitor.passes[0], visitor.passes[1]);
+    ASSERT_EQ(20u, visitor.renderables.size());
+    for (int p = 0; p < 2; ++p)
+    {
+        for (int i = 1; i < 10; ++i)
+        {
+            EXPECT_LT(visitor.renderables[p * 10 + i - 1]->getSquaredViewDepth(0),
+                      visitor.renderables[p * 10 + i]->getSquaredViewDepth(0));
+        }
+    }
+
+    for (size_t i = 0; i < rends.size(); ++i)
+        delete rends[i];
+}
+//--------------------------------------------------------------------------
+TEST(QueuedRenderableCollection, SortsDescendingFarFirst)
+{
+    Pass pass0(0, 0), pass1(0, 1);
+
+    // enough items for the radix sort path
+    std::vector<DepthRenderable*> rends;
+    QueuedRenderableCollection collection;
+    collection.addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+    for (int i = 0; i < 3000; ++i)
+    {
+        rends.push_back(new DepthRenderable(Real((i * 7919) % 1500)));
+        collection.addRenderable(i % 2 ? &pass1 : &pass0, rends.back());
+    }
+    collection.sort(0);
+
+    RecordingVisitor visitor;
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_SORT_DESCENDING);
+    ASSERT_EQ(3000u, visitor.renderables.size());
+    for (size_t i = 1; i < visitor.renderables.size(); ++i)
+    {
+        Real prev = visitor.renderables[i - 1]->getSquaredViewDepth(0);
+        Real cur = visitor.renderables[i]->getSquaredViewDepth(0);
+        ASSERT_GE(prev, cur);
+        // equal depths are ordered by pass
+        if (prev == cur)
+        {
+            EXPECT_LE(visitor.passes[i - 1]->getHash(), visitor.passes[i]->getHash());
+        }
+    }
+
+    for (size_t i = 0; i < rends.size(); ++i)
+        delete rends[i];
+}
@@ -9,6 +9,7 @@
 
 #include <Ogre.h>
 #include <OgreDefaultHardwareBufferManager.h>
+#include <OgreWorkQueue.h>
 
 using namespace Ogre;
 
@@ -43,7 +44,21 @@ void RootWithoutRenderSystemFixture::SetUp()
 
 void RootWithoutRenderSystemFixture::TearDown()
 {
+    // also when a test failed before stopping the queue itself
+    stopWorkQueue();
     delete mRoot;
     delete mHBM;
     delete mFSLayer;
 }
+
+void RootWithoutRenderSystemFixture::startWorkQueue(size_t threadCount)
+{
+    DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+    wq->setWorkerThreadCount(threadCount);
+    wq->startup();
+}
+
+void RootWithoutRenderSystemFixture::stopWorkQueue()
+{
+    mRoot->getWorkQueue()->shutdown();
+}
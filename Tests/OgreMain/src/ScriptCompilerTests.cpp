@@ -0,0 +1,203 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+#include "OgreScriptCompiler.h"
+#include "OgreDataStream.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreRoot.h"
+#include "OgreStringConverter.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace Ogre;
+
+namespace {
+    ConcreteNodePtr addNode(ConcreteNodeList& list, ConcreteNode* parent, const String& token,
+                            ConcreteNodeType type, unsigned int line)
+    {
+        ConcreteNodePtr node(OGRE_NEW ConcreteNode());
+        node->token = token;
+        node->file = "test.material";
+        node->line = line;
+        node->type = type;
+        node->parent = parent;
+        list.push_back(node);
+        return node;
+    }
+
+    void expectSameNodes(const ConcreteNodeList& a, const ConcreteNodeList& b, const ConcreteNode* parent)
+    {
+        ASSERT_EQ(a.size(), b.size());
+        for (ConcreteNodeList::const_iterator i = a.begin(), j = b.begin(); i != a.end(); ++i, ++j)
+        {
+            EXPECT_EQ((*i)->token, (*j)->token);
+            EXPECT_EQ((*i)->file, (*j)->file);
+            EXPECT_EQ((*i)->line, (*j)->line);
+            EXPECT_EQ((*i)->type, (*j)->type);
+            EXPECT_EQ(parent, (*j)->parent);
+            expectSameNodes((*i)->children, (*j)->children, (*j).get());
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+TEST(ScriptCompilerTests, ConcreteNodeListCache)
+{
+    String script = "material Test : Base { diffuse \"1\n0 0\" }";
+    ConcreteNodeListPtr nodes(OGRE_NEW_T(ConcreteNodeList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+    ConcreteNodePtr mat = addNode(*nodes, 0, "material", CNT_WORD, 1);
+    addNode(mat->children, mat.get(), "Test", CNT_WORD, 1);
+    addNode(mat->children, mat.get(), ":", CNT_COLON, 1);
+    addNode(mat->children, mat.get(), "Base", CNT_WORD, 1);
+    ConcreteNodePtr body = addNode(mat->children, mat.get(), "{", CNT_LBRACE, 1);
+    ConcreteNodePtr diffuse = addNode(body->children, body.get(), "diffuse", CNT_WORD, 1);
+    addNode(diffuse->children, diffuse.get(), "1\n0 0", CNT_QUOTE, 1);
+    addNode(body->children, body.get(), "}", CNT_RBRACE, 2);
+
+    DataStreamPtr cache(OGRE_NEW MemoryDataStream(4096));
+    ConcreteNodeListSerializer serializer;
+    serializer.exportConcreteNodeList(nodes, script, cache);
+
+    // unchanged source, the tree comes back as parsed
+    cache->seek(0);
+    ConcreteNodeListPtr cached = serializer.importConcreteNodeList(cache, script, "test.material");
+    ASSERT_TRUE(cached);
+    expectSameNodes(*nodes, *cached, 0);
+
+    // changed source, the cache is stale
+    cache->seek(0);
+    EXPECT_FALSE(serializer.importConcreteNodeList(cache, script + "\n", "test.material"));
+
+    // not a cache at all
+    DataStreamPtr garbage(OGRE_NEW MemoryDataStream(const_cast<char*>(script.data()), script.size()));
+    EXPECT_FALSE(serializer.importConcreteNodeList(garbage, script, "test.material"));
+}
+
+//--------------------------------------------------------------------------
+TEST_F(RootWithoutRenderSystemFixture, ScriptCompilerCache)
+{
+    {
+        std::ofstream script("ScriptCacheTest.material");
+        script << "material ScriptCacheTest { technique { pass { diffuse 1 0 0 } } }\n";
+    }
+
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    ScriptCompilerManager::getSingleton().setScriptCacheEnabled(true);
+
+    // the first run parses the script and writes the cache next to it
+    rgm.addResourceLocation("./", "FileSystem", "ScriptCache", false, false);
+    rgm.initialiseResourceGroup("ScriptCache");
+    EXPECT_TRUE(MaterialManager::getSingleton().resourceExists("ScriptCacheTest"));
+    EXPECT_TRUE(std::ifstream("ScriptCacheTest.material.cache").good());
+    rgm.destroyResourceGroup("ScriptCache");
+
+    // the second run loads the cache
+    rgm.addResourceLocation("./", "FileSystem", "ScriptCache", false, false);
+    rgm.initialiseResourceGroup("ScriptCache");
+    MaterialPtr mat = MaterialManager::getSingleton().getByName("ScriptCacheTest", "ScriptCache");
+    ASSERT_TRUE(mat);
+    EXPECT_EQ(ColourValue::Red, mat->getTechnique(0)->getPass(0)->getDiffuse());
+    rgm.destroyResourceGroup("ScriptCache");
+
+    ScriptCompilerManager::getSingleton().setScriptCacheEnabled(false);
+    std::remove("ScriptCacheTest.material");
+    std::remove("ScriptCacheTest.material.cache");
+}
+
+//--------------------------------------------------------------------------
+namespace
+{
+    /// Skips one script and records the streams opened for the others
+    struct ScriptSkippingListener : public ResourceGroupListener, public ResourceLoadingListener
+    {
+        String skipped;
+        StringVector opened;
+
+        void scriptParseStarted(const String& scriptName, bool& skipThisScript)
+        {
+            skipThisScript = scriptName == skipped;
+        }
+        DataStreamPtr resourceLoading(const String&, const String&, Resource*) { return DataStreamPtr(); }
+        void resourceStreamOpened(const String& name, const String&, Resource*, DataStreamPtr&)
+        {
+            opened.push_back(name);
+        }
+        bool resourceCollision(Resource*, ResourceManager*) { return true; }
+    };
+}
+TEST_F(RootWithoutRenderSystemFixture, ParallelScriptParsing)
+{
+    const int numScripts = 8;
+    for (int i = 0; i < numScripts; ++i)
+    {
+        // abstract objects are local to their script, so every script gets its own base
+        std::ofstream script(("ParallelScript" + StringConverter::toString(i) + ".material").c_str());
+        script << "abstract pass Base { diffuse " << i << " 0 0 }\n";
+        script << "material ParallelScript" << i << " { technique { pass : Base { } } }\n";
+    }
+
+    startWorkQueue();
+
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    ScriptSkippingListener listener;
+    listener.skipped = "ParallelScript3.material";
+    rgm.addResourceGroupListener(&listener);
+    rgm.setLoadingListener(&listener);
+    rgm.setParallelScriptParsingEnabled(true);
+    rgm.addResourceLocation("./", "FileSystem", "ParallelScripts", false);
+    rgm.initialiseResourceGroup("ParallelScripts");
+    rgm.removeResourceGroupListener(&listener);
+    rgm.setLoadingListener(0);
+
+    for (int i = 0; i < numScripts; ++i)
+    {
+        String name = "ParallelScript" + StringConverter::toString(i);
+        bool opened = std::find(listener.opened.begin(), listener.opened.end(), name + ".material") != listener.opened.end();
+        MaterialPtr mat = MaterialManager::getSingleton().getByName(name, "ParallelScripts");
+        if (i == 3)
+        {
+            // the listener only hears about the scripts that are parsed
+            EXPECT_FALSE(opened);
+            EXPECT_FALSE(mat);
+            continue;
+        }
+        EXPECT_TRUE(opened);
+        ASSERT_TRUE(mat);
+        EXPECT_EQ(ColourValue(i, 0, 0), mat->getTechnique(0)->getPass(0)->getDiffuse());
+    }
+
+    rgm.destroyResourceGroup("ParallelScripts");
+    rgm.setParallelScriptParsingEnabled(false);
+    for (int i = 0; i < numScripts; ++i)
+        std::remove(("ParallelScript" + StringConverter::toString(i) + ".material").c_str());
+}
@@ -0,0 +1,229 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+#include "OgreException.h"
+
+using namespace Ogre;
+
+namespace
+{
+    /// Counts how often each index is visited
+    struct CountVisits
+    {
+        vector<int>::type* visits;
+        void operator()(size_t begin, size_t end) const
+        {
+            for (size_t i = begin; i < end; ++i)
+                ++(*visits)[i];
+        }
+    };
+
+    /// Sums the indices of a range
+    struct SumIndices
+    {
+        AtomicScalar<size_t>* sum;
+        void operator()(size_t begin, size_t end) const
+        {
+            size_t s = 0;
+            for (size_t i = begin; i < end; ++i)
+                s += i;
+            *sum += s;
+        }
+    };
+
+    /// Runs an inner parallelFor for every index
+    struct NestedSum
+    {
+        WorkQueue* queue;
+        AtomicScalar<size_t>* sum;
+        void operator()(size_t begin, size_t end) const
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                SumIndices inner = {sum};
+                queue->parallelFor(0, 100, 3, inner);
+            }
+        }
+    };
+
+    struct ThrowAt
+    {
+        size_t index;
+        void operator()(size_t begin, size_t end) const
+        {
+            if (begin <= index && index < end)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "failed", "ThrowAt");
+        }
+    };
+
+    /// Blocks its worker until released
+    struct BlockTask
+    {
+        AtomicScalar<bool>* started;
+        AtomicScalar<bool>* released;
+        void operator()() const
+        {
+            *started = true;
+            while (!*released)
+                OGRE_THREAD_SLEEP(1);
+        }
+    };
+
+    /// Records its priority when run
+    struct RecordTask
+    {
+        int id;
+        AtomicScalar<int>* order;
+        AtomicScalar<int>* position;
+        void operator()() const
+        {
+            position[id] = (*order)++;
+        }
+    };
+
+    typedef DefaultWorkQueueBase* (*CreateWorkQueue)();
+
+    DefaultWorkQueueBase* createDefaultWorkQueue() { return OGRE_NEW DefaultWorkQueue("Test"); }
+#if OGRE_THREAD_PROVIDER == 4
+    DefaultWorkQueueBase* createStealingWorkQueue() { return OGRE_NEW StealingWorkQueue("Test"); }
+#endif
+}
+
+/// Runs every test against each WorkQueue implementation, whichever one Root uses
+struct WorkQueueTests : public ::testing::TestWithParam<CreateWorkQueue>
+{
+    Root* mRoot;
+    DefaultWorkQueueBase* mQueue;
+
+    void SetUp()
+    {
+        mRoot = new Root("");
+        mQueue = GetParam()();
+        mRoot->setWorkQueue(mQueue);
+    }
+
+    void TearDown()
+    {
+        delete mRoot;
+    }
+};
+//--------------------------------------------------------------------------
+TEST_P(WorkQueueTests, SynchronousWhenNotRunning)
+{
+    EXPECT_EQ(0u, mQueue->getTaskConcurrency());
+
+    AtomicScalar<size_t> sum(0);
+    SumIndices task = {&sum};
+    mQueue->parallelFor(0, 1000, 10, task);
+    EXPECT_EQ(999u * 1000u / 2, (size_t)sum);
+}
+//--------------------------------------------------------------------------
+TEST_P(WorkQueueTests, ParallelForVisitsAllOnce)
+{
+    mQueue->setWorkerThreadCount(3);
+    mQueue->startup();
+#if OGRE_THREAD_SUPPORT
+    EXPECT_EQ(3u, mQueue->getTaskConcurrency());
+#endif
+
+    vector<int>::type visits(10007, 0);
+    CountVisits task = {&visits};
+    mQueue->parallelFor(0, visits.size(), 13, task);
+    mQueue->parallelFor(5, visits.size(), 0, task);
+
+    for (size_t i = 0; i < visits.size(); ++i)
+        ASSERT_EQ(i < 5 ? 1 : 2, visits[i]) << i;
+}
+//--------------------------------------------------------------------------
+TEST_P(WorkQueueTests, NestedParallelFor)
+{
+    mQueue->setWorkerThreadCount(2);
+    mQueue->startup();
+
+    AtomicScalar<size_t> sum(0);
+    NestedSum task = {mQueue, &sum};
+    mQueue->parallelFor(0, 50, 1, task);
+    EXPECT_EQ(50u * (99u * 100u / 2), (size_t)sum);
+}
+//--------------------------------------------------------------------------
+TEST_P(WorkQueueTests, ParallelForRethrows)
+{
+    mQueue->setWorkerThreadCount(2);
+    mQueue->startup();
+
+    ThrowAt task = {500};
+    EXPECT_THROW(mQueue->parallelFor(0, 1000, 10, task), InvalidParametersException);
+
+    // the queue is still usable afterwards
+    AtomicScalar<size_t> sum(0);
+    SumIndices sumTask = {&sum};
+    mQueue->parallelFor(0, 1000, 10, sumTask);
+    EXPECT_EQ(999u * 1000u / 2, (size_t)sum);
+}
+#if OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER != 3
+//--------------------------------------------------------------------------
+TEST_P(WorkQueueTests, TaskPriorities)
+{
+    mQueue->setWorkerThreadCount(1);
+    mQueue->startup();
+
+    // keep the only worker busy while the tasks are queued
+    AtomicScalar<bool> started(false), released(false);
+    BlockTask block = {&started, &released};
+    mQueue->addTask(block);
+    while (!started)
+        OGRE_THREAD_SLEEP(1);
+
+    AtomicScalar<int> order(0);
+    AtomicScalar<int> position[3];
+    for (int i = 0; i < 3; ++i)
+        position[i] = -1;
+    RecordTask low = {WorkQueue::TASK_PRIORITY_LOW, &order, position};
+    RecordTask normal = {WorkQueue::TASK_PRIORITY_NORMAL, &order, position};
+    RecordTask high = {WorkQueue::TASK_PRIORITY_HIGH, &order, position};
+    mQueue->addTask(low, WorkQueue::TASK_PRIORITY_LOW);
+    mQueue->addTask(normal, WorkQueue::TASK_PRIORITY_NORMAL);
+    mQueue->addTask(high, WorkQueue::TASK_PRIORITY_HIGH);
+    released = true;
+
+    while (order < 3)
+        OGRE_THREAD_SLEEP(1);
+    EXPECT_EQ(0, (int)position[WorkQueue::TASK_PRIORITY_HIGH]);
+    EXPECT_EQ(1, (int)position[WorkQueue::TASK_PRIORITY_NORMAL]);
+    EXPECT_EQ(2, (int)position[WorkQueue::TASK_PRIORITY_LOW]);
+}
+#endif
+//--------------------------------------------------------------------------
+INSTANTIATE_TEST_CASE_P(Default, WorkQueueTests, ::testing::Values(&createDefaultWorkQueue));
+#if OGRE_THREAD_PROVIDER == 4
+INSTANTIATE_TEST_CASE_P(Stealing, WorkQueueTests, ::testing::Values(&createStealingWorkQueue));
+#endif
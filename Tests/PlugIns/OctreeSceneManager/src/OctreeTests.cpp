@@ -0,0 +1,147 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "RootWithoutRenderSystemFixture.h"
+#include "OgreOctreeSceneManager.h"
+#include "OgreOctreeNode.h"
+#include "OgreManualObject.h"
+#include "OgreCamera.h"
+
+#include <algorithm>
+
+using namespace Ogre;
+//--------------------------------------------------------------------------
+namespace {
+    // exposes the nodes found visible by the last walk of the octree
+    class TestOctreeSceneManager : public OctreeSceneManager
+    {
+    public:
+        TestOctreeSceneManager() : OctreeSceneManager("OctreeTests") {}
+        const Octree::NodeList& getVisibleNodes() const { return mVisible; }
+    };
+
+    void populate(SceneManager* sm, vector<SceneNode*>::type& nodes, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            ManualObject* mo = sm->createManualObject();
+            mo->setBoundingBox(AxisAlignedBox(Vector3(-5), Vector3(5)));
+            SceneNode* node = sm->getRootSceneNode()->createChildSceneNode(
+                Vector3(Math::RangeRandom(-900, 900), Math::RangeRandom(-900, 900),
+                        Math::RangeRandom(-900, 900)));
+            node->attachObject(mo);
+            nodes.push_back(node);
+        }
+    }
+
+    vector<SceneNode*>::type intersecting(const vector<SceneNode*>::type& nodes,
+                                          const AxisAlignedBox& box)
+    {
+        vector<SceneNode*>::type result;
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            if (box.intersects(nodes[i]->_getWorldAABB()))
+                result.push_back(nodes[i]);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(RootWithoutRenderSystemFixture, OctreeFindNodesIn)
+{
+    srand(7);
+    TestOctreeSceneManager sm;
+    Camera* cam = sm.createCamera("cam");
+
+    vector<SceneNode*>::type nodes;
+    populate(&sm, nodes, 2000);
+    sm._updateSceneGraph(cam);
+
+    AxisAlignedBox box(Vector3(-300, -200, -100), Vector3(400, 100, 250));
+    vector<SceneNode*>::type found;
+    sm.findNodesIn(box, found);
+    std::sort(found.begin(), found.end());
+    EXPECT_FALSE(found.empty());
+    EXPECT_EQ(intersecting(nodes, box), found);
+
+    // move the nodes around, they have to be found in their new octants
+    for (size_t i = 0; i < nodes.size(); ++i)
+        nodes[i]->translate(Vector3(Math::RangeRandom(-300, 300), 0, Math::RangeRandom(-300, 300)));
+    sm._updateSceneGraph(cam);
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        OctreeNode* on = static_cast<OctreeNode*>(nodes[i]);
+        Octree* octant = on->getOctant();
+        ASSERT_TRUE(octant != 0);
+        // nodes outside the octree live in the root
+        EXPECT_TRUE(on->_isIn(octant->mBox) || octant->getParent() == 0);
+    }
+
+    found.clear();
+    sm.findNodesIn(box, found);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(intersecting(nodes, box), found);
+
+    list<SceneNode*>::type foundList;
+    sm.findNodesIn(box, foundList);
+    EXPECT_EQ(found.size(), foundList.size());
+}
+//--------------------------------------------------------------------------
+TEST_F(RootWithoutRenderSystemFixture, OctreeParallelCulling)
+{
+    startWorkQueue();
+
+    srand(11);
+    TestOctreeSceneManager sm;
+    Camera* cam = sm.createCamera("cam");
+    cam->setPosition(Vector3(0, 0, 1000));
+    cam->lookAt(Vector3(200, 100, 0));
+    cam->setFarClipDistance(1500);
+
+    vector<SceneNode*>::type nodes;
+    populate(&sm, nodes, 4000);
+    sm._updateSceneGraph(cam);
+
+    VisibleObjectsBoundsInfo bounds;
+    sm._findVisibleObjects(cam, &bounds, false);
+    Octree::NodeList serial = sm.getVisibleNodes();
+    EXPECT_FALSE(serial.empty());
+    EXPECT_LT(serial.size(), nodes.size());
+
+    bool parallel = true;
+    sm.setOption("ParallelCulling", &parallel);
+    parallel = false;
+    sm.getOption("ParallelCulling", &parallel);
+    EXPECT_TRUE(parallel);
+
+    bounds.reset();
+    sm._findVisibleObjects(cam, &bounds, false);
+    EXPECT_EQ(serial, sm.getVisibleNodes());
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,183 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+
+#include "Ogre.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMeshLodGenerator.h"
+#include "OgreLodBatchGenerator.h"
+#include "OgreLodConfig.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace Ogre;
+
+namespace {
+
+void help(void)
+{
+    // Print help message
+    cout << endl << "OgreMeshLodBatch: Generates the LOD levels of all the .mesh files in a directory." << endl;
+    cout << "Usage: OgreMeshLodBatch [opts] sourcedir [destdir] " << endl;
+    cout << "-threads n     = number of worker threads (default: one per core)" << endl;
+    cout << "-budget mb     = memory used by the meshes being generated, in MB (default 256)" << endl;
+    cout << "-config dir    = directory to keep the .lodconfig files in (default destdir)" << endl;
+    cout << "-noconfig      = DON'T keep .lodconfig files, regenerate every mesh" << endl;
+    cout << "-l lodlevels   = number of LOD levels (default: autoconfigured)" << endl;
+    cout << "-d loddist     = distance increment to reduce LOD" << endl;
+    cout << "-p lodpercent  = Percentage triangle reduction amount per LOD" << endl;
+    cout << "-nocompression = DON'T compress the LOD index buffers" << endl;
+    cout << "sourcedir  = directory of the meshes to generate the LOD levels of" << endl;
+    cout << "destdir    = optional directory to write the meshes to. If you don't" << endl;
+    cout << "             specify this OGRE overwrites the existing files." << endl;
+    cout << "Meshes whose .lodconfig is newer and has the same settings are skipped." << endl;
+
+    cout << endl;
+}
+
+/// Prints the progress of the batch
+class ProgressListener : public LodBatchGenerator::Listener
+{
+public:
+    void meshProcessed(const String& name, const String& group, const LodBatchGenerator::Statistics& stats)
+    {
+        size_t done = stats.generatedCount + stats.skippedCount + stats.failedCount;
+        cout << "[" << done << "/" << stats.meshCount << "] " << name << endl;
+    }
+};
+
+}
+
+int main(int numargs, char** args)
+{
+    if (numargs < 2) {
+        help();
+        return -1;
+    }
+
+    int retCode = 0;
+    LogManager* logMgr = 0;
+    Root* root = 0;
+    DefaultHardwareBufferManager* bufferManager = 0;
+    MeshLodGenerator* lodGenerator = 0;
+    try 
+    {
+        // keep the console for the progress
+        logMgr = new LogManager();
+        logMgr->createLog("OgreMeshLodBatch.log", true, false);
+        root = new Root("", "", "");
+        bufferManager = new DefaultHardwareBufferManager(); // needed because we don't have a rendersystem
+        MaterialManager::getSingleton().initialise();
+        lodGenerator = new MeshLodGenerator();
+
+        UnaryOptionList unOptList;
+        BinaryOptionList binOptList;
+
+        unOptList["-noconfig"] = false;
+        unOptList["-nocompression"] = false;
+        binOptList["-threads"] = "";
+        binOptList["-budget"] = "";
+        binOptList["-config"] = "";
+        binOptList["-l"] = "";
+        binOptList["-d"] = "500";
+        binOptList["-p"] = "20";
+
+        int startIdx = findCommandLineOpts(numargs, args, unOptList, binOptList);
+        if (startIdx >= numargs) {
+            help();
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "No source directory given.", "OgreMeshLodBatch");
+        }
+
+        String source(args[startIdx]);
+        String dest = numargs > startIdx + 1 ? String(args[startIdx + 1]) : source;
+        String configDir = binOptList["-config"].empty() ? dest : binOptList["-config"];
+
+        // The generation runs on the work queue, which is normally started by Root::initialise
+        DefaultWorkQueueBase* queue = static_cast<DefaultWorkQueueBase*>(root->getWorkQueue());
+        if (!binOptList["-threads"].empty()) {
+            queue->setWorkerThreadCount(StringConverter::parseUnsignedInt(binOptList["-threads"]));
+        }
+        queue->startup();
+
+        LodConfig lodConfig;
+        lodConfig.strategy = DistanceLodSphereStrategy::getSingletonPtr();
+        lodConfig.advanced.useCompression = !unOptList["-nocompression"];
+        unsigned short numLods = StringConverter::parseUnsignedInt(binOptList["-l"]);
+        LodLevel lodLevel;
+        lodLevel.distance = 0.0;
+        lodLevel.reductionMethod = LodLevel::VRM_PROPORTIONAL;
+        lodLevel.reductionValue = 0.0;
+        for (unsigned short iLod = 0; iLod < numLods; ++iLod) {
+            lodLevel.reductionValue += StringConverter::parseReal(binOptList["-p"]) * 0.01f;
+            lodLevel.distance += StringConverter::parseReal(binOptList["-d"]);
+            lodConfig.levels.push_back(lodLevel);
+        }
+
+        ResourceGroupManager::getSingleton().addResourceLocation(source, "FileSystem", "LodBatch");
+
+        ProgressListener listener;
+        LodBatchGenerator batch;
+        batch.setLodConfig(lodConfig);
+        if (!binOptList["-budget"].empty()) {
+            batch.setMemoryBudget(StringConverter::parseSizeT(binOptList["-budget"]) * 1024 * 1024);
+        }
+        batch.setOutputDirectory(dest);
+        if (!unOptList["-noconfig"]) {
+            batch.setConfigDirectory(configDir);
+        }
+        batch.setListener(&listener);
+        batch.addResourceGroup("LodBatch");
+        batch.generate();
+
+        const LodBatchGenerator::Statistics& stats = batch.getStatistics();
+        double seconds = std::max(stats.elapsedTime, 1ul) / 1000000.0;
+        cout << endl << stats.generatedCount << " generated, " << stats.skippedCount << " skipped, "
+             << stats.failedCount << " failed in " << seconds << " s" << endl;
+        cout << stats.generatedCount / seconds << " meshes/s, " << stats.triangleCount / seconds << " triangles/s, "
+             << "peak " << stats.peakBytesInFlight / (1024 * 1024) << " MB in flight" << endl;
+        if (stats.failedCount) {
+            retCode = 1;
+        }
+
+        queue->shutdown();
+    }
+    catch (Exception& e)
+    {
+        cout << "Exception caught: " << e.getDescription();
+        retCode = 1;
+    }
+
+    delete lodGenerator;
+    delete bufferManager;
+    delete root;
+    delete logMgr;
+
+    return retCode;
+
+}